@@ -16,9 +16,19 @@
 #include <hicn/transport/http/client_connection.h>
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <functional>
+#include <iomanip>
 #include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #define ASIO_STANDALONE
 #include <asio.hpp>
@@ -41,23 +51,247 @@ typedef struct {
   bool print_headers;
   std::string producer_certificate;
   std::string ipv6_first_word;
+  std::vector<std::string> input_files;
+  unsigned parallel;
+  bool direct_io;
 } Configuration;
 
+/**
+ * Outcome of the download of one object, for the final report.
+ */
+struct DownloadStats {
+  std::string url;
+  bool success;
+  long bytes;
+  double time_to_first_byte;  // ms
+  double latency;             // ms
+};
+
+class DownloadReport {
+ public:
+  DownloadReport() : start_(std::chrono::steady_clock::now()) {}
+
+  void add(DownloadStats &&stats) {
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    if (stats.success) {
+      std::cout << stats.url << ": " << stats.bytes << " bytes in "
+                << stats.latency << " ms (first byte after "
+                << stats.time_to_first_byte << " ms)" << std::endl;
+    } else {
+      std::cout << stats.url << ": failed after " << stats.latency << " ms"
+                << std::endl;
+    }
+
+    stats_.emplace_back(std::move(stats));
+  }
+
+  void print() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    double elapsed = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start_)
+                         .count();
+
+    std::vector<double> latencies, ttfbs;
+    long bytes = 0;
+    for (auto &stats : stats_) {
+      if (stats.success) {
+        bytes += stats.bytes;
+        latencies.push_back(stats.latency);
+        ttfbs.push_back(stats.time_to_first_byte);
+      }
+    }
+
+    std::cout << std::endl
+              << "Downloaded " << latencies.size() << "/" << stats_.size()
+              << " objects, " << bytes << " bytes in " << elapsed
+              << " s: " << bytes * 8 / elapsed / 1e6 << " Mbps" << std::endl;
+
+    printDistribution("Latency", latencies);
+    printDistribution("Time to first byte", ttfbs);
+  }
+
+  bool allSucceeded() {
+    std::unique_lock<std::mutex> lock(mtx_);
+    return std::all_of(stats_.begin(), stats_.end(),
+                       [](const DownloadStats &s) { return s.success; });
+  }
+
+ private:
+  static void printDistribution(const char *what,
+                                std::vector<double> &values) {
+    if (values.empty()) {
+      return;
+    }
+
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (auto v : values) {
+      sum += v;
+    }
+
+    auto percentile = [&values](double p) {
+      return values[std::size_t(p * (values.size() - 1))];
+    };
+
+    std::cout << what << " [ms]: min " << values.front() << ", avg "
+              << sum / values.size() << ", p50 " << percentile(0.5)
+              << ", p95 " << percentile(0.95) << ", max " << values.back()
+              << std::endl;
+  }
+
+  std::mutex mtx_;
+  std::chrono::steady_clock::time_point start_;
+  std::vector<DownloadStats> stats_;
+};
+
+#ifdef __linux__
+/**
+ * Output file written with O_DIRECT, so that prefetching a large catalogue
+ * does not evict the page cache. Writes are staged in an aligned buffer;
+ * the last block is padded and the file truncated to its real size on
+ * close. Falls back to normal writes if the file system does not support
+ * O_DIRECT or if a resumed download does not start on a block boundary.
+ */
+class DirectFile {
+  static constexpr std::size_t alignment = 4096;
+  static constexpr std::size_t buffer_size = 1024 * 1024;
+
+ public:
+  DirectFile(const std::string &name, long offset)
+      : fd_(-1), buffer_(nullptr), used_(0), offset_(offset), error_(false) {
+    int flags = O_WRONLY | O_CREAT;
+    direct_ = offset_ % alignment == 0;
+
+    if (direct_) {
+      fd_ = ::open(name.c_str(), flags | O_DIRECT, 0644);
+    }
+
+    if (fd_ < 0) {
+      direct_ = false;
+      fd_ = ::open(name.c_str(), flags, 0644);
+    }
+
+    if (fd_ < 0 || posix_memalign((void **)&buffer_, alignment, buffer_size)) {
+      std::cerr << "Error opening " << name << ": " << std::strerror(errno)
+                << std::endl;
+      error_ = true;
+    }
+  }
+
+  ~DirectFile() {
+    close();
+    free(buffer_);
+  }
+
+  void write(const uint8_t *data, std::size_t length) {
+    while (length > 0 && !error_) {
+      std::size_t n = std::min(length, buffer_size - used_);
+      std::memcpy(buffer_ + used_, data, n);
+      used_ += n;
+      data += n;
+      length -= n;
+
+      if (used_ == buffer_size) {
+        flush(used_);
+        used_ = 0;
+      }
+    }
+  }
+
+  void close() {
+    if (fd_ < 0) {
+      return;
+    }
+
+    if (used_ > 0) {
+      off_t size = offset_ + used_;
+      std::size_t length = used_;
+      if (direct_) {
+        length = (used_ + alignment - 1) / alignment * alignment;
+        std::memset(buffer_ + used_, 0, length - used_);
+      }
+
+      flush(length);
+      if (!error_ && direct_ && ::ftruncate(fd_, size)) {
+        error_ = true;
+      }
+
+      used_ = 0;
+    }
+
+    ::close(fd_);
+    fd_ = -1;
+  }
+
+  bool error() const { return error_; }
+
+ private:
+  void flush(std::size_t length) {
+    std::size_t written = 0;
+    while (written < length && !error_) {
+      ssize_t ret = ::pwrite(fd_, buffer_ + written, length - written,
+                             offset_ + written);
+      if (ret < 0 && errno == EINTR) {
+        continue;
+      }
+
+      if (ret <= 0) {
+        std::cerr << "Write error: " << std::strerror(errno) << std::endl;
+        error_ = true;
+        break;
+      }
+
+      written += ret;
+    }
+
+    offset_ += written;
+  }
+
+  int fd_;
+  uint8_t *buffer_;
+  std::size_t used_;
+  off_t offset_;
+  bool direct_;
+  bool error_;
+};
+#endif
+
 class ReadBytesCallbackImplementation
     : public transport::http::HTTPClientConnection::ReadBytesCallback {
   static std::string chunk_separator;
 
  public:
-  ReadBytesCallbackImplementation(std::string file_name, long yet_downloaded)
-      : file_name_(file_name),
+  /**
+   * With a report, the download is one of many: no progress bar is printed
+   * and its outcome is added to the report.
+   */
+  ReadBytesCallbackImplementation(std::string url, std::string file_name,
+                                  long yet_downloaded, bool direct_io = false,
+                                  DownloadReport *report = nullptr)
+      : url_(url),
+        file_name_(file_name),
         temp_file_name_(file_name_ + ".temp"),
-        yet_downloaded_(yet_downloaded),
-        byte_downloaded_(yet_downloaded),
+        out_(nullptr),
+        yet_downloaded_(std::max(yet_downloaded, 0L)),
+        content_size_(yet_downloaded_),
+        byte_downloaded_(yet_downloaded_),
         chunked_(false),
         chunk_size_(0),
+        report_(report),
+        success_(false),
+        start_(std::chrono::steady_clock::now()),
+        first_byte_(start_),
         work_(std::make_unique<asio::io_service::work>(io_service_)),
         thread_(
             std::make_unique<std::thread>([this]() { io_service_.run(); })) {
+#ifdef __linux__
+    if (direct_io && file_name_ != "-") {
+      direct_ = std::make_unique<DirectFile>(temp_file_name_, yet_downloaded_);
+      return;
+    }
+#endif
+
     std::streambuf *buf;
     if (file_name_ != "-") {
       of_.open(temp_file_name_, std::ofstream::binary | std::ofstream::app);
@@ -70,9 +304,18 @@ class ReadBytesCallbackImplementation
   }
 
   ~ReadBytesCallbackImplementation() {
+    // Also stops the writer if the download was stopped without any callback
+    io_service_.post([this]() { work_.reset(); });
     if (thread_->joinable()) {
       thread_->join();
     }
+
+    if (report_) {
+      auto now = std::chrono::steady_clock::now();
+      report_->add({url_, success_, byte_downloaded_ - yet_downloaded_,
+                    toMilliseconds(first_byte_ - start_),
+                    toMilliseconds(now - start_)});
+    }
   }
 
   void onBytesReceived(std::unique_ptr<utils::MemBuf> &&buffer) {
@@ -81,16 +324,17 @@ class ReadBytesCallbackImplementation
       auto buffer = std::unique_ptr<utils::MemBuf>(buffer_ptr);
       std::unique_ptr<utils::MemBuf> payload;
       if (!first_chunk_read_) {
+        first_byte_ = std::chrono::steady_clock::now();
         transport::http::HTTPResponse http_response(std::move(buffer));
         payload = http_response.getPayload();
         auto header = http_response.getHeaders();
         content_size_ = yet_downloaded_;
         std::map<std::string, std::string>::iterator it =
-            header.find("Content-Length");
+            header.find("content-length");
         if (it != header.end()) {
           content_size_ += std::stol(it->second);
         } else {
-          it = header.find("Transfer-Encoding");
+          it = header.find("transfer-encoding");
           if (it != header.end() && it->second.compare("chunked") == 0) {
             chunked_ = true;
           }
@@ -102,7 +346,7 @@ class ReadBytesCallbackImplementation
 
       if (chunked_) {
         if (chunk_size_ > 0) {
-          out_->write((char *)payload->data(), chunk_size_);
+          write(payload->data(), chunk_size_);
           payload->trimStart(chunk_size_);
 
           if (payload->length() >= chunk_separator.size()) {
@@ -130,7 +374,7 @@ class ReadBytesCallbackImplementation
               chunk_size_ -= payload->length();
             }
 
-            out_->write((char *)payload->data(), to_write);
+            write(payload->data(), to_write);
             byte_downloaded_ += (long)to_write;
             payload->trimStart(to_write);
 
@@ -140,11 +384,11 @@ class ReadBytesCallbackImplementation
           }
         }
       } else {
-        out_->write((char *)payload->data(), payload->length());
+        write(payload->data(), payload->length());
         byte_downloaded_ += (long)payload->length();
       }
 
-      if (file_name_ != "-") {
+      if (file_name_ != "-" && !report_) {
         print_bar(byte_downloaded_, content_size_, false);
       }
     });
@@ -152,9 +396,10 @@ class ReadBytesCallbackImplementation
 
   void onSuccess(std::size_t bytes) {
     io_service_.post([this, bytes]() {
-      if (file_name_ != "-") {
-        of_.close();
-        delete out_;
+      success_ = closeOutput();
+      if (file_name_ != "-" && success_) {
+        // Concurrent downloads must not pick the same final name
+        std::unique_lock<std::mutex> lock(rename_mutex);
         std::size_t found = file_name_.find_last_of(".");
         std::string name = file_name_.substr(0, found);
         std::string extension = file_name_.substr(found + 1);
@@ -174,8 +419,10 @@ class ReadBytesCallbackImplementation
           std::rename(temp_file_name_.c_str(), final_name.c_str());
         }
 
-        print_bar(100, 100, true);
-        std::cout << "\nDownloaded " << bytes << " bytes" << std::endl;
+        if (!report_) {
+          print_bar(100, 100, true);
+          std::cout << "\nDownloaded " << bytes << " bytes" << std::endl;
+        }
       }
       work_.reset();
     });
@@ -183,13 +430,50 @@ class ReadBytesCallbackImplementation
 
   void onError(const std::error_code ec) {
     io_service_.post([this]() {
-      of_.close();
-      delete out_;
+      closeOutput();
       work_.reset();
     });
   }
 
  private:
+  static double toMilliseconds(std::chrono::steady_clock::duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+  }
+
+  void write(const uint8_t *data, std::size_t length) {
+#ifdef __linux__
+    if (direct_) {
+      direct_->write(data, length);
+      return;
+    }
+#endif
+
+    out_->write((const char *)data, length);
+  }
+
+  // Return false if some content could not be written
+  bool closeOutput() {
+#ifdef __linux__
+    if (direct_) {
+      direct_->close();
+      return !direct_->error();
+    }
+#endif
+
+    if (!out_) {
+      return false;
+    }
+
+    bool ret = out_->good();
+    if (file_name_ != "-") {
+      of_.close();
+    }
+
+    delete out_;
+    out_ = nullptr;
+    return ret;
+  }
+
   bool exists_file(const std::string &name) {
     std::ifstream f(name.c_str());
     return f.good();
@@ -228,22 +512,33 @@ class ReadBytesCallbackImplementation
   }
 
  private:
+  static std::mutex rename_mutex;
+
+  std::string url_;
   std::string file_name_;
   std::string temp_file_name_;
   std::ostream *out_;
   std::ofstream of_;
+#ifdef __linux__
+  std::unique_ptr<DirectFile> direct_;
+#endif
   long yet_downloaded_;
   long content_size_;
   bool first_chunk_read_ = false;
   long byte_downloaded_ = 0;
   bool chunked_;
   std::size_t chunk_size_;
+  DownloadReport *report_;
+  bool success_;
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point first_byte_;
   asio::io_service io_service_;
   std::unique_ptr<asio::io_service::work> work_;
   std::unique_ptr<std::thread> thread_;
 };
 
 std::string ReadBytesCallbackImplementation::chunk_separator = "\r\n";
+std::mutex ReadBytesCallbackImplementation::rename_mutex;
 
 long checkFileStatus(std::string file_name) {
   struct stat stat_buf;
@@ -252,24 +547,204 @@ long checkFileStatus(std::string file_name) {
   return rc == 0 ? stat_buf.st_size : -1;
 }
 
+std::string fileNameFromUrl(const std::string &url) {
+  std::string file_name = url.substr(1 + url.find_last_of("/"));
+  return file_name.empty() ? "index.html" : file_name;
+}
+
+/**
+ * Expand the first {a,b,...} list or [first-last] range of url, curl style,
+ * and then recursively the following ones. Ranges keep the zero padding of
+ * their first value: [001-100].
+ */
+void expandUrl(const std::string &url, std::vector<std::string> &urls) {
+  std::size_t open = url.find_first_of("{[");
+  std::size_t close = std::string::npos;
+  if (open != std::string::npos) {
+    close = url.find(url[open] == '{' ? '}' : ']', open);
+  }
+
+  if (close == std::string::npos) {
+    urls.push_back(url);
+    return;
+  }
+
+  std::string prefix = url.substr(0, open);
+  std::string suffix = url.substr(close + 1);
+  std::string pattern = url.substr(open + 1, close - open - 1);
+
+  if (url[open] == '{') {
+    std::istringstream ss(pattern);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+      expandUrl(prefix + item + suffix, urls);
+    }
+
+    return;
+  }
+
+  std::size_t dash = pattern.find('-');
+  if (dash == std::string::npos || dash == 0 || dash + 1 == pattern.size() ||
+      pattern.find_first_not_of("0123456789-") != std::string::npos) {
+    // Not a range: brackets are part of the url
+    urls.push_back(url);
+    return;
+  }
+
+  unsigned long first = std::stoul(pattern.substr(0, dash));
+  unsigned long last = std::stoul(pattern.substr(dash + 1));
+  int width = pattern[0] == '0' ? dash : 0;
+  for (unsigned long i = first; i <= last; i++) {
+    std::ostringstream ss;
+    ss << prefix << std::setw(width) << std::setfill('0') << i << suffix;
+    expandUrl(ss.str(), urls);
+  }
+}
+
+// One url per line, empty lines and lines starting with # are skipped
+bool readUrls(const std::string &input_file, std::vector<std::string> &urls) {
+  std::ifstream file;
+  std::istream *in = &std::cin;
+  if (input_file != "-") {
+    file.open(input_file);
+    if (!file.good()) {
+      std::cerr << "Cannot open " << input_file << std::endl;
+      return false;
+    }
+
+    in = &file;
+  }
+
+  std::string line;
+  while (std::getline(*in, line)) {
+    line.erase(0, line.find_first_not_of(" \t"));
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    if (!line.empty() && line[0] != '#') {
+      expandUrl(line, urls);
+    }
+  }
+
+  return true;
+}
+
 void usage(char *program_name) {
   std::cerr << "usage:" << std::endl;
   std::cerr << program_name << " [option]... [url]..." << std::endl;
   std::cerr << program_name << " options:" << std::endl;
   std::cerr
-      << "-O <out_put_path>            = write documents to <out_put_file>"
+      << "-O <out_put_path>            = write documents to <out_put_file>, "
+         "or to the <out_put_path> directory with several urls"
       << std::endl;
   std::cerr << "-S                          = print server response"
             << std::endl;
   std::cerr << "-P                          = first word of the ipv6 name of "
                "the response"
             << std::endl;
+  std::cerr << "-i <file>                   = download the urls listed in "
+               "<file>, one per line ('-' for stdin)"
+            << std::endl;
+  std::cerr << "-j <n>                      = download up to <n> objects in "
+               "parallel, each with its own consumer socket (default 4)"
+            << std::endl;
+  std::cerr << "-d                          = write with O_DIRECT, bypassing "
+               "the page cache"
+            << std::endl;
+  std::cerr << "Urls can contain {a,b,c} lists and [1-100] ranges."
+            << std::endl;
   std::cerr << "example:" << std::endl;
   std::cerr << "\t" << program_name << " -O - http://origin/index.html"
             << std::endl;
+  std::cerr << "\t" << program_name
+            << " -j 8 -O segments http://origin/video/seg_[1-300].m4s"
+            << std::endl;
   exit(EXIT_FAILURE);
 }
 
+std::map<std::string, std::string> requestHeaders(long yet_downloaded) {
+  if (yet_downloaded == -1) {
+    return {{"Host", "localhost"},
+            {"User-Agent", "higet/1.0"},
+            {"Connection", "Keep-Alive"}};
+  }
+
+  std::string range;
+  range.append("bytes=");
+  range.append(std::to_string(yet_downloaded));
+  range.append("-");
+  return {{"Host", "localhost"},
+          {"User-Agent", "higet/1.0"},
+          {"Connection", "Keep-Alive"},
+          {"Range", range}};
+}
+
+void setupConnection(transport::http::HTTPClientConnection &connection,
+                     const Configuration &conf) {
+  if (!conf.producer_certificate.empty()) {
+    std::shared_ptr<transport::auth::Verifier> verifier =
+        std::make_shared<transport::auth::AsymmetricVerifier>(
+            conf.producer_certificate);
+    connection.setVerifier(verifier);
+  }
+}
+
+/**
+ * Download all the urls with conf.parallel connections. Each worker thread
+ * owns a connection, i.e. a consumer socket, and takes the next url when
+ * its current download ends.
+ */
+int downloadAll(const std::vector<std::string> &urls,
+                const Configuration &conf) {
+  std::string directory = conf.file_name.empty() ? "." : conf.file_name;
+#ifndef _WIN32
+  mkdir(directory.c_str(), 0755);
+#endif
+
+  // Names are chosen up front, so that no two downloads share a temp file
+  std::vector<std::string> file_names;
+  std::set<std::string> used;
+  for (auto &url : urls) {
+    std::string name = fileNameFromUrl(url);
+    std::string file_name = name;
+    std::size_t found = name.find_last_of(".");
+    for (int i = 1; !used.insert(file_name).second; i++) {
+      file_name = name.substr(0, found) + "(" + std::to_string(i) + ")" +
+                  (found != std::string::npos ? name.substr(found) : "");
+    }
+
+    file_names.push_back(directory + "/" + file_name);
+  }
+
+  DownloadReport report;
+  std::atomic<std::size_t> next(0);
+  std::vector<std::thread> workers;
+
+  unsigned n_workers = std::min<std::size_t>(conf.parallel, urls.size());
+  std::cerr << "Downloading " << urls.size() << " objects with " << n_workers
+            << " connections" << std::endl;
+
+  for (unsigned w = 0; w < n_workers; w++) {
+    workers.emplace_back([&]() {
+      transport::http::HTTPClientConnection connection;
+      setupConnection(connection, conf);
+
+      for (std::size_t i; (i = next++) < urls.size();) {
+        long yet_downloaded = checkFileStatus(file_names[i]);
+        http::ReadBytesCallbackImplementation callback(
+            urls[i], file_names[i], yet_downloaded, conf.direct_io, &report);
+        connection.get(urls[i], requestHeaders(yet_downloaded), {}, nullptr,
+                       &callback, conf.ipv6_first_word);
+      }
+    });
+  }
+
+  for (auto &worker : workers) {
+    worker.join();
+  }
+
+  report.print();
+  return report.allSucceeded() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int main(int argc, char **argv) {
 #ifdef _WIN32
   WSADATA wsaData = {0};
@@ -281,11 +756,13 @@ int main(int argc, char **argv) {
   conf.print_headers = false;
   conf.producer_certificate = "";
   conf.ipv6_first_word = "b001";
+  conf.parallel = 4;
+  conf.direct_io = false;
 
   std::string name("http://webserver/sintel/mpd");
 
   int opt;
-  while ((opt = getopt(argc, argv, "O:Sc:P:")) != -1) {
+  while ((opt = getopt(argc, argv, "O:Sc:P:i:j:d")) != -1) {
     switch (opt) {
       case 'O':
         conf.file_name = optarg;
@@ -299,6 +776,15 @@ int main(int argc, char **argv) {
       case 'P':
         conf.ipv6_first_word = optarg;
         break;
+      case 'i':
+        conf.input_files.push_back(optarg);
+        break;
+      case 'j':
+        conf.parallel = std::max(1, std::atoi(optarg));
+        break;
+      case 'd':
+        conf.direct_io = true;
+        break;
       case 'h':
       default:
         usage(argv[0]);
@@ -306,49 +792,53 @@ int main(int argc, char **argv) {
     }
   }
 
-  if (!argv[optind]) {
+  std::vector<std::string> urls;
+  for (int i = optind; i < argc; i++) {
+    expandUrl(argv[i], urls);
+  }
+
+  for (auto &input_file : conf.input_files) {
+    if (!readUrls(input_file, urls)) {
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  if (urls.empty()) {
     usage(argv[0]);
   }
 
-  name = argv[optind];
+  if (urls.size() > 1 || !conf.input_files.empty()) {
+    if (conf.file_name == "-") {
+      std::cerr << "-O - cannot be used with several urls" << std::endl;
+      usage(argv[0]);
+    }
+
+    int ret = downloadAll(urls, conf);
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return ret;
+  }
+
+  name = urls.front();
   std::cerr << "Using name " << name << " and name first word "
             << conf.ipv6_first_word << std::endl;
 
   if (conf.file_name.empty()) {
-    conf.file_name = name.substr(1 + name.find_last_of("/"));
+    conf.file_name = fileNameFromUrl(name);
   }
 
   long yetDownloaded = checkFileStatus(conf.file_name);
 
-  std::map<std::string, std::string> headers;
-  if (yetDownloaded == -1) {
-    headers = {{"Host", "localhost"},
-               {"User-Agent", "higet/1.0"},
-               {"Connection", "Keep-Alive"}};
-  } else {
-    std::string range;
-    range.append("bytes=");
-    range.append(std::to_string(yetDownloaded));
-    range.append("-");
-    headers = {{"Host", "localhost"},
-               {"User-Agent", "higet/1.0"},
-               {"Connection", "Keep-Alive"},
-               {"Range", range}};
-  }
+  std::map<std::string, std::string> headers = requestHeaders(yetDownloaded);
 
   transport::http::HTTPClientConnection connection;
-
-  if (!conf.producer_certificate.empty()) {
-    std::shared_ptr<transport::auth::Verifier> verifier =
-        std::make_shared<transport::auth::AsymmetricVerifier>(
-            conf.producer_certificate);
-    connection.setVerifier(verifier);
-  }
+  setupConnection(connection, conf);
 
   t1 = std::chrono::system_clock::now();
 
-  http::ReadBytesCallbackImplementation readBytesCallback(conf.file_name,
-                                                          yetDownloaded);
+  http::ReadBytesCallbackImplementation readBytesCallback(
+      name, conf.file_name, yetDownloaded, conf.direct_io);
 
   connection.get(name, headers, {}, nullptr, &readBytesCallback,
                  conf.ipv6_first_word);
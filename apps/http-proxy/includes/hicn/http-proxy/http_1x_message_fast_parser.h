@@ -52,16 +52,13 @@ class HTTPMessageFastParser {
 
   static void getHeaders(const uint8_t* headers, std::size_t length,
                          bool request, transport::Metadata* metadata);
-  static std::size_t hasBody(const uint8_t* headers, std::size_t length);
   static bool isMpdRequest(const uint8_t* headers, std::size_t length);
   static uint32_t parseCacheControl(const uint8_t* headers, std::size_t length);
 
-  static std::string numbers;
   static std::string content_length;
   static std::string transfer_encoding;
   static std::string chunked;
   static std::string cache_control;
   static std::string connection;
-  static std::string mpd;
   static std::string separator;
 };
@@ -82,6 +82,9 @@ class Receiver {
   void stopAndJoinThread() { thread_.stop(); }
   virtual void stop() = 0;
 
+  /* Run the receiver thread on the given core only */
+  void pinToCore(unsigned core);
+
  protected:
   utils::EventThread thread_;
 };
@@ -169,6 +172,7 @@ class HTTPProxy {
     std::string mtu;
     std::string content_lifetime;
     bool manifest;
+    std::size_t origin_connections;
 
     void printParams() override {
       std::cout << "Running HTTP/hICN -> HTTP/TCP proxy." << std::endl;
@@ -190,17 +194,27 @@ class HTTPProxy {
                 << "Prefix first word: " << first_ipv6_word << std::endl;
       std::cout << "\t"
                 << "Use manifest: " << manifest << std::endl;
+      std::cout << "\t"
+                << "Origin connections: " << origin_connections << std::endl;
     }
   };
 
-  HTTPProxy(ClientParams& icn_params, std::size_t n_thread = 1);
-  HTTPProxy(ServerParams& icn_params, std::size_t n_thread = 1);
+  /**
+   * Each of the n_thread receivers runs on its own thread. TCP connections are
+   * balanced among the client receivers by the kernel (SO_REUSEPORT), while
+   * the server receivers split the hICN name space among themselves.
+   */
+  HTTPProxy(ClientParams& icn_params, std::size_t n_thread = 1,
+            bool pin_threads = false);
+  HTTPProxy(ServerParams& icn_params, std::size_t n_thread = 1,
+            bool pin_threads = false);
 
   void run() { main_io_context_.run(); }
   void stop();
 
  private:
   void setupSignalHandler();
+  void pinReceivers();
 
   std::vector<std::unique_ptr<Receiver>> receivers_;
   asio::io_service main_io_context_;
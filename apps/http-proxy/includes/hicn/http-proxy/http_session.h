@@ -84,6 +84,8 @@ class HTTPSession {
 
   void close();
 
+  bool checkConnected();
+
  private:
   void doConnect();
 
@@ -95,8 +97,6 @@ class HTTPSession {
 
   void doWrite();
 
-  bool checkConnected();
-
  private:
   void handleRead(std::error_code ec, std::size_t length);
   void tryReconnection();
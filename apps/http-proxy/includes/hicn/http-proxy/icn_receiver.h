@@ -20,9 +20,12 @@
 
 #include <asio.hpp>
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <memory>
 #include <queue>
 #include <utility>
+#include <vector>
 
 #include <hicn/http-proxy/http_session.h>
 //#include "http_session.h"
@@ -30,26 +33,51 @@
 namespace transport {
 
 class AsyncConsumerProducer {
-  using SegmentProductionPair = std::pair<uint32_t, bool>;
-  using ResponseInfoMap = std::unordered_map<core::Name, SegmentProductionPair>;
+  using Clock = std::chrono::steady_clock;
   using RequestQueue = std::queue<interface::PublicationOptions>;
 
+  // Idle responses are checked with this period, and forgotten once their
+  // content has expired.
+  static constexpr std::chrono::seconds response_info_sweep_period =
+      std::chrono::seconds(1);
+
+  struct ResponseInfo {
+    // Number of segments produced so far
+    uint32_t max_segment;
+    bool in_production;
+    uint32_t lifetime;
+    Clock::time_point last_access;
+  };
+
+  using ResponseInfoMap = std::unordered_map<core::Name, ResponseInfo>;
+
+  // HTTP/1.1 responses come back in order on each connection, so every
+  // connection keeps the names of its outstanding requests.
+  struct OriginConnection {
+    std::unique_ptr<HTTPSession> session;
+    RequestQueue response_name_queue;
+  };
+
  public:
   explicit AsyncConsumerProducer(
       asio::io_service& io_service, const std::string& prefix,
       const std::string& first_ipv6_word, const std::string& origin_address,
       const std::string& origin_port, const std::string& cache_size,
       const std::string& mtu, const std::string& content_lifetime,
-      bool manifest);
+      bool manifest, std::size_t origin_connections = 1,
+      std::size_t shard = 0, std::size_t n_shards = 1);
 
   explicit AsyncConsumerProducer(
       const std::string& prefix, const std::string& first_ipv6_word,
       const std::string& origin_address, const std::string& origin_port,
       const std::string& cache_size, const std::string& mtu,
-      const std::string& content_lifetime, bool manifest)
+      const std::string& content_lifetime, bool manifest,
+      std::size_t origin_connections = 1, std::size_t shard = 0,
+      std::size_t n_shards = 1)
       : AsyncConsumerProducer(internal_io_service_, prefix, first_ipv6_word,
                               origin_address, origin_port, cache_size, mtu,
-                              content_lifetime, manifest) {
+                              content_lifetime, manifest, origin_connections,
+                              shard, n_shards) {
     external_io_service_ = false;
   }
 
@@ -64,12 +92,22 @@ class AsyncConsumerProducer {
 
   void doReceive();
 
-  void publishContent(const uint8_t* data, std::size_t size,
-                      bool is_last = true, bool headers = false);
+  void publishContent(OriginConnection& connection, const uint8_t* data,
+                      std::size_t size, bool is_last = true,
+                      bool headers = false);
 
   void manageIncomingInterest(core::Name& name, core::Packet::MemBufPtr& packet,
                               utils::MemBuf* payload);
 
+  bool onOriginConnectionClosed(OriginConnection& connection);
+
+  // nullptr if no connection to the origin is up
+  OriginConnection* selectOriginConnection();
+
+  void scheduleResponseInfoSweep();
+
+  void registerPrefixShard(std::size_t shard, std::size_t n_shards);
+
   core::Prefix prefix_;
   asio::io_service& io_service_;
   asio::io_service internal_io_service_;
@@ -82,17 +120,19 @@ class AsyncConsumerProducer {
   uint32_t mtu_;
 
   uint64_t request_counter_;
+  uint64_t coalesced_requests_;
 
-  // std::unordered_map<core::Name, std::shared_ptr<ATSConnector>>
-  // connection_map_;
-  HTTPSession connector_;
+  // Pool of connections to the origin. Requests go to the connection with the
+  // fewest outstanding responses, so a slow response only delays the requests
+  // behind it on the same connection.
+  std::vector<std::unique_ptr<OriginConnection>> connections_;
 
   unsigned long default_content_lifetime_;
 
-  // ResponseInfoMap --> max_seq_number + bool indicating whether request is in
-  // production
+  // Responses being produced or already produced. Concurrent misses for the
+  // same content are coalesced into a single request to the origin.
   ResponseInfoMap chunk_number_map_;
-  RequestQueue response_name_queue_;
+  asio::steady_timer sweep_timer_;
 };
 
 }  // namespace transport
@@ -22,6 +22,7 @@ int usage(char* program) {
             << "Server or Client: \n"
             << "  -P [FIRST_IPv6_WORD_HEX]\n"
             << "  -t [number of threads]\n"
+            << "  -A (pin each thread to a core)\n"
             << "Client Options: \n"
             << "  -L [PROXY_LISTEN_PORT]\n"
             << "Server Options: \n"
@@ -31,6 +32,7 @@ int usage(char* program) {
             << "  -m [MTU]"
             << "  -l [DEFAULT_CONTENT_LIFETIME] (seconds)\n"
             << "  -M (enable manifest)\n"
+            << "  -n [ORIGIN_CONNECTIONS]\n"
             << std::endl
             << "Example Server:\n"
             << "  " << program
@@ -55,15 +57,17 @@ struct Params : HTTPProxy::ClientParams, HTTPProxy::ServerParams {
 
     std::cout << "\t"
               << "N Threads: " << n_thread << std::endl;
+    std::cout << "\t"
+              << "Pin threads: " << pin_threads << std::endl;
   }
 
   HTTPProxy* instantiateProxyAsValue() {
     if (client) {
       HTTPProxy::ClientParams* p = dynamic_cast<HTTPProxy::ClientParams*>(this);
-      return new transport::HTTPProxy(*p, n_thread);
+      return new transport::HTTPProxy(*p, n_thread, pin_threads);
     } else if (server) {
       HTTPProxy::ServerParams* p = dynamic_cast<HTTPProxy::ServerParams*>(this);
-      return new transport::HTTPProxy(*p, n_thread);
+      return new transport::HTTPProxy(*p, n_thread, pin_threads);
     } else {
       throw std::runtime_error(
           "Proxy configured as client and server at the same time.");
@@ -73,6 +77,7 @@ struct Params : HTTPProxy::ClientParams, HTTPProxy::ServerParams {
   bool client = false;
   bool server = false;
   std::uint16_t n_thread = 1;
+  bool pin_threads = false;
 };
 
 int main(int argc, char** argv) {
@@ -86,10 +91,11 @@ int main(int argc, char** argv) {
   params.first_ipv6_word = "b001";
   params.content_lifetime = "7200;";  // seconds
   params.manifest = false;
+  params.origin_connections = 4;
   params.tcp_listen_port = 8080;
 
   int opt;
-  while ((opt = getopt(argc, argv, "CSa:p:c:m:P:l:ML:t:")) != -1) {
+  while ((opt = getopt(argc, argv, "CSa:p:c:m:P:l:ML:t:n:A")) != -1) {
     switch (opt) {
       case 'C':
         if (params.server) {
@@ -136,6 +142,12 @@ int main(int argc, char** argv) {
       case 't':
         params.n_thread = std::stoul(optarg);
         break;
+      case 'A':
+        params.pin_threads = true;
+        break;
+      case 'n':
+        params.origin_connections = std::stoul(optarg);
+        break;
       case 'h':
       default:
         return usage(argv[0]);
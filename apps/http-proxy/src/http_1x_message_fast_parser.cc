@@ -14,23 +14,18 @@
  */
 
 #include <hicn/http-proxy/http_session.h>
+#include <hicn/transport/http/parser.h>
 #include <hicn/transport/http/request.h>
 #include <hicn/transport/http/response.h>
 
-#include <experimental/algorithm>
-#include <experimental/functional>
-#include <iostream>
-
 constexpr char HTTPMessageFastParser::http_ok[];
 constexpr char HTTPMessageFastParser::http_cors[];
 constexpr char HTTPMessageFastParser::http_failed[];
 
-std::string HTTPMessageFastParser::numbers = "0123456789";
 std::string HTTPMessageFastParser::content_length = "content-length";
 std::string HTTPMessageFastParser::transfer_encoding = "transfer-encoding";
 std::string HTTPMessageFastParser::chunked = "chunked";
 std::string HTTPMessageFastParser::cache_control = "cache-control";
-std::string HTTPMessageFastParser::mpd = "mpd";
 std::string HTTPMessageFastParser::connection = "connection";
 std::string HTTPMessageFastParser::separator = "\r\n\r\n";
 
@@ -60,43 +55,10 @@ void HTTPMessageFastParser::getHeaders(const uint8_t *headers,
   throw std::runtime_error("Error parsing response headers.");
 }
 
-std::size_t HTTPMessageFastParser::hasBody(const uint8_t *headers,
-                                           std::size_t length) {
-  const char *buffer = reinterpret_cast<const char *>(headers);
-  const char *begin = buffer;
-  const char *end = buffer + length;
-
-  using std::experimental::make_boyer_moore_searcher;
-  auto it = std::experimental::search(
-      begin, end,
-      make_boyer_moore_searcher(content_length.begin(), content_length.end()));
-
-  if (it != end) {
-    // Read header line
-    auto it2 = std::find_first_of(it, end, numbers.begin(), numbers.end());
-    auto it3 = std::find(it2, end, '\n');
-
-    return std::stoul(std::string(it2, it3));
-  }
-
-  return 0;
-}
-
 bool HTTPMessageFastParser::isMpdRequest(const uint8_t *headers,
                                          std::size_t length) {
-  const char *buffer = reinterpret_cast<const char *>(headers);
-  const char *begin = buffer;
-  const char *end = buffer + length;
-
-  using std::experimental::make_boyer_moore_searcher;
-  auto it = std::experimental::search(
-      begin, end, make_boyer_moore_searcher(mpd.begin(), mpd.end()));
-
-  if (it != end) {
-    return true;
-  }
-
-  return false;
+  transport::http::HTTPMessageView message;
+  return message.parse(headers, length) && message.startLine(1).contains("mpd");
 }
 
 uint32_t HTTPMessageFastParser::parseCacheControl(const uint8_t *headers,
@@ -20,6 +20,13 @@
 #include <hicn/transport/utils/log.h>
 #include <hicn/transport/utils/string_utils.h>
 
+#include <algorithm>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
 namespace transport {
 
 using core::Interest;
@@ -329,6 +336,24 @@ void TcpReceiver::onNewConnection(asio::ip::tcp::socket&& socket) {
   used_http_clients_.insert(c);
 }
 
+void Receiver::pinToCore(unsigned core) {
+#ifdef __linux__
+  thread_.add([core]() {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core, &cpuset);
+
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (ret != 0) {
+      TRANSPORT_LOGE("Impossible to pin thread to core %u: %s", core,
+                     strerror(ret));
+    }
+  });
+#else
+  TRANSPORT_LOGW("Thread pinning is not supported on this platform.");
+#endif
+}
+
 void HTTPProxy::setupSignalHandler() {
   signals_.async_wait([this](const std::error_code& ec, int signal_number) {
     if (!ec) {
@@ -350,7 +375,16 @@ void HTTPProxy::stop() {
   signals_.cancel();
 }
 
-HTTPProxy::HTTPProxy(ClientParams& params, std::size_t n_thread)
+void HTTPProxy::pinReceivers() {
+  unsigned n_cores = std::max(std::thread::hardware_concurrency(), 1u);
+
+  for (std::size_t i = 0; i < receivers_.size(); i++) {
+    receivers_[i]->pinToCore(i % n_cores);
+  }
+}
+
+HTTPProxy::HTTPProxy(ClientParams& params, std::size_t n_thread,
+                     bool pin_threads)
     : signals_(main_io_context_, SIGINT, SIGQUIT) {
   for (uint16_t i = 0; i < n_thread; i++) {
     // icn_receivers_.emplace_back(std::make_unique<IcnReceiver>(icn_params));
@@ -358,16 +392,26 @@ HTTPProxy::HTTPProxy(ClientParams& params, std::size_t n_thread)
         params.tcp_listen_port, params.prefix, params.first_ipv6_word));
   }
 
+  if (pin_threads) {
+    pinReceivers();
+  }
+
   setupSignalHandler();
 }
 
-HTTPProxy::HTTPProxy(ServerParams& params, std::size_t n_thread)
+HTTPProxy::HTTPProxy(ServerParams& params, std::size_t n_thread,
+                     bool pin_threads)
     : signals_(main_io_context_, SIGINT, SIGQUIT) {
   for (uint16_t i = 0; i < n_thread; i++) {
     receivers_.emplace_back(std::make_unique<IcnReceiver>(
         params.prefix, params.first_ipv6_word, params.origin_address,
         params.origin_port, params.cache_size, params.mtu,
-        params.content_lifetime, params.manifest));
+        params.content_lifetime, params.manifest, params.origin_connections,
+        i, n_thread));
+  }
+
+  if (pin_threads) {
+    pinReceivers();
   }
 
   setupSignalHandler();
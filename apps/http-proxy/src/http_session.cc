@@ -170,7 +170,7 @@ void HTTPSession::handleRead(std::error_code ec, std::size_t length) {
                        std::bind(&HTTPSession::handleRead, this,
                                  std::placeholders::_1, std::placeholders::_2));
     }
-  } else if (ec == asio::error::eof) {
+  } else {
     input_buffer_.consume(input_buffer_.size());
     tryReconnection();
   }
@@ -282,6 +282,12 @@ void HTTPSession::tryReconnection() {
           // socket_.shutdown(asio::ip::tcp::socket::shutdown_type::shutdown_both);
           socket_.close();
         }
+
+        // The callback gave up the responses to these requests: sending
+        // them on the new connection would mismatch requests and responses
+        write_msgs_.clear();
+        data_available_ = false;
+
         startConnectionTimer();
         doConnect();
       });
@@ -21,36 +21,34 @@
 #include <hicn/transport/utils/hash.h>
 #include <hicn/transport/utils/log.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 
 namespace transport {
 
+constexpr std::chrono::seconds
+    AsyncConsumerProducer::response_info_sweep_period;
+
 AsyncConsumerProducer::AsyncConsumerProducer(
     asio::io_service& io_service, const std::string& prefix,
     const std::string& first_ipv6_word, const std::string& origin_address,
     const std::string& origin_port, const std::string& cache_size,
-    const std::string& mtu, const std::string& content_lifetime, bool manifest)
+    const std::string& mtu, const std::string& content_lifetime, bool manifest,
+    std::size_t origin_connections, std::size_t shard, std::size_t n_shards)
     : prefix_(core::Prefix(generatePrefix(prefix, first_ipv6_word), 64)),
       io_service_(io_service),
       external_io_service_(true),
       producer_socket_(),
       ip_address_(origin_address),
       port_(origin_port),
-      cache_size_(std::stoul(cache_size)),
+      cache_size_(std::stoul(cache_size) /
+                  std::max<std::size_t>(n_shards, 1)),
       mtu_(std::stoul(mtu)),
       request_counter_(0),
-      connector_(io_service_, ip_address_, port_,
-                 std::bind(&AsyncConsumerProducer::publishContent, this,
-                           std::placeholders::_1, std::placeholders::_2,
-                           std::placeholders::_3, std::placeholders::_4),
-                 [this](asio::ip::tcp::socket& socket) -> bool {
-                   std::queue<interface::PublicationOptions> empty;
-                   std::swap(response_name_queue_, empty);
-
-                   return true;
-                 }),
-      default_content_lifetime_(std::stoul(content_lifetime)) {
+      coalesced_requests_(0),
+      default_content_lifetime_(std::stoul(content_lifetime)),
+      sweep_timer_(io_service_) {
   int ret = producer_socket_.setSocketOption(
       interface::GeneralTransportOptions::OUTPUT_BUFFER_SIZE, cache_size_);
 
@@ -72,12 +70,67 @@ AsyncConsumerProducer::AsyncConsumerProducer(
     TRANSPORT_LOGD("Warning: mtu has not been set.");
   }
 
-  producer_socket_.registerPrefix(prefix_);
+  if (origin_connections == 0) {
+    origin_connections = 1;
+  }
+
+  for (std::size_t i = 0; i < origin_connections; i++) {
+    auto connection = std::make_unique<OriginConnection>();
+    OriginConnection& c = *connection;
+    c.session = std::make_unique<HTTPSession>(
+        io_service_, ip_address_, port_,
+        std::bind(&AsyncConsumerProducer::publishContent, this, std::ref(c),
+                  std::placeholders::_1, std::placeholders::_2,
+                  std::placeholders::_3, std::placeholders::_4),
+        [this, &c](asio::ip::tcp::socket& socket) -> bool {
+          return onOriginConnectionClosed(c);
+        });
+    connections_.emplace_back(std::move(connection));
+  }
+
+  registerPrefixShard(shard, n_shards);
+}
+
+void AsyncConsumerProducer::registerPrefixShard(std::size_t shard,
+                                                std::size_t n_shards) {
+  if (n_shards <= 1) {
+    producer_socket_.registerPrefix(prefix_);
+    return;
+  }
+
+  // The request hash follows the 64 bits of the prefix, and all the segments
+  // of a response share it: each response is produced and cached by a single
+  // shard. Some more buckets than shards keep the split even when n_shards is
+  // not a power of two.
+  unsigned bits = 0;
+  while ((std::size_t(1) << bits) < n_shards) {
+    bits++;
+  }
+
+  if ((std::size_t(1) << bits) != n_shards && bits <= 12) {
+    bits += 4;
+  }
+
+  const ip_prefix_t& ip_prefix = prefix_.toIpPrefixStruct();
+  for (std::size_t bucket = shard; bucket < (std::size_t(1) << bits);
+       bucket += n_shards) {
+    uint8_t address[IPV6_ADDR_LEN];
+    std::memcpy(address, ip_prefix.address.v6.as_u8, IPV6_ADDR_LEN);
+
+    // Bucket in the most significant bits after the first 64
+    uint16_t word = uint16_t(bucket << (16 - bits));
+    address[8] = uint8_t(word >> 8);
+    address[9] = uint8_t(word);
+
+    producer_socket_.registerPrefix(
+        core::Prefix(core::Name(AF_INET6, address), 64 + bits));
+  }
 }
 
 void AsyncConsumerProducer::start() {
   TRANSPORT_LOGD("Starting listening");
   doReceive();
+  scheduleResponseInfoSweep();
 }
 
 void AsyncConsumerProducer::run() {
@@ -92,8 +145,13 @@ void AsyncConsumerProducer::stop() {
   io_service_.post([this]() {
     TRANSPORT_LOGI("Number of requests processed by plugin: %lu",
                    (unsigned long)request_counter_);
+    TRANSPORT_LOGI("Number of coalesced requests: %lu",
+                   (unsigned long)coalesced_requests_);
+    sweep_timer_.cancel();
     producer_socket_.stop();
-    connector_.close();
+    for (auto& connection : connections_) {
+      connection->session->close();
+    }
   });
 }
 
@@ -120,50 +178,122 @@ void AsyncConsumerProducer::manageIncomingInterest(
   name.setSuffix(0);
   auto _it = chunk_number_map_.find(name);
   auto _end = chunk_number_map_.end();
+  auto now = Clock::now();
 
   if (_it != _end) {
-    if (_it->second.second) {
+    _it->second.last_access = now;
+
+    if (_it->second.in_production) {
       TRANSPORT_LOGD(
           "Content is in production, interests will be satisfied shortly.");
+      coalesced_requests_++;
+      delete payload;
       return;
     }
 
-    if (seg >= _it->second.first) {
+    if (seg >= _it->second.max_segment) {
       TRANSPORT_LOGD(
           "Ignoring interest with name %s for a content object which does not "
           "exist. (Request: %u, max: %u)",
-          name.toString().c_str(), (uint32_t)seg, (uint32_t)_it->second.first);
+          name.toString().c_str(), (uint32_t)seg,
+          (uint32_t)_it->second.max_segment);
+      delete payload;
       return;
     }
   }
 
   bool is_mpd =
       HTTPMessageFastParser::isMpdRequest(payload->data(), payload->length());
+  uint32_t lifetime = is_mpd ? 1000 : default_content_lifetime_;
+
+  OriginConnection* connection = selectOriginConnection();
+  if (TRANSPORT_EXPECT_FALSE(!connection)) {
+    // Nothing is produced: the next interest for this content retries
+    TRANSPORT_LOGD("No connection to the origin, dropping request %s",
+                   name.toString().c_str());
+    delete payload;
+    return;
+  }
+
+  auto pair = chunk_number_map_.emplace(name, ResponseInfo());
+  ResponseInfo& info = pair.first->second;
+  info.max_segment = 0;
+  info.in_production = true;
+  info.lifetime = lifetime;
+  info.last_access = now;
+
+  connection->response_name_queue.emplace(std::move(name), lifetime);
+  connection->session->send(payload, [packet = std::move(packet)]() {});
+}
+
+AsyncConsumerProducer::OriginConnection*
+AsyncConsumerProducer::selectOriginConnection() {
+  // Least outstanding requests among the connected ones: the others either
+  // failed or are reconnecting, and would hold the request indefinitely.
+  OriginConnection* ret = nullptr;
+
+  for (auto& connection : connections_) {
+    if (!connection->session->checkConnected()) {
+      continue;
+    }
+
+    if (!ret || connection->response_name_queue.size() <
+                    ret->response_name_queue.size()) {
+      ret = connection.get();
+    }
+  }
+
+  return ret;
+}
 
-  auto pair = chunk_number_map_.emplace(name, std::pair<uint32_t, bool>(0, 0));
-  if (!pair.second) {
-    pair.first->second.first = 0;
+bool AsyncConsumerProducer::onOriginConnectionClosed(
+    OriginConnection& connection) {
+  // The responses still pending on this connection are lost: forget them so
+  // that the next interests fetch them again. The session drops the requests
+  // it did not send yet.
+  while (!connection.response_name_queue.empty()) {
+    chunk_number_map_.erase(connection.response_name_queue.front().getName());
+    connection.response_name_queue.pop();
   }
 
-  pair.first->second.second = true;
+  return true;
+}
 
-  response_name_queue_.emplace(std::move(name),
-                               is_mpd ? 1000 : default_content_lifetime_);
+void AsyncConsumerProducer::scheduleResponseInfoSweep() {
+  sweep_timer_.expires_from_now(response_info_sweep_period);
+  sweep_timer_.async_wait([this](const std::error_code& ec) {
+    if (ec) {
+      return;
+    }
+
+    auto now = Clock::now();
+    for (auto it = chunk_number_map_.begin(); it != chunk_number_map_.end();) {
+      if (!it->second.in_production &&
+          now - it->second.last_access >
+              std::chrono::milliseconds(it->second.lifetime)) {
+        it = chunk_number_map_.erase(it);
+      } else {
+        ++it;
+      }
+    }
 
-  connector_.send(payload, [packet = std::move(packet)]() {});
+    scheduleResponseInfoSweep();
+  });
 }
 
-void AsyncConsumerProducer::publishContent(const uint8_t* data,
+void AsyncConsumerProducer::publishContent(OriginConnection& connection,
+                                           const uint8_t* data,
                                            std::size_t size, bool is_last,
                                            bool headers) {
   uint32_t start_suffix = 0;
 
-  if (response_name_queue_.empty()) {
+  if (connection.response_name_queue.empty()) {
     std::cerr << "Aborting due tue empty request queue" << std::endl;
     abort();
   }
 
-  interface::PublicationOptions& options = response_name_queue_.front();
+  interface::PublicationOptions& options =
+      connection.response_name_queue.front();
 
   int ret = producer_socket_.setSocketOption(
       interface::GeneralTransportOptions::CONTENT_OBJECT_EXPIRY_TIME,
@@ -182,18 +312,19 @@ void AsyncConsumerProducer::publishContent(const uint8_t* data,
     abort();
   }
 
-  start_suffix = it->second.first;
+  start_suffix = it->second.max_segment;
 
   if (headers) {
     request_counter_++;
   }
 
-  it->second.first +=
+  it->second.max_segment +=
       producer_socket_.produceStream(name, data, size, is_last, start_suffix);
+  it->second.last_access = Clock::now();
 
   if (is_last) {
-    it->second.second = false;
-    response_name_queue_.pop();
+    it->second.in_production = false;
+    connection.response_name_queue.pop();
   }
 }
 
@@ -0,0 +1,47 @@
+# Copyright (c) 2021 Cisco and/or its affiliates.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at:
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+########################################
+#
+# Find the liburing libraries and includes
+# This module sets:
+#  LIBURING_FOUND: True if liburing was found
+#  LIBURING_LIBRARIES:  The liburing library
+#  LIBURING_INCLUDE_DIRS:  The liburing include dir
+#
+
+set(LIBURING_SEARCH_PATH_LIST
+  ${LIBURING_HOME}
+  $ENV{LIBURING_HOME}
+  /usr/local
+  /opt
+  /usr
+)
+
+find_path(LIBURING_INCLUDE_DIR liburing.h
+  HINTS ${LIBURING_SEARCH_PATH_LIST}
+  PATH_SUFFIXES include
+  DOC "Find the liburing includes"
+)
+
+find_library(LIBURING_LIBRARY NAMES uring
+  HINTS ${LIBURING_SEARCH_PATH_LIST}
+  PATH_SUFFIXES lib
+  DOC "Find the liburing libraries"
+)
+
+set(LIBURING_LIBRARIES ${LIBURING_LIBRARY})
+set(LIBURING_INCLUDE_DIRS ${LIBURING_INCLUDE_DIR})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Liburing DEFAULT_MSG LIBURING_LIBRARY LIBURING_INCLUDE_DIR)
@@ -87,7 +87,8 @@ static void _usage(int exitCode) {
 #ifndef _WIN32
   printf(
       "Usage: hicn-light-daemon [--port port] [--capacity objectStoreSize] "
-      "[--log facility=level] [--log-file filename] [--config file]\n");
+      "[--log facility=level] [--log-file filename] [--config file] "
+      "[--stats-segment name]\n");
 #else
   printf(
       "Usage: hicn-light-daemon.exe [--port port] [--daemon] [--capacity objectStoreSize] "
@@ -140,6 +141,13 @@ static void _usage(int exitCode) {
       "--log-file        = file to write log messages to (required in daemon "
       "mode)\n");
   printf("--config           = configuration filename\n");
+#ifndef _WIN32
+  printf(
+      "--stats-segment   = name of the shared memory statistics segment "
+      "(default %s),\n",
+      HICN_LIGHT_STATS_SEGMENT_NAME);
+  printf("                    'none' to disable it\n");
+#endif
   printf("\n");
   exit(exitCode);
 }
@@ -290,6 +298,7 @@ int main(int argc, const char *argv[]) {
   uint16_t configurationPort = 2001;
   int capacity = -1;
   const char *configFileName = NULL;
+  const char *statsSegmentName = HICN_LIGHT_STATS_SEGMENT_NAME;
 
   char *logfile = NULL;
 
@@ -318,6 +327,12 @@ int main(int argc, const char *argv[]) {
                  strcmp(argv[i], "-c") == 0) {
         capacity = atoi(argv[i + 1]);
         i++;
+#ifndef _WIN32
+      } else if (strcmp(argv[i], "--stats-segment") == 0) {
+        statsSegmentName =
+            strcmp(argv[i + 1], "none") == 0 ? NULL : argv[i + 1];
+        i++;
+#endif
       } else if (strcmp(argv[i], "--log") == 0) {
         _setLogLevel(logLevelArray, argv[i + 1]);
         i++;
@@ -368,7 +383,8 @@ int main(int argc, const char *argv[]) {
   }
 
   // this will update the clock to the tick clock
-  Forwarder *forwarder = forwarder_Create(logger);
+  Forwarder *forwarder =
+      forwarder_CreateWithStatsSegment(logger, statsSegmentName);
 
   if (forwarder == NULL) {
     logger_Log(logger, LoggerFacility_Core, PARCLogLevel_Error, "daemon",
@@ -1279,6 +1279,8 @@ struct iovec *configuration_ProcessPolicyList(Configuration *config,
   size_t payloadSize = fibEntryList_Length(fibList);
   struct sockaddr_in tmpAddr;
   struct sockaddr_in6 tmpAddr6;
+  // Policy statistics are only computed when they are read
+  Ticks now = forwarder_GetTicks(config->forwarder);
 
   // allocate payload, cast from void* to uint8_t* = bytes granularity
   uint8_t *payloadResponse =
@@ -1303,6 +1305,7 @@ struct iovec *configuration_ProcessPolicyList(Configuration *config,
       listPoliciesCommand->address.v6.as_in6addr = tmpAddr6.sin6_addr;
     }
     listPoliciesCommand->len = nameBitvector_GetLength(prefix);
+    fibEntry_UpdateStats(entry, now);
     listPoliciesCommand->policy = fibEntry_GetPolicy(entry);
 
     addressDestroy(&addressEntry);
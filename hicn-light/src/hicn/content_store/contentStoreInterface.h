@@ -19,9 +19,14 @@
 #include <stdio.h>
 
 #include <hicn/core/message.h>
+#include <hicn/stats/statsSegment.h>
 
 typedef struct contentstore_config {
   size_t objectCapacity;
+
+  // Counters to update, kept across content store instances. If NULL, the
+  // content store uses its own zero-initialized counters.
+  hicn_light_stats_cs_t *stats;
 } ContentStoreConfig;
 
 typedef struct contentstore_interface ContentStoreInterface;
@@ -35,15 +35,6 @@
 #include <parc/assert/parc_Assert.h>
 #include <hicn/processor/hashTableFunction.h>
 
-typedef struct contentstore_stats {
-  uint64_t countExpiryEvictions;
-  uint64_t countRCTEvictions;
-  uint64_t countLruEvictions;
-  uint64_t countAdds;
-  uint64_t countHits;
-  uint64_t countMisses;
-} _ContentStoreLRUStats;
-
 typedef struct contentstore_lru_data {
   size_t objectCapacity;
   size_t objectCount;
@@ -57,7 +48,8 @@ typedef struct contentstore_lru_data {
 
   PARCHashCodeTable *storageByName;
 
-  _ContentStoreLRUStats stats;
+  hicn_light_stats_cs_t *stats;
+  hicn_light_stats_cs_t localStats;
 } _ContentStoreLRU;
 
 static void _destroyIndexes(_ContentStoreLRU *store) {
@@ -112,7 +104,12 @@ static bool _contentStoreLRU_Init(_ContentStoreLRU *store,
   store->logger = logger_Acquire(logger);
 
   size_t initialSize = config->objectCapacity * 2;
-  memset(&store->stats, 0, sizeof(_ContentStoreLRUStats));
+  if (config->stats) {
+    store->stats = config->stats;
+  } else {
+    memset(&store->localStats, 0, sizeof(hicn_light_stats_cs_t));
+    store->stats = &store->localStats;
+  }
 
   store->objectCapacity = config->objectCapacity;
   store->objectCount = 0;
@@ -182,7 +179,7 @@ static bool _contentStoreLRU_RemoveLeastUsed(_ContentStoreLRU *store) {
           store->logger, LoggerFacility_Processor, PARCLogLevel_Debug, __func__,
           "ContentStore %p evict message %p by LRU (LRU evictions %" PRIu64 ")",
           (void *)store, (void *)contentStoreEntry_GetMessage(storeEntry),
-          store->stats.countLruEvictions);
+          store->stats->countLruEvictions);
     }
 
     _contentStoreLRU_PurgeStoreEntry(store, storeEntry);
@@ -204,7 +201,7 @@ static void _evictByStorePolicy(_ContentStoreLRU *store,
       (currentTimeInTicks > contentStoreEntry_GetExpiryTimeTicks(entry))) {
     // Found an expired entry. Remove it, and we're done.
 
-    store->stats.countExpiryEvictions++;
+    store->stats->countExpiryEvictions++;
     if (logger_IsLoggable(store->logger, LoggerFacility_Processor,
                           PARCLogLevel_Debug)) {
       logger_Log(store->logger, LoggerFacility_Processor, PARCLogLevel_Debug,
@@ -212,12 +209,12 @@ static void _evictByStorePolicy(_ContentStoreLRU *store,
                  "ContentStore %p evict message %p by ExpiryTime (ExpiryTime "
                  "evictions %" PRIu64 ")",
                  (void *)store, (void *)contentStoreEntry_GetMessage(entry),
-                 store->stats.countExpiryEvictions);
+                 store->stats->countExpiryEvictions);
     }
 
     _contentStoreLRU_PurgeStoreEntry(store, entry);
   } else {
-    store->stats.countLruEvictions++;
+    store->stats->countLruEvictions++;
     _contentStoreLRU_RemoveLeastUsed(store);
   }
 }
@@ -271,7 +268,7 @@ static bool _contentStoreLRU_PutContent(ContentStoreInterface *storeImpl,
       }
 
       store->objectCount++;
-      store->stats.countAdds++;
+      store->stats->countAdds++;
 
       if (logger_IsLoggable(store->logger, LoggerFacility_Processor,
                             PARCLogLevel_Debug)) {
@@ -335,7 +332,7 @@ static Message *_contentStoreLRU_MatchInterest(ContentStoreInterface *storeImpl,
     contentStoreEntry_MoveToHead(storeEntry);
     result = contentStoreEntry_GetMessage(storeEntry);
 
-    store->stats.countHits++;
+    store->stats->countHits++;
 
     if (logger_IsLoggable(store->logger, LoggerFacility_Processor,
                           PARCLogLevel_Debug)) {
@@ -343,11 +340,11 @@ static Message *_contentStoreLRU_MatchInterest(ContentStoreInterface *storeImpl,
                  __func__,
                  "ContentStoreLRU %p matched interest %p (hits %" PRIu64
                  ", misses %" PRIu64 ")",
-                 (void *)store, (void *)interest, store->stats.countHits,
-                 store->stats.countMisses);
+                 (void *)store, (void *)interest, store->stats->countHits,
+                 store->stats->countMisses);
     }
   } else {
-    store->stats.countMisses++;
+    store->stats->countMisses++;
 
     if (logger_IsLoggable(store->logger, LoggerFacility_Processor,
                           PARCLogLevel_Debug)) {
@@ -355,8 +352,8 @@ static Message *_contentStoreLRU_MatchInterest(ContentStoreInterface *storeImpl,
                  __func__,
                  "ContentStoreLRU %p missed interest %p (hits %" PRIu64
                  ", misses %" PRIu64 ")",
-                 (void *)store, (void *)interest, store->stats.countHits,
-                 store->stats.countMisses);
+                 (void *)store, (void *)interest, store->stats->countHits,
+                 store->stats->countMisses);
     }
   }
 
@@ -390,10 +387,11 @@ static void _contentStoreLRU_Log(ContentStoreInterface *storeImpl) {
              "stats = @%p {adds = %" PRIu64 ", hits = %" PRIu64
              ", misses = %" PRIu64 ", LRUEvictons = %" PRIu64
              ", ExpiryEvictions = %" PRIu64 ", RCTEvictions = %" PRIu64 "} }",
-             store, store->objectCount, store->objectCapacity, &store->stats,
-             store->stats.countAdds, store->stats.countHits,
-             store->stats.countMisses, store->stats.countLruEvictions,
-             store->stats.countExpiryEvictions, store->stats.countRCTEvictions);
+             store, store->objectCount, store->objectCapacity, store->stats,
+             store->stats->countAdds, store->stats->countHits,
+             store->stats->countMisses, store->stats->countLruEvictions,
+             store->stats->countExpiryEvictions,
+             store->stats->countRCTEvictions);
 }
 
 static size_t _contentStoreLRU_GetObjectCapacity(
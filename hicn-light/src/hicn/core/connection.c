@@ -259,9 +259,10 @@ void connection_DetectLosses(Connection *conn, Message *message) {
   if (conn->wldr != NULL) wldr_DetectLosses(conn->wldr, conn, message);
 }
 
-void connection_HandleWldrNotification(Connection *conn, Message *message) {
+void connection_HandleWldrNotification(Connection *conn, Message *message,
+                                       size_t length) {
   if (conn->wldr != NULL)
-    wldr_HandleWldrNotification(conn->wldr, conn, message);
+    wldr_HandleWldrNotification(conn->wldr, conn, message, length);
 }
 
 connection_state_t connection_GetState(const Connection *conn)
@@ -168,7 +168,8 @@ bool connection_WldrAutoStartAllowed(const Connection *conn);
 
 void connection_DetectLosses(Connection *conn, Message *message);
 
-void connection_HandleWldrNotification(Connection *conn, Message *message);
+void connection_HandleWldrNotification(Connection *conn, Message *message,
+                                       size_t length);
 
 connection_state_t connection_GetState(const Connection *conn);
 
@@ -56,6 +56,9 @@ struct connection_table {
   // The only reason to keep this tree is so we have an iterable list
   // of connections, which the hash table does not give us.
   PARCTreeRedBlack *listById;
+
+  // Not owned, may be NULL
+  StatsSegmentWriter *statsSegment;
 };
 
 static bool connectionTable_ConnectionIdEquals(const void *keyA,
@@ -149,6 +152,29 @@ void connectionTable_Destroy(ConnectionTable **conntablePtr) {
   *conntablePtr = NULL;
 }
 
+void connectionTable_SetStatsSegment(ConnectionTable *table,
+                                     StatsSegmentWriter *statsSegment) {
+  parcAssertNotNull(table, "Parameter table must be non-null");
+  table->statsSegment = statsSegment;
+}
+
+static void connectionTable_AddFaceStats(ConnectionTable *table,
+                                         const Connection *connection) {
+  const AddressPair *pair = connection_GetAddressPair(connection);
+  char *local = addressToString(addressPair_GetLocal(pair));
+  char *remote = addressToString(addressPair_GetRemote(pair));
+
+  char name[HICN_LIGHT_STATS_FACE_NAME_SIZE];
+  snprintf(name, sizeof(name), "%s %s", local, remote);
+
+  parcMemory_Deallocate((void **)&local);
+  parcMemory_Deallocate((void **)&remote);
+
+  statsSegmentWriter_AddFace(table->statsSegment,
+                             connection_GetConnectionId(connection),
+                             connection_IsLocal(connection), name);
+}
+
 /**
  * @function connectionTable_Add
  * @abstract Add a connection, takes ownership of memory
@@ -168,6 +194,9 @@ void connectionTable_Add(ConnectionTable *table, Connection *connection) {
                           (void *)connection_GetAddressPair(connection),
                           connection);
     parcTreeRedBlack_Insert(table->listById, connectionIdKey, connection);
+    if (table->statsSegment) {
+      connectionTable_AddFaceStats(table, connection);
+    }
   } else {
     parcTrapUnexpectedState(
         "Could not add connection id %u -- is it a duplicate?",
@@ -186,6 +215,10 @@ void connectionTable_Remove(ConnectionTable *table,
 
   unsigned connid = connection_GetConnectionId(connection);
 
+  if (table->statsSegment) {
+    statsSegmentWriter_RemoveFace(table->statsSegment, connid);
+  }
+
   parcTreeRedBlack_Remove(table->listById, &connid);
   parcHashCodeTable_Del(table->indexByAddressPair,
                         connection_GetAddressPair(connection));
@@ -23,6 +23,7 @@
 #include <hicn/core/connectionList.h>
 #include <hicn/io/addressPair.h>
 #include <hicn/io/ioOperations.h>
+#include <hicn/stats/statsSegmentWriter.h>
 
 struct connection_table;
 typedef struct connection_table ConnectionTable;
@@ -41,6 +42,14 @@ ConnectionTable *connectionTable_Create(void);
  */
 void connectionTable_Destroy(ConnectionTable **conntablePtr);
 
+/**
+ * @function connectionTable_SetStatsSegment
+ * @abstract Publish the connections added from now on in the face directory
+ * of the statistics segment
+ */
+void connectionTable_SetStatsSegment(ConnectionTable *table,
+                                     StatsSegmentWriter *statsSegment);
+
 /**
  * @function connectionTable_Add
  * @abstract Add a connection, takes ownership of memory
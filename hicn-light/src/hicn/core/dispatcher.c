@@ -46,15 +46,98 @@
 
 #include <pthread.h>
 
+#ifdef WITH_IO_URING
+#include <liburing.h>
+#include <sys/eventfd.h>
+#endif /* WITH_IO_URING */
+
 #ifndef INPORT_ANY
 #define INPORT_ANY 0
 #endif
 
+#ifdef WITH_IO_URING
+#define RING_ENTRIES 1024
+// slots of the registered file table, one per receiver
+#define RING_FILES 64
+// provided buffers of a receiver, a power of 2
+#define RING_BUFFERS 256
+// room for the recvmsg header and the peer address in front of the packet
+#define RING_BUFFER_SIZE 2048
+// reads kept in flight on a descriptor that is not a socket
+#define RING_READS 32
+#define RING_SENDS 512
+// completions processed between two checks of the completion queue
+#define RING_BATCH 64
+
+// the user data of a submission is the receiver or the send it belongs to,
+// sends are tagged in the lowest bit, 0 is for the ones without completion
+// handling (cancellations)
+#define RING_TAG_SEND 0x1
+// buffer group of the multishot probe, never given to a receiver
+#define RING_PROBE_GROUP UINT16_MAX
+
+typedef struct dispatcher_send {
+  struct dispatcher_send *next;
+  struct msghdr msg;
+  struct iovec iov;
+  struct sockaddr_storage peer;
+  uint8_t packet[RING_BUFFER_SIZE];
+} DispatcherSend;
+
+struct dispatcher_receiver {
+  DispatcherReceiver *next;
+  int fd;
+  int slot;
+  bool isDatagram;
+  DispatcherReceiveCallback *callback;
+  void *userData;
+
+  // receptions in flight, the receiver is freed when the last one ends after
+  // it has been destroyed
+  unsigned armed;
+  bool closing;
+
+  // network event reading the descriptor once the io_uring cannot
+  PARCEvent *event;
+
+  // template of the multishot recvmsg, only the address length is used
+  struct msghdr msg;
+
+  struct io_uring_buf_ring *bufferRing;
+  uint16_t bufferGroup;
+  uint8_t *buffers;
+};
+#endif /* WITH_IO_URING */
+
 struct dispatcher {
   PARCEventScheduler *Base;
   Logger *logger;
+
+#ifdef WITH_IO_URING
+  bool ringEnabled;
+  // multishot recvmsg needs Linux 6.0, the datagram receivers use network
+  // events on older kernels
+  bool ringMultishot;
+  struct io_uring ring;
+  int ringEventFd;
+  PARCEvent *ringEvent;
+  // sends are submitted at the end of the completion processing
+  bool draining;
+
+  int files[RING_FILES];
+  uint16_t nextBufferGroup;
+  DispatcherReceiver *receivers;
+
+  DispatcherSend *sends;
+  DispatcherSend *freeSends;
+#endif /* WITH_IO_URING */
 };
 
+#ifdef WITH_IO_URING
+static void _dispatcher_RingCreate(Dispatcher *dispatcher);
+static void _dispatcher_RingDestroy(Dispatcher *dispatcher);
+#endif /* WITH_IO_URING */
+
 // ==========================================
 // Public API
 
@@ -74,6 +157,10 @@ Dispatcher *dispatcher_Create(Logger *logger) {
   parcAssertNotNull(dispatcher->Base,
                     "Got NULL from parcEventScheduler_Create()");
 
+#ifdef WITH_IO_URING
+  _dispatcher_RingCreate(dispatcher);
+#endif /* WITH_IO_URING */
+
   return dispatcher;
 }
 
@@ -83,6 +170,10 @@ void dispatcher_Destroy(Dispatcher **dispatcherPtr) {
                     "Parameter must dereference to non-null pointer");
   Dispatcher *dispatcher = *dispatcherPtr;
 
+#ifdef WITH_IO_URING
+  _dispatcher_RingDestroy(dispatcher);
+#endif /* WITH_IO_URING */
+
   logger_Release(&dispatcher->logger);
   parcEventScheduler_Destroy(&(dispatcher->Base));
   parcMemory_Deallocate((void **)&dispatcher);
@@ -472,3 +563,552 @@ PARCEventQueue *dispatcher_StreamBufferConnect(Dispatcher *dispatcher,
   }
   return result;
 }
+
+#ifdef WITH_IO_URING
+// =============
+// io_uring receivers and sends
+
+static void _dispatcher_RingCallback(int fd, PARCEventType what,
+                                     void *dispatcherVoid);
+
+// arms a multishot recvmsg on a socket that never receives anything and
+// cancels it: kernels without multishot support fail it right away
+static bool _dispatcher_RingProbeMultishot(struct io_uring *ring) {
+  int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return false;
+  }
+
+  int failure;
+  struct io_uring_buf_ring *bufferRing =
+      io_uring_setup_buf_ring(ring, 1, RING_PROBE_GROUP, 0, &failure);
+  if (bufferRing == NULL) {
+    close(fd);
+    return false;
+  }
+  uint8_t buffer[64];
+  io_uring_buf_ring_add(bufferRing, buffer, sizeof(buffer), 0,
+                        io_uring_buf_ring_mask(1), 0);
+  io_uring_buf_ring_advance(bufferRing, 1);
+
+  struct msghdr msg = {0};
+  struct io_uring_sqe *sqe = io_uring_get_sqe(ring);
+  io_uring_prep_recvmsg_multishot(sqe, fd, &msg, 0);
+  sqe->flags |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group = RING_PROBE_GROUP;
+  io_uring_sqe_set_data64(sqe, 1);
+
+  sqe = io_uring_get_sqe(ring);
+  io_uring_prep_cancel64(sqe, 1, 0);
+  io_uring_sqe_set_data64(sqe, 2);
+
+  bool supported = false;
+  int pending = io_uring_submit(ring) == 2 ? 2 : 0;
+  while (pending > 0) {
+    struct io_uring_cqe *cqe;
+    if (io_uring_wait_cqe(ring, &cqe) < 0) {
+      break;
+    }
+    if (io_uring_cqe_get_data64(cqe) == 1) {
+      supported = cqe->res == -ECANCELED;
+    }
+    if (!(cqe->flags & IORING_CQE_F_MORE)) {
+      pending--;
+    }
+    io_uring_cqe_seen(ring, cqe);
+  }
+
+  io_uring_free_buf_ring(ring, bufferRing, 1, RING_PROBE_GROUP);
+  close(fd);
+  return supported;
+}
+
+static void _dispatcher_RingCreate(Dispatcher *dispatcher) {
+  for (int i = 0; i < RING_FILES; i++) {
+    dispatcher->files[i] = -1;
+  }
+
+  int failure = io_uring_queue_init(RING_ENTRIES, &dispatcher->ring, 0);
+  if (failure == 0) {
+    // sparse file tables and provided buffer rings need Linux 5.19
+    failure = io_uring_register_files_sparse(&dispatcher->ring, RING_FILES);
+    if (failure < 0) {
+      io_uring_queue_exit(&dispatcher->ring);
+    }
+  }
+  if (failure < 0) {
+    if (logger_IsLoggable(dispatcher->logger, LoggerFacility_Core,
+                          PARCLogLevel_Warning)) {
+      logger_Log(dispatcher->logger, LoggerFacility_Core,
+                 PARCLogLevel_Warning, __func__,
+                 "io_uring not available (%s), using network events",
+                 strerror(-failure));
+    }
+    return;
+  }
+
+  // before the eventfd is registered, the probe completions are reaped here
+  dispatcher->ringMultishot = _dispatcher_RingProbeMultishot(&dispatcher->ring);
+  if (!dispatcher->ringMultishot &&
+      logger_IsLoggable(dispatcher->logger, LoggerFacility_Core,
+                        PARCLogLevel_Warning)) {
+    logger_Log(dispatcher->logger, LoggerFacility_Core, PARCLogLevel_Warning,
+               __func__,
+               "io_uring multishot receive not available, using network "
+               "events for sockets");
+  }
+
+  dispatcher->ringEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  parcAssertTrue(dispatcher->ringEventFd >= 0, "eventfd failed: (%d) %s",
+                 errno, strerror(errno));
+  failure = io_uring_register_eventfd(&dispatcher->ring,
+                                      dispatcher->ringEventFd);
+  parcAssertFalse(failure < 0, "io_uring_register_eventfd failed: %s",
+                  strerror(-failure));
+
+  dispatcher->sends = parcMemory_Allocate(RING_SENDS * sizeof(DispatcherSend));
+  parcAssertNotNull(dispatcher->sends, "parcMemory_Allocate(%zu) returned NULL",
+                    RING_SENDS * sizeof(DispatcherSend));
+  for (int i = 0; i < RING_SENDS; i++) {
+    dispatcher->sends[i].next =
+        i + 1 < RING_SENDS ? &dispatcher->sends[i + 1] : NULL;
+  }
+  dispatcher->freeSends = dispatcher->sends;
+
+  dispatcher->ringEvent =
+      dispatcher_CreateNetworkEvent(dispatcher, true, _dispatcher_RingCallback,
+                                    dispatcher, dispatcher->ringEventFd);
+  dispatcher_StartNetworkEvent(dispatcher, dispatcher->ringEvent);
+
+  dispatcher->ringEnabled = true;
+}
+
+static void _dispatcher_FreeReceiver(Dispatcher *dispatcher,
+                                     DispatcherReceiver *receiver) {
+  DispatcherReceiver **prev = &dispatcher->receivers;
+  while (*prev != receiver) {
+    prev = &(*prev)->next;
+  }
+  *prev = receiver->next;
+
+  if (receiver->event) {
+    dispatcher_DestroyNetworkEvent(dispatcher, &receiver->event);
+  }
+  io_uring_free_buf_ring(&dispatcher->ring, receiver->bufferRing, RING_BUFFERS,
+                         receiver->bufferGroup);
+  parcMemory_Deallocate((void **)&receiver->buffers);
+  parcMemory_Deallocate((void **)&receiver);
+}
+
+static void _dispatcher_RingDestroy(Dispatcher *dispatcher) {
+  if (!dispatcher->ringEnabled) {
+    return;
+  }
+
+  dispatcher_DestroyNetworkEvent(dispatcher, &dispatcher->ringEvent);
+
+  // receivers destroyed while a reception was in flight
+  while (dispatcher->receivers) {
+    _dispatcher_FreeReceiver(dispatcher, dispatcher->receivers);
+  }
+
+  io_uring_queue_exit(&dispatcher->ring);
+  close(dispatcher->ringEventFd);
+  parcMemory_Deallocate((void **)&dispatcher->sends);
+  dispatcher->ringEnabled = false;
+}
+
+static int _dispatcher_FileSlot(const Dispatcher *dispatcher, int fd) {
+  for (int i = 0; i < RING_FILES; i++) {
+    if (dispatcher->files[i] == fd) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static bool _dispatcher_BufferGroupInUse(const Dispatcher *dispatcher,
+                                         uint16_t group) {
+  for (DispatcherReceiver *receiver = dispatcher->receivers; receiver;
+       receiver = receiver->next) {
+    if (receiver->bufferGroup == group) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static struct io_uring_sqe *_dispatcher_GetSqe(Dispatcher *dispatcher) {
+  struct io_uring_sqe *sqe = io_uring_get_sqe(&dispatcher->ring);
+  if (sqe == NULL) {
+    // the submission queue is full, hand it to the kernel
+    io_uring_submit(&dispatcher->ring);
+    sqe = io_uring_get_sqe(&dispatcher->ring);
+  }
+  parcAssertNotNull(sqe, "io_uring submission queue is full");
+  return sqe;
+}
+
+static void _dispatcher_Submit(Dispatcher *dispatcher) {
+  // while draining, everything is submitted at the end of the callback
+  if (!dispatcher->draining) {
+    io_uring_submit(&dispatcher->ring);
+  }
+}
+
+static void _dispatcher_ArmReceiver(Dispatcher *dispatcher,
+                                    DispatcherReceiver *receiver) {
+  struct io_uring_sqe *sqe = _dispatcher_GetSqe(dispatcher);
+
+  if (receiver->isDatagram) {
+    io_uring_prep_recvmsg_multishot(sqe, receiver->slot, &receiver->msg, 0);
+  } else {
+    io_uring_prep_read(sqe, receiver->slot, NULL, RING_BUFFER_SIZE, 0);
+  }
+  sqe->flags |= IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+  sqe->buf_group = receiver->bufferGroup;
+  io_uring_sqe_set_data(sqe, receiver);
+
+  receiver->armed++;
+}
+
+DispatcherReceiver *dispatcher_CreateReceiver(
+    Dispatcher *dispatcher, int fd, bool isDatagram,
+    DispatcherReceiveCallback *callback, void *userData) {
+  parcAssertNotNull(dispatcher, "Parameter dispatcher must be non-null");
+  parcAssertNotNull(callback, "Parameter callback must be non-null");
+
+  if (!dispatcher->ringEnabled || (isDatagram && !dispatcher->ringMultishot)) {
+    return NULL;
+  }
+
+  int slot = _dispatcher_FileSlot(dispatcher, -1);
+  if (slot < 0) {
+    return NULL;
+  }
+
+  DispatcherReceiver *receiver =
+      parcMemory_AllocateAndClear(sizeof(DispatcherReceiver));
+  parcAssertNotNull(receiver, "parcMemory_AllocateAndClear(%zu) returned NULL",
+                    sizeof(DispatcherReceiver));
+  receiver->buffers = parcMemory_Allocate(RING_BUFFERS * RING_BUFFER_SIZE);
+  parcAssertNotNull(receiver->buffers, "parcMemory_Allocate(%d) returned NULL",
+                    RING_BUFFERS * RING_BUFFER_SIZE);
+
+  do {
+    receiver->bufferGroup = dispatcher->nextBufferGroup++;
+  } while (_dispatcher_BufferGroupInUse(dispatcher, receiver->bufferGroup));
+
+  int failure;
+  receiver->bufferRing =
+      io_uring_setup_buf_ring(&dispatcher->ring, RING_BUFFERS,
+                              receiver->bufferGroup, 0, &failure);
+  if (receiver->bufferRing != NULL) {
+    failure = io_uring_register_files_update(&dispatcher->ring, slot, &fd, 1);
+    if (failure < 0) {
+      io_uring_free_buf_ring(&dispatcher->ring, receiver->bufferRing,
+                             RING_BUFFERS, receiver->bufferGroup);
+    }
+  }
+  if (failure < 0) {
+    if (logger_IsLoggable(dispatcher->logger, LoggerFacility_Core,
+                          PARCLogLevel_Warning)) {
+      logger_Log(dispatcher->logger, LoggerFacility_Core,
+                 PARCLogLevel_Warning, __func__,
+                 "io_uring receiver for fd %d failed (%s)", fd,
+                 strerror(-failure));
+    }
+    parcMemory_Deallocate((void **)&receiver->buffers);
+    parcMemory_Deallocate((void **)&receiver);
+    return NULL;
+  }
+  dispatcher->files[slot] = fd;
+
+  receiver->fd = fd;
+  receiver->slot = slot;
+  receiver->isDatagram = isDatagram;
+  receiver->callback = callback;
+  receiver->userData = userData;
+  receiver->msg.msg_namelen = sizeof(struct sockaddr_storage);
+
+  for (int i = 0; i < RING_BUFFERS; i++) {
+    io_uring_buf_ring_add(receiver->bufferRing,
+                          receiver->buffers + i * RING_BUFFER_SIZE,
+                          RING_BUFFER_SIZE, i,
+                          io_uring_buf_ring_mask(RING_BUFFERS), i);
+  }
+  io_uring_buf_ring_advance(receiver->bufferRing, RING_BUFFERS);
+
+  receiver->next = dispatcher->receivers;
+  dispatcher->receivers = receiver;
+
+  // a multishot reception on sockets, several reads otherwise, so that a
+  // wakeup collects more than one packet
+  unsigned depth = isDatagram ? 1 : RING_READS;
+  for (unsigned i = 0; i < depth; i++) {
+    _dispatcher_ArmReceiver(dispatcher, receiver);
+  }
+  _dispatcher_Submit(dispatcher);
+
+  return receiver;
+}
+
+void dispatcher_DestroyReceiver(Dispatcher *dispatcher,
+                                DispatcherReceiver **receiverPtr) {
+  parcAssertNotNull(dispatcher, "Parameter dispatcher must be non-null");
+  parcAssertNotNull(receiverPtr,
+                    "Parameter receiverPtr must be non-null double pointer");
+  parcAssertNotNull(
+      *receiverPtr,
+      "Parameter receiverPtr must dereference to non-null pointer");
+  DispatcherReceiver *receiver = *receiverPtr;
+
+  // the receptions in flight hold their own reference to the file, so the
+  // caller may close it right away
+  int none = -1;
+  io_uring_register_files_update(&dispatcher->ring, receiver->slot, &none, 1);
+  dispatcher->files[receiver->slot] = -1;
+
+  receiver->closing = true;
+  if (receiver->event) {
+    dispatcher_DestroyNetworkEvent(dispatcher, &receiver->event);
+  }
+  if (receiver->armed == 0) {
+    _dispatcher_FreeReceiver(dispatcher, receiver);
+  } else {
+    // freed at the completion of the last reception
+    struct io_uring_sqe *sqe = _dispatcher_GetSqe(dispatcher);
+    io_uring_prep_cancel(sqe, receiver, IORING_ASYNC_CANCEL_ALL);
+    io_uring_sqe_set_data(sqe, NULL);
+    _dispatcher_Submit(dispatcher);
+  }
+
+  *receiverPtr = NULL;
+}
+
+static void _dispatcher_Deliver(DispatcherReceiver *receiver, uint8_t *buffer,
+                                int size) {
+  uint8_t *payload = buffer;
+  size_t length = size;
+  const struct sockaddr *peer = NULL;
+  socklen_t peerLength = 0;
+
+  if (receiver->isDatagram) {
+    struct io_uring_recvmsg_out *out =
+        io_uring_recvmsg_validate(buffer, size, &receiver->msg);
+    if (out == NULL || (out->flags & MSG_TRUNC)) {
+      return;
+    }
+    payload = io_uring_recvmsg_payload(out, &receiver->msg);
+    length = io_uring_recvmsg_payload_length(out, size, &receiver->msg);
+    peer = io_uring_recvmsg_name(out);
+    peerLength = out->namelen < receiver->msg.msg_namelen
+                     ? out->namelen
+                     : receiver->msg.msg_namelen;
+  }
+
+  if (length > DISPATCHER_PACKET_SIZE) {
+    return;
+  }
+
+  // the ring buffer goes back to the kernel, the message owns a copy
+  uint8_t *packet = parcMemory_AllocateAndClear(DISPATCHER_PACKET_SIZE);
+  parcAssertNotNull(packet, "parcMemory_AllocateAndClear(%d) returned NULL",
+                    DISPATCHER_PACKET_SIZE);
+  memcpy(packet, payload, length);
+
+  receiver->callback(receiver->fd, packet, length, peer, peerLength,
+                     receiver->userData);
+}
+
+static void _dispatcher_ReceiverReadable(int fd, PARCEventType what,
+                                         void *receiverVoid) {
+  DispatcherReceiver *receiver = (DispatcherReceiver *)receiverVoid;
+  struct sockaddr_storage peer;
+  socklen_t peerLength = sizeof(peer);
+  ssize_t length;
+
+  uint8_t *packet = parcMemory_AllocateAndClear(DISPATCHER_PACKET_SIZE);
+  parcAssertNotNull(packet, "parcMemory_AllocateAndClear(%d) returned NULL",
+                    DISPATCHER_PACKET_SIZE);
+
+  if (receiver->isDatagram) {
+    // the real length is returned for truncated datagrams, which are dropped
+    length = recvfrom(fd, packet, DISPATCHER_PACKET_SIZE, MSG_TRUNC,
+                      (struct sockaddr *)&peer, &peerLength);
+  } else {
+    length = read(fd, packet, DISPATCHER_PACKET_SIZE);
+  }
+  if (length <= 0 || length > DISPATCHER_PACKET_SIZE) {
+    parcMemory_Deallocate((void **)&packet);
+    return;
+  }
+
+  receiver->callback(fd, packet, length,
+                     receiver->isDatagram ? (struct sockaddr *)&peer : NULL,
+                     receiver->isDatagram ? peerLength : 0,
+                     receiver->userData);
+}
+
+// the io_uring cannot receive on the descriptor: go on with a network event,
+// as the listeners do without io_uring
+static void _dispatcher_ReceiverFallback(Dispatcher *dispatcher,
+                                         DispatcherReceiver *receiver,
+                                         int error) {
+  if (receiver->event) {
+    return;
+  }
+
+  if (logger_IsLoggable(dispatcher->logger, LoggerFacility_IO,
+                        PARCLogLevel_Warning)) {
+    logger_Log(dispatcher->logger, LoggerFacility_IO, PARCLogLevel_Warning,
+               __func__,
+               "io_uring reception on fd %d failed (%s), using a network "
+               "event",
+               receiver->fd, strerror(error));
+  }
+
+  receiver->event =
+      dispatcher_CreateNetworkEvent(dispatcher, true,
+                                    _dispatcher_ReceiverReadable, receiver,
+                                    receiver->fd);
+  dispatcher_StartNetworkEvent(dispatcher, receiver->event);
+}
+
+static void _dispatcher_ReceiveCompleted(Dispatcher *dispatcher,
+                                         DispatcherReceiver *receiver,
+                                         const struct io_uring_cqe *cqe) {
+  if (cqe->flags & IORING_CQE_F_BUFFER) {
+    unsigned id = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+    uint8_t *buffer = receiver->buffers + id * RING_BUFFER_SIZE;
+
+    // the callback may destroy the receiver, which stays allocated until
+    // the end of this reception
+    if (!receiver->closing && cqe->res > 0) {
+      _dispatcher_Deliver(receiver, buffer, cqe->res);
+    }
+
+    io_uring_buf_ring_add(receiver->bufferRing, buffer, RING_BUFFER_SIZE, id,
+                          io_uring_buf_ring_mask(RING_BUFFERS), 0);
+    io_uring_buf_ring_advance(receiver->bufferRing, 1);
+  }
+
+  if (cqe->flags & IORING_CQE_F_MORE) {
+    return;
+  }
+
+  receiver->armed--;
+  if (receiver->closing) {
+    if (receiver->armed == 0) {
+      _dispatcher_FreeReceiver(dispatcher, receiver);
+    }
+    return;
+  }
+
+  // the receptions still in flight after a fallback are not armed again
+  if (receiver->event) {
+    return;
+  }
+
+  // EAGAIN comes from a device that the io_uring cannot wait for: a non
+  // blocking file without nowait support. Armed again, it would spin
+  if (cqe->res == -EAGAIN || cqe->res == -EINVAL || cqe->res == -EOPNOTSUPP ||
+      cqe->res == -EBADF) {
+    _dispatcher_ReceiverFallback(dispatcher, receiver, -cqe->res);
+    return;
+  }
+
+  // out of buffers and transient errors just end a multishot reception
+
+  _dispatcher_ArmReceiver(dispatcher, receiver);
+}
+
+static void _dispatcher_SendCompleted(Dispatcher *dispatcher,
+                                      DispatcherSend *send, int res) {
+  if (res < 0 && logger_IsLoggable(dispatcher->logger, LoggerFacility_IO,
+                                   PARCLogLevel_Debug)) {
+    logger_Log(dispatcher->logger, LoggerFacility_IO, PARCLogLevel_Debug,
+               __func__, "io_uring send of %zu bytes failed: (%d) %s",
+               send->iov.iov_len, -res, strerror(-res));
+  }
+
+  send->next = dispatcher->freeSends;
+  dispatcher->freeSends = send;
+}
+
+static void _dispatcher_RingCallback(int fd, PARCEventType what,
+                                     void *dispatcherVoid) {
+  Dispatcher *dispatcher = (Dispatcher *)dispatcherVoid;
+  struct io_uring_cqe *cqes[RING_BATCH];
+  eventfd_t count;
+  unsigned n;
+
+  // the eventfd only wakes up the loop, the completion queue is drained
+  eventfd_read(fd, &count);
+
+  dispatcher->draining = true;
+  do {
+    n = io_uring_peek_batch_cqe(&dispatcher->ring, cqes, RING_BATCH);
+    for (unsigned i = 0; i < n; i++) {
+      uintptr_t data = (uintptr_t)io_uring_cqe_get_data(cqes[i]);
+      if (data & RING_TAG_SEND) {
+        _dispatcher_SendCompleted(
+            dispatcher, (DispatcherSend *)(data & ~(uintptr_t)RING_TAG_SEND),
+            cqes[i]->res);
+      } else if (data) {
+        _dispatcher_ReceiveCompleted(dispatcher, (DispatcherReceiver *)data,
+                                     cqes[i]);
+      }
+    }
+    io_uring_cq_advance(&dispatcher->ring, n);
+  } while (n == RING_BATCH);
+  dispatcher->draining = false;
+
+  // the receptions armed again and the packets forwarded meanwhile
+  if (io_uring_sq_ready(&dispatcher->ring) > 0) {
+    io_uring_submit(&dispatcher->ring);
+  }
+}
+
+bool dispatcher_Send(Dispatcher *dispatcher, int fd, const uint8_t *packet,
+                     size_t length, const struct sockaddr *peer,
+                     socklen_t peerLength) {
+  parcAssertNotNull(dispatcher, "Parameter dispatcher must be non-null");
+  parcAssertNotNull(packet, "Parameter packet must be non-null");
+
+  if (!dispatcher->ringEnabled || dispatcher->freeSends == NULL ||
+      length > RING_BUFFER_SIZE ||
+      peerLength > sizeof(struct sockaddr_storage)) {
+    return false;
+  }
+
+  DispatcherSend *send = dispatcher->freeSends;
+  dispatcher->freeSends = send->next;
+
+  memcpy(send->packet, packet, length);
+  send->iov.iov_base = send->packet;
+  send->iov.iov_len = length;
+
+  int slot = _dispatcher_FileSlot(dispatcher, fd);
+  struct io_uring_sqe *sqe = _dispatcher_GetSqe(dispatcher);
+  if (peer != NULL) {
+    memcpy(&send->peer, peer, peerLength);
+    memset(&send->msg, 0, sizeof(struct msghdr));
+    send->msg.msg_name = &send->peer;
+    send->msg.msg_namelen = peerLength;
+    send->msg.msg_iov = &send->iov;
+    send->msg.msg_iovlen = 1;
+    io_uring_prep_sendmsg(sqe, slot >= 0 ? slot : fd, &send->msg, 0);
+  } else {
+    io_uring_prep_write(sqe, slot >= 0 ? slot : fd, send->packet,
+                        (unsigned)length, 0);
+  }
+  if (slot >= 0) {
+    sqe->flags |= IOSQE_FIXED_FILE;
+  }
+  io_uring_sqe_set_data(sqe, (void *)((uintptr_t)send | RING_TAG_SEND));
+
+  _dispatcher_Submit(dispatcher);
+  return true;
+}
+#endif /* WITH_IO_URING */
@@ -32,6 +32,7 @@
 #include <sys/socket.h>
 #endif
 #include <stdbool.h>
+#include <stdint.h>
 
 struct dispatcher;
 typedef struct dispatcher Dispatcher;
@@ -250,6 +251,80 @@ void dispatcher_StartSignalEvent(Dispatcher *dispatcher,
                                  PARCEventSignal *event);
 void dispatcher_StopSignalEvent(Dispatcher *dispatcher, PARCEventSignal *event);
 
+#ifdef WITH_IO_URING
+// =============
+// io_uring receivers and sends
+//
+// Packet I/O of the datagram listeners may go through an io_uring instead of
+// a readiness event per packet followed by a read. Receives are multishot
+// (or kept in flight) on registered file descriptors, into a ring of
+// buffers provided to the kernel, and sends are queued and submitted in a
+// batch once all the completions of a wakeup have been processed. The ring
+// is polled through an eventfd by the event loop, so timers, signals and
+// the other network events are unchanged.
+//
+// When the ring cannot be used (old kernel, io_uring disabled) the
+// functions below fail and the callers go on with network events and
+// synchronous sends.
+
+// largest packet handed to a receive callback
+#define DISPATCHER_PACKET_SIZE 1500
+
+struct dispatcher_receiver;
+typedef struct dispatcher_receiver DispatcherReceiver;
+
+/**
+ * Called for each packet received on the file descriptor.
+ *
+ * @param packet is allocated with parcMemory, of DISPATCHER_PACKET_SIZE
+ * bytes, and owned by the callback
+ * @param peer is the source address, NULL if the descriptor is not a socket
+ */
+typedef void(DispatcherReceiveCallback)(int fd, uint8_t *packet,
+                                        size_t length,
+                                        const struct sockaddr *peer,
+                                        socklen_t peerLength, void *userData);
+
+/**
+ * @function dispatcher_CreateReceiver
+ * @abstract Receives the packets of a file descriptor through the io_uring
+ * @discussion
+ *   The receiver starts immediately. The callback is never called after
+ *   <code>dispatcher_DestroyReceiver()</code>. If the io_uring cannot receive
+ *   on the descriptor, the receiver goes on with a network event.
+ *
+ * @param isDatagram is true for sockets (the peer address is reported) and
+ * false for devices, like the hICN TUN, that are read. The descriptor is
+ * left non blocking: when no packet is ready the io_uring polls it, where a
+ * blocking read would hold a kernel worker thread per read in flight.
+ * @return NULL if the io_uring is not available, or if the kernel cannot
+ * do multishot receptions on sockets (before Linux 6.0)
+ */
+DispatcherReceiver *dispatcher_CreateReceiver(
+    Dispatcher *dispatcher, int fd, bool isDatagram,
+    DispatcherReceiveCallback *callback, void *userData);
+
+void dispatcher_DestroyReceiver(Dispatcher *dispatcher,
+                                DispatcherReceiver **receiverPtr);
+
+/**
+ * @function dispatcher_Send
+ * @abstract Queues a packet to be sent through the io_uring
+ * @discussion
+ *   The packet is copied, so the caller may modify it as soon as the
+ *   function returns. Sends queued while processing received packets are
+ *   submitted together, other sends are submitted immediately. Send errors
+ *   are only logged.
+ *
+ * @param peer is the destination address, NULL to write to a descriptor
+ * that is not a socket
+ * @return false if the packet has not been queued, the caller should send it
+ */
+bool dispatcher_Send(Dispatcher *dispatcher, int fd, const uint8_t *packet,
+                     size_t length, const struct sockaddr *peer,
+                     socklen_t peerLength);
+#endif /* WITH_IO_URING */
+
 // =============
 // stream buffers
 
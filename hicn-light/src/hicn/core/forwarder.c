@@ -58,6 +58,7 @@
 #include <hicn/config/configurationFile.h>
 #include <hicn/config/configurationListeners.h>
 #include <hicn/processor/messageProcessor.h>
+#include <hicn/strategies/probeService.h>
 
 #include <hicn/core/wldr.h>
 
@@ -99,6 +100,11 @@ struct forwarder {
   // we'll eventually want to setup a threadpool of these
   MessageProcessor *processor;
 
+  // path measurements shared by the strategy instances
+  ProbeService *probeService;
+
+  StatsSegmentWriter *statsSegment;
+
   Logger *logger;
 
   PARCClock *clock;
@@ -118,7 +124,8 @@ struct forwarder {
 // signal traps through the event scheduler
 static void _signal_cb(int, PARCEventType, void *);
 
-// A no-op keepalive to prevent Libevent from exiting the dispatch loop
+// A keepalive to prevent Libevent from exiting the dispatch loop, also used
+// to refresh the statistics segment
 static void _keepalive_cb(int, PARCEventType, void *);
 
 /**
@@ -158,6 +165,11 @@ Logger *forwarder_GetLogger(const Forwarder *forwarder) {
 // Setup and destroy section
 
 Forwarder *forwarder_Create(Logger *logger) {
+  return forwarder_CreateWithStatsSegment(logger, NULL);
+}
+
+Forwarder *forwarder_CreateWithStatsSegment(Logger *logger,
+                                            const char *statsSegmentName) {
   Forwarder *forwarder = parcMemory_AllocateAndClear(sizeof(Forwarder));
   parcAssertNotNull(forwarder, "parcMemory_AllocateAndClear(%zu) returned NULL",
                     sizeof(Forwarder));
@@ -176,13 +188,26 @@ Forwarder *forwarder_Create(Logger *logger) {
     parcLogReporter_Release(&reporter);
   }
 
+  forwarder->statsSegment = statsSegmentWriter_Create(statsSegmentName);
+#ifdef WITH_STATS_SEGMENT
+  if (statsSegmentName &&
+      !statsSegmentWriter_IsShared(forwarder->statsSegment)) {
+    logger_Log(forwarder->logger, LoggerFacility_Core, PARCLogLevel_Warning,
+               __func__, "Could not create statistics segment %s",
+               statsSegmentName);
+  }
+#endif /* WITH_STATS_SEGMENT */
+
   forwarder->nextConnectionid = 1;
   forwarder->dispatcher = dispatcher_Create(forwarder->logger);
   forwarder->messenger = messenger_Create(forwarder->dispatcher);
   forwarder->connectionManager = connectionManager_Create(forwarder);
   forwarder->connectionTable = connectionTable_Create();
+  connectionTable_SetStatsSegment(forwarder->connectionTable,
+                                  forwarder->statsSegment);
   forwarder->listenerSet = listenerSet_Create();
   forwarder->config = configuration_Create(forwarder);
+  forwarder->probeService = probeService_Create(forwarder);
   forwarder->processor = messageProcessor_Create(forwarder);
 
   forwarder->signal_term = dispatcher_CreateSignalEvent(
@@ -250,8 +275,11 @@ ERR_SOCKET:
   connectionManager_Destroy(&(forwarder->connectionManager));
   connectionTable_Destroy(&(forwarder->connectionTable));
   messageProcessor_Destroy(&(forwarder->processor));
+  // after the processor, the strategies unsubscribe when destroyed
+  probeService_Destroy(&(forwarder->probeService));
   configuration_Destroy(&(forwarder->config));
   messenger_Destroy(&(forwarder->messenger));
+  statsSegmentWriter_Destroy(&(forwarder->statsSegment));
 
   dispatcher_DestroySignalEvent(forwarder->dispatcher,
                                 &(forwarder->signal_int));
@@ -286,6 +314,8 @@ void forwarder_Destroy(Forwarder **ptr) {
   connectionManager_Destroy(&(forwarder->connectionManager));
   connectionTable_Destroy(&(forwarder->connectionTable));
   messageProcessor_Destroy(&(forwarder->processor));
+  // after the processor, the strategies unsubscribe when destroyed
+  probeService_Destroy(&(forwarder->probeService));
   configuration_Destroy(&(forwarder->config));
 
   // the messenger is used by many of the other pieces, so destroy it last
@@ -295,6 +325,10 @@ void forwarder_Destroy(Forwarder **ptr) {
   mapme_free(forwarder->mapme);
 #endif /* WITH_MAPME */
 
+  // the processor and the connection table update the segment until they
+  // are destroyed
+  statsSegmentWriter_Destroy(&(forwarder->statsSegment));
+
   dispatcher_DestroySignalEvent(forwarder->dispatcher,
                                 &(forwarder->signal_int));
   dispatcher_DestroySignalEvent(forwarder->dispatcher,
@@ -365,6 +399,11 @@ ConnectionTable *forwarder_GetConnectionTable(Forwarder *forwarder) {
   return forwarder->connectionTable;
 }
 
+StatsSegmentWriter *forwarder_GetStatsSegment(const Forwarder *forwarder) {
+  parcAssertNotNull(forwarder, "Parameter must be non-null");
+  return forwarder->statsSegment;
+}
+
 ListenerSet *forwarder_GetListenerSet(Forwarder *forwarder) {
   parcAssertNotNull(forwarder, "Parameter must be non-null");
   return forwarder->listenerSet;
@@ -572,7 +611,15 @@ static void _signal_cb(int sig, PARCEventType events, void *user_data) {
 static void _keepalive_cb(int fd, PARCEventType what, void *user_data) {
   parcAssertTrue(what & PARCEventType_Timeout, "Got unexpected tick_cb: %d",
                  what);
-  // function is just a keepalive for hicn-light, does not do anything
+  Forwarder *forwarder = (Forwarder *)user_data;
+
+  messageProcessor_UpdateTableStats(forwarder->processor);
+  statsSegmentWriter_Heartbeat(forwarder->statsSegment);
+}
+
+ProbeService *forwarder_GetProbeService(const Forwarder *forwarder) {
+  parcAssertNotNull(forwarder, "Parameter must be non-null");
+  return forwarder->probeService;
 }
 
 #ifdef WITH_MAPME
@@ -589,8 +636,8 @@ void forwarder_onConnectionEvent(Forwarder *forwarder, const Connection *conn, c
 }
 
 void forwarder_ProcessMapMe(Forwarder *forwarder, const uint8_t *msgBuffer,
-                            unsigned conn_id) {
-  mapme_Process(forwarder->mapme, msgBuffer, conn_id);
+                            size_t length, unsigned conn_id) {
+  mapme_Process(forwarder->mapme, msgBuffer, length, conn_id);
 }
 
 MapMe *
@@ -39,6 +39,7 @@
 #endif /* WITH_MAPME */
 
 #include <hicn/core/logger.h>
+#include <hicn/stats/statsSegmentWriter.h>
 #include <hicn/core/ticks.h>
 #include <hicn/io/listenerSet.h>
 
@@ -71,6 +72,20 @@ typedef struct forwarder Forwarder;
  */
 Forwarder *forwarder_Create(Logger *logger);
 
+/**
+ * @function forwarder_CreateWithStatsSegment
+ * @abstract Create the forwarder and export its statistics in shared memory
+ * @discussion
+ *   Same as forwarder_Create, the statistics segment is published with the
+ *   given name (e.g. HICN_LIGHT_STATS_SEGMENT_NAME). If the name is NULL or
+ *   the segment cannot be created, statistics are kept in private memory.
+ *
+ * @param logger may be NULL
+ * @param statsSegmentName may be NULL
+ */
+Forwarder *forwarder_CreateWithStatsSegment(Logger *logger,
+                                            const char *statsSegmentName);
+
 /**
  * @function forwarder_Destroy
  * @abstract Destroys the forwarder, stopping all traffic and freeing all memory
@@ -139,6 +154,13 @@ Messenger *forwarder_GetMessenger(Forwarder *forwarder);
 
 Dispatcher *forwarder_GetDispatcher(Forwarder *forwarder);
 
+/**
+ * @function forwarder_GetProbeService
+ * @abstract Path measurements shared by the strategy instances
+ */
+struct probe_service;
+struct probe_service *forwarder_GetProbeService(const Forwarder *forwarder);
+
 /**
  * Returns the set of currently active listeners
  *
@@ -164,6 +186,12 @@ ConnectionTable *forwarder_GetConnectionTable(const Forwarder *forwarder);
 ConnectionTable *forwarder_GetConnectionTable(Forwarder *forwarder);
 #endif /* WITH_POLICY */
 
+/**
+ * @function forwarder_GetStatsSegment
+ * @abstract Returns the statistics segment the counters are written to
+ */
+StatsSegmentWriter *forwarder_GetStatsSegment(const Forwarder *forwarder);
+
 /**
  * Returns a Tick-based clock
  *
@@ -296,10 +324,11 @@ void forwarder_onConnectionEvent(Forwarder *forwarder, const Connection *conn, c
  *      message.
  * @param [in] forwarder - Pointer to the hICN forwarder.
  * @param [in] msgBuffer - MAP-Me buffer
+ * @param [in] length - Number of bytes received in msgBuffer
  * @param [in] conn_id - Ingress connection id
  */
 void forwarder_ProcessMapMe(Forwarder *forwarder, const uint8_t *msgBuffer,
-                            unsigned conn_id);
+                            size_t length, unsigned conn_id);
 
 struct mapme;
 struct mapme * forwarder_getMapmeInstance(const Forwarder *forwarder);
@@ -29,6 +29,7 @@
 #include <hicn/core/forwarder.h>
 #include <hicn/core/logger.h>
 #include <hicn/core/message.h>
+#include <hicn/core/messageHandler.h>
 #include <hicn/core/messagePacketType.h>  // packet types
 #include <hicn/core/ticks.h>
 #include <hicn/processor/fibEntry.h>
@@ -71,6 +72,29 @@
 #define DEBUG(mapme, fmt, ...) \
   LOG(mapme, PARCLogLevel_Debug, fmt, ##__VA_ARGS__)
 
+/**
+ * Updates sent on a connection for many prefixes at once (eg. all the
+ * prefixes served by a producer which has moved), with a single
+ * retransmission timer. The connection is recorded in the TFIB of each prefix
+ * without a timer of its own.
+ */
+typedef struct mapme_batch {
+  struct mapme_batch *next;
+  const MapMe *mapme;
+  unsigned conn_id;
+  seq_t id;
+  uint32_t num_retx;
+  PARCEventTimer *timer;
+  size_t count;
+  Name *names[HICN_MAPME_BATCH_MAX];
+  seq_t seqs[HICN_MAPME_BATCH_MAX];
+} MapMeBatch;
+
+typedef struct {
+  MapMeBatch *head;
+  seq_t lastId;
+} MapMeBatchList;
+
 /**
  * MAP-Me state data structure
  */
@@ -79,6 +103,9 @@ struct mapme {
   uint32_t Tu;   /* ms */
   bool removeFibEntries;
 
+  /* Batches waiting for an acknowledgement */
+  MapMeBatchList *batches;
+
   Forwarder *forwarder;
 };
 
@@ -97,6 +124,9 @@ bool mapme_create(MapMe **mapme, Forwarder *forwarder) {
 
   (*mapme)->forwarder = forwarder;
 
+  (*mapme)->batches = calloc(1, sizeof(MapMeBatchList));
+  if (!(*mapme)->batches) goto ERR_BATCHES;
+
   /* As there is no face table and no related events, we need to install hooks
    * in various places in the forwarder, where both control commands and
    * signalization are processed.
@@ -104,12 +134,22 @@ bool mapme_create(MapMe **mapme, Forwarder *forwarder) {
 
   return true;
 
+ERR_BATCHES:
+  free(*mapme);
 ERR_MALLOC:
   return false;
 }
 
+static void mapmeBatch_Release(MapMeBatch **batchPtr);
+
 void mapme_free(MapMe *mapme)
 {
+    while (mapme->batches->head) {
+        MapMeBatch *batch = mapme->batches->head;
+        mapme->batches->head = batch->next;
+        mapmeBatch_Release(&batch);
+    }
+    free(mapme->batches);
     free(mapme);
 }
 
@@ -198,6 +238,13 @@ END:
   return timer;
 }
 
+static bool mapmeTFIB_Contains(const MapMeTFIB *tfib, unsigned conn_id) {
+  PARCUnsigned *cid = parcUnsigned_Create(conn_id);
+  bool found = parcHashMap_Contains(tfib->nexthops, cid);
+  parcUnsigned_Release(&cid);
+  return found;
+}
+
 static void mapmeTFIB_Put(MapMeTFIB *tfib, unsigned conn_id,
                           const PARCEventTimer *timer) {
   /* NOTE: Timers are not objects (the only class not being an object in
@@ -263,6 +310,14 @@ int hicn_prefix_from_name(const Name *name, hicn_prefix_t *prefix) {
   return hicn_prefix_create_from_ip_prefix(&ip_prefix, prefix);
 }
 
+static Name *mapme_createNameFromPrefix(const hicn_prefix_t *prefix) {
+  ip_address_t addr;
+  memcpy(&addr, &prefix->name, sizeof(addr));
+  return name_CreateFromAddress(
+      ip46_address_is_ip4(&prefix->name) ? ADDR_INET : ADDR_INET6, addr,
+      prefix->len);
+}
+
 static Message *mapme_createMessage(const MapMe *mapme, const Name *name,
                                     mapme_params_t *params) {
   Ticks now = forwarder_GetTicks(mapme->forwarder);
@@ -302,13 +357,25 @@ ERR_NAME:
 }
 
 static Message *mapme_createAckMessage(const MapMe *mapme,
-                                       const uint8_t *msgBuffer,
+                                       const uint8_t *msgBuffer, size_t length,
                                        const mapme_params_t *params) {
   Ticks now = forwarder_GetTicks(mapme->forwarder);
   Logger *logger = forwarder_GetLogger(mapme->forwarder);
 
-  size_t size = (params->protocol == IPPROTO_IPV6) ? HICN_MAPME_V6_HDRLEN
-                                                   : HICN_MAPME_V4_HDRLEN;
+  // A batch has been checked by hicn_mapme_parse_batch: its IP length is the
+  // exact size of its tuples, within the received bytes
+  size_t size;
+  if (hicn_mapme_is_batch(msgBuffer)) {
+    size = messageHandler_GetTotalPacketLength(msgBuffer);
+  } else {
+    size = (params->protocol == IPPROTO_IPV6) ? HICN_MAPME_V6_HDRLEN
+                                              : HICN_MAPME_V4_HDRLEN;
+  }
+  if (size > length) {
+    ERR(mapme, "[MAP-Me] Truncated packet, cannot acknowledge it");
+    return NULL;
+  }
+
   uint8_t *icmp_pkt = parcMemory_AllocateAndClear(size);
   memcpy(icmp_pkt, msgBuffer, size);
 
@@ -338,7 +405,8 @@ struct setFacePendingArgs {
 
 static bool mapme_setFacePending(const MapMe *mapme, const Name *name,
                                  FibEntry *fibEntry, unsigned conn_id,
-                                 bool send, bool is_producer, bool clear_tfib, uint32_t num_retx);
+                                 bool send, bool is_producer, bool clear_tfib,
+                                 uint32_t num_retx, MapMeBatchList *updates);
 
 static void mapme_setFacePendingCallback(int fd, PARCEventType which_event,
                                          void *data) {
@@ -350,10 +418,227 @@ static void mapme_setFacePendingCallback(int fd, PARCEventType which_event,
 
   INFO(args->mapme, "Timeout during retransmission. Re-sending");
   mapme_setFacePending(args->mapme, args->name, args->fibEntry, args->conn_id,
-                       args->send, args->is_producer, false, args->num_retx);
+                       args->send, args->is_producer, false, args->num_retx,
+                       NULL);
   free(args);
 }
 
+/*------------------------------------------------------------------------------
+ * Batches
+ *----------------------------------------------------------------------------*/
+
+static MapMeBatch *mapmeBatch_Create(const MapMe *mapme, unsigned conn_id) {
+  MapMeBatch *batch = calloc(1, sizeof(MapMeBatch));
+  if (!batch) return NULL;
+  batch->mapme = mapme;
+  batch->conn_id = conn_id;
+  return batch;
+}
+
+static void mapmeBatch_Release(MapMeBatch **batchPtr) {
+  MapMeBatch *batch = *batchPtr;
+
+  if (batch->timer) {
+    parcEventTimer_Stop(batch->timer);
+    Dispatcher *dispatcher = forwarder_GetDispatcher(batch->mapme->forwarder);
+    dispatcher_DestroyTimerEvent(dispatcher, &batch->timer);
+  }
+  for (size_t i = 0; i < batch->count; i++)
+    name_Release(&batch->names[i]);
+
+  free(batch);
+  *batchPtr = NULL;
+}
+
+static void mapmeBatchList_Remove(MapMeBatchList *list, MapMeBatch *batch) {
+  for (MapMeBatch **it = &list->head; *it; it = &(*it)->next) {
+    if (*it == batch) {
+      *it = batch->next;
+      batch->next = NULL;
+      return;
+    }
+  }
+}
+
+/*
+ * Drop the prefixes which are no more pending on the connection of the
+ * batch: acknowledged, superseded by a newer update, or removed from the FIB.
+ */
+static void mapmeBatch_Refresh(MapMeBatch *batch) {
+  FIB *fib = forwarder_getFib(batch->mapme->forwarder);
+  size_t count = 0;
+
+  for (size_t i = 0; i < batch->count; i++) {
+    FibEntry *fibEntry = fib_Contains(fib, batch->names[i]);
+    if (fibEntry && TFIB(fibEntry) && TFIB(fibEntry)->seq == batch->seqs[i] &&
+        mapmeTFIB_Contains(TFIB(fibEntry), batch->conn_id)) {
+      batch->names[count] = batch->names[i];
+      batch->seqs[count] = batch->seqs[i];
+      count++;
+    } else {
+      name_Release(&batch->names[i]);
+    }
+  }
+  batch->count = count;
+}
+
+static Message *mapme_createBatchMessage(const MapMe *mapme,
+                                         const MapMeBatch *batch) {
+  Ticks now = forwarder_GetTicks(mapme->forwarder);
+  Logger *logger = forwarder_GetLogger(mapme->forwarder);
+
+  // IPv4 prefixes only set the last 4 bytes of the name, the others have to
+  // be zero for the receiver to recognize the family
+  hicn_prefix_t prefixes[HICN_MAPME_BATCH_MAX];
+  memset(prefixes, 0, batch->count * sizeof(hicn_prefix_t));
+  for (size_t i = 0; i < batch->count; i++) {
+    if (hicn_prefix_from_name(batch->names[i], &prefixes[i]) < 0) {
+      ERR(mapme, "[MAP-Me] Failed to create lib's name");
+      return NULL;
+    }
+  }
+
+  mapme_params_t params = {
+      .protocol = IPPROTO_IPV6, .type = UPDATE, .seq = batch->id};
+  size_t size = HICN_MAPME_V6_BATCH_LEN(batch->count);
+  uint8_t *icmp_pkt = parcMemory_AllocateAndClear(size);
+
+  size_t len = hicn_mapme_create_batch(icmp_pkt, prefixes, batch->seqs,
+                                       batch->count, &params);
+  if (len == 0) {
+    ERR(mapme, "[MAP-Me] Failed to create mapme batch through lib");
+    parcMemory_Deallocate(&icmp_pkt);
+    return NULL;
+  }
+
+  return message_CreateFromByteArray(NO_INGRESS, icmp_pkt,
+                                     MessagePacketType_Interest, now, logger);
+}
+
+static void mapme_sendBatchCallback(int fd, PARCEventType which_event,
+                                    void *data);
+
+/*
+ * Send the batch on its connection and schedule its retransmission. The batch
+ * is released once it is not expected to be acknowledged anymore.
+ */
+static void mapme_transmitBatch(const MapMe *mapme, MapMeBatch *batch) {
+  const ConnectionTable *table = forwarder_GetConnectionTable(mapme->forwarder);
+  const Connection *conn =
+      connectionTable_FindById((ConnectionTable *)table, batch->conn_id);
+  if (!conn) {
+    INFO(mapme, "[MAP-Me] Stopped retransmissions as face went down");
+    goto END;
+  }
+
+  Message *special_interest = mapme_createBatchMessage(mapme, batch);
+  if (!special_interest) {
+    INFO(mapme, "[MAP-Me] Could not create special interest");
+    goto END;
+  }
+  INFO(mapme,
+       "[MAP-Me] Sending MAP-Me batch id=%u prefixes=%zu conn=%d retx=%d",
+       batch->id, batch->count, batch->conn_id, batch->num_retx);
+  connection_ReSend(conn, special_interest, NOT_A_NOTIFICATION);
+  message_Release(&special_interest);
+
+  if (batch->num_retx >= MAX_RETX) {
+    INFO(mapme, "[MAP-Me] Last retransmission.");
+    goto END;
+  }
+
+  if (!batch->timer) {
+    Dispatcher *dispatcher = forwarder_GetDispatcher(mapme->forwarder);
+    batch->timer = dispatcher_CreateTimer(dispatcher, TIMER_NO_REPEAT,
+                                          mapme_sendBatchCallback, batch);
+  }
+  struct timeval timeout = {mapme->retx / 1000, (mapme->retx % 1000) * 1000};
+  if (parcEventTimer_Start(batch->timer, &timeout) < 0) goto END;
+  return;
+
+END:
+  mapmeBatchList_Remove(mapme->batches, batch);
+  mapmeBatch_Release(&batch);
+}
+
+static void mapme_sendBatchCallback(int fd, PARCEventType which_event,
+                                    void *data) {
+  MapMeBatch *batch = (MapMeBatch *)data;
+  const MapMe *mapme = batch->mapme;
+
+  parcAssertTrue(which_event & PARCEventType_Timeout,
+                 "Event incorrect, expecting %X set, got %X",
+                 PARCEventType_Timeout, which_event);
+
+  INFO(mapme, "Timeout during retransmission of batch %u. Re-sending",
+       batch->id);
+  mapmeBatch_Refresh(batch);
+  if (batch->count == 0) {
+    mapmeBatchList_Remove(mapme->batches, batch);
+    mapmeBatch_Release(&batch);
+    return;
+  }
+  batch->num_retx++;
+  mapme_transmitBatch(mapme, batch);
+}
+
+static void mapme_sendBatch(const MapMe *mapme, MapMeBatch *batch) {
+  /* A single prefix is sent as a regular update */
+  if (batch->count == 1) {
+    FIB *fib = forwarder_getFib(mapme->forwarder);
+    FibEntry *fibEntry = fib_Contains(fib, batch->names[0]);
+    if (fibEntry)
+      mapme_setFacePending(mapme, fibEntry_GetPrefix(fibEntry), fibEntry,
+                           batch->conn_id, true, false, false, 0, NULL);
+    mapmeBatch_Release(&batch);
+    return;
+  }
+
+  batch->id = ++mapme->batches->lastId;
+  batch->next = mapme->batches->head;
+  mapme->batches->head = batch;
+  mapme_transmitBatch(mapme, batch);
+}
+
+/*
+ * Queue the update of a prefix on a connection, batches are sent as soon as
+ * they are full, and otherwise by mapme_flushUpdates.
+ */
+static void mapme_addUpdate(const MapMe *mapme, MapMeBatchList *updates,
+                            unsigned conn_id, const Name *name, seq_t seq) {
+  MapMeBatch *batch;
+  for (batch = updates->head; batch; batch = batch->next)
+    if (batch->conn_id == conn_id) break;
+
+  if (!batch) {
+    batch = mapmeBatch_Create(mapme, conn_id);
+    if (!batch) {
+      ERR(mapme, "[MAP-Me] Could not allocate batch");
+      return;
+    }
+    batch->next = updates->head;
+    updates->head = batch;
+  }
+
+  batch->names[batch->count] = name_Acquire(name);
+  batch->seqs[batch->count] = seq;
+  batch->count++;
+
+  if (batch->count == HICN_MAPME_BATCH_MAX) {
+    mapmeBatchList_Remove(updates, batch);
+    mapme_sendBatch(mapme, batch);
+  }
+}
+
+static void mapme_flushUpdates(const MapMe *mapme, MapMeBatchList *updates) {
+  while (updates->head) {
+    MapMeBatch *batch = updates->head;
+    updates->head = batch->next;
+    batch->next = NULL;
+    mapme_sendBatch(mapme, batch);
+  }
+}
+
 /**
  * @brief Update/Notification heuristic:
  *
@@ -376,7 +661,8 @@ static hicn_mapme_type_t mapme_getTypeFromHeuristic(const MapMe *mapme,
 
 static bool mapme_setFacePending(const MapMe *mapme, const Name *name,
                                  FibEntry *fibEntry, unsigned conn_id,
-                                 bool send, bool is_producer, bool clear_tfib, uint32_t num_retx) {
+                                 bool send, bool is_producer, bool clear_tfib,
+                                 uint32_t num_retx, MapMeBatchList *updates) {
   int rc;
 
   INFO(mapme, "[MAP-Me] SetFacePending connection=%d prefix=XX retx=%d",
@@ -422,6 +708,14 @@ static bool mapme_setFacePending(const MapMe *mapme, const Name *name,
     }
   }
 
+  /* The update is retransmitted with the batch */
+  if (send && updates) {
+    mapme_addUpdate(mapme, updates, conn_id, name, TFIB(fibEntry)->seq);
+    mapmeTFIB_Remove(mapme, TFIB(fibEntry), conn_id);
+    mapmeTFIB_Put(TFIB(fibEntry), conn_id, NULL);
+    return true;
+  }
+
   // NOTE
   // - at producer, send always true, we always send something reliably so we
   // set the timer.
@@ -526,8 +820,9 @@ static bool mapme_hasLocalNextHops(const MapMe *mapme,
   return false;
 }
 
-void
-mapme_send_updates(const MapMe * mapme, FibEntry * fibEntry, const NumberSet * nexthops)
+static void
+mapme_queueUpdates(const MapMe * mapme, FibEntry * fibEntry,
+        const NumberSet * nexthops, MapMeBatchList * updates)
 {
   if (!TFIB(fibEntry)) /* Create TFIB associated to FIB entry */
     mapme_CreateTFIB(mapme, fibEntry);
@@ -557,13 +852,22 @@ mapme_send_updates(const MapMe * mapme, FibEntry * fibEntry, const NumberSet * n
 
       INFO(mapme, "[MAP-Me] sending IU/IN for name %s on connection %d - %s (%s)", name_str,
            nexthop_id, connection_GetInterfaceName(conn), nexthop_type);
-      mapme_setFacePending(mapme, name, fibEntry, nexthop_id, true, true, clear_tfib, 0);
+      mapme_setFacePending(mapme, name, fibEntry, nexthop_id, true, true,
+              clear_tfib, 0, updates);
       clear_tfib = false;
   }
-  INFO(mapme, "[MAP-Me] Done sending MAP-Me update");
+  INFO(mapme, "[MAP-Me] Done queuing MAP-Me update");
   free(name_str);
 }
 
+void
+mapme_send_updates(const MapMe * mapme, FibEntry * fibEntry, const NumberSet * nexthops)
+{
+  MapMeBatchList updates = {0};
+  mapme_queueUpdates(mapme, fibEntry, nexthops, &updates);
+  mapme_flushUpdates(mapme, &updates);
+}
+
 
 void
 mapme_maybe_send_updates(const MapMe * mapme, FibEntry * fibEntry, const NumberSet * nexthops)
@@ -579,8 +883,9 @@ mapme_maybe_send_updates(const MapMe * mapme, FibEntry * fibEntry, const NumberS
   mapme_send_updates(mapme, fibEntry, nexthops);
 }
 
-void
-mapme_reconsiderFibEntry(const MapMe *mapme, FibEntry * fibEntry)
+static void
+mapme_queueFibEntry(const MapMe *mapme, FibEntry * fibEntry,
+        MapMeBatchList * updates)
 {
   /*
    * Skip entries that do not correspond to a producer ( / have a locally
@@ -593,11 +898,19 @@ mapme_reconsiderFibEntry(const MapMe *mapme, FibEntry * fibEntry)
   NumberSet * available_nexthops = fibEntry_GetAvailableNextHops(fibEntry, ~0);
 
   /* Advertise prefix on all available next hops (if needed) */
-  mapme_send_updates(mapme, fibEntry, available_nexthops);
+  mapme_queueUpdates(mapme, fibEntry, available_nexthops, updates);
 
   numberSet_Release(&available_nexthops);
 }
 
+void
+mapme_reconsiderFibEntry(const MapMe *mapme, FibEntry * fibEntry)
+{
+  MapMeBatchList updates = {0};
+  mapme_queueFibEntry(mapme, fibEntry, &updates);
+  mapme_flushUpdates(mapme, &updates);
+}
+
 /*
  * Callback called everytime a new connection is created by the control protocol
  */
@@ -643,11 +956,16 @@ mapme_onConnectionEvent(const MapMe *mapme, const Connection *conn_added, connec
    * each concerned fibEntry : connection is involved, or no more involved */
   FibEntryList *fiblist = forwarder_GetFibEntries(mapme->forwarder);
 
-  /* Iterate a first time on the FIB to get the locally served prefixes */
+  /*
+   * Iterate a first time on the FIB to get the locally served prefixes, the
+   * updates of all prefixes are then sent in batches on each connection.
+   */
+  MapMeBatchList updates = {0};
   for (size_t i = 0; i < fibEntryList_Length(fiblist); i++) {
     FibEntry *fibEntry = (FibEntry *)fibEntryList_Get(fiblist, i);
-    mapme_reconsiderFibEntry(mapme, fibEntry);
+    mapme_queueFibEntry(mapme, fibEntry, &updates);
   }
+  mapme_flushUpdates(mapme, &updates);
 
   fibEntryList_Destroy(&fiblist);
 
@@ -659,46 +977,14 @@ mapme_onConnectionEvent(const MapMe *mapme, const Connection *conn_added, connec
  *----------------------------------------------------------------------------*/
 
 /**
- * @discussion This function is way too long and should be cut out
+ * @discussion Process the update of a single prefix, IUs to be sent in turn
+ * are queued in updates.
  */
-static bool mapme_onSpecialInterest(const MapMe *mapme,
-                                    const uint8_t *msgBuffer,
-                                    unsigned conn_in_id, hicn_prefix_t *prefix,
-                                    mapme_params_t *params) {
-  const ConnectionTable *table = forwarder_GetConnectionTable(mapme->forwarder);
-  /* The cast is needed since connectionTable_FindById miss the
-   * const qualifier for the first parameter */
-  const Connection *conn_in =
-      connectionTable_FindById((ConnectionTable *)table, conn_in_id);
-  seq_t fibSeq, seq = params->seq;
-  bool send = (params->type == UPDATE);
-  bool rv;
-
-  Name *name = name_CreateFromPacket(msgBuffer, MessagePacketType_Interest);
-  name_setLen(name, prefix->len);
-  char *name_str = name_ToString(name);
-  INFO(mapme,
-       "[MAP-Me] Ack'ed Special Interest on connection %d - prefix=%s type=XX "
-       "seq=%d",
-       conn_in_id, name_str, seq);
-  free(name_str);
-
-  /*
-   * Immediately send an acknowledgement back on the ingress connection
-   * We always ack, even duplicates.
-   */
-  Message *ack = mapme_createAckMessage(mapme, msgBuffer, params);
-  if (!ack) {
-    name_Release(&name);
-    return false;
-  }
-  rv = connection_ReSend(conn_in, ack, NOT_A_NOTIFICATION);
-  message_Release(&ack);
-
-  if (!rv) {
-    name_Release(&name);
-    return false;
-  }
+static bool mapme_onUpdate(const MapMe *mapme, unsigned conn_in_id,
+                           const Name *name, seq_t seq,
+                           hicn_mapme_type_t type, MapMeBatchList *updates) {
+  seq_t fibSeq;
+  bool send = (type == UPDATE);
 
   /* EPM on FIB */
   /* only the processor has access to the FIB */
@@ -706,8 +992,6 @@ static bool mapme_onSpecialInterest(const MapMe *mapme,
 
   FibEntry *fibEntry = fib_Contains(fib, name);
 
-  name_Release(&name);
-
   if (!fibEntry) {
     INFO(mapme, "Ignored update with no FIB entry");
     return 0;
@@ -783,7 +1067,7 @@ static bool mapme_onSpecialInterest(const MapMe *mapme,
 
     /* Reliably forward the IU on all prevHops */
     INFO(mapme, "[MAP-Me]   - (1/3) processing prev hops");
-    if (params->type == UPDATE) {
+    if (type == UPDATE) {
       PARCIterator *iterator = mapmeTFIB_CreateKeyIterator(TFIB(fibEntry));
       if (iterator) {
         /* No iterator is created if the TFIB is empty */
@@ -793,7 +1077,7 @@ static bool mapme_onSpecialInterest(const MapMe *mapme,
           INFO(mapme, "[MAP-Me]   - Re-sending IU to pending connection %d",
                conn_id);
           mapme_setFacePending(mapme, fibEntry_GetPrefix(fibEntry), fibEntry,
-                               conn_id, false, false, false, 0);
+                               conn_id, false, false, false, 0, updates);
         }
         parcIterator_Release(&iterator);
       }
@@ -850,7 +1134,7 @@ static bool mapme_onSpecialInterest(const MapMe *mapme,
       INFO(mapme, "[MAP-Me]   - Sending IU on current next hop connection %d",
            conn_id);
       mapme_setFacePending(mapme, fibEntry_GetPrefix(fibEntry), fibEntry,
-                           conn_id, send, false, false, 0);
+                           conn_id, send, false, false, 0, updates);
       complete = false;
     }
 
@@ -896,12 +1180,96 @@ static bool mapme_onSpecialInterest(const MapMe *mapme,
         "[MAP-Me]   - Update interest %d -> %d sent backwards on connection %d",
         seq, fibSeq, conn_in_id);
     mapme_setFacePending(mapme, fibEntry_GetPrefix(fibEntry), fibEntry,
-                         conn_in_id, send, false, false, 0);
+                         conn_in_id, send, false, false, 0, updates);
   }
 
   return true;
 }
 
+static bool mapme_onSpecialInterest(const MapMe *mapme,
+                                    const uint8_t *msgBuffer, size_t length,
+                                    unsigned conn_in_id, hicn_prefix_t *prefix,
+                                    mapme_params_t *params) {
+  const ConnectionTable *table = forwarder_GetConnectionTable(mapme->forwarder);
+  /* The cast is needed since connectionTable_FindById miss the
+   * const qualifier for the first parameter */
+  const Connection *conn_in =
+      connectionTable_FindById((ConnectionTable *)table, conn_in_id);
+  seq_t seq = params->seq;
+  bool rv;
+
+  Name *name = name_CreateFromPacket(msgBuffer, MessagePacketType_Interest);
+  name_setLen(name, prefix->len);
+  char *name_str = name_ToString(name);
+  INFO(mapme,
+       "[MAP-Me] Ack'ed Special Interest on connection %d - prefix=%s type=XX "
+       "seq=%d",
+       conn_in_id, name_str, seq);
+  free(name_str);
+
+  /*
+   * Immediately send an acknowledgement back on the ingress connection
+   * We always ack, even duplicates.
+   */
+  Message *ack = mapme_createAckMessage(mapme, msgBuffer, length, params);
+  if (!ack) {
+    name_Release(&name);
+    return false;
+  }
+  rv = connection_ReSend(conn_in, ack, NOT_A_NOTIFICATION);
+  message_Release(&ack);
+
+  if (!rv) {
+    name_Release(&name);
+    return false;
+  }
+
+  MapMeBatchList updates = {0};
+  rv = mapme_onUpdate(mapme, conn_in_id, name, seq, params->type, &updates);
+  mapme_flushUpdates(mapme, &updates);
+
+  name_Release(&name);
+  return rv;
+}
+
+/*
+ * A batch is acknowledged as a whole, then each of its prefixes is processed
+ * as a regular update, and the IUs to be forwarded are batched again per
+ * connection.
+ */
+static bool mapme_onBatch(const MapMe *mapme, const uint8_t *msgBuffer,
+                          size_t length, unsigned conn_in_id,
+                          const hicn_prefix_t *prefixes,
+                          const seq_t *seqs, size_t count,
+                          mapme_params_t *params) {
+  const ConnectionTable *table = forwarder_GetConnectionTable(mapme->forwarder);
+  const Connection *conn_in =
+      connectionTable_FindById((ConnectionTable *)table, conn_in_id);
+
+  INFO(mapme,
+       "[MAP-Me] Ack'ed Special Interest batch on connection %d - id=%u "
+       "prefixes=%zu",
+       conn_in_id, params->seq, count);
+
+  Message *ack = mapme_createAckMessage(mapme, msgBuffer, length, params);
+  if (!ack)
+    return false;
+  bool rv = connection_ReSend(conn_in, ack, NOT_A_NOTIFICATION);
+  message_Release(&ack);
+  if (!rv)
+    return false;
+
+  MapMeBatchList updates = {0};
+  for (size_t i = 0; i < count; i++) {
+    Name *name = mapme_createNameFromPrefix(&prefixes[i]);
+    mapme_onUpdate(mapme, conn_in_id, name, seqs[i], params->type, &updates);
+    name_Release(&name);
+  }
+  mapme_flushUpdates(mapme, &updates);
+
+  return true;
+}
+
 void mapme_onSpecialInterestAck(const MapMe *mapme, const uint8_t *msgBuffer,
                                 unsigned conn_in_id, hicn_prefix_t *prefix,
                                 mapme_params_t *params) {
@@ -979,6 +1347,42 @@ void mapme_onSpecialInterestAck(const MapMe *mapme, const uint8_t *msgBuffer,
   }
 }
 
+/*
+ * Each prefix of the batch acknowledged with the latest sequence number stops
+ * being pending on the connection, as does the batch itself.
+ */
+static void mapme_onBatchAck(const MapMe *mapme, unsigned conn_in_id,
+                             const hicn_prefix_t *prefixes, const seq_t *seqs,
+                             size_t count, mapme_params_t *params) {
+  INFO(mapme, "[MAP-Me] Receive batch Ack id=%u prefixes=%zu on connection %d",
+       params->seq, count, conn_in_id);
+
+  FIB *fib = forwarder_getFib(mapme->forwarder);
+  Ticks now = forwarder_GetTicks(mapme->forwarder);
+
+  for (size_t i = 0; i < count; i++) {
+    Name *name = mapme_createNameFromPrefix(&prefixes[i]);
+    FibEntry *fibEntry = fib_Contains(fib, name);
+    name_Release(&name);
+
+    if (!fibEntry || !TFIB(fibEntry)) continue;
+    if (seqs[i] < TFIB(fibEntry)->seq) continue;
+    if (!mapmeTFIB_Contains(TFIB(fibEntry), conn_in_id)) continue;
+
+    mapmeTFIB_Remove(mapme, TFIB(fibEntry), conn_in_id);
+    if (params->type == UPDATE_ACK) TFIB(fibEntry)->lastAckedUpdate = now;
+  }
+
+  for (MapMeBatch *batch = mapme->batches->head; batch; batch = batch->next) {
+    if (batch->conn_id == conn_in_id && batch->id == params->seq) {
+      INFO(mapme, "[MAP-Me]   - Removing batch %u", batch->id);
+      mapmeBatchList_Remove(mapme->batches, batch);
+      mapmeBatch_Release(&batch);
+      break;
+    }
+  }
+}
+
 /*-----------------------------------------------------------------------------
  * Overloaded functions
  *----------------------------------------------------------------------------*/
@@ -1002,11 +1406,15 @@ bool mapme_isMapMe(const uint8_t *packet) {
     case 4:
       if (mapme->v4.ip.protocol != IPPROTO_ICMP)
         return false;
-      return HICN_IS_MAPME(mapme->v4.icmp_rd.type, mapme->v4.icmp_rd.code);
+      return HICN_IS_MAPME(mapme->v4.icmp_rd.type, mapme->v4.icmp_rd.code) ||
+             HICN_MAPME_IS_BATCH(mapme->v4.icmp_rd.type,
+                                 mapme->v4.icmp_rd.code);
     case 6:
       if (mapme->v6.ip.nxt != IPPROTO_ICMPV6)
         return false;
-      return HICN_IS_MAPME(mapme->v6.icmp_rd.type, mapme->v6.icmp_rd.code);
+      return HICN_IS_MAPME(mapme->v6.icmp_rd.type, mapme->v6.icmp_rd.code) ||
+             HICN_MAPME_IS_BATCH(mapme->v6.icmp_rd.type,
+                                 mapme->v6.icmp_rd.code);
     default:
       return false;
   }
@@ -1024,15 +1432,35 @@ bool mapme_isMapMe(const uint8_t *packet) {
  * processed by MAP-Me core.
  */
 void mapme_Process(const MapMe *mapme, const uint8_t *msgBuffer,
-                   unsigned conn_id) {
+                   size_t length, unsigned conn_id) {
   hicn_prefix_t prefix;
   mapme_params_t params;
+
+  if (hicn_mapme_is_batch(msgBuffer)) {
+    hicn_prefix_t prefixes[HICN_MAPME_BATCH_MAX];
+    seq_t seqs[HICN_MAPME_BATCH_MAX];
+    int count = hicn_mapme_parse_batch(msgBuffer, length, prefixes, seqs,
+                                       HICN_MAPME_BATCH_MAX, &params);
+    if (count < 0) {
+      ERR(mapme, "[MAP-Me] Malformed batch");
+      return;
+    }
+
+    if (params.type == UPDATE)
+      mapme_onBatch(mapme, msgBuffer, length, conn_id, prefixes, seqs, count,
+                    &params);
+    else
+      mapme_onBatchAck(mapme, conn_id, prefixes, seqs, count, &params);
+    return;
+  }
+
   hicn_mapme_parse_packet(msgBuffer, &prefix, &params);
 
   switch (params.type) {
     case UPDATE:
     case NOTIFICATION:
-      mapme_onSpecialInterest(mapme, msgBuffer, conn_id, &prefix, &params);
+      mapme_onSpecialInterest(mapme, msgBuffer, length, conn_id, &prefix,
+                              &params);
       break;
     case UPDATE_ACK:
     case NOTIFICATION_ACK:
@@ -63,10 +63,11 @@ bool mapme_isMapMe(const uint8_t *msgBuffer);
  * @abstract Process a MAP-Me message.
  * @param [in] mapme - Pointer to the MAP-Me data structure.
  * @param [in] message - MAP-Me buffer
+ * @param [in] length - Number of bytes received in msgBuffer
  * @param [in] conn_id - Ingress connection id
  */
 void mapme_Process(const MapMe *mapme, const uint8_t *msgBuffer,
-                   unsigned conn_id);
+                   size_t length, unsigned conn_id);
 
 /**
  * @function mapme_send_updates
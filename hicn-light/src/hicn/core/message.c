@@ -191,13 +191,21 @@ unsigned message_GetWldrLastReceived(const Message *message) {
   return messageHandler_GetWldrLastReceived(message->messageHead);
 }
 
+bool message_GetWldrLossBitmap(const Message *message, size_t length,
+                               uint64_t *bitmap) {
+  parcAssertNotNull(message, "Parameter must be non-null");
+  return messageHandler_GetWldrLossBitmap(message->messageHead, length,
+                                          bitmap);
+}
+
 void message_SetWldrLabel(Message *message, uint16_t label) {
   parcAssertNotNull(message, "Parameter must be non-null");
   messageHandler_SetWldrLabel(message->messageHead, label);
 }
 
 Message *message_CreateWldrNotification(Message *original, uint16_t expected,
-                                        uint16_t lastReceived) {
+                                        uint16_t lastReceived,
+                                        uint64_t lossBitmap) {
   parcAssertNotNull(original, "Parameter original must be non-null");
   Message *message = parcMemory_AllocateAndClear(sizeof(Message));
   parcAssertNotNull(message, "parcMemory_AllocateAndClear(%zu) returned NULL",
@@ -208,7 +216,8 @@ Message *message_CreateWldrNotification(Message *original, uint16_t expected,
   message->logger = logger_Acquire(original->logger);
 
   message->length = (unsigned int)messageHandler_GetICMPPacketSize(
-      messageHandler_GetIPPacketType(original->messageHead));
+      messageHandler_GetIPPacketType(original->messageHead)) +
+      WLDR_BITMAP_LEN;
   message->messageHead = parcMemory_AllocateAndClear(message->length);
   parcAssertNotNull(message->messageHead,
                     "parcMemory_AllocateAndClear returned NULL");
@@ -219,7 +228,8 @@ Message *message_CreateWldrNotification(Message *original, uint16_t expected,
 
   // set notification stuff.
   messageHandler_SetWldrNotification(
-      message->messageHead, original->messageHead, expected, lastReceived);
+      message->messageHead, original->messageHead, expected, lastReceived,
+      lossBitmap);
   return message;
 }
 
@@ -92,10 +92,18 @@ unsigned message_GetWldrExpectedLabel(const Message *message);
 
 unsigned message_GetWldrLastReceived(const Message *message);
 
+/**
+ * Returns false if the notification has no loss bitmap, or if it does not fit
+ * in the length bytes received
+ */
+bool message_GetWldrLossBitmap(const Message *message, size_t length,
+                               uint64_t *bitmap);
+
 void message_SetWldrLabel(Message *message, uint16_t label);
 
 Message *message_CreateWldrNotification(Message *original, uint16_t expected,
-                                        uint16_t lastReceived);
+                                        uint16_t lastReceived,
+                                        uint64_t lossBitmap);
 /**
  * Returns the connection id of the packet input
  */
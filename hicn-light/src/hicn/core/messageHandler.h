@@ -22,6 +22,7 @@
 #endif
 
 #include <hicn/hicn.h>
+#include <hicn/packet_inline.h>
 #include <hicn/core/messagePacketType.h>
 
 #define H(packet) ((hicn_header_t *)packet)
@@ -38,6 +39,10 @@
 #define IPv4_TYPE 4
 #define ICMP_WLDR_TYPE 42
 #define ICMP_WLDR_CODE 0
+// a WLDR notification carries a loss bitmap after the ICMP header: bit i is
+// set if label expected_lbl + i was lost
+#define WLDR_BITMAP_BITS 64
+#define WLDR_BITMAP_LEN (WLDR_BITMAP_BITS / 8)
 #define ICMP_LB_TYPE 43
 
 /*** masks and constants ***/
@@ -71,44 +76,28 @@ static inline uint8_t messageHandler_GetIPPacketType(const uint8_t *message) {
   return HICN_IP_VERSION(message);
 }
 
+// Incremental update (RFC 1624) of the checksums after size 16 bit words of
+// the packet have changed from old_val to new_val, both in network order.
 static inline void messageHandler_UpdateTCPCheckSum(uint8_t *message,
                                                     uint16_t *old_val,
                                                     uint16_t *new_val,
                                                     uint8_t size) {
+  uint16_t *csum;
+
   switch (messageHandler_GetIPPacketType(message)) {
     case IPv4_TYPE:
-      for (uint8_t i = 0; i < size; i++) {
-        uint16_t old_csum = ~(H4T(message).csum);
-        uint16_t not_old_val = ~(*old_val);
-        uint32_t sum = (uint32_t)old_csum + not_old_val + *new_val;
-
-        while (sum >> 16) {
-          sum = (sum >> 16) + (sum & UINT16_T_MASK);
-        }
-
-        H4T(message).csum = ~sum;
-        ++old_val;
-        ++new_val;
-      }
+      csum = &H4T(message).csum;
       break;
     case IPv6_TYPE:
-      for (uint8_t i = 0; i < size; i++) {
-        uint16_t old_csum = ~(H6T(message).csum);
-        uint16_t not_old_val = ~(*old_val);
-        uint32_t sum = (uint32_t)old_csum + not_old_val + *new_val;
-
-        while (sum >> 16) {
-          sum = (sum >> 16) + (sum & UINT16_T_MASK);
-        }
-
-        H6T(message).csum = ~sum;
-        ++old_val;
-        ++new_val;
-      }
+      csum = &H6T(message).csum;
       break;
     default:
       return;
   }
+
+  for (uint8_t i = 0; i < size; i++) {
+    *csum = hicn_csum_update_u16(*csum, old_val[i], new_val[i]);
+  }
 }
 
 static inline void messageHandler_UpdateIPv4CheckSum(uint8_t *message,
@@ -116,17 +105,8 @@ static inline void messageHandler_UpdateIPv4CheckSum(uint8_t *message,
                                                      uint16_t *new_val,
                                                      uint8_t size) {
   for (uint8_t i = 0; i < size; i++) {
-    uint16_t old_csum = ~(H4(message).csum);
-    uint16_t not_old_val = ~(*old_val);
-    uint32_t sum = (uint32_t)old_csum + not_old_val + *new_val;
-
-    while (sum >> 16) {
-      sum = (sum >> 16) + (sum & UINT16_T_MASK);
-    }
-
-    H4(message).csum = ~sum;
-    ++old_val;
-    ++new_val;
+    H4(message).csum =
+        hicn_csum_update_u16(H4(message).csum, old_val[i], new_val[i]);
   }
 }
 
@@ -265,13 +245,15 @@ ERR:
  * \brief Handle incoming messages
  * \param [in] forwarder - Reference to the Forwarder instance
  * \param [in] packet - Packet buffer
+ * \param [in] length - Number of bytes received in packet
  * \param [in] conn_id - A hint on the connection ID on which the packet
  *      was received
  * \return Flag indicating whether the packet matched a hook and was
  *      (successfully or not) processed.
  */
 static inline bool messageHandler_handleHooks(Forwarder * forwarder,
-        const uint8_t * packet, ListenerOps * listener, int fd, AddressPair * pair)
+        const uint8_t * packet, size_t length, ListenerOps * listener, int fd,
+        AddressPair * pair)
 {
   bool is_matched = false;
 
@@ -315,7 +297,7 @@ static inline bool messageHandler_handleHooks(Forwarder * forwarder,
 
 #ifdef WITH_MAPME
   if (mapme_isMapMe(packet))
-    forwarder_ProcessMapMe(forwarder, packet, conn_id);
+    forwarder_ProcessMapMe(forwarder, packet, length, conn_id);
 #endif /* WITH_MAPME */
 
   /* ... */
@@ -330,24 +312,28 @@ static inline bool messageHandler_IsTCP(const uint8_t *message) {
   return true;
 }
 
+/*
+ * The accessors below only read the TCP header, which is at the same offset
+ * with and without AH, so the IP version is enough to pick the format.
+ */
+static inline bool messageHandler_IsIPv6TCP(const uint8_t *message) {
+  return messageHandler_GetIPPacketType(message) == IPv6_TYPE;
+}
+
 static inline bool messageHandler_IsInterest(const uint8_t *message) {
   if (!messageHandler_IsTCP(message)) return false;
 
-  bool flag;
-  hicn_packet_test_ece(HF_INET6_TCP, (hicn_header_t *)message,
-                       &flag);  // ECE flag is set to 0 in interest packets
-  if (flag == false) return true;
-  return false;
+  // ECE flag is set to 0 in interest packets
+  if (messageHandler_IsIPv6TCP(message))
+    return hicn_inet6_tcp_is_interest(H(message));
+  return hicn_inet_tcp_is_interest(H(message));
 }
 
 static inline bool messageHandler_IsData(const uint8_t *message) {
   if (!messageHandler_IsTCP(message)) return false;
 
-  bool flag;
-  hicn_packet_test_ece(HF_INET6_TCP, (hicn_header_t *)message,
-                       &flag);  // ECE flag is set to 1 in data packets
-  if (flag == true) return true;
-  return false;
+  // ECE flag is set to 1 in data packets
+  return !messageHandler_IsInterest(message);
 }
 
 static inline bool messageHandler_IsWldrNotification(const uint8_t *message) {
@@ -452,6 +438,28 @@ static inline uint16_t messageHandler_GetWldrLastReceived(
   return ntohs(((_icmp_wldr_header_t *)icmp_ptr)->received_lbl);
 }
 
+/**
+ * @param length is the number of bytes received, the bitmap is only read if
+ * both the packet and the bytes received are long enough
+ */
+static inline bool messageHandler_GetWldrLossBitmap(const uint8_t *message,
+                                                    size_t length,
+                                                    uint64_t *bitmap) {
+  unsigned ipVersion = messageHandler_GetIPPacketType(message);
+  size_t size = messageHandler_GetICMPPacketSize(ipVersion);
+  if (size == 0 || length < size + WLDR_BITMAP_LEN ||
+      messageHandler_GetTotalPacketLength(message) < size + WLDR_BITMAP_LEN) {
+    // notification without bitmap, only the range
+    // [expected_lbl, received_lbl) was lost
+    return false;
+  }
+
+  uint32_t words[2];
+  memcpy(words, message + size, WLDR_BITMAP_LEN);
+  *bitmap = ((uint64_t)ntohl(words[0]) << 32) | ntohl(words[1]);
+  return true;
+}
+
 static inline uint16_t messageHandler_GetWldrLabel(const uint8_t *message) {
   switch (messageHandler_GetIPPacketType(message)) {
     case IPv6_TYPE:
@@ -465,20 +473,21 @@ static inline uint16_t messageHandler_GetWldrLabel(const uint8_t *message) {
 
 static inline void messageHandler_SetWldrLabel(uint8_t *message,
                                                uint16_t label) {
-  uint16_t old_val = messageHandler_GetWldrLabel(message);
+  uint16_t old_val = htons(messageHandler_GetWldrLabel(message));
+  uint16_t new_val = htons(label);
 
   switch (messageHandler_GetIPPacketType(message)) {
     case IPv6_TYPE:
-      H6T(message).window = htons(label);
+      H6T(message).window = new_val;
       break;
     case IPv4_TYPE:
-      H4T(message).window = htons(label);
+      H4T(message).window = new_val;
       break;
     default:
-      break;
+      return;
   }
 
-  messageHandler_UpdateTCPCheckSum(message, &old_val, &label, 1);
+  messageHandler_UpdateTCPCheckSum(message, &old_val, &new_val, 1);
 }
 
 static inline void messageHandler_ResetWldrLabel(uint8_t *message) {
@@ -498,10 +507,9 @@ static inline bool messageHandler_HasWldr(const uint8_t *message) {
 static inline uint32_t messageHandler_GetPathLabel(const uint8_t *message) {
   if (!messageHandler_IsTCP(message)) return 0;
 
-  uint32_t path_label;
-  int res = hicn_data_get_path_label((hicn_header_t *)message, &path_label);
-  if (res < 0) return 0;
-  return path_label;
+  if (messageHandler_IsIPv6TCP(message))
+    return hicn_inet6_tcp_get_path_label(H(message));
+  return hicn_inet_tcp_get_path_label(H(message));
 }
 
 static inline void messageHandler_SetPathLabel(uint8_t *message,
@@ -509,10 +517,13 @@ static inline void messageHandler_SetPathLabel(uint8_t *message,
                                                uint32_t new_path_label) {
   if (!messageHandler_IsTCP(message)) return;
 
-  hicn_data_set_path_label((hicn_header_t *)message, new_path_label);
+  // The old label is read back from the packet by the rewrite
+  (void)old_path_label;
 
-  messageHandler_UpdateTCPCheckSum(message, (uint16_t *)&old_path_label,
-                                   (uint16_t *)&new_path_label, 2);
+  if (messageHandler_IsIPv6TCP(message))
+    hicn_inet6_tcp_rewrite_path_label(H(message), new_path_label);
+  else
+    hicn_inet_tcp_rewrite_path_label(H(message), new_path_label);
 }
 
 static inline void messageHandler_UpdatePathLabel(uint8_t *message,
@@ -535,10 +546,9 @@ static inline uint16_t messageHandler_GetInterestLifetime(
     const uint8_t *message) {
   if (!messageHandler_IsTCP(message)) return 0;
 
-  hicn_lifetime_t lifetime;
-  int res = hicn_interest_get_lifetime((hicn_header_t *)message, &lifetime);
-  if (res < 0) return 0;
-  return lifetime;
+  if (messageHandler_IsIPv6TCP(message))
+    return hicn_inet6_tcp_get_lifetime(H(message));
+  return hicn_inet_tcp_get_lifetime(H(message));
 }
 
 static inline bool messageHandler_HasInterestLifetime(const uint8_t *message) {
@@ -552,20 +562,16 @@ static inline uint32_t messageHandler_GetContentExpiryTime(
     const uint8_t *message) {
   if (!messageHandler_IsTCP(message)) return 0;
 
-  uint32_t expirationTime;
-  int res =
-      hicn_data_get_expiry_time((hicn_header_t *)message, &expirationTime);
-  if (res < 0) return 0;
-  return expirationTime;
+  // The expiry time is stored in the lifetime field of data packets
+  if (messageHandler_IsIPv6TCP(message))
+    return hicn_inet6_tcp_get_lifetime(H(message));
+  return hicn_inet_tcp_get_lifetime(H(message));
 }
 
 static inline bool messageHandler_HasContentExpiryTime(const uint8_t *message) {
   if (!messageHandler_IsTCP(message)) return 0;
 
-  uint32_t expirationTime;
-  int res =
-      hicn_data_get_expiry_time((hicn_header_t *)message, &expirationTime);
-  if (res < 0) return false;
+  uint32_t expirationTime = messageHandler_GetContentExpiryTime(message);
 
   if (expirationTime == HICN_MAX_LIFETIME) return false;
 
@@ -644,8 +650,11 @@ static inline void messageHandler_SetDestination_IPv4(uint8_t *message,
 static inline void messageHandler_SetWldrNotification(uint8_t *notification,
                                                       uint8_t *original,
                                                       uint16_t expected,
-                                                      uint16_t received) {
+                                                      uint16_t received,
+                                                      uint64_t bitmap) {
   hicn_header_t *h = (hicn_header_t *)notification;
+  uint32_t words[2] = {htonl((uint32_t)(bitmap >> 32)),
+                       htonl((uint32_t)bitmap)};
   switch (messageHandler_GetIPPacketType(original)) {
     case IPv6_TYPE: {
       *h = (hicn_header_t){.v6 = {
@@ -655,7 +664,8 @@ static inline void messageHandler_SetWldrNotification(uint8_t *notification,
                                            (IPV6_DEFAULT_VERSION << 28) |
                                            (IPV6_DEFAULT_TRAFFIC_CLASS << 20) |
                                            (IPV6_DEFAULT_FLOW_LABEL & 0xfffff)),
-                                       .len = htons(ICMP_HDRLEN),
+                                       .len = htons(ICMP_HDRLEN +
+                                                    WLDR_BITMAP_LEN),
                                        .nxt = IPPROTO_ICMPV6,
                                        .hlim = 5,
                                    },
@@ -667,6 +677,7 @@ static inline void messageHandler_SetWldrNotification(uint8_t *notification,
                                        .received_lbl = htons(received),
                                    },
                            }};
+      memcpy(notification + IPV6_HDRLEN + ICMP_HDRLEN, words, WLDR_BITMAP_LEN);
       messageHandler_SetSource_IPv6(
           notification,
           (struct in6_addr *)messageHandler_GetDestination(original));
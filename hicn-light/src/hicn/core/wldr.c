@@ -17,21 +17,42 @@
 #include <parc/logging/parc_LogReporterTextStdout.h>
 #include <hicn/core/connection.h>
 #include <hicn/core/forwarder.h>
+#include <hicn/core/messageHandler.h>
 #include <hicn/core/wldr.h>
 #include <stdint.h>
 #include <stdio.h>
 
+// the packet sent with a label is kept in the slot label % BUFFER_SIZE. The
+// label is stored along to detect slots that have been reused or evicted
 struct wldr_buffer {
   Message *message;
+  uint16_t label;
   uint8_t rtx_counter;
+  bool repaired;  // already retransmitted with a new label
 };
 
 typedef struct wldr_buffer WldrBuffer;
 
+// retransmissions triggered by a notification
+typedef struct {
+  Message *messages[WLDR_BITMAP_BITS];
+  size_t count;
+} WldrBurst;
+
 struct wldr_state {
   uint16_t expected_label;
   uint16_t next_label;
-  WldrBuffer *buffer[BUFFER_SIZE];
+
+  // oldest label that may still be in the buffer and bytes held by the buffer
+  uint16_t oldest_label;
+  size_t bytes;
+
+  // losses detected in the last WLDR_BITMAP_BITS labels, reported again in
+  // each notification in case a previous one got lost
+  uint16_t loss_base;
+  uint64_t loss_bitmap;
+
+  WldrBuffer buffer[BUFFER_SIZE];
 };
 
 Wldr *wldr_Init() {
@@ -40,67 +61,117 @@ Wldr *wldr_Init() {
                     sizeof(Wldr));
   wldr->expected_label = 1;
   wldr->next_label = 1;
-  for (int i = 0; i < BUFFER_SIZE; i++) {
-    WldrBuffer *entry = parcMemory_AllocateAndClear(sizeof(WldrBuffer));
-    parcAssertNotNull(
-        entry,
-        "WldrBuffer init: parcMemory_AllocateAndClear(%zu) returned NULL",
-        sizeof(WldrBuffer));
-    entry->message = NULL;
-    entry->rtx_counter = 0;
-    wldr->buffer[i] = entry;
-  }
+  wldr->oldest_label = 1;
   return wldr;
 }
 
+static void _wldr_ReleaseEntry(Wldr *wldr, WldrBuffer *entry) {
+  if (entry->message != NULL) {
+    wldr->bytes -= message_Length(entry->message);
+    message_Release(&(entry->message));
+  }
+  entry->rtx_counter = 0;
+  entry->repaired = false;
+}
+
 void wldr_ResetState(Wldr *wldr) {
-  wldr->expected_label = 1;
-  wldr->next_label = 1;
   for (int i = 0; i < BUFFER_SIZE; i++) {
-    wldr->buffer[i]->message = NULL;
-    wldr->buffer[i]->rtx_counter = 0;
+    _wldr_ReleaseEntry(wldr, &wldr->buffer[i]);
   }
+  wldr->expected_label = 1;
+  wldr->next_label = 1;
+  wldr->oldest_label = 1;
+  wldr->loss_base = 0;
+  wldr->loss_bitmap = 0;
 }
 
 void wldr_Destroy(Wldr **wldrPtr) {
   Wldr *wldr = *wldrPtr;
   for (unsigned i = 0; i < BUFFER_SIZE; i++) {
-    if (wldr->buffer[i]->message != NULL) {
-      message_Release(&(wldr->buffer[i]->message));
-      parcMemory_Deallocate((void **)&(wldr->buffer[i]));
-    }
+    _wldr_ReleaseEntry(wldr, &wldr->buffer[i]);
   }
   parcMemory_Deallocate((void **)&wldr);
   *wldrPtr = NULL;
 }
 
+static void _wldr_StorePacket(Wldr *wldr, Message *message,
+                              uint8_t rtx_counter) {
+  uint16_t label = wldr->next_label;
+
+  // the message may be the one of a slot released below
+  message_Acquire(message);
+
+  WldrBuffer *entry = &wldr->buffer[label % BUFFER_SIZE];
+  _wldr_ReleaseEntry(wldr, entry);
+
+  // drop the oldest packets to stay within the byte budget
+  if ((uint16_t)(label - wldr->oldest_label) >= BUFFER_SIZE) {
+    wldr->oldest_label = (uint16_t)(label - BUFFER_SIZE + 1);
+  }
+  size_t length = message_Length(message);
+  while (wldr->bytes + length > WLDR_BYTE_BUDGET &&
+         wldr->oldest_label != label) {
+    WldrBuffer *old = &wldr->buffer[wldr->oldest_label % BUFFER_SIZE];
+    if (old->label == wldr->oldest_label) {
+      _wldr_ReleaseEntry(wldr, old);
+    }
+    wldr->oldest_label++;
+  }
+
+  message_SetWldrLabel(message, label);
+  entry->message = message;
+  entry->label = label;
+  entry->rtx_counter = rtx_counter;
+  entry->repaired = false;
+  wldr->bytes += length;
+
+  wldr->next_label++;
+  if (wldr->next_label ==
+      0)  // we alwasy skip label 0 beacause it means that wldr is not active
+    wldr->next_label++;
+}
+
+static void _wldr_SendBurst(const Connection *conn, WldrBurst *burst) {
+  // the whole burst is relabelled before the first packet goes out
+  for (size_t i = 0; i < burst->count; i++) {
+    connection_ReSend(conn, burst->messages[i], false);
+    message_Release(&(burst->messages[i]));
+  }
+  burst->count = 0;
+}
+
 static void _wldr_RetransmitPacket(Wldr *wldr, const Connection *conn,
-                                   uint16_t label) {
-  if (wldr->buffer[label % BUFFER_SIZE]->message == NULL) {
+                                   uint16_t label, WldrBurst *burst) {
+  WldrBuffer *entry = &wldr->buffer[label % BUFFER_SIZE];
+  if (label == 0 || entry->message == NULL || entry->label != label) {
     // the required message for retransmission is not in the buffer
     return;
   }
 
-  if (wldr->buffer[label % BUFFER_SIZE]->rtx_counter < MAX_RTX) {
-    Message *msg = wldr->buffer[label % BUFFER_SIZE]->message;
-    message_SetWldrLabel(msg, wldr->next_label);
+  if (entry->repaired || entry->rtx_counter >= MAX_RTX) {
+    return;
+  }
 
-    if (wldr->buffer[wldr->next_label % BUFFER_SIZE]->message != NULL) {
-      message_Release(&(wldr->buffer[wldr->next_label % BUFFER_SIZE]->message));
-    }
+  Message *msg = entry->message;
+  _wldr_StorePacket(wldr, msg, entry->rtx_counter + 1);
 
-    wldr->buffer[wldr->next_label % BUFFER_SIZE]->message = msg;
-    wldr->buffer[wldr->next_label % BUFFER_SIZE]->rtx_counter =
-        wldr->buffer[label % BUFFER_SIZE]->rtx_counter + 1;
-    message_Acquire(wldr->buffer[wldr->next_label % BUFFER_SIZE]->message);
-    wldr->next_label++;
-    connection_ReSend(conn, msg, false);
+  // the packet is now held by the slot of its new label, so that its bytes
+  // are counted once: the old slot only remembers that it has been repaired
+  if (entry->label == label) {
+    _wldr_ReleaseEntry(wldr, entry);
+    entry->repaired = true;
+  }
+
+  burst->messages[burst->count++] = message_Acquire(msg);
+  if (burst->count == WLDR_BITMAP_BITS) {
+    _wldr_SendBurst(conn, burst);
   }
 }
 
 static void _wldr_SendWldrNotificaiton(Wldr *wldr, const Connection *conn,
                                        Message *message, uint16_t expected_lbl,
-                                       uint16_t received_lbl) {
+                                       uint16_t received_lbl,
+                                       uint64_t loss_bitmap) {
   // here we need to create a new packet that is used to send the wldr
   // notification to the prevoius hop. the destionation address of the
   // notification is the source address of the message for which we want to
@@ -113,32 +184,47 @@ static void _wldr_SendWldrNotificaiton(Wldr *wldr, const Connection *conn,
   // this way the notification packet will be dispaced to the right connection
   // at the next hop.
 
-  Message *notification =
-      message_CreateWldrNotification(message, expected_lbl, received_lbl);
+  Message *notification = message_CreateWldrNotification(
+      message, expected_lbl, received_lbl, loss_bitmap);
   parcAssertNotNull(notification, "Got null from CreateWldrNotification");
   connection_ReSend(conn, notification, true);
 }
 
-void wldr_SetLabel(Wldr *wldr, Message *message) {
-  // in this function we send the packet for the first time
-  // 1) we set the wldr label
-  message_SetWldrLabel(message, wldr->next_label);
+// records the loss of the labels in [first, end)
+static void _wldr_AddLosses(Wldr *wldr, uint16_t first, uint16_t end) {
+  uint16_t gap = (uint16_t)(end - first);
 
-  // 2) we store the pointer to packet in the buffer
-  if (wldr->buffer[wldr->next_label % BUFFER_SIZE]->message != NULL) {
-    // release an old message if necessary
-    message_Release(&(wldr->buffer[wldr->next_label % BUFFER_SIZE]->message));
+  if (gap >= WLDR_BITMAP_BITS) {
+    // the labels after the bitmap are implicitly lost
+    wldr->loss_base = first;
+    wldr->loss_bitmap = ~0ULL;
+    return;
   }
 
-  // we need to acquire the message to avoid that it gets destroyed
-  message_Acquire(message);
+  if (wldr->loss_bitmap == 0) {
+    wldr->loss_base = first;
+  } else {
+    // slide the window to fit the last lost label
+    uint16_t span = (uint16_t)(end - 1 - wldr->loss_base);
+    if (span >= WLDR_BITMAP_BITS) {
+      uint16_t shift = (uint16_t)(span - WLDR_BITMAP_BITS + 1);
+      wldr->loss_bitmap =
+          shift >= WLDR_BITMAP_BITS ? 0 : wldr->loss_bitmap >> shift;
+      wldr->loss_base = wldr->loss_bitmap == 0
+                            ? first
+                            : (uint16_t)(wldr->loss_base + shift);
+    }
+  }
 
-  wldr->buffer[wldr->next_label % BUFFER_SIZE]->message = message;
-  wldr->buffer[wldr->next_label % BUFFER_SIZE]->rtx_counter = 0;
-  wldr->next_label++;
-  if (wldr->next_label ==
-      0)  // we alwasy skip label 0 beacause it means that wldr is not active
-    wldr->next_label++;
+  for (uint16_t lbl = first; lbl != end; lbl++) {
+    wldr->loss_bitmap |= 1ULL << (uint16_t)(lbl - wldr->loss_base);
+  }
+}
+
+void wldr_SetLabel(Wldr *wldr, Message *message) {
+  // in this function we send the packet for the first time: we set the wldr
+  // label and we keep a reference to the packet in the buffer
+  _wldr_StorePacket(wldr, message, 0);
 }
 
 void wldr_DetectLosses(Wldr *wldr, const Connection *conn, Message *message) {
@@ -153,30 +239,57 @@ void wldr_DetectLosses(Wldr *wldr, const Connection *conn, Message *message) {
       // synch the labels
 
       if ((pkt_lbl != 1) || (wldr->expected_label < pkt_lbl)) {
-        _wldr_SendWldrNotificaiton(wldr, conn, message, wldr->expected_label,
-                                   pkt_lbl);
+        if ((uint16_t)(pkt_lbl - wldr->expected_label) < BUFFER_SIZE) {
+          _wldr_AddLosses(wldr, wldr->expected_label, pkt_lbl);
+          _wldr_SendWldrNotificaiton(wldr, conn, message, wldr->loss_base,
+                                     pkt_lbl, wldr->loss_bitmap);
+        }
+      } else {
+        wldr->loss_bitmap = 0;
       }
 
       // here we always synch
       wldr->expected_label = (uint16_t)(pkt_lbl + 1);
     } else {
       wldr->expected_label++;
-      if (wldr->expected_label == 0)
-        wldr->expected_label++;  // for the next_label we want to skip 0
     }
+    if (wldr->expected_label == 0)
+      wldr->expected_label++;  // for the next_label we want to skip 0
   }
 }
 
 void wldr_HandleWldrNotification(Wldr *wldr, const Connection *conn,
-                                 Message *message) {
+                                 Message *message, size_t length) {
   uint16_t expected_lbl = (uint16_t)message_GetWldrExpectedLabel(message);
   uint16_t received_lbl = (uint16_t)message_GetWldrLastReceived(message);
-  if ((wldr->next_label - expected_lbl) > BUFFER_SIZE) {
+  uint16_t span = (uint16_t)(received_lbl - expected_lbl);
+  if (span > BUFFER_SIZE) {
     // the packets are not in the buffer anymore
     return;
   }
-  while (expected_lbl < received_lbl) {
-    _wldr_RetransmitPacket(wldr, conn, expected_lbl);
-    expected_lbl++;
+
+  WldrBurst burst = {.count = 0};
+  uint64_t loss_bitmap;
+  uint16_t lbl = expected_lbl;
+
+  // a whole burst of losses is repaired at once
+  if (message_GetWldrLossBitmap(message, length, &loss_bitmap)) {
+    for (unsigned i = 0; i < WLDR_BITMAP_BITS && i < span; i++) {
+      if (loss_bitmap & (1ULL << i)) {
+        _wldr_RetransmitPacket(wldr, conn, (uint16_t)(expected_lbl + i),
+                               &burst);
+      }
+    }
+    lbl = span > WLDR_BITMAP_BITS
+              ? (uint16_t)(expected_lbl + WLDR_BITMAP_BITS)
+              : received_lbl;
   }
+
+  // notification without bitmap, or labels after the bitmap
+  while (lbl != received_lbl) {
+    _wldr_RetransmitPacket(wldr, conn, lbl, &burst);
+    lbl++;
+  }
+
+  _wldr_SendBurst(conn, &burst);
 }
@@ -21,6 +21,9 @@
 #include <hicn/core/message.h>
 
 #define BUFFER_SIZE 8192
+// bytes of packets a connection keeps for retransmission, the oldest packets
+// are dropped first
+#define WLDR_BYTE_BUDGET (4 * 1024 * 1024)
 #define MAX_RTX 3
 #define WLDR_LBL 13
 #define WLDR_NOTIFICATION 14
@@ -33,6 +36,9 @@
 //    last_received_label = urgent pointer in the TCP header
 //                        ATTENTION!!! in order to detect a notificaiton the
 //                        source and destination ports must be set to 0
+//    the ICMP header is followed by a loss bitmap: bit i is set if
+//    expected_label + i was lost. The labels between expected_label +
+//    WLDR_BITMAP_BITS and last_received_label, if any, were all lost.
 
 struct wldr_state;
 typedef struct wldr_state Wldr;
@@ -47,6 +53,7 @@ void wldr_SetLabel(Wldr *wldr, Message *message);
 
 void wldr_DetectLosses(Wldr *wldr, const Connection *conn, Message *message);
 
+// length is the number of bytes received for the notification
 void wldr_HandleWldrNotification(Wldr *wldr, const Connection *conn,
-                                 Message *message);
+                                 Message *message, size_t length);
 #endif  // wldr_h
@@ -324,6 +324,16 @@ static bool _send(IoOperations *ops, const Address *dummy, Message *message) {
     return false;
   }
 
+#ifdef WITH_IO_URING
+  // the packet is copied, the addresses may be rewritten for the next face
+  if (dispatcher_Send(forwarder_GetDispatcher(hicnConnState->forwarder),
+                      hicnConnState->hicnListenerSocket,
+                      message_FixedHeader(message), message_Length(message),
+                      NULL, 0)) {
+    return true;
+  }
+#endif /* WITH_IO_URING */
+
   ssize_t writeLength =
       write(hicnConnState->hicnListenerSocket, message_FixedHeader(message),
             message_Length(message));
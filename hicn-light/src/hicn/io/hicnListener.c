@@ -49,6 +49,9 @@ struct hicn_listener {
   Logger *logger;
 
   PARCEvent *hicn_event;
+#ifdef WITH_IO_URING
+  DispatcherReceiver *hicn_receiver;
+#endif /* WITH_IO_URING */
   int hicn_fd;  // this is the file descriptor got from hicn library
 
   Address
@@ -84,8 +87,14 @@ static unsigned _createNewConnection(ListenerOps *listener, int fd, const Addres
 static const Connection * _lookupConnection(ListenerOps * listener, const AddressPair *pair);
 static Message *_readMessage(ListenerOps * listener, int fd, uint8_t *msgBuffer);
 static void _hicnListener_readcb(int fd, PARCEventType what, void *listener_void);
+#ifdef WITH_IO_URING
+static void _hicnListener_receivecb(int fd, uint8_t *packet, size_t length,
+                                    const struct sockaddr *peer,
+                                    socklen_t peerLength, void *listener_void);
+#endif /* WITH_IO_URING */
 static Address *_createAddressFromPacket(uint8_t *msgBuffer);
-static void _handleWldrNotification(ListenerOps *listener, uint8_t *msgBuffer);
+static void _handleWldrNotification(ListenerOps *listener, uint8_t *msgBuffer,
+                                    size_t length);
 static void _readFrameToDiscard(HicnListener *hicn, int fd);
 
 static ListenerOps _hicnTemplate = {
@@ -121,17 +130,11 @@ static bool _isEmptyAddressIPv6(Address *address) {
   return res;
 }
 
-static Message *_readMessage(ListenerOps * listener, int fd, uint8_t *msgBuffer) {
+static Message *_processMessage(ListenerOps *listener, int fd,
+                                uint8_t *msgBuffer, size_t readLength) {
   HicnListener * hicn = (HicnListener*)listener->context;
   Message *message = NULL;
 
-  ssize_t readLength = read(fd, msgBuffer, MTU_SIZE);
-
-  if (readLength < 0) {
-    printf("read failed %d: (%d) %s\n", fd, errno, strerror(errno));
-    return message;
-  }
-
   size_t packetLength = messageHandler_GetTotalPacketLength(msgBuffer);
 
   if (readLength != packetLength) {
@@ -180,15 +183,27 @@ static Message *_readMessage(ListenerOps * listener, int fd, uint8_t *msgBuffer)
       parcMemory_Deallocate((void **)&msgBuffer);
     }
   } else if (messageHandler_IsWldrNotification(msgBuffer)) {
-    _handleWldrNotification(listener, msgBuffer);
+    _handleWldrNotification(listener, msgBuffer, readLength);
   } else {
-    messageHandler_handleHooks(hicn->forwarder, msgBuffer, listener, fd, NULL);
+    messageHandler_handleHooks(hicn->forwarder, msgBuffer, readLength,
+                               listener, fd, NULL);
     parcMemory_Deallocate((void **)&msgBuffer);
   }
 
   return message;
 }
 
+static Message *_readMessage(ListenerOps * listener, int fd, uint8_t *msgBuffer) {
+  ssize_t readLength = read(fd, msgBuffer, MTU_SIZE);
+
+  if (readLength < 0) {
+    printf("read failed %d: (%d) %s\n", fd, errno, strerror(errno));
+    return NULL;
+  }
+
+  return _processMessage(listener, fd, msgBuffer, readLength);
+}
+
 static void _receivePacket(ListenerOps * listener, int fd) {
   HicnListener * hicn = (HicnListener*)listener->context;
   Message *msg = NULL;
@@ -213,6 +228,37 @@ static void _hicnListener_readcb(int fd, PARCEventType what, void *listener_void
   }
 }
 
+#ifdef WITH_IO_URING
+static void _hicnListener_receivecb(int fd, uint8_t *packet, size_t length,
+                                    const struct sockaddr *peer,
+                                    socklen_t peerLength, void *listener_void) {
+  ListenerOps *listener = (ListenerOps *)listener_void;
+  HicnListener *hicn = (HicnListener *)listener->context;
+
+  Message *msg = _processMessage(listener, fd, packet, length);
+  if (msg) {
+    forwarder_Receive(hicn->forwarder, msg);
+  }
+}
+#endif /* WITH_IO_URING */
+
+static void _hicnListener_StartReceiving(HicnListener *hicn,
+                                         ListenerOps *ops) {
+  Dispatcher *dispatcher = forwarder_GetDispatcher(hicn->forwarder);
+
+#ifdef WITH_IO_URING
+  hicn->hicn_receiver = dispatcher_CreateReceiver(
+      dispatcher, hicn->hicn_fd, false, _hicnListener_receivecb, (void *)ops);
+  if (hicn->hicn_receiver) {
+    return;
+  }
+#endif /* WITH_IO_URING */
+
+  hicn->hicn_event = dispatcher_CreateNetworkEvent(
+      dispatcher, true, _hicnListener_readcb, (void *)ops, hicn->hicn_fd);
+  dispatcher_StartNetworkEvent(dispatcher, hicn->hicn_event);
+}
+
 static bool _isEmptyAddressIPv4(Address *address) {
   bool res = false;
 
@@ -288,11 +334,7 @@ ListenerOps *hicnListener_CreateInet(Forwarder *forwarder, char *symbolic,
   memcpy(ops, &_hicnTemplate, sizeof(ListenerOps));
   ops->context = hicn;
 
-  hicn->hicn_event = dispatcher_CreateNetworkEvent(
-      forwarder_GetDispatcher(forwarder), true, _hicnListener_readcb,
-      (void *)ops, hicn->hicn_fd);
-  dispatcher_StartNetworkEvent(forwarder_GetDispatcher(forwarder),
-                               hicn->hicn_event);
+  _hicnListener_StartReceiving(hicn, ops);
 
 
   if (logger_IsLoggable(hicn->logger, LoggerFacility_IO, PARCLogLevel_Debug)) {
@@ -381,11 +423,7 @@ ListenerOps *hicnListener_CreateInet6(Forwarder *forwarder, char *symbolic,
   memcpy(ops, &_hicnTemplate, sizeof(ListenerOps));
   ops->context = hicn;
 
-  hicn->hicn_event = dispatcher_CreateNetworkEvent(
-      forwarder_GetDispatcher(forwarder), true, _hicnListener_readcb,
-      (void *)ops, hicn->hicn_fd);
-  dispatcher_StartNetworkEvent(forwarder_GetDispatcher(forwarder),
-                               hicn->hicn_event);
+  _hicnListener_StartReceiving(hicn, ops);
 
   if (logger_IsLoggable(hicn->logger, LoggerFacility_IO, PARCLogLevel_Debug)) {
     logger_Log(hicn->logger, LoggerFacility_IO, PARCLogLevel_Debug, __func__,
@@ -512,8 +550,16 @@ static void _hicnListener_Destroy(HicnListener **listenerPtr) {
 
   HicnListener *hicn = *listenerPtr;
 
-  dispatcher_DestroyNetworkEvent(forwarder_GetDispatcher(hicn->forwarder),
-                                 &hicn->hicn_event);
+#ifdef WITH_IO_URING
+  if (hicn->hicn_receiver) {
+    dispatcher_DestroyReceiver(forwarder_GetDispatcher(hicn->forwarder),
+                               &hicn->hicn_receiver);
+  }
+#endif /* WITH_IO_URING */
+  if (hicn->hicn_event) {
+    dispatcher_DestroyNetworkEvent(forwarder_GetDispatcher(hicn->forwarder),
+                                   &hicn->hicn_event);
+  }
   logger_Release(&hicn->logger);
   addressDestroy(&hicn->localAddress);
   parcMemory_Deallocate((void **)&hicn);
@@ -640,7 +686,8 @@ static Address *_createAddressFromPacket(uint8_t *msgBuffer) {
   return packetAddr;
 }
 
-static void _handleWldrNotification(ListenerOps *listener, uint8_t *msgBuffer) {
+static void _handleWldrNotification(ListenerOps *listener, uint8_t *msgBuffer,
+                                    size_t length) {
   HicnListener * hicn = (HicnListener *)listener->context;
 
   Address *packetAddr = _createAddressFromPacket(msgBuffer);
@@ -667,7 +714,7 @@ static void _handleWldrNotification(ListenerOps *listener, uint8_t *msgBuffer) {
       MessagePacketType_WldrNotification, forwarder_GetTicks(hicn->forwarder),
       forwarder_GetLogger(hicn->forwarder));
 
-  connection_HandleWldrNotification((Connection *)conn, message);
+  connection_HandleWldrNotification((Connection *)conn, message, length);
 
   message_Release(&message);
 }
@@ -282,6 +282,16 @@ static bool _send(IoOperations *ops, const Address *dummy, Message *message) {
   // in this particular connection we don't need natting beacause we send the
   // packet to the next hop using upd connection
 
+#ifdef WITH_IO_URING
+  if (dispatcher_Send(forwarder_GetDispatcher(udpConnState->forwarder),
+                      udpConnState->udpListenerSocket,
+                      message_FixedHeader(message), message_Length(message),
+                      udpConnState->peerAddress,
+                      udpConnState->peerAddressLength)) {
+    return true;
+  }
+#endif /* WITH_IO_URING */
+
   ssize_t writeLength =
       sendto(udpConnState->udpListenerSocket, message_FixedHeader(message),
              (int)message_Length(message), 0, udpConnState->peerAddress,
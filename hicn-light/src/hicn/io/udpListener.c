@@ -45,6 +45,9 @@ struct udp_listener {
   Logger *logger;
 
   PARCEvent *udp_event;
+#ifdef WITH_IO_URING
+  DispatcherReceiver *udp_receiver;
+#endif /* WITH_IO_URING */
   SocketType udp_socket;
   uint16_t port;
 
@@ -78,6 +81,27 @@ static ListenerOps udpTemplate = {
 
 
 static void _readcb(int fd, PARCEventType what, void * listener_void);
+#ifdef WITH_IO_URING
+static void _receivecb(int fd, uint8_t *packet, size_t length,
+                       const struct sockaddr *peer, socklen_t peerLength,
+                       void *listener_void);
+#endif /* WITH_IO_URING */
+
+static void _startReceiving(UdpListener *udp, ListenerOps *ops) {
+  Dispatcher *dispatcher = forwarder_GetDispatcher(udp->forwarder);
+
+#ifdef WITH_IO_URING
+  udp->udp_receiver = dispatcher_CreateReceiver(dispatcher, udp->udp_socket,
+                                                true, _receivecb, (void *)ops);
+  if (udp->udp_receiver) {
+    return;
+  }
+#endif /* WITH_IO_URING */
+
+  udp->udp_event = dispatcher_CreateNetworkEvent(dispatcher, true, _readcb,
+                                                 (void *)ops, udp->udp_socket);
+  dispatcher_StartNetworkEvent(dispatcher, udp->udp_event);
+}
 
 #ifdef __ANDROID__
 extern int bindSocket(int sock, const char* ifname);
@@ -168,11 +192,7 @@ ListenerOps *udpListener_CreateInet6(Forwarder *forwarder, char *listenerName,
     memcpy(ops, &udpTemplate, sizeof(ListenerOps));
     ops->context = udp;
 
-    udp->udp_event =
-        dispatcher_CreateNetworkEvent(forwarder_GetDispatcher(forwarder), true,
-                                      _readcb, (void*)ops, udp->udp_socket);
-    dispatcher_StartNetworkEvent(forwarder_GetDispatcher(forwarder),
-                                 udp->udp_event);
+    _startReceiving(udp, ops);
 
     if (logger_IsLoggable(udp->logger, LoggerFacility_IO, PARCLogLevel_Debug)) {
       char *str = addressToString(udp->localAddress);
@@ -286,11 +306,7 @@ ListenerOps *udpListener_CreateInet(Forwarder *forwarder, char *listenerName,
     memcpy(ops, &udpTemplate, sizeof(ListenerOps));
     ops->context = udp;
 
-    udp->udp_event =
-        dispatcher_CreateNetworkEvent(forwarder_GetDispatcher(forwarder), true,
-                                      _readcb, (void *)ops, udp->udp_socket);
-    dispatcher_StartNetworkEvent(forwarder_GetDispatcher(forwarder),
-                                 udp->udp_event);
+    _startReceiving(udp, ops);
 
 
     if (logger_IsLoggable(udp->logger, LoggerFacility_IO, PARCLogLevel_Debug)) {
@@ -344,8 +360,16 @@ static void udpListener_Destroy(UdpListener **listenerPtr) {
 #endif
 
   addressDestroy(&udp->localAddress);
-  dispatcher_DestroyNetworkEvent(forwarder_GetDispatcher(udp->forwarder),
-                                 &udp->udp_event);
+#ifdef WITH_IO_URING
+  if (udp->udp_receiver) {
+    dispatcher_DestroyReceiver(forwarder_GetDispatcher(udp->forwarder),
+                               &udp->udp_receiver);
+  }
+#endif /* WITH_IO_URING */
+  if (udp->udp_event) {
+    dispatcher_DestroyNetworkEvent(forwarder_GetDispatcher(udp->forwarder),
+                                   &udp->udp_event);
+  }
   logger_Release(&udp->logger);
   parcMemory_Deallocate((void **)&udp);
   *listenerPtr = NULL;
@@ -477,7 +501,7 @@ static unsigned _createNewConnection(ListenerOps * listener, int fd,
 }
 
 static void _handleWldrNotification(UdpListener *udp, unsigned connId,
-                                    uint8_t *msgBuffer) {
+                                    uint8_t *msgBuffer, size_t length) {
   const Connection *conn = connectionTable_FindById(
       forwarder_GetConnectionTable(udp->forwarder), connId);
   if (conn == NULL) {
@@ -489,13 +513,14 @@ static void _handleWldrNotification(UdpListener *udp, unsigned connId,
       connId, msgBuffer, MessagePacketType_WldrNotification,
       forwarder_GetTicks(udp->forwarder), forwarder_GetLogger(udp->forwarder));
 
-  connection_HandleWldrNotification((Connection *)conn, message);
+  connection_HandleWldrNotification((Connection *)conn, message, length);
 
   message_Release(&message);
 }
 
 static Message *_readMessage(ListenerOps * listener, int fd,
-                      AddressPair *pair, uint8_t * packet, bool * processed) {
+                      AddressPair *pair, uint8_t * packet, size_t length,
+                      bool * processed) {
   UdpListener * udp = (UdpListener *)listener->context;
 
   Message *message = NULL;
@@ -542,10 +567,11 @@ static Message *_readMessage(ListenerOps * listener, int fd,
     }
   } else if (messageHandler_IsWldrNotification(packet)) {
     *processed = true;
-    _handleWldrNotification(udp, connid, packet);
+    _handleWldrNotification(udp, connid, packet, length);
   } else {
 
-    *processed = messageHandler_handleHooks(udp->forwarder, packet, listener, fd, pair);
+    *processed = messageHandler_handleHooks(udp->forwarder, packet, length,
+                                            listener, fd, pair);
   }
 
   return message;
@@ -597,17 +623,32 @@ static void _readCommand(ListenerOps * listener, int fd,
 
 static bool _receivePacket(ListenerOps * listener, int fd,
                            AddressPair *pair,
-                           uint8_t * packet) {
+                           uint8_t * packet, size_t length) {
   UdpListener * udp = (UdpListener *)listener->context;
   bool processed = false;
   Message *message = _readMessage(listener, fd, pair,
-                                   packet, &processed);
+                                   packet, length, &processed);
   if (message) {
     forwarder_Receive(udp->forwarder, message);
   }
   return processed;
 }
 
+static void _receiveDatagram(ListenerOps *listener, int fd,
+                             struct sockaddr *peer, socklen_t peerLength,
+                             uint8_t *packet, size_t length) {
+  UdpListener *udp = (UdpListener *)listener->context;
+
+  AddressPair *pair = _constructAddressPair(udp, peer, peerLength);
+
+  bool done = _receivePacket(listener, fd, pair, packet, length);
+  if(!done){
+    _readCommand(listener, fd, pair, packet);
+  }
+
+  addressPair_Release(&pair);
+}
+
 static void _readcb(int fd, PARCEventType what, void * listener_void) {
   ListenerOps * listener = (ListenerOps *)listener_void;
   UdpListener * udp = (UdpListener *)listener->context;
@@ -640,14 +681,16 @@ static void _readcb(int fd, PARCEventType what, void * listener_void) {
       return;
     }
 
-    AddressPair *pair = _constructAddressPair(
-      udp, (struct sockaddr *)&peerIpAddress, peerIpAddressLength);
-
-    bool done = _receivePacket(listener, fd, pair, packet);
-    if(!done){
-      _readCommand(listener, fd, pair, packet);
-    }
-
-    addressPair_Release(&pair);
+    _receiveDatagram(listener, fd, (struct sockaddr *)&peerIpAddress,
+                     peerIpAddressLength, packet, (size_t)readLength);
   }
 }
+
+#ifdef WITH_IO_URING
+static void _receivecb(int fd, uint8_t *packet, size_t length,
+                       const struct sockaddr *peer, socklen_t peerLength,
+                       void *listener_void) {
+  _receiveDatagram((ListenerOps *)listener_void, fd, (struct sockaddr *)peer,
+                   peerLength, packet, length);
+}
+#endif /* WITH_IO_URING */
@@ -44,19 +44,30 @@
 #include <hicn/core/mapme.h>
 #endif /* WITH_MAPME */
 
+#include <math.h>
+
 #define ALPHA 0.5
 
+// Policy statistics are computed when they are read, as if they had been
+// refreshed every POLICY_STATS_INTERVAL since the previous read
+#define POLICY_STATS_INTERVAL 1000 /* ms */
+
 #endif /* WITH_POLICY */
 
 struct fib_entry {
   Name *name;
   unsigned refcount;
   StrategyImpl *fwdStrategy;
+  // Points to the prefix directory slot if any, to localCounters otherwise
+  hicn_light_stats_prefix_counters_t *counters;
+  hicn_light_stats_prefix_counters_t localCounters;
 #ifdef WITH_POLICY
   NumberSet *nexthops;
   const Forwarder * forwarder;
   hicn_policy_t policy;
   policy_counters_t policy_counters;
+  // Slot in the prefix directory of the statistics segment, -1 if none
+  int statsSlot;
 //  NumberSet *available_nexthops;
 #ifdef WITH_MAPME
   /* In case of no multipath, this stores the previous decision taken by policy */
@@ -70,6 +81,35 @@ struct fib_entry {
 #endif /* WITH_MAPME */
 };
 
+#ifdef WITH_POLICY
+static void _fibEntry_AddPrefixStats(FibEntry *fibEntry) {
+  StatsSegmentWriter *statsSegment =
+      forwarder_GetStatsSegment(fibEntry->forwarder);
+
+  NameBitvector *prefix = name_GetContentName(fibEntry->name);
+  ip_prefix_t ip_prefix;
+  char name[HICN_LIGHT_STATS_PREFIX_NAME_SIZE] = "";
+
+  nameBitvector_ToIPAddress(prefix, &ip_prefix);
+  ip_prefix.len = nameBitvector_GetLength(prefix);
+  ip_prefix_ntop(&ip_prefix, name, sizeof(name));
+
+  fibEntry->statsSlot = statsSegmentWriter_AddPrefix(
+      statsSegment, name, fibEntry_GetFwdStrategyType(fibEntry));
+  if (fibEntry->statsSlot >= 0) {
+    fibEntry->counters =
+        statsSegmentWriter_GetPrefixCounters(statsSegment, fibEntry->statsSlot);
+  }
+}
+
+static void _fibEntry_UpdatePrefixStats(const FibEntry *fibEntry) {
+  statsSegmentWriter_UpdatePrefix(
+      forwarder_GetStatsSegment(fibEntry->forwarder), fibEntry->statsSlot,
+      (unsigned)numberSet_Length(fibEntry->nexthops),
+      fibEntry_GetFwdStrategyType(fibEntry));
+}
+#endif /* WITH_POLICY */
+
 #ifdef WITH_POLICY
 FibEntry *fibEntry_Create(Name *name, strategy_type fwdStrategy, const Forwarder * forwarder) {
 #else
@@ -100,6 +140,7 @@ FibEntry *fibEntry_Create(Name *name, strategy_type fwdStrategy) {
   }
 
   fibEntry->refcount = 1;
+  fibEntry->counters = &fibEntry->localCounters;
 
 #ifdef WITH_MAPME
   fibEntry->userDataOwner = NULL;
@@ -112,6 +153,8 @@ FibEntry *fibEntry_Create(Name *name, strategy_type fwdStrategy) {
   fibEntry->forwarder = forwarder;
   fibEntry->policy = POLICY_NONE;
   fibEntry->policy_counters = POLICY_COUNTERS_NONE;
+  fibEntry->policy_counters.last_update = forwarder_GetTicks(forwarder);
+  _fibEntry_AddPrefixStats(fibEntry);
 #endif /* WITH_POLICY */
 
   if(fwdStrategy == SET_STRATEGY_LOW_LATENCY){
@@ -143,6 +186,8 @@ void fibEntry_Release(FibEntry **fibEntryPtr) {
 #endif /* WITH_MAPME */
 #ifdef WITH_POLICY
   numberSet_Release(&fibEntry->nexthops);
+  statsSegmentWriter_RemovePrefix(
+      forwarder_GetStatsSegment(fibEntry->forwarder), fibEntry->statsSlot);
 #endif /* WITH_POLICY */
     parcMemory_Deallocate((void **)&fibEntry);
   }
@@ -188,6 +233,9 @@ void fibEntry_SetStrategy(FibEntry *fibEntry, strategy_type strategy,
   }
   fibEntry->fwdStrategy->destroy(&(fibEntry->fwdStrategy));
   fibEntry->fwdStrategy = fwdStrategyImpl;
+#ifdef WITH_POLICY
+  _fibEntry_UpdatePrefixStats(fibEntry);
+#endif /* WITH_POLICY */
 }
 
 #ifdef WITH_POLICY
@@ -498,6 +546,7 @@ void fibEntry_AddNexthop(FibEntry *fibEntry, unsigned connectionId) {
 #ifdef WITH_POLICY
   if (!numberSet_Contains(fibEntry->nexthops, connectionId)) {
     numberSet_Add(fibEntry->nexthops, connectionId);
+    _fibEntry_UpdatePrefixStats(fibEntry);
   }
 #endif /* WITH_POLICY */
   fibEntry->fwdStrategy->addNexthop(fibEntry->fwdStrategy, connectionId);
@@ -509,6 +558,7 @@ void fibEntry_RemoveNexthopByConnectionId(FibEntry *fibEntry,
 #ifdef WITH_POLICY
   if (numberSet_Contains(fibEntry->nexthops, connectionId)) {
     numberSet_Remove(fibEntry->nexthops, connectionId);
+    _fibEntry_UpdatePrefixStats(fibEntry);
   }
 #endif /* WITH_POLICY */
   fibEntry->fwdStrategy->removeNexthop(fibEntry->fwdStrategy, connectionId);
@@ -551,6 +601,7 @@ const NumberSet *fibEntry_GetNexthopsFromForwardingStrategy(
   NumberSet * available_nexthops = fibEntry_GetAvailableNextHops(fibEntry, in_connection);
   if (numberSet_Length(available_nexthops) == 0) {
     numberSet_Release(&available_nexthops);
+    fibEntry->counters->droppedNoNexthop++;
     out = numberSet_Create();
     return out;
   }
@@ -597,12 +648,19 @@ const NumberSet *fibEntry_GetNexthopsFromForwardingStrategy(
   }
 
   numberSet_Release(&available_nexthops);
-
-  return out;
 #else
-  return fibEntry->fwdStrategy->lookupNexthop(fibEntry->fwdStrategy,
+  NumberSet *out = fibEntry->fwdStrategy->lookupNexthop(fibEntry->fwdStrategy,
           interestMessage);
 #endif /* WITH_POLICY */
+
+  if (numberSet_Length(out) == 0) {
+    fibEntry->counters->droppedNoNexthop++;
+  } else {
+    fibEntry->counters->interestsForwarded++;
+    fibEntry->counters->bytesForwarded += message_Length(interestMessage);
+  }
+
+  return out;
 }
 
 #ifdef WITH_POLICY
@@ -616,6 +674,15 @@ void fibEntry_ReceiveObjectMessage(const FibEntry *fibEntry,
                                    Ticks objReception) {
   parcAssertNotNull(fibEntry, "Parameter fibEntry must be non-null");
 
+  // Probes are not matched against the PIT and have no creation time
+  if (pitEntryCreation != 0) {
+    fibEntry->counters->objectsReceived++;
+    fibEntry->counters->bytesReceived += message_Length(objectMessage);
+    fibEntry->counters->interestsSatisfied++;
+    fibEntry->counters->satisfactionLatency +=
+        objReception - pitEntryCreation;
+  }
+
 #ifdef WITH_POLICY
   ConnectionTable * table = forwarder_GetConnectionTable(fibEntry->forwarder);
 
@@ -677,6 +744,8 @@ void fibEntry_OnTimeout(const FibEntry *fibEntry, const NumberSet *egressId) {
 #endif /* WITH_POLICY */
   parcAssertNotNull(fibEntry, "Parameter fibEntry must be non-null");
 
+  fibEntry->counters->timeouts++;
+
 #ifdef WITH_POLICY
 
   ConnectionTable * table = forwarder_GetConnectionTable(fibEntry->forwarder);
@@ -705,13 +774,42 @@ void fibEntry_OnTimeout(const FibEntry *fibEntry, const NumberSet *egressId) {
 }
 
 #ifdef WITH_POLICY
+/*
+ * latency_idle holds the time without data since the first read that
+ * followed the last data: the latency is reset once it exceeds
+ * POLICY_STATS_INTERVAL, whatever the rate of the reads.
+ */
+static void _fibEntry_UpdateLatencyIdle(interface_counters_t *counters,
+                                        interface_stats_t *stats,
+                                        uint64_t elapsed) {
+  if (counters->latency_idle == 0) {
+    counters->latency_idle = 1;
+    return;
+  }
+
+  if (elapsed > UINT32_MAX - counters->latency_idle)
+    counters->latency_idle = UINT32_MAX;
+  else
+    counters->latency_idle += (uint32_t)elapsed;
+
+  if (counters->latency_idle > POLICY_STATS_INTERVAL)
+    stats->latency = 0;
+}
+
 void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now) {
   double throughput;
   double loss_rate;
+  double alpha;
+  uint64_t elapsed;
 
   if (now == fibEntry->policy_counters.last_update)
       return ;
 
+  // Weigh the history by the time elapsed since the previous read, in
+  // POLICY_STATS_INTERVAL units
+  elapsed = now - fibEntry->policy_counters.last_update;
+  alpha = pow(ALPHA, (double)elapsed / POLICY_STATS_INTERVAL);
+
   /* WIRED */
 
   /*  a) throughput */
@@ -725,8 +823,8 @@ void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now) {
     throughput = 0;
   }
   fibEntry->policy.stats.wired.throughput = (float)(\
-        ALPHA     * fibEntry->policy.stats.wired.throughput + \
-        (1-ALPHA) * throughput);
+        alpha     * fibEntry->policy.stats.wired.throughput + \
+        (1-alpha) * throughput);
 
   /* b) loss rate */
   if ((fibEntry->policy_counters.wired.num_losses > 0) && \
@@ -738,22 +836,18 @@ void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now) {
       loss_rate = 0;
   }
   fibEntry->policy.stats.wired.loss_rate = (float)(\
-        ALPHA     * fibEntry->policy.stats.wired.loss_rate + \
-        (1-ALPHA) * loss_rate);
+        alpha     * fibEntry->policy.stats.wired.loss_rate + \
+        (1-alpha) * loss_rate);
 
   /* Latency */
-  fibEntry->policy_counters.wired.latency_idle++;
-  if (fibEntry->policy_counters.wired.latency_idle > 1)
-      fibEntry->policy.stats.wired.latency = 0;
-  fibEntry->policy_counters.wifi.latency_idle++;
-  if (fibEntry->policy_counters.wifi.latency_idle > 1)
-      fibEntry->policy.stats.wifi.latency = 0;
-  fibEntry->policy_counters.cellular.latency_idle++;
-  if (fibEntry->policy_counters.cellular.latency_idle > 1)
-      fibEntry->policy.stats.cellular.latency = 0;
-  fibEntry->policy_counters.all.latency_idle++;
-  if (fibEntry->policy_counters.all.latency_idle > 1)
-      fibEntry->policy.stats.all.latency = 0;
+  _fibEntry_UpdateLatencyIdle(&fibEntry->policy_counters.wired,
+                              &fibEntry->policy.stats.wired, elapsed);
+  _fibEntry_UpdateLatencyIdle(&fibEntry->policy_counters.wifi,
+                              &fibEntry->policy.stats.wifi, elapsed);
+  _fibEntry_UpdateLatencyIdle(&fibEntry->policy_counters.cellular,
+                              &fibEntry->policy.stats.cellular, elapsed);
+  _fibEntry_UpdateLatencyIdle(&fibEntry->policy_counters.all,
+                              &fibEntry->policy.stats.all, elapsed);
 
   fibEntry->policy_counters.wired.num_bytes = 0;
   fibEntry->policy_counters.wired.num_losses = 0;
@@ -772,8 +866,8 @@ void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now) {
     throughput = 0;
   }
   fibEntry->policy.stats.wifi.throughput = (float)( \
-        ALPHA     * fibEntry->policy.stats.wifi.throughput + \
-        (1-ALPHA) * throughput);
+        alpha     * fibEntry->policy.stats.wifi.throughput + \
+        (1-alpha) * throughput);
 
   /* b) loss rate */
   if ((fibEntry->policy_counters.wifi.num_losses > 0) && \
@@ -785,8 +879,8 @@ void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now) {
       loss_rate = 0;
   }
   fibEntry->policy.stats.wifi.loss_rate = (float)(\
-        ALPHA     * fibEntry->policy.stats.wifi.loss_rate + \
-        (1-ALPHA) * loss_rate);
+        alpha     * fibEntry->policy.stats.wifi.loss_rate + \
+        (1-alpha) * loss_rate);
 
   fibEntry->policy_counters.wifi.num_bytes = 0;
   fibEntry->policy_counters.wifi.num_losses = 0;
@@ -805,8 +899,8 @@ void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now) {
     throughput = 0;
   }
   fibEntry->policy.stats.cellular.throughput = (float)( \
-        ALPHA     * fibEntry->policy.stats.cellular.throughput + \
-        (1-ALPHA) * throughput);
+        alpha     * fibEntry->policy.stats.cellular.throughput + \
+        (1-alpha) * throughput);
 
   /* b) loss rate */
   if ((fibEntry->policy_counters.cellular.num_losses > 0) && \
@@ -818,8 +912,8 @@ void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now) {
       loss_rate = 0;
   }
   fibEntry->policy.stats.cellular.loss_rate = (float)( \
-        ALPHA     * fibEntry->policy.stats.cellular.loss_rate + \
-        (1-ALPHA) * loss_rate);
+        alpha     * fibEntry->policy.stats.cellular.loss_rate + \
+        (1-alpha) * loss_rate);
 
   fibEntry->policy_counters.cellular.num_bytes = 0;
   fibEntry->policy_counters.cellular.num_losses = 0;
@@ -838,8 +932,8 @@ void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now) {
     throughput = 0;
   }
   fibEntry->policy.stats.all.throughput = (float)(\
-        ALPHA     * fibEntry->policy.stats.all.throughput + \
-        (1-ALPHA) * throughput);
+        alpha     * fibEntry->policy.stats.all.throughput + \
+        (1-alpha) * throughput);
 
   /* b) loss rate */
   if ((fibEntry->policy_counters.all.num_losses > 0) && \
@@ -851,8 +945,8 @@ void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now) {
       loss_rate = 0;
   }
   fibEntry->policy.stats.all.loss_rate = (float)(\
-        ALPHA     * fibEntry->policy.stats.all.loss_rate + \
-        (1-ALPHA) * loss_rate);
+        alpha     * fibEntry->policy.stats.all.loss_rate + \
+        (1-alpha) * loss_rate);
 
   fibEntry->policy_counters.all.num_bytes = 0;
   fibEntry->policy_counters.all.num_losses = 0;
@@ -876,6 +970,12 @@ StrategyImpl *fibEntry_GetFwdStrategy(const FibEntry *fibEntry) {
   return fibEntry->fwdStrategy;
 }
 
+const hicn_light_stats_prefix_counters_t *fibEntry_GetCounters(
+    const FibEntry *fibEntry) {
+  parcAssertNotNull(fibEntry, "Parameter fibEntry must be non-null");
+  return fibEntry->counters;
+}
+
 #ifdef WITH_MAPME
 
 void *fibEntry_getUserData(const FibEntry *fibEntry) {
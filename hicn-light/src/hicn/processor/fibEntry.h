@@ -38,6 +38,7 @@
 #define fibEntry_h
 
 #include <hicn/core/name.h>
+#include <hicn/stats/statsSegment.h>
 #include <hicn/strategies/strategyImpl.h>
 
 #ifdef WITH_POLICY
@@ -113,6 +114,10 @@ void fibEntry_ReceiveObjectMessage(const FibEntry *fibEntry,
 hicn_policy_t fibEntry_GetPolicy(const FibEntry *fibEntry);
 void fibEntry_ReconsiderPolicy(FibEntry *fibEntry);
 void fibEntry_SetPolicy(FibEntry *fibEntry, hicn_policy_t policy);
+/**
+ * Refresh the policy statistics from the counters accumulated since the
+ * previous call. Statistics are computed lazily, when they are read.
+ */
 void fibEntry_UpdateStats(FibEntry *fibEntry, uint64_t now);
 NumberSet * fibEntry_GetAvailableNextHops(const FibEntry *fibEntry, unsigned in_connection);
 NumberSet * fibEntry_GetPreviousNextHops(const FibEntry *fibEntry);
@@ -133,6 +138,16 @@ strategy_type fibEntry_GetFwdStrategyType(const FibEntry *fibEntry);
 
 StrategyImpl *fibEntry_GetFwdStrategy(const FibEntry *fibEntry);
 
+/**
+ * @function fibEntry_GetCounters
+ * @abstract Traffic counters of the entry
+ * @discussion
+ *   The counters are exported in the statistics segment when the entry has a
+ *   slot in the prefix directory, and kept in the entry otherwise.
+ */
+const hicn_light_stats_prefix_counters_t *fibEntry_GetCounters(
+    const FibEntry *fibEntry);
+
 /**
  * @function fibEntry_GetPrefix
  * @abstract Returns a copy of the prefix.
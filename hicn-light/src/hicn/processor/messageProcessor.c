@@ -14,13 +14,13 @@
  */
 
 #include <hicn/hicn-light/config.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
 #include <parc/algol/parc_ArrayList.h>
 #include <parc/algol/parc_Memory.h>
 #ifdef WITH_POLICY
-#include <parc/algol/parc_EventTimer.h>
 #ifdef WITH_MAPME
 #include <hicn/core/connection.h>
 #endif /* WITH_MAPME */
@@ -33,8 +33,11 @@
 #include <hicn/content_store/contentStoreInterface.h>
 #include <hicn/content_store/contentStoreLRU.h>
 
+#include <hicn/stats/statsSegmentWriter.h>
+
 #include <hicn/strategies/loadBalancer.h>
 #include <hicn/strategies/lowLatency.h>
+#include <hicn/strategies/probeService.h>
 #include <hicn/strategies/rnd.h>
 #include <hicn/strategies/strategyImpl.h>
 
@@ -49,10 +52,6 @@
 #include <hicn/utils/address.h>
 #include <hicn/core/messageHandler.h>
 
-#ifdef WITH_POLICY
-#define STATS_INTERVAL 1000 /* ms */
-#endif /* WITH_POLICY */
-
 /*
  * Copyright (c) 2017-2019 Cisco and/or its affiliates.
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -67,31 +66,6 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-typedef struct processor_stats {
-  uint32_t countReceived;
-  uint32_t countInterestsReceived;
-  uint32_t countObjectsReceived;
-
-  uint32_t countInterestsAggregated;
-
-  uint32_t countDropped;
-  uint32_t countInterestsDropped;
-  uint32_t countDroppedNoRoute;
-  uint32_t countDroppedNoReversePath;
-
-  uint32_t countDroppedConnectionNotFound;
-  uint32_t countObjectsDropped;
-
-  uint32_t countSendFailures;
-  uint32_t countInterestForwarded;
-  uint32_t countObjectsForwarded;
-  uint32_t countInterestsSatisfiedFromStore;
-
-  uint32_t countDroppedNoHopLimit;
-  uint32_t countDroppedZeroHopLimitFromRemote;
-  uint32_t countDroppedZeroHopLimitToRemote;
-} _ProcessorStats;
-
 struct message_processor {
   Forwarder *forwarder;
   Logger *logger;
@@ -103,11 +77,9 @@ struct message_processor {
   bool store_in_cache;
   bool serve_from_cache;
 
-  _ProcessorStats stats;
-
-#ifdef WITH_POLICY
-  void * timer;
-#endif /* WITH_POLICY */
+  // Counters live in the statistics segment owned by the forwarder
+  StatsSegmentWriter *statsSegment;
+  hicn_light_stats_processor_t *stats;
 };
 
 static void messageProcessor_Drop(MessageProcessor *processor,
@@ -127,25 +99,6 @@ static void messageProcessor_ForwardToInterfaceId(MessageProcessor *processor,
 // ============================================================
 // Public API
 
-#ifdef WITH_POLICY
-static void
-messageProcessor_Tick(int fd, PARCEventType type, void *user_data)
-{
-  MessageProcessor *processor = (MessageProcessor*)user_data;
-  uint64_t now = (uint64_t)forwarder_GetTicks(processor->forwarder);
-
-  /* Loop over FIB entries to compute statistics from counters */
-  FibEntryList *fibList = forwarder_GetFibEntries(processor->forwarder);
-
-  for (size_t i = 0; i < fibEntryList_Length(fibList); i++) {
-    FibEntry *entry = (FibEntry *)fibEntryList_Get(fibList, i);
-    fibEntry_UpdateStats(entry, now);
-  }
-
-  fibEntryList_Destroy(&fibList);
-}
-#endif /* WITH_POLICY */
-
 MessageProcessor *messageProcessor_Create(Forwarder *forwarder) {
   size_t objectStoreSize =
       configuration_GetObjectStoreSize(forwarder_GetConfiguration(forwarder));
@@ -158,6 +111,9 @@ MessageProcessor *messageProcessor_Create(Forwarder *forwarder) {
 
   processor->forwarder = forwarder;
   processor->logger = logger_Acquire(forwarder_GetLogger(forwarder));
+  processor->statsSegment = forwarder_GetStatsSegment(forwarder);
+  processor->stats =
+      statsSegmentWriter_GetProcessorStats(processor->statsSegment);
   processor->pit = pitStandard_Create(forwarder);
 
   processor->fib = fib_Create(forwarder);
@@ -170,6 +126,7 @@ MessageProcessor *messageProcessor_Create(Forwarder *forwarder) {
 
   ContentStoreConfig contentStoreConfig = {
       .objectCapacity = objectStoreSize,
+      .stats = statsSegmentWriter_GetContentStoreStats(processor->statsSegment),
   };
 
   processor->contentStore =
@@ -181,20 +138,6 @@ MessageProcessor *messageProcessor_Create(Forwarder *forwarder) {
   processor->store_in_cache = true;
   processor->serve_from_cache = true;
 
-#ifdef WITH_POLICY
-  /* Create statistics timer */
-  Dispatcher *dispatcher = forwarder_GetDispatcher(forwarder);
-  if (!dispatcher)
-    goto ERR;
-  processor->timer = dispatcher_CreateTimer(dispatcher, /* repeat */ true,
-          messageProcessor_Tick, processor);
-  if (!processor->timer)
-      goto ERR;
-  struct timeval timeout = {STATS_INTERVAL / 1000, (STATS_INTERVAL % 1000) * 1000};
-  dispatcher_StartTimer(dispatcher, processor->timer, &timeout);
-ERR:
-#endif /* WITH_POLICY */
-
   return processor;
 }
 
@@ -203,8 +146,10 @@ void messageProcessor_SetContentObjectStoreSize(
   parcAssertNotNull(processor, "Parameter processor must be non-null");
   contentStoreInterface_Release(&processor->contentStore);
 
-  ContentStoreConfig contentStoreConfig = {.objectCapacity =
-                                               maximumContentStoreSize};
+  ContentStoreConfig contentStoreConfig = {
+      .objectCapacity = maximumContentStoreSize,
+      .stats = statsSegmentWriter_GetContentStoreStats(processor->statsSegment),
+  };
 
   processor->contentStore =
       contentStoreLRU_Create(&contentStoreConfig, processor->logger);
@@ -219,6 +164,7 @@ void messageProcessor_ClearCache(MessageProcessor *processor) {
 
   ContentStoreConfig contentStoreConfig = {
       .objectCapacity = objectStoreSize,
+      .stats = statsSegmentWriter_GetContentStoreStats(processor->statsSegment),
   };
 
   processor->contentStore =
@@ -248,15 +194,6 @@ void messageProcessor_Destroy(MessageProcessor **processorPtr) {
   contentStoreInterface_Release(&processor->contentStore);
   pit_Release(&processor->pit);
 
-#ifdef WITH_POLICY
-  Dispatcher *dispatcher = forwarder_GetDispatcher(processor->forwarder);
-  if (!dispatcher)
-    goto ERR;
-  dispatcher_StopTimer(dispatcher, processor->timer);
-  dispatcher_DestroyTimerEvent(dispatcher, (PARCEventTimer**)&processor->timer);
-ERR:
-#endif /* WITH_POLICY */
-
   parcMemory_Deallocate((void **)&processor);
   *processorPtr = NULL;
 }
@@ -265,7 +202,25 @@ void messageProcessor_Receive(MessageProcessor *processor, Message *message) {
   parcAssertNotNull(processor, "Parameter processor must be non-null");
   parcAssertNotNull(message, "Parameter message must be non-null");
 
-  processor->stats.countReceived++;
+  processor->stats->countReceived++;
+
+  hicn_light_stats_face_counters_t *face = statsSegmentWriter_GetFaceCounters(
+      processor->statsSegment, message_GetIngressConnectionId(message));
+  if (face) {
+    switch (message_GetType(message)) {
+      case MessagePacketType_Interest:
+        face->interestsReceived++;
+        break;
+
+      case MessagePacketType_ContentObject:
+        face->objectsReceived++;
+        break;
+
+      default:
+        break;
+    }
+    face->bytesReceived += message_Length(message);
+  }
 
   if (logger_IsLoggable(processor->logger, LoggerFacility_Processor,
                         PARCLogLevel_Debug)) {
@@ -395,6 +350,20 @@ void processor_SetStrategy(MessageProcessor *processor, Name *prefix,
   }
 }
 
+void messageProcessor_UpdateTableStats(MessageProcessor *processor) {
+  parcAssertNotNull(processor, "Parameter processor must be non-null");
+
+  hicn_light_stats_tables_t *tables =
+      statsSegmentWriter_GetTableStats(processor->statsSegment);
+
+  tables->pitEntries = pit_GetSize(processor->pit);
+  tables->csEntries =
+      contentStoreInterface_GetObjectCount(processor->contentStore);
+  tables->csCapacity =
+      contentStoreInterface_GetObjectCapacity(processor->contentStore);
+  tables->fibEntries = fib_Length(processor->fib);
+}
+
 FibEntryList *messageProcessor_GetFibEntries(MessageProcessor *processor) {
   parcAssertNotNull(processor, "Parameter processor must be non-null");
   return fib_GetEntries(processor->fib);
@@ -416,15 +385,15 @@ FibEntryList *messageProcessor_GetFibEntries(MessageProcessor *processor) {
  */
 static void messageProcessor_Drop(MessageProcessor *processor,
                                   Message *message) {
-  processor->stats.countDropped++;
+  processor->stats->countDropped++;
 
   switch (message_GetType(message)) {
     case MessagePacketType_Interest:
-      processor->stats.countInterestsDropped++;
+      processor->stats->countInterestsDropped++;
       break;
 
     case MessagePacketType_ContentObject:
-      processor->stats.countObjectsDropped++;
+      processor->stats->countObjectsDropped++;
       break;
 
     default:
@@ -454,14 +423,15 @@ static bool messageProcessor_AggregateInterestInPit(MessageProcessor *processor,
 
   if (verdict == PITVerdict_Aggregate) {
     // PIT has it, we're done
-    processor->stats.countInterestsAggregated++;
+    processor->stats->countInterestsAggregated++;
 
     if (logger_IsLoggable(processor->logger, LoggerFacility_Processor,
                           PARCLogLevel_Debug)) {
       logger_Log(
           processor->logger, LoggerFacility_Processor, PARCLogLevel_Debug,
-          __func__, "Message %p aggregated in PIT (aggregated count %u)",
-          (void *)interestMessage, processor->stats.countInterestsAggregated);
+          __func__,
+          "Message %p aggregated in PIT (aggregated count %" PRIu64 ")",
+          (void *)interestMessage, processor->stats->countInterestsAggregated);
     }
 
     return true;
@@ -471,8 +441,9 @@ static bool messageProcessor_AggregateInterestInPit(MessageProcessor *processor,
                         PARCLogLevel_Debug)) {
     logger_Log(
         processor->logger, LoggerFacility_Processor, PARCLogLevel_Debug,
-        __func__, "Message %p not aggregated in PIT (aggregated count %u)",
-        (void *)interestMessage, processor->stats.countInterestsAggregated);
+        __func__,
+        "Message %p not aggregated in PIT (aggregated count %" PRIu64 ")",
+        (void *)interestMessage, processor->stats->countInterestsAggregated);
   }
 
   return false;
@@ -503,15 +474,16 @@ static bool _satisfyFromContentStore(MessageProcessor *processor,
         "Illegal state: got a null nexthops for an interest we just inserted.");
 
     // send message in reply, then done
-    processor->stats.countInterestsSatisfiedFromStore++;
+    processor->stats->countInterestsSatisfiedFromStore++;
 
     if (logger_IsLoggable(processor->logger, LoggerFacility_Processor,
                           PARCLogLevel_Debug)) {
       logger_Log(processor->logger, LoggerFacility_Processor,
                  PARCLogLevel_Debug, __func__,
-                 "Message %p satisfied from content store (satisfied count %u)",
+                 "Message %p satisfied from content store "
+                 "(satisfied count %" PRIu64 ")",
                  (void *)interestMessage,
-                 processor->stats.countInterestsSatisfiedFromStore);
+                 processor->stats->countInterestsSatisfiedFromStore);
     }
 
     message_ResetPathLabel(objectMessage);
@@ -635,7 +607,7 @@ static bool messageProcessor_ForwardViaFib(MessageProcessor *processor,
  */
 static void messageProcessor_ReceiveInterest(MessageProcessor *processor,
                                              Message *interestMessage) {
-  processor->stats.countInterestsReceived++;
+  processor->stats->countInterestsReceived++;
 
   // (1) Try to aggregate in PIT
 #ifdef WITH_POLICY
@@ -678,13 +650,20 @@ static void messageProcessor_ReceiveInterest(MessageProcessor *processor,
   }
 
   // Remove the PIT entry?
-  processor->stats.countDroppedNoRoute++;
+  processor->stats->countDroppedNoRoute++;
+
+  hicn_light_stats_face_counters_t *face = statsSegmentWriter_GetFaceCounters(
+      processor->statsSegment, message_GetIngressConnectionId(interestMessage));
+  if (face) {
+    face->droppedNoRoute++;
+  }
 
   if (logger_IsLoggable(processor->logger, LoggerFacility_Processor,
                         PARCLogLevel_Debug)) {
     logger_Log(processor->logger, LoggerFacility_Processor, PARCLogLevel_Debug,
-               __func__, "Message %p did not match FIB, no route (count %u)",
-               (void *)interestMessage, processor->stats.countDroppedNoRoute);
+               __func__,
+               "Message %p did not match FIB, no route (count %" PRIu64 ")",
+               (void *)interestMessage, processor->stats->countDroppedNoRoute);
   }
 
   messageProcessor_Drop(processor, interestMessage);
@@ -702,34 +681,35 @@ static void messageProcessor_ReceiveInterest(MessageProcessor *processor,
  */
 static void messageProcessor_ReceiveContentObject(MessageProcessor *processor,
                                                   Message *message) {
-  processor->stats.countObjectsReceived++;
+  processor->stats->countObjectsReceived++;
 
   NumberSet *ingressSetUnion = pit_SatisfyInterest(processor->pit, message);
 
   if (numberSet_Length(ingressSetUnion) == 0) {
     // (1) If it does not match anything in the PIT, drop it
-    processor->stats.countDroppedNoReversePath++;
+    processor->stats->countDroppedNoReversePath++;
+
+    hicn_light_stats_face_counters_t *face =
+        statsSegmentWriter_GetFaceCounters(
+            processor->statsSegment, message_GetIngressConnectionId(message));
+    if (face) {
+      face->droppedNoReversePath++;
+    }
 
     if (logger_IsLoggable(processor->logger, LoggerFacility_Processor,
                           PARCLogLevel_Debug)) {
       logger_Log(processor->logger, LoggerFacility_Processor,
                  PARCLogLevel_Debug, __func__,
-                 "Message %p did not match PIT, no reverse path (count %u)",
-                 (void *)message, processor->stats.countDroppedNoReversePath);
+                 "Message %p did not match PIT, no reverse path "
+                 "(count %" PRIu64 ")",
+                 (void *)message, processor->stats->countDroppedNoReversePath);
     }
 
     //if the packet is a probe we need to analyze it
     if(messageHandler_IsAProbe(message_FixedHeader(message))){
-      FibEntry *fibEntry = fib_MatchMessage(processor->fib, message);
-      if(fibEntry &&
-          fibEntry_GetFwdStrategyType(fibEntry) == SET_STRATEGY_LOW_LATENCY){
-        unsigned connid = message_GetIngressConnectionId(message);
-        NumberSet *outFace = numberSet_Create();
-        numberSet_Add(outFace, connid);
-        fibEntry_ReceiveObjectMessage(fibEntry, outFace, message, 0,
-                                      forwarder_GetTicks(processor->forwarder));
-        numberSet_Release(&(outFace));
-      }
+      probeService_ReceiveReply(forwarder_GetProbeService(processor->forwarder),
+                                message_GetIngressConnectionId(message),
+                                message);
     }
 
     // we store the packets in the content store enven in the case where there
@@ -818,35 +798,58 @@ static void messageProcessor_SendWithGoodHopLimit(MessageProcessor *processor,
   if (success) {
     switch (message_GetType(message)) {
       case MessagePacketType_Interest:
-        processor->stats.countInterestForwarded++;
+        processor->stats->countInterestForwarded++;
         break;
 
       case MessagePacketType_ContentObject:
-        processor->stats.countObjectsForwarded++;
+        processor->stats->countObjectsForwarded++;
         break;
 
       default:
         break;
     }
 
+    hicn_light_stats_face_counters_t *face =
+        statsSegmentWriter_GetFaceCounters(processor->statsSegment,
+                                           interfaceId);
+    if (face) {
+      if (message_GetType(message) == MessagePacketType_Interest) {
+        face->interestsSent++;
+      } else if (message_GetType(message) == MessagePacketType_ContentObject) {
+        face->objectsSent++;
+      }
+      face->bytesSent += message_Length(message);
+    }
+
     if (logger_IsLoggable(processor->logger, LoggerFacility_Processor,
                           PARCLogLevel_Debug)) {
       logger_Log(
           processor->logger, LoggerFacility_Processor, PARCLogLevel_Debug,
-          __func__, "forward message %p to interface %u (int %u, obj %u)",
-          (void *)message, interfaceId, processor->stats.countInterestForwarded,
-          processor->stats.countObjectsForwarded);
+          __func__,
+          "forward message %p to interface %u (int %" PRIu64 ", obj %" PRIu64
+          ")",
+          (void *)message, interfaceId,
+          processor->stats->countInterestForwarded,
+          processor->stats->countObjectsForwarded);
     }
   } else {
-    processor->stats.countSendFailures++;
+    processor->stats->countSendFailures++;
+
+    hicn_light_stats_face_counters_t *face =
+        statsSegmentWriter_GetFaceCounters(processor->statsSegment,
+                                           interfaceId);
+    if (face) {
+      face->sendFailures++;
+    }
 
     if (logger_IsLoggable(processor->logger, LoggerFacility_Processor,
                           PARCLogLevel_Debug)) {
       logger_Log(processor->logger, LoggerFacility_Processor,
                  PARCLogLevel_Debug, __func__,
-                 "forward message %p to interface %u send failure (count %u)",
+                 "forward message %p to interface %u send failure "
+                 "(count %" PRIu64 ")",
                  (void *)message, interfaceId,
-                 processor->stats.countSendFailures);
+                 processor->stats->countSendFailures);
     }
     messageProcessor_Drop(processor, message);
   }
@@ -869,15 +872,16 @@ static void messageProcessor_ForwardToInterfaceId(MessageProcessor *processor,
     messageProcessor_SendWithGoodHopLimit(processor, message, interfaceId,
                                           conn);
   } else {
-    processor->stats.countDroppedConnectionNotFound++;
+    processor->stats->countDroppedConnectionNotFound++;
 
     if (logger_IsLoggable(processor->logger, LoggerFacility_Processor,
                           PARCLogLevel_Debug)) {
       logger_Log(processor->logger, LoggerFacility_Processor,
                  PARCLogLevel_Debug, __func__,
-                 "forward message %p to interface %u not found (count %u)",
+                 "forward message %p to interface %u not found "
+                 "(count %" PRIu64 ")",
                  (void *)message, interfaceId,
-                 processor->stats.countDroppedConnectionNotFound);
+                 processor->stats->countDroppedConnectionNotFound);
     }
 
     messageProcessor_Drop(processor, message);
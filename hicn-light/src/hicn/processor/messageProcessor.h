@@ -186,6 +186,12 @@ bool messageProcessor_GetCacheServeFlag(MessageProcessor *processor);
 
 void messageProcessor_ClearCache(MessageProcessor *processor);
 
+/**
+ * @function messageProcessor_UpdateTableStats
+ * @abstract Refresh the PIT, CS and FIB occupancy in the statistics segment
+ */
+void messageProcessor_UpdateTableStats(MessageProcessor *processor);
+
 void processor_SetStrategy(MessageProcessor *processor, Name *prefix,
                            strategy_type strategy,
                            unsigned related_prefixes_len,
@@ -43,3 +43,5 @@ void pit_RemoveInterest(PIT *pit, const Message *interestMessage) {
 PitEntry *pit_GetPitEntry(const PIT *pit, const Message *interestMessage) {
   return pit->getPitEntry(pit, interestMessage);
 }
+
+size_t pit_GetSize(const PIT *pit) { return pit->getSize(pit); }
@@ -39,6 +39,7 @@ struct pit {
   NumberSet *(*satisfyInterest)(PIT *pit, const Message *objectMessage);
   void (*removeInterest)(PIT *pit, const Message *interestMessage);
   PitEntry *(*getPitEntry)(const PIT *pit, const Message *interestMessage);
+  size_t (*getSize)(const PIT *pit);
   void *closure;
 };
 
@@ -111,4 +112,10 @@ void pit_RemoveInterest(PIT *pit, const Message *interestMessage);
  * @return NULL if not in table, otherwise a reference counted copy of the entry
  */
 PitEntry *pit_GetPitEntry(const PIT *pit, const Message *interestMessage);
+
+/**
+ * @function pit_GetSize
+ * @abstract Number of entries currently in the table
+ */
+size_t pit_GetSize(const PIT *pit);
 #endif  // pit_h
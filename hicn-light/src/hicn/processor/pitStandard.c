@@ -219,6 +219,14 @@ static NumberSet *_pitStandard_SatisfyInterest(PIT *generic,
                                       pitEntry_GetCreationTime(pitEntry),
                                       forwarder_GetTicks(pit->forwarder));
       }
+      hicn_light_stats_face_counters_t *face =
+          statsSegmentWriter_GetFaceCounters(
+              forwarder_GetStatsSegment(pit->forwarder),
+              message_GetIngressConnectionId(objectMessage));
+      if (face) {
+        face->interestsSatisfied++;
+        face->satisfactionLatency += now - pitEntry_GetCreationTime(pitEntry);
+      }
       const NumberSet *is = pitEntry_GetIngressSet(pitEntry);
       numberSet_AddSet(ingressSet, is);  // with this we do a copy so we can
                                          // remove the entry from the PIT
@@ -266,6 +274,13 @@ static PitEntry *_pitStandard_GetPitEntry(const PIT *generic,
   return NULL;
 }
 
+static size_t _pitStandard_GetSize(const PIT *generic) {
+  parcAssertNotNull(generic, "Parameter pit must be non-null");
+
+  StandardPIT *pit = pit_Closure(generic);
+  return parcHashCodeTable_Length(pit->table);
+}
+
 // ======================================================================
 // Public API
 
@@ -296,6 +311,7 @@ PIT *pitStandard_Create(Forwarder *forwarder) {
   }
 
   generic->getPitEntry = _pitStandard_GetPitEntry;
+  generic->getSize = _pitStandard_GetSize;
   generic->receiveInterest = _pitStandard_ReceiveInterest;
   generic->release = _pitStandard_Destroy;
   generic->removeInterest = _pitStandard_RemoveInterest;
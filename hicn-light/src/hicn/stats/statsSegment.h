@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file statsSegment.h
+ * @brief Layout of the hicn-light shared-memory statistics segment.
+ *
+ * The forwarder maps a POSIX shared memory object and updates the counters
+ * below in place, from the forwarding thread only. External processes map
+ * the same object read-only (see statsSegmentReader.h) and scrape it without
+ * any interaction with the forwarder.
+ *
+ * The segment is made of a header, followed by the face directory and the
+ * prefix directory, both fixed-size arrays of slots:
+ *
+ *   +--------------------------------+ 0
+ *   | hicn_light_stats_header_t      |
+ *   +--------------------------------+ facesOffset
+ *   | hicn_light_stats_face_t   [0]  |
+ *   | ...                            |
+ *   | hicn_light_stats_face_t   [maxFaces - 1]
+ *   +--------------------------------+ prefixesOffset
+ *   | hicn_light_stats_prefix_t [0]  |
+ *   | ...                            |
+ *   +--------------------------------+ size
+ *
+ * Counters are naturally aligned 64-bit integers with a single writer, so a
+ * reader never sees a torn value. Slots are only (re)assigned when a face or
+ * a route is added or removed: these changes are bracketed by increments of
+ * the header sequence number, which is odd while a change is in progress.
+ * A reader copying a directory retries if the sequence was odd or changed
+ * during the copy.
+ *
+ * This file is shared with the readers and only depends on stdint.h.
+ */
+
+#ifndef statsSegment_h
+#define statsSegment_h
+
+#include <stdint.h>
+
+#define HICN_LIGHT_STATS_SEGMENT_NAME "/hicn-light-stats"
+
+#define HICN_LIGHT_STATS_MAGIC 0x48494c5354415453ULL /* "HILSTATS" */
+#define HICN_LIGHT_STATS_VERSION 2
+
+#define HICN_LIGHT_STATS_MAX_FACES 1024
+#define HICN_LIGHT_STATS_MAX_PREFIXES 4096
+
+#define HICN_LIGHT_STATS_FACE_NAME_SIZE 128
+#define HICN_LIGHT_STATS_PREFIX_NAME_SIZE 64
+
+/**
+ * Message processor counters. The names match the ones historically used by
+ * the message processor.
+ */
+typedef struct {
+  uint64_t countReceived;
+  uint64_t countInterestsReceived;
+  uint64_t countObjectsReceived;
+
+  uint64_t countInterestsAggregated;
+
+  uint64_t countDropped;
+  uint64_t countInterestsDropped;
+  uint64_t countDroppedNoRoute;
+  uint64_t countDroppedNoReversePath;
+
+  uint64_t countDroppedConnectionNotFound;
+  uint64_t countObjectsDropped;
+
+  uint64_t countSendFailures;
+  uint64_t countInterestForwarded;
+  uint64_t countObjectsForwarded;
+  uint64_t countInterestsSatisfiedFromStore;
+
+  uint64_t countDroppedNoHopLimit;
+  uint64_t countDroppedZeroHopLimitFromRemote;
+  uint64_t countDroppedZeroHopLimitToRemote;
+} hicn_light_stats_processor_t;
+
+/**
+ * Content store counters. They survive the re-creation of the content store
+ * (e.g. when its size is changed or the cache is cleared).
+ */
+typedef struct {
+  uint64_t countExpiryEvictions;
+  uint64_t countRCTEvictions;
+  uint64_t countLruEvictions;
+  uint64_t countAdds;
+  uint64_t countHits;
+  uint64_t countMisses;
+} hicn_light_stats_cs_t;
+
+/**
+ * Table occupancy gauges, refreshed periodically by the forwarder.
+ */
+typedef struct {
+  uint64_t pitEntries;
+  uint64_t csEntries;
+  uint64_t csCapacity;
+  uint64_t fibEntries;
+  uint64_t faces;
+} hicn_light_stats_tables_t;
+
+/**
+ * Traffic counters of a face, updated inline on the data path. Rates are left
+ * to the reader, which divides the difference between two reads by the time
+ * elapsed.
+ *
+ * Drops are accounted to the face the packet was received from, except send
+ * failures. The satisfaction latency is the sum, in ticks, of the time
+ * between the creation of a PIT entry and the reception of the matching data
+ * on this face: the mean latency over an interval is the increase of
+ * satisfactionLatency divided by the increase of interestsSatisfied.
+ */
+typedef struct {
+  uint64_t interestsReceived;
+  uint64_t objectsReceived;
+  uint64_t bytesReceived;
+  uint64_t interestsSent;
+  uint64_t objectsSent;
+  uint64_t bytesSent;
+
+  uint64_t droppedNoRoute;
+  uint64_t droppedNoReversePath;
+  uint64_t sendFailures;
+
+  uint64_t interestsSatisfied;
+  uint64_t satisfactionLatency;
+} hicn_light_stats_face_counters_t;
+
+/**
+ * Face directory slot. A slot is free when id is 0, as connection ids start
+ * from 1.
+ */
+typedef struct {
+  uint32_t id;
+  uint32_t local;
+  char name[HICN_LIGHT_STATS_FACE_NAME_SIZE];
+
+  hicn_light_stats_face_counters_t counters;
+} hicn_light_stats_face_t;
+
+/**
+ * Traffic counters of a FIB entry, with the same conventions as the face
+ * counters. An interest is forwarded when the strategy selected at least one
+ * next hop for it, and dropped for lack of next hop otherwise (e.g. all the
+ * next hops were filtered out by the policy).
+ */
+typedef struct {
+  uint64_t interestsForwarded;
+  uint64_t bytesForwarded;
+  uint64_t objectsReceived;
+  uint64_t bytesReceived;
+
+  uint64_t droppedNoNexthop;
+  uint64_t timeouts;
+
+  uint64_t interestsSatisfied;
+  uint64_t satisfactionLatency;
+} hicn_light_stats_prefix_counters_t;
+
+/**
+ * Prefix directory slot, one per FIB entry, including the inner nodes of the
+ * FIB trie (which have no next hop). A slot is free when used is 0.
+ */
+typedef struct {
+  uint32_t used;
+  uint32_t nexthops;
+  uint32_t strategy;
+  uint32_t reserved;
+  char name[HICN_LIGHT_STATS_PREFIX_NAME_SIZE];
+
+  hicn_light_stats_prefix_counters_t counters;
+} hicn_light_stats_prefix_t;
+
+typedef struct {
+  uint64_t magic;
+  uint32_t version;
+  uint32_t pid;
+  uint64_t size;
+
+  /* Odd while a directory is being modified */
+  uint64_t sequence;
+
+  /*
+   * CLOCK_MONOTONIC (ms) at the last periodic refresh. Readers on the same
+   * host can compare it to their own clock to detect a stalled forwarder.
+   */
+  uint64_t heartbeat;
+
+  uint32_t maxFaces;
+  uint32_t maxPrefixes;
+  uint64_t facesOffset;
+  uint64_t prefixesOffset;
+
+  hicn_light_stats_processor_t processor;
+  hicn_light_stats_cs_t cs;
+  hicn_light_stats_tables_t tables;
+} hicn_light_stats_header_t;
+
+#endif  // statsSegment_h
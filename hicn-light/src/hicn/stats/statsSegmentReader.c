@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <hicn/stats/statsSegmentReader.h>
+
+/* A directory change takes a few hundred ns, this is plenty */
+#define SNAPSHOT_MAX_RETRIES 1000
+
+struct stats_segment_reader {
+  char *name;
+  ino_t inode;
+  size_t size;
+  const hicn_light_stats_header_t *header;
+};
+
+StatsSegmentReader *statsSegmentReader_Open(const char *name) {
+  int fd = shm_open(name, O_RDONLY, 0);
+  if (fd < 0) {
+    return NULL;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) < 0 ||
+      (size_t)st.st_size < sizeof(hicn_light_stats_header_t)) {
+    close(fd);
+    return NULL;
+  }
+
+  void *base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    return NULL;
+  }
+
+  const hicn_light_stats_header_t *header = base;
+  if (__atomic_load_n(&header->magic, __ATOMIC_ACQUIRE) !=
+          HICN_LIGHT_STATS_MAGIC ||
+      header->version != HICN_LIGHT_STATS_VERSION ||
+      header->size != (uint64_t)st.st_size) {
+    munmap(base, st.st_size);
+    return NULL;
+  }
+
+  StatsSegmentReader *reader = calloc(1, sizeof(StatsSegmentReader));
+  if (!reader) {
+    munmap(base, st.st_size);
+    return NULL;
+  }
+
+  reader->name = strdup(name);
+  reader->inode = st.st_ino;
+  reader->size = st.st_size;
+  reader->header = header;
+
+  return reader;
+}
+
+void statsSegmentReader_Close(StatsSegmentReader **readerPtr) {
+  StatsSegmentReader *reader = *readerPtr;
+  if (!reader) {
+    return;
+  }
+
+  munmap((void *)reader->header, reader->size);
+  free(reader->name);
+  free(reader);
+  *readerPtr = NULL;
+}
+
+int statsSegmentReader_IsStale(const StatsSegmentReader *reader,
+                               uint64_t timeout) {
+  // A restarted forwarder unlinks our segment and creates a new one
+  int fd = shm_open(reader->name, O_RDONLY, 0);
+  if (fd < 0) {
+    return 1;
+  }
+
+  struct stat st;
+  int rc = fstat(fd, &st);
+  close(fd);
+  if (rc < 0 || st.st_ino != reader->inode) {
+    return 1;
+  }
+
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  uint64_t now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+  uint64_t heartbeat =
+      __atomic_load_n(&reader->header->heartbeat, __ATOMIC_RELAXED);
+
+  return now > heartbeat + timeout;
+}
+
+void statsSegmentSnapshot_Init(StatsSegmentSnapshot *snapshot) {
+  memset(snapshot, 0, sizeof(StatsSegmentSnapshot));
+}
+
+void statsSegmentSnapshot_Free(StatsSegmentSnapshot *snapshot) {
+  free(snapshot->faces);
+  free(snapshot->prefixes);
+  statsSegmentSnapshot_Init(snapshot);
+}
+
+int statsSegmentReader_Snapshot(const StatsSegmentReader *reader,
+                                StatsSegmentSnapshot *snapshot) {
+  const hicn_light_stats_header_t *header = reader->header;
+  const hicn_light_stats_face_t *faces =
+      (const hicn_light_stats_face_t *)((const uint8_t *)header +
+                                        header->facesOffset);
+  const hicn_light_stats_prefix_t *prefixes =
+      (const hicn_light_stats_prefix_t *)((const uint8_t *)header +
+                                          header->prefixesOffset);
+
+  if (!snapshot->faces) {
+    snapshot->faces = calloc(header->maxFaces, sizeof(*faces));
+  }
+  if (!snapshot->prefixes) {
+    snapshot->prefixes = calloc(header->maxPrefixes, sizeof(*prefixes));
+  }
+  if (!snapshot->faces || !snapshot->prefixes) {
+    return -1;
+  }
+
+  for (int retry = 0; retry < SNAPSHOT_MAX_RETRIES; retry++) {
+    uint64_t sequence = __atomic_load_n(&header->sequence, __ATOMIC_ACQUIRE);
+    if (sequence & 1) {
+      sched_yield();
+      continue;
+    }
+
+    snapshot->pid = header->pid;
+    snapshot->heartbeat = header->heartbeat;
+    snapshot->processor = header->processor;
+    snapshot->cs = header->cs;
+    snapshot->tables = header->tables;
+
+    snapshot->faceCount = 0;
+    for (uint32_t i = 0; i < header->maxFaces; i++) {
+      if (faces[i].id != 0) {
+        snapshot->faces[snapshot->faceCount++] = faces[i];
+      }
+    }
+
+    snapshot->prefixCount = 0;
+    for (uint32_t i = 0; i < header->maxPrefixes; i++) {
+      if (prefixes[i].used) {
+        snapshot->prefixes[snapshot->prefixCount++] = prefixes[i];
+      }
+    }
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    if (__atomic_load_n(&header->sequence, __ATOMIC_RELAXED) == sequence) {
+      return 0;
+    }
+  }
+
+  return -1;
+}
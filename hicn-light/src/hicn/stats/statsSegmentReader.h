@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @header StatsSegmentReader
+ * @abstract Read-only access to the hicn-light statistics segment
+ * @discussion
+ *   Standalone library (libhicn-light-stats) used by monitoring agents such
+ *   as the collectd plugin. It maps the segment read-only and never blocks
+ *   or slows down the forwarder: a snapshot is a plain copy of the segment,
+ *   retried if a face or a route was added or removed during the copy.
+ *
+ *   Example:
+ *
+ *     StatsSegmentReader *reader =
+ *         statsSegmentReader_Open(HICN_LIGHT_STATS_SEGMENT_NAME);
+ *     StatsSegmentSnapshot snapshot;
+ *     statsSegmentSnapshot_Init(&snapshot);
+ *     if (reader && statsSegmentReader_Snapshot(reader, &snapshot) == 0) {
+ *       for (size_t i = 0; i < snapshot.faceCount; i++)
+ *         printf("%s %" PRIu64 "\n", snapshot.faces[i].name,
+ *                snapshot.faces[i].counters.interestsReceived);
+ *     }
+ *     statsSegmentSnapshot_Free(&snapshot);
+ *     statsSegmentReader_Close(&reader);
+ */
+
+#ifndef statsSegmentReader_h
+#define statsSegmentReader_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <hicn/stats/statsSegment.h>
+
+struct stats_segment_reader;
+typedef struct stats_segment_reader StatsSegmentReader;
+
+/**
+ * Consistent copy of the segment. The faces and prefixes arrays only hold
+ * the slots in use.
+ */
+typedef struct {
+  uint32_t pid;
+  uint64_t heartbeat;
+
+  hicn_light_stats_processor_t processor;
+  hicn_light_stats_cs_t cs;
+  hicn_light_stats_tables_t tables;
+
+  hicn_light_stats_face_t *faces;
+  size_t faceCount;
+
+  hicn_light_stats_prefix_t *prefixes;
+  size_t prefixCount;
+} StatsSegmentSnapshot;
+
+/**
+ * @function statsSegmentReader_Open
+ * @abstract Map the segment read-only
+ * @return NULL if the segment does not exist or has an unsupported layout
+ */
+StatsSegmentReader *statsSegmentReader_Open(const char *name);
+
+void statsSegmentReader_Close(StatsSegmentReader **readerPtr);
+
+/**
+ * @function statsSegmentReader_IsStale
+ * @abstract true if the forwarder has restarted (the segment we mapped was
+ * unlinked) or has not refreshed the segment for more than timeout ms.
+ * @discussion
+ *   A stale reader should be closed and re-opened.
+ */
+int statsSegmentReader_IsStale(const StatsSegmentReader *reader,
+                               uint64_t timeout);
+
+void statsSegmentSnapshot_Init(StatsSegmentSnapshot *snapshot);
+
+void statsSegmentSnapshot_Free(StatsSegmentSnapshot *snapshot);
+
+/**
+ * @function statsSegmentReader_Snapshot
+ * @abstract Copy the segment in snapshot, allocating the arrays if needed
+ * @return 0 on success, -1 if no consistent copy could be taken
+ */
+int statsSegmentReader_Snapshot(const StatsSegmentReader *reader,
+                                StatsSegmentSnapshot *snapshot);
+
+#endif  // statsSegmentReader_h
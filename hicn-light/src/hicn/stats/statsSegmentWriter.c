@@ -0,0 +1,444 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hicn/hicn-light/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#ifdef WITH_STATS_SEGMENT
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#endif /* WITH_STATS_SEGMENT */
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/assert/parc_Assert.h>
+
+#include <hicn/stats/statsSegmentWriter.h>
+
+/* Keep the directories on their own cache lines */
+#define STATS_SEGMENT_ALIGN 64
+#define STATS_SEGMENT_ROUND(x) \
+  (((x) + STATS_SEGMENT_ALIGN - 1) & ~((size_t)STATS_SEGMENT_ALIGN - 1))
+
+/*
+ * A face gets a slot in the face directory if one is free, otherwise its
+ * counters are kept in private memory: they are not exported but remain
+ * available to the forwarder.
+ */
+typedef struct {
+  int slot;
+  hicn_light_stats_face_counters_t *counters;
+} FaceIndexEntry;
+
+struct stats_segment_writer {
+  char *name;
+  size_t size;
+  bool shared;
+
+  hicn_light_stats_header_t *header;
+  hicn_light_stats_face_t *faces;
+  hicn_light_stats_prefix_t *prefixes;
+
+  // Faces by connection id. Connection ids are small and monotonically
+  // increasing, so a flat array grown on demand is enough.
+  FaceIndexEntry *faceById;
+  size_t faceByIdSize;
+
+  unsigned prefixCount;
+};
+
+/*
+ * Directory changes are bracketed by two increments of the sequence number.
+ * The release fence orders the first increment before the slot updates, the
+ * release store orders the slot updates before the second increment.
+ */
+static void _beginUpdate(StatsSegmentWriter *writer) {
+#ifdef WITH_STATS_SEGMENT
+  __atomic_store_n(&writer->header->sequence, writer->header->sequence + 1,
+                   __ATOMIC_RELAXED);
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+#else
+  writer->header->sequence++;
+#endif /* WITH_STATS_SEGMENT */
+}
+
+static void _endUpdate(StatsSegmentWriter *writer) {
+#ifdef WITH_STATS_SEGMENT
+  __atomic_store_n(&writer->header->sequence, writer->header->sequence + 1,
+                   __ATOMIC_RELEASE);
+#else
+  writer->header->sequence++;
+#endif /* WITH_STATS_SEGMENT */
+}
+
+#ifdef WITH_STATS_SEGMENT
+/*
+ * True if the segment exists and was left behind by a forwarder that is no
+ * longer running. A segment that cannot be read is assumed to be in use.
+ */
+static bool _isStale(const char *name) {
+  bool stale = false;
+
+  int fd = shm_open(name, O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == 0 &&
+      (size_t)st.st_size >= sizeof(hicn_light_stats_header_t)) {
+    void *base = mmap(NULL, sizeof(hicn_light_stats_header_t), PROT_READ,
+                      MAP_SHARED, fd, 0);
+    if (base != MAP_FAILED) {
+      const hicn_light_stats_header_t *header = base;
+      stale = header->pid != 0 && kill((pid_t)header->pid, 0) < 0 &&
+              errno == ESRCH;
+      munmap(base, sizeof(hicn_light_stats_header_t));
+    }
+  }
+  close(fd);
+
+  return stale;
+}
+
+static void *_mapShared(const char *name, size_t size) {
+  // Never take over the segment of another forwarder. Only a segment left
+  // behind by a forwarder that died is removed, readers still mapping it
+  // keep their (now stale) copy.
+  int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0640);
+  if (fd < 0 && errno == EEXIST && _isStale(name)) {
+    shm_unlink(name);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0640);
+  }
+  if (fd < 0) {
+    return NULL;
+  }
+
+  void *base = MAP_FAILED;
+  if (ftruncate(fd, size) == 0) {
+    base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+
+  if (base == MAP_FAILED) {
+    shm_unlink(name);
+    return NULL;
+  }
+
+  return base;
+}
+#endif /* WITH_STATS_SEGMENT */
+
+StatsSegmentWriter *statsSegmentWriter_Create(const char *name) {
+  StatsSegmentWriter *writer =
+      parcMemory_AllocateAndClear(sizeof(StatsSegmentWriter));
+  parcAssertNotNull(writer, "parcMemory_AllocateAndClear(%zu) returned NULL",
+                    sizeof(StatsSegmentWriter));
+
+  size_t facesOffset = STATS_SEGMENT_ROUND(sizeof(hicn_light_stats_header_t));
+  size_t prefixesOffset = STATS_SEGMENT_ROUND(
+      facesOffset +
+      HICN_LIGHT_STATS_MAX_FACES * sizeof(hicn_light_stats_face_t));
+  writer->size = STATS_SEGMENT_ROUND(
+      prefixesOffset +
+      HICN_LIGHT_STATS_MAX_PREFIXES * sizeof(hicn_light_stats_prefix_t));
+
+  void *base = NULL;
+#ifdef WITH_STATS_SEGMENT
+  if (name) {
+    base = _mapShared(name, writer->size);
+    if (base) {
+      writer->name = parcMemory_StringDuplicate(name, strlen(name));
+      writer->shared = true;
+    }
+  }
+#endif /* WITH_STATS_SEGMENT */
+  if (!base) {
+    base = parcMemory_AllocateAndClear(writer->size);
+    parcAssertNotNull(base, "parcMemory_AllocateAndClear(%zu) returned NULL",
+                      writer->size);
+  }
+
+  writer->header = (hicn_light_stats_header_t *)base;
+  writer->faces = (hicn_light_stats_face_t *)((uint8_t *)base + facesOffset);
+  writer->prefixes =
+      (hicn_light_stats_prefix_t *)((uint8_t *)base + prefixesOffset);
+
+  hicn_light_stats_header_t *header = writer->header;
+  header->version = HICN_LIGHT_STATS_VERSION;
+#ifndef _WIN32
+  header->pid = (uint32_t)getpid();
+#endif
+  header->size = writer->size;
+  header->maxFaces = HICN_LIGHT_STATS_MAX_FACES;
+  header->maxPrefixes = HICN_LIGHT_STATS_MAX_PREFIXES;
+  header->facesOffset = facesOffset;
+  header->prefixesOffset = prefixesOffset;
+
+  // Readers check the magic last: once visible, the layout is valid.
+#ifdef WITH_STATS_SEGMENT
+  __atomic_store_n(&header->magic, HICN_LIGHT_STATS_MAGIC, __ATOMIC_RELEASE);
+#else
+  header->magic = HICN_LIGHT_STATS_MAGIC;
+#endif /* WITH_STATS_SEGMENT */
+
+  statsSegmentWriter_Heartbeat(writer);
+
+  return writer;
+}
+
+void statsSegmentWriter_Destroy(StatsSegmentWriter **writerPtr) {
+  parcAssertNotNull(writerPtr, "Parameter must be non-null double pointer");
+  parcAssertNotNull(*writerPtr,
+                    "Parameter must dereference to non-null pointer");
+
+  StatsSegmentWriter *writer = *writerPtr;
+
+#ifdef WITH_STATS_SEGMENT
+  if (writer->shared) {
+    munmap(writer->header, writer->size);
+    shm_unlink(writer->name);
+    parcMemory_Deallocate((void **)&writer->name);
+  } else
+#endif /* WITH_STATS_SEGMENT */
+  {
+    parcMemory_Deallocate((void **)&writer->header);
+  }
+
+  for (size_t i = 0; i < writer->faceByIdSize; i++) {
+    if (writer->faceById[i].counters && writer->faceById[i].slot < 0) {
+      free(writer->faceById[i].counters);
+    }
+  }
+  free(writer->faceById);
+  parcMemory_Deallocate((void **)&writer);
+  *writerPtr = NULL;
+}
+
+bool statsSegmentWriter_IsShared(const StatsSegmentWriter *writer) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+  return writer->shared;
+}
+
+const char *statsSegmentWriter_GetName(const StatsSegmentWriter *writer) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+  return writer->name;
+}
+
+hicn_light_stats_processor_t *statsSegmentWriter_GetProcessorStats(
+    StatsSegmentWriter *writer) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+  return &writer->header->processor;
+}
+
+hicn_light_stats_cs_t *statsSegmentWriter_GetContentStoreStats(
+    StatsSegmentWriter *writer) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+  return &writer->header->cs;
+}
+
+hicn_light_stats_tables_t *statsSegmentWriter_GetTableStats(
+    StatsSegmentWriter *writer) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+  return &writer->header->tables;
+}
+
+// ============================================================
+// Face directory
+
+bool statsSegmentWriter_AddFace(StatsSegmentWriter *writer, unsigned connid,
+                                bool local, const char *name) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+  parcAssertTrue(connid > 0, "Connection ids start from 1");
+
+  if (connid >= writer->faceByIdSize) {
+    size_t size = writer->faceByIdSize ? writer->faceByIdSize : 64;
+    while (size <= connid) {
+      size *= 2;
+    }
+    FaceIndexEntry *entries =
+        realloc(writer->faceById, size * sizeof(FaceIndexEntry));
+    if (!entries) {
+      return false;
+    }
+    for (size_t i = writer->faceByIdSize; i < size; i++) {
+      entries[i] = (FaceIndexEntry){.slot = -1, .counters = NULL};
+    }
+    writer->faceById = entries;
+    writer->faceByIdSize = size;
+  }
+
+  FaceIndexEntry *entry = &writer->faceById[connid];
+  if (entry->counters) {
+    return entry->slot >= 0;
+  }
+
+  int slot = -1;
+  for (int i = 0; i < HICN_LIGHT_STATS_MAX_FACES; i++) {
+    if (writer->faces[i].id == 0) {
+      slot = i;
+      break;
+    }
+  }
+  if (slot < 0) {
+    // Directory full: count in private memory
+    hicn_light_stats_face_counters_t *counters =
+        calloc(1, sizeof(hicn_light_stats_face_counters_t));
+    if (!counters) {
+      // Not counted at all: statsSegmentWriter_GetFaceCounters returns NULL
+      return false;
+    }
+    entry->counters = counters;
+    return false;
+  }
+
+  hicn_light_stats_face_t *face = &writer->faces[slot];
+
+  _beginUpdate(writer);
+  memset(face, 0, sizeof(hicn_light_stats_face_t));
+  face->local = local;
+  if (name) {
+    strncpy(face->name, name, HICN_LIGHT_STATS_FACE_NAME_SIZE - 1);
+  }
+  face->id = connid;
+  writer->header->tables.faces++;
+  _endUpdate(writer);
+
+  entry->slot = slot;
+  entry->counters = &face->counters;
+  return true;
+}
+
+void statsSegmentWriter_RemoveFace(StatsSegmentWriter *writer,
+                                   unsigned connid) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+
+  if (connid >= writer->faceByIdSize || !writer->faceById[connid].counters) {
+    return;
+  }
+
+  FaceIndexEntry *entry = &writer->faceById[connid];
+  if (entry->slot >= 0) {
+    _beginUpdate(writer);
+    writer->faces[entry->slot].id = 0;
+    writer->header->tables.faces--;
+    _endUpdate(writer);
+  } else {
+    free(entry->counters);
+  }
+
+  *entry = (FaceIndexEntry){.slot = -1, .counters = NULL};
+}
+
+hicn_light_stats_face_counters_t *statsSegmentWriter_GetFaceCounters(
+    StatsSegmentWriter *writer, unsigned connid) {
+  if (connid >= writer->faceByIdSize) {
+    return NULL;
+  }
+  return writer->faceById[connid].counters;
+}
+
+// ============================================================
+// Prefix directory
+
+int statsSegmentWriter_AddPrefix(StatsSegmentWriter *writer, const char *name,
+                                 unsigned strategy) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+
+  if (writer->prefixCount == HICN_LIGHT_STATS_MAX_PREFIXES) {
+    return -1;
+  }
+
+  int slot = -1;
+  for (int i = 0; i < HICN_LIGHT_STATS_MAX_PREFIXES; i++) {
+    if (!writer->prefixes[i].used) {
+      slot = i;
+      break;
+    }
+  }
+  parcAssertTrue(slot >= 0, "Prefix directory out of sync");
+
+  hicn_light_stats_prefix_t *prefix = &writer->prefixes[slot];
+
+  _beginUpdate(writer);
+  memset(prefix, 0, sizeof(hicn_light_stats_prefix_t));
+  prefix->strategy = strategy;
+  if (name) {
+    strncpy(prefix->name, name, HICN_LIGHT_STATS_PREFIX_NAME_SIZE - 1);
+  }
+  prefix->used = 1;
+  _endUpdate(writer);
+
+  writer->prefixCount++;
+  return slot;
+}
+
+void statsSegmentWriter_UpdatePrefix(StatsSegmentWriter *writer, int slot,
+                                     unsigned nexthops, unsigned strategy) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+
+  if (slot < 0) {
+    return;
+  }
+
+  hicn_light_stats_prefix_t *prefix = &writer->prefixes[slot];
+
+  _beginUpdate(writer);
+  prefix->nexthops = nexthops;
+  prefix->strategy = strategy;
+  _endUpdate(writer);
+}
+
+hicn_light_stats_prefix_counters_t *statsSegmentWriter_GetPrefixCounters(
+    StatsSegmentWriter *writer, int slot) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+
+  if (slot < 0) {
+    return NULL;
+  }
+  return &writer->prefixes[slot].counters;
+}
+
+void statsSegmentWriter_RemovePrefix(StatsSegmentWriter *writer, int slot) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+
+  if (slot < 0) {
+    return;
+  }
+
+  _beginUpdate(writer);
+  writer->prefixes[slot].used = 0;
+  _endUpdate(writer);
+
+  writer->prefixCount--;
+}
+
+void statsSegmentWriter_Heartbeat(StatsSegmentWriter *writer) {
+  parcAssertNotNull(writer, "Parameter writer must be non-null");
+#ifdef WITH_STATS_SEGMENT
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  writer->header->heartbeat =
+      (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+#endif /* WITH_STATS_SEGMENT */
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @header StatsSegmentWriter
+ * @abstract Forwarder side of the shared-memory statistics segment
+ * @discussion
+ *   The writer owns the segment described in statsSegment.h. When the
+ *   segment cannot be shared (no name given, or a platform without POSIX
+ *   shared memory) it is allocated in private memory instead, so that the
+ *   counter pointers handed out by the writer are always valid and the data
+ *   path never has to check for them.
+ *
+ *   All the functions must be called from the forwarder thread.
+ */
+
+#ifndef statsSegmentWriter_h
+#define statsSegmentWriter_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <hicn/stats/statsSegment.h>
+
+struct stats_segment_writer;
+typedef struct stats_segment_writer StatsSegmentWriter;
+
+/**
+ * @function statsSegmentWriter_Create
+ * @abstract Create the statistics segment
+ * @discussion
+ *   If name is not NULL, a POSIX shared memory object with that name (e.g.
+ *   HICN_LIGHT_STATS_SEGMENT_NAME) is created. An existing object is only
+ *   replaced if the forwarder that created it is no longer running. If name
+ *   is NULL or the object cannot be created, the segment is private.
+ *
+ * @param name may be NULL
+ */
+StatsSegmentWriter *statsSegmentWriter_Create(const char *name);
+
+/**
+ * @function statsSegmentWriter_Destroy
+ * @abstract Unmap the segment and remove the shared memory object
+ */
+void statsSegmentWriter_Destroy(StatsSegmentWriter **writerPtr);
+
+/**
+ * @function statsSegmentWriter_IsShared
+ * @abstract true if the segment can be mapped by other processes
+ */
+bool statsSegmentWriter_IsShared(const StatsSegmentWriter *writer);
+
+/**
+ * @function statsSegmentWriter_GetName
+ * @abstract Name of the shared memory object, NULL if the segment is private
+ */
+const char *statsSegmentWriter_GetName(const StatsSegmentWriter *writer);
+
+hicn_light_stats_processor_t *statsSegmentWriter_GetProcessorStats(
+    StatsSegmentWriter *writer);
+
+hicn_light_stats_cs_t *statsSegmentWriter_GetContentStoreStats(
+    StatsSegmentWriter *writer);
+
+hicn_light_stats_tables_t *statsSegmentWriter_GetTableStats(
+    StatsSegmentWriter *writer);
+
+/**
+ * @function statsSegmentWriter_AddFace
+ * @abstract Assign a face directory slot to a connection
+ * @return false if the directory is full. The counters of the face are then
+ * kept in private memory and not exported.
+ */
+bool statsSegmentWriter_AddFace(StatsSegmentWriter *writer, unsigned connid,
+                                bool local, const char *name);
+
+/**
+ * @function statsSegmentWriter_RemoveFace
+ * @abstract Release the slot of a connection, if any
+ */
+void statsSegmentWriter_RemoveFace(StatsSegmentWriter *writer,
+                                   unsigned connid);
+
+/**
+ * @function statsSegmentWriter_GetFaceCounters
+ * @abstract Counters of a connection
+ * @discussion
+ *   Constant time, meant to be used on the data path.
+ *
+ * @return NULL if the connection was not added
+ */
+hicn_light_stats_face_counters_t *statsSegmentWriter_GetFaceCounters(
+    StatsSegmentWriter *writer, unsigned connid);
+
+/**
+ * @function statsSegmentWriter_AddPrefix
+ * @abstract Assign a prefix directory slot
+ * @return The slot index, or -1 if the directory is full
+ */
+int statsSegmentWriter_AddPrefix(StatsSegmentWriter *writer, const char *name,
+                                 unsigned strategy);
+
+/**
+ * @function statsSegmentWriter_UpdatePrefix
+ * @abstract Refresh the attributes of a prefix slot. No-op if slot is -1.
+ */
+void statsSegmentWriter_UpdatePrefix(StatsSegmentWriter *writer, int slot,
+                                     unsigned nexthops, unsigned strategy);
+
+/**
+ * @function statsSegmentWriter_GetPrefixCounters
+ * @abstract Counters of a prefix slot
+ * @return NULL if slot is -1
+ */
+hicn_light_stats_prefix_counters_t *statsSegmentWriter_GetPrefixCounters(
+    StatsSegmentWriter *writer, int slot);
+
+/**
+ * @function statsSegmentWriter_RemovePrefix
+ * @abstract Release a prefix slot. No-op if slot is -1.
+ */
+void statsSegmentWriter_RemovePrefix(StatsSegmentWriter *writer, int slot);
+
+/**
+ * @function statsSegmentWriter_Heartbeat
+ * @abstract Mark the segment as alive, called by the periodic refresh
+ */
+void statsSegmentWriter_Heartbeat(StatsSegmentWriter *writer);
+
+#endif  // statsSegmentWriter_h
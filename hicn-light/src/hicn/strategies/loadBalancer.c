@@ -21,13 +21,18 @@
 
 #include <parc/assert/parc_Assert.h>
 
-#include <parc/algol/parc_HashMap.h>
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Object.h>
-#include <parc/algol/parc_Unsigned.h>
 
 #include <hicn/strategies/loadBalancer.h>
 #include <hicn/strategies/nexthopState.h>
+#include <hicn/strategies/nexthopVector.h>
+
+#ifdef WITH_POLICY
+// draws from the whole nexthop set before falling back to a scan of the
+// nexthops allowed by the policy
+#define MAX_SAMPLES 4
+#endif /* WITH_POLICY */
 
 static void _strategyLoadBalancer_ReceiveObject(StrategyImpl *strategy,
                                                 const NumberSet *egressId,
@@ -72,11 +77,9 @@ struct strategy_load_balancer;
 typedef struct strategy_load_balancer StrategyLoadBalancer;
 
 struct strategy_load_balancer {
-#ifndef WITH_POLICY
-  double weights_sum;
-#endif /* ! WITH_POLICY */
-  // hash map from connectionId to StrategyNexthopState
-  PARCHashMap *strategy_state;
+  // StrategyNexthopState of each nexthop, weighted by the inverse of its
+  // pending interests
+  NexthopVector *strategy_state;
 #ifndef WITH_POLICY
   NumberSet *nexthops;
 #endif /* ! WITH_POLICY */
@@ -88,10 +91,7 @@ StrategyImpl *strategyLoadBalancer_Create() {
   parcAssertNotNull(strategy, "parcMemory_AllocateAndClear(%zu) returned NULL",
                     sizeof(StrategyLoadBalancer));
 
-#ifndef WITH_POLICY
-  strategy->weights_sum = 0.0;
-#endif /* ! WITH_POLICY */
-  strategy->strategy_state = parcHashMap_Create();
+  strategy->strategy_state = nexthopVector_Create();
 #ifndef WITH_POLICY
   strategy->nexthops = numberSet_Create();
 #endif /* ! WITH_POLICY */
@@ -113,52 +113,15 @@ strategy_type _strategyLoadBalancer_GetStrategy(StrategyImpl *strategy) {
   return SET_STRATEGY_LOADBALANCER;
 }
 
-static void _update_Stats(StrategyLoadBalancer *strategy,
-                          StrategyNexthopState *state, bool inc) {
+static void _update_Stats(StrategyLoadBalancer *strategy, size_t index,
+                          bool inc) {
   const double ALPHA = 0.9;
-#ifdef WITH_POLICY
-  strategyNexthopState_UpdateState(state, inc, ALPHA);
-#else
-  double w = strategyNexthopState_GetWeight(state);
-  strategy->weights_sum -= w;
-  w = strategyNexthopState_UpdateState(state, inc, ALPHA);
-  strategy->weights_sum += w;
-#endif /* WITH_POLICY */
+  StrategyNexthopState *state =
+      nexthopVector_GetState(strategy->strategy_state, index);
+  double w = strategyNexthopState_UpdateState(state, inc, ALPHA);
+  nexthopVector_SetWeight(strategy->strategy_state, index, w);
 }
 
-#ifndef WITH_POLICY
-static unsigned _select_Nexthop(StrategyLoadBalancer *strategy) {
-  double rnd = (double)rand() / (double)RAND_MAX;
-  double start_range = 0.0;
-
-  PARCIterator *it = parcHashMap_CreateKeyIterator(strategy->strategy_state);
-
-  unsigned nexthop = 100000;
-  while (parcIterator_HasNext(it)) {
-    PARCUnsigned *cid = parcIterator_Next(it);
-    const StrategyNexthopState *elem =
-        parcHashMap_Get(strategy->strategy_state, cid);
-
-    double w = strategyNexthopState_GetWeight(elem);
-
-    double prob = w / strategy->weights_sum;
-    if ((rnd >= start_range) && (rnd <= (start_range + prob))) {
-      nexthop = parcUnsigned_GetUnsigned(cid);
-      break;
-    } else {
-      start_range += prob;
-    }
-  }
-
-  parcIterator_Release(&it);
-
-  // if no face is selected by the algorithm (for example because of a wrong
-  // round in the weights) we may always select the last face here. Double check
-  // this!
-  return nexthop;
-}
-#endif /* ! WITH_POLICY */
-
 static void _strategyLoadBalancer_ReceiveObject(StrategyImpl *strategy,
                                                 const NumberSet *egressId,
                                                 const Message *objectMessage,
@@ -173,17 +136,14 @@ static void _strategyLoadBalancer_OnTimeout(StrategyImpl *strategy,
 
   for (unsigned i = 0; i < numberSet_Length(egressId); i++) {
     unsigned outId = numberSet_GetItem(egressId, i);
-    PARCUnsigned *cid = parcUnsigned_Create(outId);
 
-    const StrategyNexthopState *state =
-        parcHashMap_Get(lb->strategy_state, cid);
-    if (state != NULL) {
-      _update_Stats(lb, (StrategyNexthopState *)state, false);
+    int index = nexthopVector_IndexOf(lb->strategy_state, outId);
+    if (index >= 0) {
+      _update_Stats(lb, index, false);
     } else {
       // this may happen if we remove a face/route while downloading a file
       // we should ignore this timeout
     }
-    parcUnsigned_Release(&cid);
   }
 }
 
@@ -197,72 +157,79 @@ static NumberSet *_strategyLoadBalancer_LookupNexthop(
   NumberSet *outList = numberSet_Create();
 
 #ifdef WITH_POLICY
-  /* Compute the sum of weights of potential next hops */
-  double sum = 0;
-  for (unsigned i = 0; i < numberSet_Length(nexthops); i++) {
-    PARCUnsigned *cid = parcUnsigned_Create(numberSet_GetItem(nexthops, i));
-    const StrategyNexthopState *elem =
-        parcHashMap_Get(lb->strategy_state, cid);
-    parcUnsigned_Release(&cid);
-    if (!elem)
-      continue;
-    sum += strategyNexthopState_GetWeight(elem);
+  if (numberSet_Length(nexthops) == 0) {
+    return outList;
   }
 
-  /* Perform weighted random selection */
-  double distance = (double)rand() * sum / ((double)RAND_MAX + 1);
+  /* Weighted random selection among the whole nexthop set, rejecting the
+   * nexthops not allowed by the policy: this is the weighted selection
+   * among the allowed ones */
+  int selected = -1;
+  for (unsigned i = 0; i < MAX_SAMPLES && selected < 0; i++) {
+    int index = nexthopVector_Sample(lb->strategy_state);
+    if (index >= 0 &&
+        numberSet_Contains(nexthops,
+                           nexthopVector_GetConnectionId(lb->strategy_state,
+                                                         index))) {
+      selected = index;
+    }
+  }
 
-  for (unsigned i = 0; i < numberSet_Length(nexthops); i++) {
-    PARCUnsigned *cid = parcUnsigned_Create(numberSet_GetItem(nexthops, i));
-    const StrategyNexthopState *state =
-        parcHashMap_Get(lb->strategy_state, cid);
-    if (!state) {
-       parcUnsigned_Release(&cid);
-       continue;
+  if (selected < 0) {
+    /* The allowed nexthops have a small share of the weights */
+    double sum = 0;
+    for (unsigned i = 0; i < numberSet_Length(nexthops); i++) {
+      int index = nexthopVector_IndexOf(lb->strategy_state,
+                                        numberSet_GetItem(nexthops, i));
+      if (index < 0)
+        continue;
+      sum += nexthopVector_GetWeight(lb->strategy_state, index);
     }
-    distance -= strategyNexthopState_GetWeight(state);
-    if (distance < 0) {
-      numberSet_Add(outList, parcUnsigned_GetUnsigned(cid));
-      _update_Stats(lb, (StrategyNexthopState *)state, true);
-      parcUnsigned_Release(&cid);
-      break;
+
+    double distance = (double)rand() * sum / ((double)RAND_MAX + 1);
+
+    for (unsigned i = 0; i < numberSet_Length(nexthops); i++) {
+      int index = nexthopVector_IndexOf(lb->strategy_state,
+                                        numberSet_GetItem(nexthops, i));
+      if (index < 0)
+        continue;
+      distance -= nexthopVector_GetWeight(lb->strategy_state, index);
+      if (distance < 0) {
+        selected = index;
+        break;
+      }
     }
-    parcUnsigned_Release(&cid);
+  }
+
+  if (selected >= 0) {
+    numberSet_Add(outList,
+                  nexthopVector_GetConnectionId(lb->strategy_state, selected));
+    _update_Stats(lb, selected, true);
   }
 #else
   unsigned in_connection = message_GetIngressConnectionId(interestMessage);
-  PARCUnsigned *in = parcUnsigned_Create(in_connection);
 
-  unsigned mapSize = (unsigned)parcHashMap_Size(lb->strategy_state);
+  size_t size = nexthopVector_Length(lb->strategy_state);
 
-  if ((mapSize == 0) ||
-      ((mapSize == 1) && parcHashMap_Contains(lb->strategy_state, in))) {
+  if ((size == 0) ||
+      ((size == 1) &&
+       nexthopVector_GetConnectionId(lb->strategy_state, 0) ==
+           in_connection)) {
     // there are no output faces or the input face is also the only output face.
     // return null to avoid loops
-    parcUnsigned_Release(&in);
     return outList;
   }
 
-  unsigned out_connection;
+  int index;
   do {
-    out_connection = _select_Nexthop(lb);
-  } while (out_connection == in_connection);
+    index = nexthopVector_Sample(lb->strategy_state);
+  } while (nexthopVector_GetConnectionId(lb->strategy_state, index) ==
+           in_connection);
 
-  PARCUnsigned *out = parcUnsigned_Create(out_connection);
+  _update_Stats(lb, index, true);
 
-  const StrategyNexthopState *state = parcHashMap_Get(lb->strategy_state, out);
-  if (state == NULL) {
-    // this is an error and should not happen!
-    parcTrapNotImplemented(
-        "Try to send an interest on a face that does not exists");
-  }
-
-  _update_Stats(lb, (StrategyNexthopState *)state, true);
-
-  parcUnsigned_Release(&in);
-  parcUnsigned_Release(&out);
-
-  numberSet_Add(outList, out_connection);
+  numberSet_Add(outList,
+                nexthopVector_GetConnectionId(lb->strategy_state, index));
 #endif /* WITH_POLICY */
 
   return outList;
@@ -282,62 +249,43 @@ unsigned _strategyLoadBalancer_CountNexthops(StrategyImpl *strategy) {
 
 static void _strategyLoadBalancer_resetState(StrategyImpl *strategy) {
   StrategyLoadBalancer *lb = (StrategyLoadBalancer *)strategy->context;
-#ifndef WITH_POLICY
-  lb->weights_sum = 0.0;
-#endif/* ! WITH_POLICY */
-  PARCIterator *it = parcHashMap_CreateKeyIterator(lb->strategy_state);
 
-  while (parcIterator_HasNext(it)) {
-    PARCUnsigned *cid = parcIterator_Next(it);
-    StrategyNexthopState *elem =
-        (StrategyNexthopState *)parcHashMap_Get(lb->strategy_state, cid);
+  for (size_t i = 0; i < nexthopVector_Length(lb->strategy_state); i++) {
+    StrategyNexthopState *elem = nexthopVector_GetState(lb->strategy_state, i);
 
     strategyNexthopState_Reset(elem);
-#ifndef WITH_POLICY
-    lb->weights_sum += strategyNexthopState_GetWeight(elem);
-#endif /* ! WITH_POLICY */
+    nexthopVector_SetWeight(lb->strategy_state, i,
+                            strategyNexthopState_GetWeight(elem));
   }
-
-  parcIterator_Release(&it);
 }
 
 static void _strategyLoadBalancer_AddNexthop(StrategyImpl *strategy,
                                              unsigned connectionId) {
-
-  PARCUnsigned *cid = parcUnsigned_Create(connectionId);
-
   StrategyLoadBalancer *lb = (StrategyLoadBalancer *)strategy->context;
 
-  if (!parcHashMap_Contains(lb->strategy_state, cid)) {
+  if (nexthopVector_IndexOf(lb->strategy_state, connectionId) < 0) {
     StrategyNexthopState *state = strategyNexthopState_Create();
-    parcHashMap_Put(lb->strategy_state, cid, state);
+    nexthopVector_Add(lb->strategy_state, connectionId, state);
 #ifndef WITH_POLICY
     numberSet_Add(lb->nexthops, connectionId);
 #endif /* WITH_POLICY */
     _strategyLoadBalancer_resetState(strategy);
   }
-  parcUnsigned_Release(&cid);
 }
 
 static void _strategyLoadBalancer_RemoveNexthop(StrategyImpl *strategy,
                                                 unsigned connectionId) {
   StrategyLoadBalancer *lb = (StrategyLoadBalancer *)strategy->context;
 
-  PARCUnsigned *cid = parcUnsigned_Create(connectionId);
-
-  if (parcHashMap_Contains(lb->strategy_state, cid)) {
-    StrategyNexthopState *state =
-        (StrategyNexthopState *)parcHashMap_Get(lb->strategy_state, cid);
+  StrategyNexthopState *state =
+      nexthopVector_Remove(lb->strategy_state, connectionId);
+  if (state != NULL) {
     parcObject_Release((void**)&state);
-
-    parcHashMap_Remove(lb->strategy_state, cid);
 #ifndef WITH_POLICY
     numberSet_Remove(lb->nexthops, connectionId);
 #endif /* WITH_POLICY */
     _strategyLoadBalancer_resetState(strategy);
   }
-
-  parcUnsigned_Release(&cid);
 }
 
 static void _strategyLoadBalancer_ImplDestroy(StrategyImpl **strategyPtr) {
@@ -347,18 +295,13 @@ static void _strategyLoadBalancer_ImplDestroy(StrategyImpl **strategyPtr) {
 
   StrategyImpl *impl = *strategyPtr;
   StrategyLoadBalancer *strategy = (StrategyLoadBalancer *)impl->context;
-  if (parcHashMap_Size(strategy->strategy_state) > 0) {
-    PARCIterator *it = parcHashMap_CreateKeyIterator(strategy->strategy_state);
-    while (parcIterator_HasNext(it)) {
-      PARCUnsigned *cid = parcIterator_Next(it);
-      StrategyNexthopState *state =
-              (StrategyNexthopState *) parcHashMap_Get(strategy->strategy_state, cid);
-      parcObject_Release((void **) &state);
-    }
-    parcIterator_Release(&it);
+  for (size_t i = 0; i < nexthopVector_Length(strategy->strategy_state); i++) {
+    StrategyNexthopState *state =
+        nexthopVector_GetState(strategy->strategy_state, i);
+    parcObject_Release((void **) &state);
   }
 
-  parcHashMap_Release(&(strategy->strategy_state));
+  nexthopVector_Destroy(&(strategy->strategy_state));
 #ifndef WITH_POLICY
   numberSet_Release(&(strategy->nexthops));
 #endif /* ! WITH_POLICY */
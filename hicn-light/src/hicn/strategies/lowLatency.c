@@ -22,15 +22,15 @@
 
 #include <parc/assert/parc_Assert.h>
 
-#include <parc/algol/parc_HashMap.h>
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_Object.h>
-#include <parc/algol/parc_Unsigned.h>
 
 #include <hicn/core/messageHandler.h>
 
 #include <hicn/strategies/lowLatency.h>
 #include <hicn/strategies/nexthopStateLowLatency.h>
+#include <hicn/strategies/nexthopVector.h>
+#include <hicn/strategies/probeService.h>
 
 const unsigned STABILITY_FACTOR = 15;
 const unsigned MAX_SWITCH_TRY = 10;
@@ -39,7 +39,6 @@ const unsigned MAX_TOLLERATED_LATENCY_DIFF = 15;
 const unsigned MAX_ROUNDS_MP_WITHOUT_CHECK = 2;
 const unsigned MAX_ROUNDS_AVOIDING_MULTIPATH = 40; //about 20 sec
 const unsigned MAX_ROUNDS_WITH_ERROR = 4;
-const unsigned PROBE_LIFETIME = 500; //ms
 
 static void _strategyLowLatency_ReceiveObject(StrategyImpl *strategy,
                                                 const NumberSet *egressId,
@@ -84,16 +83,13 @@ struct strategy_low_latency;
 typedef struct strategy_low_latency StrategyLowLatency;
 
 struct strategy_low_latency {
-  // hash map from connectionId to StrategyNexthopStateLL
-  PARCHashMap *strategy_state;
-  //hash map from sequence number to ticks (sent time)
-  PARCHashMap *pending_probes_ticks;
-  //hash map from sequence number to face id
-  PARCHashMap *pending_probes_faces;
+  // StrategyNexthopStateLL of each nexthop
+  NexthopVector *strategy_state;
   const Forwarder * forwarder;
-  PARCEventTimer *sendProbes;
+  //the probes are sent by the forwarder probe service
+  ProbeService *service;
   PARCEventTimer *computeBestFace;
-  uint8_t * probe;
+  //name probed on the nexthops
   hicn_name_t * name;
   StrategyNexthopStateLL * bestFaces[2];
   unsigned round;
@@ -109,81 +105,6 @@ struct strategy_low_latency {
 #endif /* ! WITH_POLICY */
 };
 
-static void strategyLowLatency_SendProbesCB(int fd, PARCEventType which_event,
-                                            void *data){
-  parcAssertTrue(which_event & PARCEventType_Timeout,
-                 "Event incorrect, expecting %X set, got %X",
-                 PARCEventType_Timeout, which_event);
-
-  StrategyLowLatency *ll = (StrategyLowLatency *) data;
-
-  //delete old pending probes
-  if(parcHashMap_Size(ll->pending_probes_ticks) != 0){
-    Ticks now = forwarder_GetTicks(ll->forwarder);
-    PARCIterator *iterator = parcHashMap_CreateKeyIterator(ll->pending_probes_ticks);
-    NumberSet *to_remove = numberSet_Create();
-    while(parcIterator_HasNext(iterator)) {
-      PARCUnsigned *parc_seq = (PARCUnsigned *) parcIterator_Next(iterator);
-      PARCUnsigned *parc_time = (PARCUnsigned *) parcHashMap_Get(ll->pending_probes_ticks, parc_seq);
-      Ticks sent_time = parcUnsigned_GetUnsigned(parc_time);
-      if((now - sent_time) > PROBE_LIFETIME){
-        //probes to delete
-        numberSet_Add(to_remove, parcUnsigned_GetUnsigned(parc_seq));
-      }
-    }
-    parcIterator_Release(&iterator);
-
-    for(int i = 0; i < numberSet_Length(to_remove); i++){
-      PARCUnsigned *prob_seq = parcUnsigned_Create(numberSet_GetItem(to_remove,i));
-      PARCUnsigned *cid = (PARCUnsigned *) parcHashMap_Get(ll->pending_probes_faces, prob_seq);
-      StrategyNexthopStateLL *state =
-        (StrategyNexthopStateLL *) parcHashMap_Get(ll->strategy_state, cid);
-      strategyNexthopStateLL_LostProbe(state);
-      parcHashMap_Remove(ll->pending_probes_ticks, prob_seq);
-      parcHashMap_Remove(ll->pending_probes_faces, prob_seq);
-      parcUnsigned_Release(&prob_seq);
-    }
-    numberSet_Release(&to_remove);
-  }
-
-  ConnectionTable * ct = forwarder_GetConnectionTable(ll->forwarder);
-
-  PARCIterator *iterator = parcHashMap_CreateKeyIterator(ll->strategy_state);
-  while(parcIterator_HasNext(iterator)){
-    PARCUnsigned *cid = (PARCUnsigned *) parcIterator_Next(iterator);
-    Connection *conn =
-        (Connection *)connectionTable_FindById(ct,
-                        parcUnsigned_GetUnsigned(cid));
-    if(!conn)
-        continue;
-
-    StrategyNexthopStateLL *state =
-        (StrategyNexthopStateLL *) parcHashMap_Get(ll->strategy_state, cid);
-
-    //probe only usable paths
-    if(!strategyNexthopStateLL_IsAllowed(state))
-      continue;
-
-    uint32_t seq = rand();
-    messageHandler_SetProbeName(ll->probe, HF_INET6_TCP,
-                                ll->name, seq);
-    connection_Probe(conn, ll->probe);
-
-    PARCUnsigned *parc_seq = parcUnsigned_Create(seq);
-    Ticks now = forwarder_GetTicks(ll->forwarder);
-    PARCUnsigned *parc_time = parcUnsigned_Create((unsigned int)now);
-    parcHashMap_Put(ll->pending_probes_ticks, parc_seq, parc_time);
-    parcHashMap_Put(ll->pending_probes_faces, parc_seq, cid);
-    strategyNexthopStateLL_SentProbe(state);
-    parcUnsigned_Release(&parc_seq);
-    parcUnsigned_Release(&parc_time);
-  }
-  parcIterator_Release(&iterator);
-
-  struct timeval timeout = {0,50000};
-  parcEventTimer_Start(ll->sendProbes, &timeout);
-}
-
 static void strategyLowLatency_SendMapmeUpdate(StrategyLowLatency *ll,
                                                const NumberSet * nexthops){
   MapMe * mapme = forwarder_getMapmeInstance(ll->forwarder);
@@ -209,7 +130,7 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
     ll->round++;
   }
 
-  if(parcHashMap_Size(ll->strategy_state) == 0){
+  if(nexthopVector_Length(ll->strategy_state) == 0){
     ll->bestFaces[0] = NULL;
     ll->bestFaces[1] = NULL;
     ll->use2paths = false;
@@ -265,18 +186,17 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
   ll->bestFaces[1] = NULL;
 
   //check if there is at least one non lossy connection
-  PARCIterator *iterator = parcHashMap_CreateKeyIterator(ll->strategy_state);
+  size_t size = nexthopVector_Length(ll->strategy_state);
   bool check_losses = true;
   bool found_good_face = false;
-  while(parcIterator_HasNext(iterator) && !found_good_face){
-    PARCUnsigned *cid = (PARCUnsigned *) parcIterator_Next(iterator);
-    const StrategyNexthopStateLL *state = parcHashMap_Get(ll->strategy_state, cid);
+  for(size_t i = 0; i < size && !found_good_face; i++){
+    const StrategyNexthopStateLL *state =
+        nexthopVector_GetState(ll->strategy_state, i);
     if(!strategyNexthopStateLL_IsLossy(state) &&
       strategyNexthopStateLL_IsAllowed(state)){
       found_good_face = true;
     }
   }
-  parcIterator_Release(&iterator);
   if(!found_good_face){
     // all the available faces are lossy, so we take into account only
     // the latency computed with the probes
@@ -285,12 +205,10 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
 
   if(ll->bestFaces[0] == NULL){
     //try to take a random face
-    PARCIterator *iterator = parcHashMap_CreateKeyIterator(ll->strategy_state);
     bool face_found = false;
-    while(parcIterator_HasNext(iterator) && !face_found) {
-      PARCUnsigned *cid = (PARCUnsigned *) parcIterator_Next(iterator);
-      StrategyNexthopStateLL *state = (StrategyNexthopStateLL *)
-          parcHashMap_Get(ll->strategy_state, cid);
+    for(size_t i = 0; i < size && !face_found; i++) {
+      StrategyNexthopStateLL *state =
+          nexthopVector_GetState(ll->strategy_state, i);
 
       if((check_losses && strategyNexthopStateLL_IsLossy(state)) ||
             !strategyNexthopStateLL_IsAllowed(state)){
@@ -301,7 +219,6 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
       ll->bestFaces[0] = state;
       face_found = true;
     }
-    parcIterator_Release(&iterator);
   }
 
   if(ll->bestFaces[0] == NULL){
@@ -322,12 +239,9 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
     ll->rounds_avoiding_multipath = 0;
   }
 
-  iterator = parcHashMap_CreateKeyIterator(ll->strategy_state);
-  while (parcIterator_HasNext(iterator)) {
-
-    PARCUnsigned *cid = (PARCUnsigned *) parcIterator_Next(iterator);
-    StrategyNexthopStateLL *state = (StrategyNexthopStateLL *)
-                              parcHashMap_Get(ll->strategy_state, cid);
+  for(size_t i = 0; i < size; i++){
+    StrategyNexthopStateLL *state =
+        nexthopVector_GetState(ll->strategy_state, i);
     double rtt = strategyNexthopStateLL_GetRTTLive(state);
 
     if((check_losses && strategyNexthopStateLL_IsLossy(state)) ||
@@ -347,8 +261,6 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
         //we have a new best face!
         strategyNexthopStateLL_ResetTryToSwitch((StrategyNexthopStateLL*) state);
         bestRtt = rtt;
-        if(ll->bestFaces[0] != NULL)
-           strategyNexthopStateLL_SetUnusedFace(ll->bestFaces[0]);
         ll->bestFaces[0] = (StrategyNexthopStateLL*) state;
       }else{
         //in this case we should switch but we wait MAX_SWITCH_TRY
@@ -359,8 +271,6 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
     }
   }
 
-  parcIterator_Release(&iterator);
-
   if(ll->bestFaces[0] == NULL){
     //we found no face so return
     ll->bestFaces[0] = NULL;
@@ -369,11 +279,10 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
     goto NEW_ROUND;
   }
 
-  if(parcHashMap_Size(ll->strategy_state) == 1 || ll->avoid_multipath){
+  if(size == 1 || ll->avoid_multipath){
     //in this case (one face available or avoid multipath) we stop the
     //search here. Just reset face 1 if needed
     if(ll->bestFaces[1] != NULL){
-      strategyNexthopStateLL_SetUnusedFace(ll->bestFaces[1]);
       ll->bestFaces[1] = NULL;
     }
     ll->use2paths = false;
@@ -382,14 +291,12 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
 
   //if we are here we have more than 1 interface, so we search for a second one
   //to use in case of multipath
-  iterator = parcHashMap_CreateKeyIterator(ll->strategy_state);
-  while (parcIterator_HasNext(iterator)) {
-    PARCUnsigned *cid = (PARCUnsigned *) parcIterator_Next(iterator);
-    if(parcUnsigned_GetUnsigned(cid) !=
+  for(size_t i = 0; i < size; i++){
+    if(nexthopVector_GetConnectionId(ll->strategy_state, i) !=
           strategyNexthopStateLL_GetFaceId(ll->bestFaces[0])){
 
-      StrategyNexthopStateLL *state = (StrategyNexthopStateLL *)
-                 parcHashMap_Get(ll->strategy_state, cid);
+      StrategyNexthopStateLL *state =
+          nexthopVector_GetState(ll->strategy_state, i);
 
       if((check_losses && strategyNexthopStateLL_IsLossy(state)) ||
         !strategyNexthopStateLL_IsAllowed(state)){
@@ -405,13 +312,11 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
         double rtt1 = strategyNexthopStateLL_GetRTTLive(ll->bestFaces[1]);
         double rttNewFace = strategyNexthopStateLL_GetRTTLive(state);
         if(rttNewFace + STABILITY_FACTOR < rtt1){
-          strategyNexthopStateLL_SetUnusedFace(ll->bestFaces[1]);
           ll->bestFaces[1] = state;
         }
       }
     }
   }
-  parcIterator_Release(&iterator);
 
   if(ll->bestFaces[1] != NULL){
     //we are not using the second face yet so we use the normal rtt for comparison
@@ -425,7 +330,6 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
       ll->rounds_in_multipath = 0;
     }else{
       //we use only one path
-      strategyNexthopStateLL_SetUnusedFace(ll->bestFaces[1]);
       ll->bestFaces[1] = NULL;
       ll->use2paths = false;
     }
@@ -440,24 +344,29 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
         logger_IsLoggable(log, LoggerFacility_Strategy, PARCLogLevel_Info)){
       if(ll->use2paths){
           logger_Log(log, LoggerFacility_Strategy, PARCLogLevel_Info,
-            __func__, "use 2 paths. rtt face %d = %f queue = %f is_lossy = %d,"
-            "rtt face %d = %f queue = %f is_lossy = %d\n",
+            __func__, "use 2 paths. rtt face %d = %f queue = %f jitter = %f "
+            "is_lossy = %d, rtt face %d = %f queue = %f jitter = %f "
+            "is_lossy = %d\n",
             strategyNexthopStateLL_GetFaceId(ll->bestFaces[0]),
             strategyNexthopStateLL_GetRTTLive(ll->bestFaces[0]),
             strategyNexthopStateLL_GetQueuing(ll->bestFaces[0]),
+            strategyNexthopStateLL_GetJitter(ll->bestFaces[0]),
             strategyNexthopStateLL_IsLossy(ll->bestFaces[0]),
             strategyNexthopStateLL_GetFaceId(ll->bestFaces[1]),
             strategyNexthopStateLL_GetRTTLive(ll->bestFaces[1]),
             strategyNexthopStateLL_GetQueuing(ll->bestFaces[1]),
+            strategyNexthopStateLL_GetJitter(ll->bestFaces[1]),
             strategyNexthopStateLL_IsLossy(ll->bestFaces[1]));
         }else{
           if(ll->bestFaces[0] != NULL){
             logger_Log(log, LoggerFacility_Strategy,
               PARCLogLevel_Info, __func__,
-              "use 1 path. rtt face %d = %f is_lossy = %d, "
-              "(avoid multipath = %d)\n",
+              "use 1 path. rtt face %d = %f jitter = %f loss = %f "
+              "is_lossy = %d, (avoid multipath = %d)\n",
               strategyNexthopStateLL_GetFaceId(ll->bestFaces[0]),
               strategyNexthopStateLL_GetRTTLive(ll->bestFaces[0]),
+              strategyNexthopStateLL_GetJitter(ll->bestFaces[0]),
+              strategyNexthopStateLL_GetLossRate(ll->bestFaces[0]),
               strategyNexthopStateLL_IsLossy(ll->bestFaces[0]),
               ll->avoid_multipath);
           }else{
@@ -468,17 +377,6 @@ static void strategyLowLatency_SelectBestFaces(StrategyLowLatency *ll,
       }
     }
 
-  //update the round only at the end for all the faces
-  if(new_round){
-    PARCIterator * iterator = parcHashMap_CreateKeyIterator(ll->strategy_state);
-    while (parcIterator_HasNext(iterator)) {
-      PARCUnsigned *cid = (PARCUnsigned *) parcIterator_Next(iterator);
-      strategyNexthopStateLL_StartNewRound((StrategyNexthopStateLL *)
-          parcHashMap_Get(ll->strategy_state, cid));
-    }
-    parcIterator_Release(&iterator);
-  }
-
   //mapme updates
   //if ll->bestFaces[0] == NULL we don't have any output faces
   //so don't need to send any updates since we are disconnected
@@ -544,9 +442,7 @@ StrategyImpl *strategyLowLatency_Create() {
   parcAssertNotNull(strategy, "parcMemory_AllocateAndClear(%zu) returned NULL",
                     sizeof(StrategyLowLatency));
 
-  strategy->strategy_state = parcHashMap_Create();
-  strategy->pending_probes_ticks = parcHashMap_Create();
-  strategy->pending_probes_faces = parcHashMap_Create();
+  strategy->strategy_state = nexthopVector_Create();
 #ifndef WITH_POLICY
   strategy->nexthops = numberSet_Create();
 #endif /* ! WITH_POLICY */
@@ -569,9 +465,8 @@ void strategyLowLatency_SetStrategy(StrategyImpl *strategy,
   StrategyLowLatency *ll =
       (StrategyLowLatency *)strategy->context;
   ll->forwarder = forwarder;
+  ll->service = forwarder_GetProbeService(forwarder);
 
-  //create probe packet
-  ll->probe = messageHandler_CreateProbePacket(HF_INET6_TCP, PROBE_LIFETIME);
   ip_prefix_t address;
   nameBitvector_ToIPAddress(name_GetContentName(
                                   fibEntry_GetPrefix(fibEntry)), &address);
@@ -579,8 +474,6 @@ void strategyLowLatency_SetStrategy(StrategyImpl *strategy,
 
 
   Dispatcher *dispatcher = forwarder_GetDispatcher((Forwarder *)ll->forwarder);
-  ll->sendProbes = dispatcher_CreateTimer(dispatcher, false,
-                                     strategyLowLatency_SendProbesCB, ll);
 
   ll->round = 0;
   ll->rounds_in_multipath = 0;
@@ -603,17 +496,24 @@ void _startTimers(StrategyImpl *strategy){
   StrategyLowLatency *ll =
       (StrategyLowLatency *)strategy->context;
 
-  struct timeval timeoutProbes = {0,10000};
-  parcEventTimer_Start(ll->sendProbes, &timeoutProbes);
-   struct timeval timeoutBF = {1,0};
-   parcEventTimer_Start(ll->computeBestFace, &timeoutBF);
+  for(size_t i = 0; i < nexthopVector_Length(ll->strategy_state); i++){
+    strategyNexthopStateLL_Subscribe(
+        nexthopVector_GetState(ll->strategy_state, i), ll->name);
+  }
+
+  struct timeval timeoutBF = {1,0};
+  parcEventTimer_Start(ll->computeBestFace, &timeoutBF);
 }
 
 void _stopTimers(StrategyImpl *strategy){
   StrategyLowLatency *ll =
       (StrategyLowLatency *)strategy->context;
 
-  parcEventTimer_Stop(ll->sendProbes);
+  for(size_t i = 0; i < nexthopVector_Length(ll->strategy_state); i++){
+    strategyNexthopStateLL_Unsubscribe(
+        nexthopVector_GetState(ll->strategy_state, i), ll->name);
+  }
+
   parcEventTimer_Stop(ll->computeBestFace);
 }
 
@@ -629,42 +529,7 @@ static void _strategyLowLatency_ReceiveObject(StrategyImpl *strategy,
                                                 const Message *objectMessage,
                                                 Ticks pitEntryCreation,
                                                 Ticks objReception) {
-  StrategyLowLatency *ll = (StrategyLowLatency *)strategy->context;
-
-  if(!messageHandler_IsAProbe(message_FixedHeader(objectMessage)))
-    return;
-
-  uint32_t seq = messageHandler_GetSegment(message_FixedHeader(objectMessage));
-  PARCUnsigned *parc_seq = parcUnsigned_Create(seq);
-  if (!parcHashMap_Contains(ll->pending_probes_ticks, parc_seq)){
-    parcUnsigned_Release(&parc_seq);
-    return;
-  }
-
-  //here numberSet_Length(egressId) should be 1
-  for (unsigned i = 0; i < numberSet_Length(egressId); i++) {
-    unsigned outId = numberSet_GetItem(egressId, i);
-    PARCUnsigned *cid = parcUnsigned_Create(outId);
-
-    const StrategyNexthopStateLL *state =
-        parcHashMap_Get(ll->strategy_state, cid);
-    if (state != NULL) {
-      Ticks time = parcUnsigned_GetUnsigned(
-            parcHashMap_Get(ll->pending_probes_ticks, parc_seq));
-      Ticks now = forwarder_GetTicks(ll->forwarder);
-      Ticks RTT =  now - time;
-      if(RTT <= 0)
-        RTT = 1;
-      strategyNexthopStateLL_AddRttSample(
-                          (StrategyNexthopStateLL *) state, (unsigned int)RTT);
-      parcHashMap_Remove(ll->pending_probes_ticks, parc_seq);
-    } else {
-      // this may happen if we remove a face/route while downloading a file
-      // we should ignore this timeout
-    }
-    parcUnsigned_Release(&cid);
-  }
-  parcUnsigned_Release(&parc_seq);
+  //probe replies are handled by the forwarder probe service
 }
 
 static void _strategyLowLatency_OnTimeout(StrategyImpl *strategy,
@@ -681,18 +546,16 @@ static NumberSet *_strategyLowLatency_LookupNexthop(StrategyImpl *strategy,
   StrategyLowLatency *ll = (StrategyLowLatency *)strategy->context;
 
   //update is_allowed flag of all the next hops
-  PARCIterator *iterator = parcHashMap_CreateKeyIterator(ll->strategy_state);
-  while(parcIterator_HasNext(iterator)){
-    PARCUnsigned *cid = (PARCUnsigned *) parcIterator_Next(iterator);
+  for(size_t i = 0; i < nexthopVector_Length(ll->strategy_state); i++){
     StrategyNexthopStateLL *state =
-        (StrategyNexthopStateLL *) parcHashMap_Get(ll->strategy_state, cid);
-    if(numberSet_Contains(nexthops, parcUnsigned_GetUnsigned(cid))){
+        nexthopVector_GetState(ll->strategy_state, i);
+    if(numberSet_Contains(nexthops,
+                    nexthopVector_GetConnectionId(ll->strategy_state, i))){
       strategyNexthopStateLL_SetIsAllowed(state,true);
     }else{
       strategyNexthopStateLL_SetIsAllowed(state,false);
     }
   }
-  parcIterator_Release(&iterator);
 
   if(ll->bestFaces[0] != NULL &&
       !strategyNexthopStateLL_IsAllowed(ll->bestFaces[0])){
@@ -748,13 +611,12 @@ unsigned _strategyLowLatency_CountNexthops(StrategyImpl *strategy) {
 
 static void _strategyLowLatency_AddNexthop(StrategyImpl *strategy,
                                              unsigned connectionId) {
-  PARCUnsigned *cid = parcUnsigned_Create(connectionId);
-
   StrategyLowLatency *ll = (StrategyLowLatency *)strategy->context;
 
-  if (!parcHashMap_Contains(ll->strategy_state, cid)) {
-    StrategyNexthopStateLL *state = strategyNexthopStateLL_Create(connectionId);
-    parcHashMap_Put(ll->strategy_state, cid, state);
+  if (nexthopVector_IndexOf(ll->strategy_state, connectionId) < 0) {
+    StrategyNexthopStateLL *state =
+        strategyNexthopStateLL_Create(connectionId, ll->service);
+    nexthopVector_Add(ll->strategy_state, connectionId, state);
     if(ll->bestFaces[0] == NULL){
       ll->bestFaces[0] = state;
     }
@@ -763,11 +625,9 @@ static void _strategyLowLatency_AddNexthop(StrategyImpl *strategy,
 #endif /* WITH_POLICY */
   }
 
-  if(parcHashMap_Size(ll->strategy_state) >= 2){
+  if(nexthopVector_Length(ll->strategy_state) >= 2){
     _startTimers(strategy);
   }
-
-  parcUnsigned_Release(&cid);
 }
 
 static void _strategyLowLatency_RemoveNexthop(StrategyImpl *strategy,
@@ -783,10 +643,11 @@ static void _strategyLowLatency_RemoveNexthop(StrategyImpl *strategy,
     reset_bestFaces = true;
   }
 
-  PARCUnsigned *cid = parcUnsigned_Create(connectionId);
-
-  if (parcHashMap_Contains(ll->strategy_state, cid)) {
-    parcHashMap_Remove(ll->strategy_state, cid);
+  StrategyNexthopStateLL *state =
+      nexthopVector_Remove(ll->strategy_state, connectionId);
+  if (state != NULL) {
+    strategyNexthopStateLL_Unsubscribe(state, ll->name);
+    parcObject_Release((void**)&state);
 #ifndef WITH_POLICY
     numberSet_Remove(lb->nexthops, connectionId);
 #endif /* WITH_POLICY */
@@ -798,11 +659,9 @@ static void _strategyLowLatency_RemoveNexthop(StrategyImpl *strategy,
     strategyLowLatency_SelectBestFaces(ll, false);
   }
 
-  if(parcHashMap_Size(ll->strategy_state) < 2){
+  if(nexthopVector_Length(ll->strategy_state) < 2){
     _stopTimers(strategy);
   }
-
-  parcUnsigned_Release(&cid);
 }
 
 static void _strategyLowLatency_ImplDestroy(StrategyImpl **strategyPtr) {
@@ -815,25 +674,16 @@ static void _strategyLowLatency_ImplDestroy(StrategyImpl **strategyPtr) {
 
   _stopTimers(impl);
 
-  parcEventTimer_Destroy(&(strategy->sendProbes));
   parcEventTimer_Destroy(&(strategy->computeBestFace));
 
-  if (parcHashMap_Size(strategy->strategy_state) > 0) {
-    PARCIterator *it = parcHashMap_CreateKeyIterator(strategy->strategy_state);
-    while (parcIterator_HasNext(it)) {
-      PARCUnsigned *cid = parcIterator_Next(it);
-      StrategyNexthopStateLL *state =
-          (StrategyNexthopStateLL *)parcHashMap_Get(strategy->strategy_state, cid);
-      parcObject_Release((void**)&state);
-    }
-    parcIterator_Release(&it);
+  for (size_t i = 0; i < nexthopVector_Length(strategy->strategy_state); i++) {
+    StrategyNexthopStateLL *state =
+        nexthopVector_GetState(strategy->strategy_state, i);
+    parcObject_Release((void**)&state);
   }
 
-  parcHashMap_Release(&(strategy->strategy_state));
-  parcHashMap_Release(&(strategy->pending_probes_ticks));
-  parcHashMap_Release(&(strategy->pending_probes_faces));
+  nexthopVector_Destroy(&(strategy->strategy_state));
 
-  parcMemory_Deallocate(&(strategy->probe));
   parcMemory_Deallocate(&(strategy->name));
 
   for(unsigned i = 0; i < strategy->related_prefixes_len; i++){
@@ -19,6 +19,8 @@
 #include <parc/algol/parc_HashCode.h>
 #include <parc/algol/parc_Object.h>
 
+#include <hicn/strategies/probeService.h>
+
 struct strategy_nexthop_state_ll;
 typedef struct strategy_nexthop_state_ll StrategyNexthopStateLL;
 extern parcObjectDescriptor_Declaration(StrategyNexthopStateLL);
@@ -41,9 +43,9 @@ void strategyNexthopStateLL_AssertValid(const StrategyNexthopStateLL *instance);
 
 /**
  */
-StrategyNexthopStateLL *strategyNexthopStateLL_Create(unsigned face_id);
+StrategyNexthopStateLL *strategyNexthopStateLL_Create(unsigned face_id,
+                                                      ProbeService *service);
 
-void strategyNexthopStateLL_Reset(StrategyNexthopStateLL *x);
 /**
  */
 int strategyNexthopStateLL_Compare(const StrategyNexthopStateLL *instance,
@@ -82,13 +84,24 @@ void strategyNexthopStateLL_Release(StrategyNexthopStateLL **instancePtr);
 char *strategyNexthopStateLL_ToString(const StrategyNexthopStateLL *instance);
 
 /**
+ * The path measurements are shared by all the strategies using the face,
+ * they are read from the forwarder probe service
  */
 double strategyNexthopStateLL_GetRTTProbe(StrategyNexthopStateLL *x);
 double strategyNexthopStateLL_GetRTTInUse(StrategyNexthopStateLL *x);
 double strategyNexthopStateLL_GetRTTLive(StrategyNexthopStateLL *x);
 double strategyNexthopStateLL_GetQueuing(const StrategyNexthopStateLL *x);
-void strategyNexthopStateLL_AddRttSample(StrategyNexthopStateLL *x,
-                                                unsigned int rtt);
+double strategyNexthopStateLL_GetJitter(const StrategyNexthopStateLL *x);
+double strategyNexthopStateLL_GetLossRate(const StrategyNexthopStateLL *x);
+
+/**
+ * Start (stop) probing the face for the prefix name, does nothing if the
+ * face is already (not) probed
+ */
+void strategyNexthopStateLL_Subscribe(StrategyNexthopStateLL *x,
+                                      const hicn_name_t *name);
+void strategyNexthopStateLL_Unsubscribe(StrategyNexthopStateLL *x,
+                                        const hicn_name_t *name);
 
 
 void strategyNexthopStateLL_IncreaseTryToSwitch(StrategyNexthopStateLL *x,
@@ -96,21 +109,13 @@ void strategyNexthopStateLL_IncreaseTryToSwitch(StrategyNexthopStateLL *x,
 unsigned strategyNexthopStateLL_GetTryToSwitch(const StrategyNexthopStateLL *x);
 void strategyNexthopStateLL_ResetTryToSwitch(StrategyNexthopStateLL *x);
 
-void strategyNexthopStateLL_SetUnusedFace(StrategyNexthopStateLL *x);
-
 unsigned strategyNexthopStateLL_GetFaceId(StrategyNexthopStateLL *x);
 
 void strategyNexthopStateLL_SendPacket(StrategyNexthopStateLL *x);
 
-void strategyNexthopStateLL_SentProbe(StrategyNexthopStateLL *x);
-
-void strategyNexthopStateLL_LostProbe(StrategyNexthopStateLL *x);
-
 bool strategyNexthopStateLL_IsLossy(const StrategyNexthopStateLL *x);
 
 void strategyNexthopStateLL_SetIsAllowed(StrategyNexthopStateLL *x, bool allowed);
 
 bool strategyNexthopStateLL_IsAllowed(const StrategyNexthopStateLL *x);
-
-void strategyNexthopStateLL_StartNewRound(StrategyNexthopStateLL *x);
 #endif
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hicn/hicn-light/config.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/assert/parc_Assert.h>
+
+#include <hicn/strategies/nexthopVector.h>
+
+typedef struct {
+  unsigned connectionId;
+  void *state;
+  double weight;
+  // alias table
+  double builtWeight;
+  double prob;
+  unsigned alias;
+} NexthopEntry;
+
+struct nexthop_vector {
+  NexthopEntry *entries;
+  // small and large lists of the alias table construction
+  unsigned *work;
+  size_t length;
+  size_t capacity;
+  bool dirty;
+
+  NexthopEntry inlineEntries[NEXTHOP_VECTOR_INLINE];
+  unsigned inlineWork[NEXTHOP_VECTOR_INLINE];
+};
+
+static void _nexthopVector_Expand(NexthopVector *vector) {
+  size_t capacity = vector->capacity * 2;
+
+  NexthopEntry *entries = parcMemory_Allocate(capacity * sizeof(NexthopEntry));
+  unsigned *work = parcMemory_Allocate(capacity * sizeof(unsigned));
+  parcAssertNotNull(entries, "parcMemory_Allocate returned NULL");
+  parcAssertNotNull(work, "parcMemory_Allocate returned NULL");
+  memcpy(entries, vector->entries, vector->length * sizeof(NexthopEntry));
+
+  if (vector->entries != vector->inlineEntries) {
+    parcMemory_Deallocate((void **)&(vector->entries));
+    parcMemory_Deallocate((void **)&(vector->work));
+  }
+
+  vector->entries = entries;
+  vector->work = work;
+  vector->capacity = capacity;
+}
+
+static void _nexthopVector_Build(NexthopVector *vector) {
+  NexthopEntry *entries = vector->entries;
+  unsigned *work = vector->work;
+  size_t n = vector->length;
+
+  double sum = 0.0;
+  for (size_t i = 0; i < n; i++) {
+    entries[i].builtWeight = entries[i].weight;
+    sum += entries[i].weight;
+  }
+
+  // scaled probabilities, the small list grows from the start of work and
+  // the large one from the end
+  size_t small = 0;
+  size_t large = n;
+  for (size_t i = 0; i < n; i++) {
+    entries[i].prob = sum > 0 ? entries[i].weight * n / sum : 1.0;
+    if (entries[i].prob < 1.0) {
+      work[small++] = (unsigned)i;
+    } else {
+      work[--large] = (unsigned)i;
+    }
+  }
+
+  while (small > 0 && large < n) {
+    unsigned s = work[--small];
+    unsigned l = work[large++];
+
+    entries[s].alias = l;
+    entries[l].prob += entries[s].prob - 1.0;
+    if (entries[l].prob < 1.0) {
+      work[small++] = l;
+    } else {
+      work[--large] = l;
+    }
+  }
+
+  // what is left is 1 up to rounding errors
+  while (large < n) {
+    entries[work[large++]].prob = 1.0;
+  }
+  while (small > 0) {
+    entries[work[--small]].prob = 1.0;
+  }
+
+  vector->dirty = false;
+}
+
+NexthopVector *nexthopVector_Create(void) {
+  NexthopVector *vector = parcMemory_AllocateAndClear(sizeof(NexthopVector));
+  parcAssertNotNull(vector, "parcMemory_AllocateAndClear(%zu) returned NULL",
+                    sizeof(NexthopVector));
+
+  vector->entries = vector->inlineEntries;
+  vector->work = vector->inlineWork;
+  vector->capacity = NEXTHOP_VECTOR_INLINE;
+
+  return vector;
+}
+
+void nexthopVector_Destroy(NexthopVector **vectorPtr) {
+  parcAssertNotNull(vectorPtr, "Parameter must be non-null double pointer");
+  parcAssertNotNull(*vectorPtr,
+                    "Parameter must dereference to non-null pointer");
+  NexthopVector *vector = *vectorPtr;
+
+  if (vector->entries != vector->inlineEntries) {
+    parcMemory_Deallocate((void **)&(vector->entries));
+    parcMemory_Deallocate((void **)&(vector->work));
+  }
+
+  parcMemory_Deallocate((void **)&vector);
+  *vectorPtr = NULL;
+}
+
+size_t nexthopVector_Length(const NexthopVector *vector) {
+  return vector->length;
+}
+
+bool nexthopVector_Add(NexthopVector *vector, unsigned connectionId,
+                       void *state) {
+  if (nexthopVector_IndexOf(vector, connectionId) >= 0) {
+    return false;
+  }
+
+  if (vector->length == vector->capacity) {
+    _nexthopVector_Expand(vector);
+  }
+
+  NexthopEntry *entry = &vector->entries[vector->length++];
+  memset(entry, 0, sizeof(NexthopEntry));
+  entry->connectionId = connectionId;
+  entry->state = state;
+  entry->weight = 1.0;
+  vector->dirty = true;
+
+  return true;
+}
+
+void *nexthopVector_Remove(NexthopVector *vector, unsigned connectionId) {
+  int index = nexthopVector_IndexOf(vector, connectionId);
+  if (index < 0) {
+    return NULL;
+  }
+
+  void *state = vector->entries[index].state;
+  // same as numberSet_Remove, so that the positions match the nexthop set of
+  // the FIB entry
+  vector->length--;
+  vector->entries[index] = vector->entries[vector->length];
+  vector->dirty = true;
+
+  return state;
+}
+
+int nexthopVector_IndexOf(const NexthopVector *vector, unsigned connectionId) {
+  for (size_t i = 0; i < vector->length; i++) {
+    if (vector->entries[i].connectionId == connectionId) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+void *nexthopVector_Get(const NexthopVector *vector, unsigned connectionId) {
+  int index = nexthopVector_IndexOf(vector, connectionId);
+  return index < 0 ? NULL : vector->entries[index].state;
+}
+
+unsigned nexthopVector_GetConnectionId(const NexthopVector *vector,
+                                       size_t index) {
+  parcAssertTrue(index < vector->length, "Index %zu out of range", index);
+  return vector->entries[index].connectionId;
+}
+
+void *nexthopVector_GetState(const NexthopVector *vector, size_t index) {
+  parcAssertTrue(index < vector->length, "Index %zu out of range", index);
+  return vector->entries[index].state;
+}
+
+double nexthopVector_GetWeight(const NexthopVector *vector, size_t index) {
+  parcAssertTrue(index < vector->length, "Index %zu out of range", index);
+  return vector->entries[index].weight;
+}
+
+void nexthopVector_SetWeight(NexthopVector *vector, size_t index,
+                             double weight) {
+  parcAssertTrue(index < vector->length, "Index %zu out of range", index);
+  NexthopEntry *entry = &vector->entries[index];
+
+  entry->weight = weight;
+  if (fabs(weight - entry->builtWeight) >
+      NEXTHOP_VECTOR_WEIGHT_TOLERANCE * entry->builtWeight) {
+    vector->dirty = true;
+  }
+}
+
+int nexthopVector_Sample(NexthopVector *vector) {
+  if (vector->length == 0) {
+    return -1;
+  }
+
+  if (vector->dirty) {
+    _nexthopVector_Build(vector);
+  }
+
+  unsigned index = (unsigned)(rand() % vector->length);
+  double coin = (double)rand() / ((double)RAND_MAX + 1);
+
+  return coin < vector->entries[index].prob
+             ? (int)index
+             : (int)vector->entries[index].alias;
+}
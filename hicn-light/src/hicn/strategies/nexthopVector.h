@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @header NexthopVector
+ * @abstract Per nexthop state of a forwarding strategy
+ * @discussion
+ *   A FIB entry has a handful of nexthops, so the strategy state is kept in
+ *   a small array with the same layout as the nexthop set of the entry
+ *   (additions are appended, a removal moves the last element in place) and
+ *   looked up with a linear scan: no key is boxed and nothing is allocated
+ *   while forwarding. The first NEXTHOP_VECTOR_INLINE nexthops are stored
+ *   in the vector itself.
+ *
+ *   Each nexthop has a weight, and nexthopVector_Sample draws one with a
+ *   probability proportional to it in O(1) using an alias table (Vose). The
+ *   table is rebuilt at the first sample following a weight change larger
+ *   than NEXTHOP_VECTOR_WEIGHT_TOLERANCE, or an addition or removal.
+ */
+
+#ifndef nexthopVector_h
+#define nexthopVector_h
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define NEXTHOP_VECTOR_INLINE 8
+
+// relative change of a weight that triggers a rebuild of the alias table
+#define NEXTHOP_VECTOR_WEIGHT_TOLERANCE 0.05
+
+struct nexthop_vector;
+typedef struct nexthop_vector NexthopVector;
+
+NexthopVector *nexthopVector_Create(void);
+
+/**
+ * @function nexthopVector_Destroy
+ * @abstract Destroy the vector, the states are owned by the caller
+ */
+void nexthopVector_Destroy(NexthopVector **vectorPtr);
+
+size_t nexthopVector_Length(const NexthopVector *vector);
+
+/**
+ * @function nexthopVector_Add
+ * @abstract Append a nexthop with weight 1
+ * @return false if connectionId is already in the vector
+ */
+bool nexthopVector_Add(NexthopVector *vector, unsigned connectionId,
+                       void *state);
+
+/**
+ * @function nexthopVector_Remove
+ * @abstract Remove a nexthop
+ * @return The state of the nexthop, NULL if it is not in the vector
+ */
+void *nexthopVector_Remove(NexthopVector *vector, unsigned connectionId);
+
+/**
+ * @function nexthopVector_IndexOf
+ * @return The position of connectionId, -1 if it is not in the vector
+ */
+int nexthopVector_IndexOf(const NexthopVector *vector, unsigned connectionId);
+
+/**
+ * @function nexthopVector_Get
+ * @return The state of connectionId, NULL if it is not in the vector
+ */
+void *nexthopVector_Get(const NexthopVector *vector, unsigned connectionId);
+
+unsigned nexthopVector_GetConnectionId(const NexthopVector *vector,
+                                       size_t index);
+
+void *nexthopVector_GetState(const NexthopVector *vector, size_t index);
+
+double nexthopVector_GetWeight(const NexthopVector *vector, size_t index);
+
+void nexthopVector_SetWeight(NexthopVector *vector, size_t index,
+                             double weight);
+
+/**
+ * @function nexthopVector_Sample
+ * @abstract Weighted random selection of a nexthop
+ * @discussion
+ *   Nexthops are drawn uniformly if all the weights are zero.
+ * @return The position of the nexthop, -1 if the vector is empty
+ */
+int nexthopVector_Sample(NexthopVector *vector);
+
+#endif  // nexthopVector_h
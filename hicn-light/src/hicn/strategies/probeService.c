@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hicn/hicn-light/config.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/assert/parc_Assert.h>
+
+#include <hicn/core/messageHandler.h>
+#include <hicn/strategies/probeService.h>
+
+#define PROBE_LIFETIME 500  // ms
+#define PROBE_INTERVAL 50   // ms
+// the loss rate and the idle state are computed once per round
+#define PROBE_TICKS_PER_ROUND 10
+
+// more than the probes in flight: PROBE_LIFETIME / PROBE_INTERVAL
+#define PROBE_SLOTS 16
+
+// if we do not receive probes for 4 rounds (2 sec) the connection is
+// considered dead
+#define MAX_ROUNDS_WITHOUT_PROBES 4
+// number of rounds below MAX_LOSS_RATE before a connection is not lossy
+// anymore
+#define MIN_NON_LOSSY_ROUNDS 10
+#define MAX_LOSS_RATE 0.10
+
+typedef struct {
+  uint32_t seq;
+  Ticks sentTime;
+  bool pending;
+} ProbeSlot;
+
+typedef struct {
+  // names of the subscribed prefixes, probed in turn
+  const hicn_name_t **names;
+  unsigned subscribers;
+  unsigned namesCapacity;
+  unsigned nextName;
+
+  uint32_t nextSeq;
+  ProbeSlot slots[PROBE_SLOTS];
+
+  bool inUse;
+  unsigned sentPackets;
+
+  // per round counters
+  unsigned receivedProbes;
+  unsigned roundsWithoutProbes;
+  unsigned sentProbes;
+  unsigned lostProbes;
+  unsigned nonLossyRounds;
+
+  double avgRtt;
+  double avgRttInUse;
+  double avgQueue;
+  double avgLossRate;
+  double jitter;
+  double lastRtt;
+} PathState;
+
+struct probe_service {
+  Forwarder *forwarder;
+  PARCEventTimer *timer;
+  unsigned ticks;
+  unsigned subscriptions;
+
+  uint8_t *probe;
+
+  // indexed by connection id
+  PathState *paths;
+  unsigned pathsSize;
+};
+
+static void _pathState_Reset(PathState *path) {
+  path->nextName = 0;
+  path->nextSeq = (uint32_t)rand();
+  memset(path->slots, 0, sizeof(path->slots));
+  path->inUse = false;
+  path->sentPackets = 0;
+  path->receivedProbes = 0;
+  path->roundsWithoutProbes = 0;
+  path->sentProbes = 0;
+  path->lostProbes = 0;
+  path->nonLossyRounds = MIN_NON_LOSSY_ROUNDS;
+  path->avgRtt = -1.0;
+  path->avgRttInUse = -1.0;
+  path->avgQueue = 0.0001;
+  path->avgLossRate = 0.0;
+  path->jitter = 0.0;
+  path->lastRtt = -1.0;
+}
+
+static PathState *_getPath(const ProbeService *service, unsigned connId) {
+  if (connId >= service->pathsSize) {
+    return NULL;
+  }
+  return &service->paths[connId];
+}
+
+static void _pathState_AddRttSample(PathState *path, double rtt) {
+  path->receivedProbes++;
+
+  if (path->lastRtt >= 0) {
+    path->jitter += (fabs(rtt - path->lastRtt) - path->jitter) / 16;
+  }
+  path->lastRtt = rtt;
+
+  if (path->inUse) {
+    if (path->avgRttInUse == -1.0) {
+      path->avgRttInUse = rtt;
+    } else {
+      path->avgRttInUse = (path->avgRttInUse * 0.9) + (rtt * 0.1);
+    }
+  } else {
+    if (path->avgRtt == -1.0) {
+      path->avgRtt = rtt;
+    } else {
+      path->avgRtt = (path->avgRtt * 0.9) + (rtt * 0.1);
+    }
+  }
+
+  if (path->avgRttInUse == -1.0 || path->avgRtt == -1.0) {
+    path->avgQueue = 0.0001;
+  } else {
+    double queue = path->avgRttInUse - path->avgRtt;
+    if (queue < 0) {
+      queue = 0.0001;
+    }
+    path->avgQueue = (path->avgQueue * 0.95) + (0.05 * queue);
+  }
+}
+
+static void _pathState_StartNewRound(PathState *path) {
+  // the connection was not used in the last round
+  if (path->sentPackets == 0) {
+    path->inUse = false;
+  }
+  path->sentPackets = 0;
+
+  if (path->receivedProbes == 0) {
+    path->roundsWithoutProbes++;
+  } else {
+    path->roundsWithoutProbes = 0;
+  }
+  path->receivedProbes = 0;
+
+  if (path->sentProbes != 0) {
+    double lossRate = (double)path->lostProbes / (double)path->sentProbes;
+    path->avgLossRate = path->avgLossRate * 0.7 + lossRate * 0.3;
+    if (path->avgLossRate > MAX_LOSS_RATE) {
+      path->nonLossyRounds = 0;
+    } else {
+      path->nonLossyRounds++;
+    }
+  }
+
+  path->lostProbes = 0;
+  path->sentProbes = 0;
+
+  // the connection received probes only while in use: start the idle average
+  // from there
+  if (path->avgRtt == -1.0 && path->avgRttInUse != -1.0) {
+    path->avgRtt = path->avgRttInUse;
+  }
+}
+
+static void _probeService_SendProbe(ProbeService *service, unsigned connId,
+                                    PathState *path, Ticks now) {
+  // expired probes are lost
+  for (unsigned i = 0; i < PROBE_SLOTS; i++) {
+    ProbeSlot *slot = &path->slots[i];
+    if (slot->pending && now - slot->sentTime > PROBE_LIFETIME) {
+      slot->pending = false;
+      path->lostProbes++;
+    }
+  }
+
+  ConnectionTable *table = forwarder_GetConnectionTable(service->forwarder);
+  Connection *conn = (Connection *)connectionTable_FindById(table, connId);
+  if (!conn) {
+    return;
+  }
+
+  // the probe name is the only field modified by messageHandler_SetProbeName
+  hicn_name_t name = *path->names[path->nextName++ % path->subscribers];
+  uint32_t seq = path->nextSeq++;
+  messageHandler_SetProbeName(service->probe, HF_INET6_TCP, &name, seq);
+  connection_Probe(conn, service->probe);
+
+  ProbeSlot *slot = &path->slots[seq % PROBE_SLOTS];
+  if (slot->pending) {
+    path->lostProbes++;
+  }
+  slot->seq = seq;
+  slot->sentTime = now;
+  slot->pending = true;
+  path->sentProbes++;
+}
+
+static void _probeService_TimerCB(int fd, PARCEventType which_event,
+                                  void *data) {
+  parcAssertTrue(which_event & PARCEventType_Timeout,
+                 "Event incorrect, expecting %X set, got %X",
+                 PARCEventType_Timeout, which_event);
+
+  ProbeService *service = (ProbeService *)data;
+  Ticks now = forwarder_GetTicks(service->forwarder);
+  bool newRound = ++service->ticks % PROBE_TICKS_PER_ROUND == 0;
+
+  for (unsigned connId = 0; connId < service->pathsSize; connId++) {
+    PathState *path = &service->paths[connId];
+    if (path->subscribers == 0) {
+      continue;
+    }
+
+    if (newRound) {
+      _pathState_StartNewRound(path);
+    }
+
+    _probeService_SendProbe(service, connId, path, now);
+  }
+}
+
+ProbeService *probeService_Create(Forwarder *forwarder) {
+  ProbeService *service = parcMemory_AllocateAndClear(sizeof(ProbeService));
+  parcAssertNotNull(service, "parcMemory_AllocateAndClear(%zu) returned NULL",
+                    sizeof(ProbeService));
+
+  service->forwarder = forwarder;
+  service->probe =
+      messageHandler_CreateProbePacket(HF_INET6_TCP, PROBE_LIFETIME);
+  service->timer =
+      dispatcher_CreateTimer(forwarder_GetDispatcher(forwarder), true,
+                             _probeService_TimerCB, service);
+
+  return service;
+}
+
+void probeService_Destroy(ProbeService **servicePtr) {
+  parcAssertNotNull(servicePtr, "Parameter must be non-null double pointer");
+  parcAssertNotNull(*servicePtr,
+                    "Parameter must dereference to non-null pointer");
+  ProbeService *service = *servicePtr;
+  Dispatcher *dispatcher = forwarder_GetDispatcher(service->forwarder);
+
+  dispatcher_StopTimer(dispatcher, service->timer);
+  dispatcher_DestroyTimerEvent(dispatcher, &(service->timer));
+
+  for (unsigned connId = 0; connId < service->pathsSize; connId++) {
+    if (service->paths[connId].names) {
+      parcMemory_Deallocate((void **)&(service->paths[connId].names));
+    }
+  }
+  if (service->paths) {
+    parcMemory_Deallocate((void **)&(service->paths));
+  }
+
+  parcMemory_Deallocate((void **)&(service->probe));
+  parcMemory_Deallocate((void **)&service);
+  *servicePtr = NULL;
+}
+
+void probeService_Subscribe(ProbeService *service, unsigned connId,
+                            const hicn_name_t *name) {
+  if (connId >= service->pathsSize) {
+    unsigned size = service->pathsSize ? service->pathsSize : 16;
+    while (size <= connId) {
+      size *= 2;
+    }
+    service->paths = parcMemory_Reallocate(service->paths,
+                                           size * sizeof(PathState));
+    parcAssertNotNull(service->paths, "parcMemory_Reallocate returned NULL");
+    memset(service->paths + service->pathsSize, 0,
+           (size - service->pathsSize) * sizeof(PathState));
+    service->pathsSize = size;
+  }
+
+  PathState *path = &service->paths[connId];
+  if (path->subscribers == path->namesCapacity) {
+    path->namesCapacity = path->namesCapacity ? path->namesCapacity * 2 : 4;
+    path->names = parcMemory_Reallocate(
+        path->names, path->namesCapacity * sizeof(hicn_name_t *));
+    parcAssertNotNull(path->names, "parcMemory_Reallocate returned NULL");
+  }
+
+  if (path->subscribers == 0) {
+    _pathState_Reset(path);
+  }
+  path->names[path->subscribers++] = name;
+
+  if (service->subscriptions++ == 0) {
+    struct timeval interval = {0, PROBE_INTERVAL * 1000};
+    dispatcher_StartTimer(forwarder_GetDispatcher(service->forwarder),
+                          service->timer, &interval);
+  }
+}
+
+void probeService_Unsubscribe(ProbeService *service, unsigned connId,
+                              const hicn_name_t *name) {
+  PathState *path = _getPath(service, connId);
+  if (!path) {
+    return;
+  }
+
+  for (unsigned i = 0; i < path->subscribers; i++) {
+    if (path->names[i] == name) {
+      path->names[i] = path->names[--path->subscribers];
+      if (--service->subscriptions == 0) {
+        dispatcher_StopTimer(forwarder_GetDispatcher(service->forwarder),
+                             service->timer);
+      }
+      return;
+    }
+  }
+}
+
+void probeService_ReceiveReply(ProbeService *service, unsigned connId,
+                               const Message *message) {
+  PathState *path = _getPath(service, connId);
+  if (!path || path->subscribers == 0) {
+    return;
+  }
+
+  uint32_t seq = messageHandler_GetSegment(message_FixedHeader(message));
+  ProbeSlot *slot = &path->slots[seq % PROBE_SLOTS];
+  if (!slot->pending || slot->seq != seq) {
+    // expired, or not one of ours
+    return;
+  }
+  slot->pending = false;
+
+  Ticks rtt = forwarder_GetTicks(service->forwarder) - slot->sentTime;
+  _pathState_AddRttSample(path, rtt > 0 ? (double)rtt : 1.0);
+}
+
+void probeService_PacketSent(ProbeService *service, unsigned connId) {
+  PathState *path = _getPath(service, connId);
+  if (path) {
+    path->inUse = true;
+    path->sentPackets++;
+  }
+}
+
+double probeService_GetRTTProbe(ProbeService *service, unsigned connId) {
+  PathState *path = _getPath(service, connId);
+  if (!path || path->subscribers == 0) {
+    return 0.0;
+  }
+
+  if (path->roundsWithoutProbes > MAX_ROUNDS_WITHOUT_PROBES) {
+    return DBL_MAX;
+  }
+
+  if (path->avgRtt == -1.0) {
+    // until the next round, or no probe received yet
+    return path->avgRttInUse == -1.0 ? 0.0 : path->avgRttInUse;
+  }
+
+  return path->avgRtt;
+}
+
+double probeService_GetRTTInUse(ProbeService *service, unsigned connId) {
+  PathState *path = _getPath(service, connId);
+  if (!path || path->subscribers == 0) {
+    return 0.0;
+  }
+
+  if (path->roundsWithoutProbes > MAX_ROUNDS_WITHOUT_PROBES) {
+    return DBL_MAX;
+  }
+
+  if (path->avgRttInUse == -1.0) {
+    return probeService_GetRTTProbe(service, connId);
+  }
+
+  return path->avgRttInUse;
+}
+
+double probeService_GetRTTLive(ProbeService *service, unsigned connId) {
+  PathState *path = _getPath(service, connId);
+  if (path && path->inUse) {
+    return probeService_GetRTTInUse(service, connId);
+  }
+  return probeService_GetRTTProbe(service, connId);
+}
+
+double probeService_GetQueuing(const ProbeService *service, unsigned connId) {
+  PathState *path = _getPath(service, connId);
+  if (!path || path->roundsWithoutProbes > MAX_ROUNDS_WITHOUT_PROBES) {
+    return 0.0;
+  }
+  return path->avgQueue;
+}
+
+double probeService_GetJitter(const ProbeService *service, unsigned connId) {
+  PathState *path = _getPath(service, connId);
+  return path ? path->jitter : 0.0;
+}
+
+double probeService_GetLossRate(const ProbeService *service, unsigned connId) {
+  PathState *path = _getPath(service, connId);
+  return path ? path->avgLossRate : 0.0;
+}
+
+bool probeService_IsLossy(const ProbeService *service, unsigned connId) {
+  PathState *path = _getPath(service, connId);
+  if (!path) {
+    return false;
+  }
+  return path->nonLossyRounds < MIN_NON_LOSSY_ROUNDS ||
+         path->avgLossRate > MAX_LOSS_RATE;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @header ProbeService
+ * @abstract Forwarder-wide path quality measurements
+ * @discussion
+ *   Measures RTT, jitter and loss on the connections used by the
+ *   lowLatency strategy, with one probe stream per connection whatever the
+ *   number of prefixes routed through it. The strategy instances subscribe
+ *   the nexthops they want measured and read the results from here.
+ *
+ *   A probe is an interest on the name of one of the prefixes routed
+ *   through the connection, answered by the first forwarder having a local
+ *   face for that prefix: the subscribed names are probed in turn.
+ *
+ *   The state of each connection is kept in a flat array indexed by
+ *   connection id.
+ */
+
+#ifndef probeService_h
+#define probeService_h
+
+#include <stdbool.h>
+
+#include <hicn/hicn.h>
+#include <hicn/core/forwarder.h>
+#include <hicn/core/message.h>
+
+struct probe_service;
+typedef struct probe_service ProbeService;
+
+ProbeService *probeService_Create(Forwarder *forwarder);
+
+void probeService_Destroy(ProbeService **servicePtr);
+
+/**
+ * @function probeService_Subscribe
+ * @abstract Start probing connId for a prefix routed through it
+ * @discussion
+ *   name must stay valid until the matching probeService_Unsubscribe.
+ */
+void probeService_Subscribe(ProbeService *service, unsigned connId,
+                            const hicn_name_t *name);
+
+void probeService_Unsubscribe(ProbeService *service, unsigned connId,
+                              const hicn_name_t *name);
+
+/**
+ * @function probeService_ReceiveReply
+ * @abstract Process a probe reply received on connId
+ */
+void probeService_ReceiveReply(ProbeService *service, unsigned connId,
+                               const Message *message);
+
+/**
+ * @function probeService_PacketSent
+ * @abstract Record that traffic was forwarded on connId
+ * @discussion
+ *   RTT samples taken while a connection carries traffic are kept apart
+ *   from the idle ones, their difference estimates the queuing delay.
+ */
+void probeService_PacketSent(ProbeService *service, unsigned connId);
+
+/**
+ * RTT measured while idle, DBL_MAX if the connection does not answer
+ * anymore, 0 if it was not measured yet.
+ */
+double probeService_GetRTTProbe(ProbeService *service, unsigned connId);
+
+double probeService_GetRTTInUse(ProbeService *service, unsigned connId);
+
+/**
+ * RTT in use or idle, depending on whether the connection carries traffic.
+ */
+double probeService_GetRTTLive(ProbeService *service, unsigned connId);
+
+double probeService_GetQueuing(const ProbeService *service, unsigned connId);
+
+/**
+ * Mean deviation between consecutive RTT samples (RFC 3550).
+ */
+double probeService_GetJitter(const ProbeService *service, unsigned connId);
+
+double probeService_GetLossRate(const ProbeService *service, unsigned connId);
+
+bool probeService_IsLossy(const ProbeService *service, unsigned connId);
+
+#endif  // probeService_h
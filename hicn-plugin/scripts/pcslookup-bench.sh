@@ -0,0 +1,119 @@
+#!/bin/bash
+# Copyright (c) 2021 Cisco and/or its affiliates.
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at:
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# Measure the cost of the PCS lookup with the hicn packet generator.
+#
+# The PIT is first filled with <entries> distinct names, then <packets>
+# interests for the same names are sent and the clocks/packet of the
+# hicn-interest-pcslookup node are read from "show runtime". Run it once
+# with the plugin under test and once with the reference plugin, using
+# a different label, to compare the two.
+#
+# VPP must be running with the hicn plugin loaded and a PIT large enough
+# to hold all the names, e.g. in startup.conf:
+#
+#   hicn {
+#     pit-size 1048576
+#     pit-lifetime-max 60
+#   }
+
+set -euo pipefail
+
+VPPCTL=${VPPCTL:-vppctl}
+ENTRIES=1000000
+PACKETS=10000000
+RATE=1e7
+LABEL=$(date +%s)
+STREAM=hicn-pcslookup-bench
+NODE=hicn-interest-pcslookup
+
+usage() {
+  echo "Usage: $0 [-e entries] [-p packets] [-r rate] [-l label]"
+  echo "  -e entries   number of PIT entries to install (default ${ENTRIES})"
+  echo "  -p packets   number of interests to measure (default ${PACKETS})"
+  echo "  -r rate      packet generator rate in pps (default ${RATE})"
+  echo "  -l label     label printed with the results (e.g. before, after)"
+  exit 1
+}
+
+while getopts "e:p:r:l:h" opt; do
+  case ${opt} in
+    e) ENTRIES=${OPTARG} ;;
+    p) PACKETS=${OPTARG} ;;
+    r) RATE=${OPTARG} ;;
+    l) LABEL=${OPTARG} ;;
+    *) usage ;;
+  esac
+done
+
+vpp() {
+  ${VPPCTL} "$@"
+}
+
+# Send <limit> interests and wait until the stream is done
+run_stream() {
+  local limit=$1
+  local conf
+  conf=$(mktemp)
+
+  cat > "${conf}" << EOF
+packet-generator new {
+  name ${STREAM}
+  limit ${limit}
+  size 74-74
+  node hicnpg-interest
+  rate ${RATE}
+  data {
+    TCP: 5001::2 -> 5001::1
+    hex 0x000000000000000050020000000001f4
+  }
+}
+EOF
+
+  vpp packet-generator delete ${STREAM} > /dev/null 2>&1 || true
+  vpp exec "${conf}"
+  vpp packet-generator enable-stream ${STREAM}
+
+  while vpp show packet-generator | awk -v s=${STREAM} '$1 == s { print $2 }' \
+      | grep -q Yes; do
+    sleep 1
+  done
+
+  rm -f "${conf}"
+}
+
+# Interests leave through a loopback whose neighbor never answers, so that
+# every name stays in the PIT for the whole run.
+vpp create loopback interface instance 100 > /dev/null 2>&1 || true
+vpp set interface state loop100 up
+vpp set interface ip address loop100 5002::1/64 || true
+vpp ip neighbor loop100 5002::2 de:ad:00:00:00:00 || true
+vpp ip route add b001::/64 via 5002::2 loop100
+vpp hicn enable b001::/64 || true
+vpp hicn pgen client src 5001::2 name b001::1/64 lifetime 60000 \
+  intfc loop100 max_seq "${ENTRIES}" n_flows 1
+
+echo "Filling the PIT with ${ENTRIES} entries"
+run_stream "${ENTRIES}"
+
+echo "Sending ${PACKETS} interests"
+vpp clear runtime
+run_stream "${PACKETS}"
+
+# Name State Calls Vectors Suspends Clocks Vectors/Call
+vpp show runtime | awk -v n=${NODE} -v l="${LABEL}" '
+  $1 == n {
+    printf "%s %s: %s clocks/packet, %s vectors/call\n", l, n, $6, $7
+  }'
+vpp show hicn | grep -i "pit" || true
@@ -217,12 +217,12 @@ int
 hicn_cs_lru_flush (vlib_main_t * vm, struct hicn_pit_cs_s *pitcs,
 		   hicn_cs_policy_t * state)
 {
-  if (state->head == 0 && state->tail == 0)
-    return 0;
-
+  hicn_cs_arena_t *arena = &pitcs->cs_arena;
+  hicn_cs_arena_slot_t *slot;
   hicn_hash_node_t *lrunode;
   hicn_pcs_entry_t *lrupcs;
-  u32 idx;
+  hicn_hash_entry_t *hash_entry;
+  u32 idx, slot_id;
   int i = 0;
 
   idx = state->tail;
@@ -248,8 +248,7 @@ hicn_cs_lru_flush (vlib_main_t * vm, struct hicn_pit_cs_s *pitcs,
 	    pool_elt_at_index (pitcs->pcs_table->ht_overflow_buckets,
 			       lrunode->bucket_id);
 	}
-      hicn_hash_entry_t *hash_entry =
-	&(bucket->hb_entries[lrunode->entry_idx]);
+      hash_entry = &(bucket->hb_entries[lrunode->entry_idx]);
       hash_entry->locks++;
       hicn_pcs_cs_delete (vm, pitcs, &lrupcs, &lrunode, hash_entry, NULL,
 			  NULL);
@@ -257,6 +256,29 @@ hicn_cs_lru_flush (vlib_main_t * vm, struct hicn_pit_cs_s *pitcs,
       i++;
     }
 
+  /* Entries demoted to the CS arena are no longer in the LRU */
+  for (slot_id = 0; slot_id < arena->n_slots && arena->count > 0; slot_id++)
+    {
+      slot = hicn_cs_arena_get_slot (arena, slot_id);
+      if (slot->node_id == HICN_CS_ARENA_SLOT_FREE)
+	continue;
+
+      lrunode = hicn_hashtb_node_from_idx (pitcs->pcs_table, slot->node_id);
+      hash_entry = hicn_hashtb_get_entry (
+	pitcs->pcs_table, lrunode->entry_idx, lrunode->bucket_id,
+	lrunode->hn_flags & HICN_HASH_NODE_OVERFLOW_BUCKET);
+
+      /* Already deleted, the slot goes when the last lock is released */
+      if (hash_entry->he_flags & HICN_HASH_ENTRY_FLAG_DELETED)
+	continue;
+
+      lrupcs = hicn_pit_get_data (lrunode);
+      hash_entry->locks++;
+      hicn_pcs_cs_delete (vm, pitcs, &lrupcs, &lrunode, hash_entry, NULL,
+			  NULL);
+      i++;
+    }
+
   return (i);
 
 }
@@ -183,6 +183,16 @@ hicn_cli_node_ctl_param_set_command_fn (vlib_main_t *vm,
 		}
 	      node_ctl_params.cs_max_size = table_size;
 	    }
+	  else if (unformat (line_input, "arena-size %d", &table_size))
+	    {
+	      if (table_size < HICN_PARAM_CS_ARENA_ENTRIES_MIN ||
+		  table_size > HICN_PARAM_CS_ARENA_ENTRIES_MAX)
+		{
+		  rv = HICN_ERROR_CS_CONFIG_SIZE_OOB;
+		  break;
+		}
+	      hicn_main.cs_arena_size = table_size;
+	    }
 	  else
 	    {
 	      rv = HICN_ERROR_CLI_INVAL;
@@ -288,10 +298,12 @@ hicn_cli_show_command_fn (vlib_main_t *vm, unformat_input_t *main_input,
 		   "Forwarder: %sabled\n"
 		   "  PIT:: max entries:%d,"
 		   " lifetime default: max:%05.3f\n"
-		   "  CS::  max entries:%d\n",
+		   "  CS::  max entries:%d, arena max entries:%d\n"
+		   "  PIT/CS tables: %d (max entries are per table)\n",
 		   hicn_main.is_enabled ? "en" : "dis", hicn_infra_pit_size,
 		   ((f64) hicn_main.pit_lifetime_max_ms) / SEC_MS,
-		   hicn_infra_cs_size);
+		   hicn_infra_cs_size, hicn_infra_cs_arena_size,
+		   hicn_main.pcs_n_threads);
 
   vl_api_hicn_api_node_stats_get_reply_t rm = { 0, }
   , *rmp = &rm;
@@ -336,16 +348,24 @@ done:
   if (all_p && internal_p && ret == HICN_ERROR_NONE)
     {
       vlib_cli_output (vm, "Plugin features: cs:%d\n", HICN_FEATURE_CS);
-      vlib_cli_output (vm,
-		       "Removed CS entries (and freed vlib buffers) %d, "
-		       "Removed PIT entries %d\n",
-		       hicn_main.pitcs.pcs_cs_dealloc,
-		       hicn_main.pitcs.pcs_pit_dealloc);
-      vlib_cli_output (vm,
-		       "Bucke count %d, Overflow buckets count %d, used %d\n",
-		       hicn_main.pitcs.pcs_table->ht_bucket_count,
-		       hicn_main.pitcs.pcs_table->ht_overflow_bucket_count,
-		       hicn_main.pitcs.pcs_table->ht_overflow_buckets_used);
+      hicn_pit_cs_t *pitcs;
+      vec_foreach (pitcs, hicn_main.pitcs)
+      {
+	if (pitcs->pcs_table == NULL)
+	  continue;
+
+	vlib_cli_output (vm, "Thread %d PIT/CS:\n", pitcs - hicn_main.pitcs);
+	vlib_cli_output (vm,
+			 "Removed CS entries (and freed vlib buffers) %d, "
+			 "Removed PIT entries %d\n",
+			 pitcs->pcs_cs_dealloc, pitcs->pcs_pit_dealloc);
+	vlib_cli_output (vm,
+			 "Bucke count %d, Overflow buckets count %d, used %d\n",
+			 pitcs->pcs_table->ht_bucket_count,
+			 pitcs->pcs_table->ht_overflow_bucket_count,
+			 pitcs->pcs_table->ht_overflow_buckets_used);
+	vlib_cli_output (vm, "%U\n", format_hicn_cs_arena, &pitcs->cs_arena);
+      }
     }
   return (ret == HICN_ERROR_NONE) ?
 		 0 :
@@ -800,7 +820,8 @@ VLIB_CLI_COMMAND (hicn_cli_node_ctl_param_set_command, static) = {
   .path = "hicn control param",
   .short_help = "hicn control param { pit { size <entries> | { dfltlife | "
 		"minlife | maxlife } <seconds> } | fib size <entries> | cs "
-		"{size <entries> | app <portion to reserved to app>} }\n",
+		"{size <entries> | arena-size <entries> | app <portion to "
+		"reserved to app>} }\n",
   .function = hicn_cli_node_ctl_param_set_command_fn,
 };
 
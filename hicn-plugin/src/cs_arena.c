@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/mman.h>
+
+#include "cs_arena.h"
+#include "error.h"
+
+int
+hicn_cs_arena_init (hicn_cs_arena_t *arena, u32 n_slots)
+{
+  void *p;
+
+  clib_memset (arena, 0, sizeof (*arena));
+
+  if (n_slots == 0)
+    return HICN_ERROR_NONE;
+
+  arena->size = round_pow2 ((uword) n_slots * HICN_CS_ARENA_SLOT_SIZE,
+			    HICN_CS_ARENA_PAGE_SIZE);
+
+  p = mmap (NULL, arena->size, PROT_READ | PROT_WRITE,
+	    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (p != MAP_FAILED)
+    {
+      arena->is_hugetlb = 1;
+    }
+  else
+    {
+      p = mmap (NULL, arena->size, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED)
+	{
+	  arena->size = 0;
+	  return HICN_ERROR_CS_ARENA_NOMEM;
+	}
+      madvise (p, arena->size, MADV_HUGEPAGE);
+    }
+
+  /* Anonymous memory is zeroed, so all the slots are free */
+  arena->slots = p;
+  arena->n_slots = arena->size / HICN_CS_ARENA_SLOT_SIZE;
+
+  return HICN_ERROR_NONE;
+}
+
+void
+hicn_cs_arena_free (hicn_cs_arena_t *arena)
+{
+  if (arena->slots)
+    munmap (arena->slots, arena->size);
+
+  clib_memset (arena, 0, sizeof (*arena));
+}
+
+u8 *
+format_hicn_cs_arena (u8 *s, va_list *args)
+{
+  hicn_cs_arena_t *arena = va_arg (*args, hicn_cs_arena_t *);
+
+  if (!hicn_cs_arena_enabled (arena))
+    return format (s, "CS arena: disabled");
+
+  s = format (s, "CS arena: %u/%u slots (%U%s), ", arena->count,
+	      arena->n_slots, format_memory_size, arena->size,
+	      arena->is_hugetlb ? ", hugetlb" : "");
+  s = format (s, "inserts %lu, hits %lu, evictions %lu", arena->inserts,
+	      arena->hits, arena->evictions);
+
+  return s;
+}
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables: eval: (c-set-style "gnu") End:
+ */
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HICN_CS_ARENA_H__
+#define __HICN_CS_ARENA_H__
+
+#include <vlib/vlib.h>
+
+/**
+ * @file cs_arena.h
+ *
+ * Second tier of the content store. Entries in the first tier (the LRU) keep
+ * the vlib_buffer of the data, so the first tier cannot grow beyond the
+ * number of buffers of vpp. When the LRU evicts an entry, its packet is
+ * copied in a fixed-size slot of the arena, a large array mapped on
+ * hugepages, and the vlib_buffer is released. The entry stays in the PIT/CS
+ * hashtable, marked with HICN_PCS_ENTRY_CS_ARENA_FLAG, and a new buffer is
+ * filled from the slot when an interest hits it.
+ *
+ * Slots are recycled in FIFO order: when the arena is full, the entry owning
+ * the oldest slot is removed from the PIT/CS.
+ */
+
+/* Size of a slot, header included */
+#define HICN_CS_ARENA_SLOT_SIZE 2048
+
+/* The arena is mapped in multiples of this size */
+#define HICN_CS_ARENA_PAGE_SIZE (2 << 20)
+
+/*
+ * Hashtable node 0 is never used, so it marks free slots. This also makes a
+ * freshly mapped (zeroed) arena empty.
+ */
+#define HICN_CS_ARENA_SLOT_FREE 0
+
+/*
+ * Max number of slots skipped when the oldest ones belong to entries that are
+ * still locked by packets in flight.
+ */
+#define HICN_CS_ARENA_EVICT_TRIES 8
+
+typedef struct hicn_cs_arena_slot_s
+{
+  /* Hashtable node of the CS entry owning the slot */
+  u32 node_id;
+
+  /* Length of the packet */
+  u16 length;
+  u16 _reserved;
+
+  /* hicn_buffer_t of the packet, restored on hit */
+  u32 opaque2[14];
+
+  /* Packet, starting from the IP header */
+  u8 data[0];
+} hicn_cs_arena_slot_t;
+
+STATIC_ASSERT (sizeof (hicn_cs_arena_slot_t) == CLIB_CACHE_LINE_BYTES,
+	       "hicn_cs_arena_slot_t header must be one cache line");
+STATIC_ASSERT (STRUCT_SIZE_OF (hicn_cs_arena_slot_t, opaque2) ==
+		 STRUCT_SIZE_OF (vlib_buffer_t, opaque2),
+	       "hicn_cs_arena_slot_t must hold the vlib_buffer_t opaque2");
+
+/* Max packet size that fits in a slot */
+#define HICN_CS_ARENA_DATA_SIZE                                               \
+  (HICN_CS_ARENA_SLOT_SIZE - sizeof (hicn_cs_arena_slot_t))
+
+typedef struct hicn_cs_arena_s
+{
+  /* Slots, HICN_CS_ARENA_SLOT_SIZE bytes each */
+  u8 *slots;
+
+  /* Size of the mapping */
+  uword size;
+
+  u32 n_slots;
+
+  /* Next slot to hand out, slots are recycled in FIFO order */
+  u32 next;
+
+  /* Slots currently in use */
+  u32 count;
+
+  /* 1 if the arena is backed by hugetlbfs pages */
+  u8 is_hugetlb;
+
+  /* Counters */
+  u64 inserts;
+  u64 evictions;
+  u64 hits;
+} hicn_cs_arena_t;
+
+/**
+ * @brief Map an arena of n_slots slots. An arena of 0 slots is disabled.
+ *
+ * Explicit hugepages are tried first; if none are reserved the arena falls
+ * back to anonymous memory advised for transparent hugepages.
+ */
+int hicn_cs_arena_init (hicn_cs_arena_t *arena, u32 n_slots);
+
+/**
+ * @brief Unmap an arena
+ */
+void hicn_cs_arena_free (hicn_cs_arena_t *arena);
+
+/**
+ * @brief Format the arena counters
+ */
+u8 *format_hicn_cs_arena (u8 *s, va_list *args);
+
+always_inline int
+hicn_cs_arena_enabled (const hicn_cs_arena_t *arena)
+{
+  return arena->n_slots > 0;
+}
+
+always_inline hicn_cs_arena_slot_t *
+hicn_cs_arena_get_slot (const hicn_cs_arena_t *arena, u32 slot_id)
+{
+  ASSERT (slot_id < arena->n_slots);
+  return (hicn_cs_arena_slot_t *) (arena->slots +
+				   (uword) slot_id * HICN_CS_ARENA_SLOT_SIZE);
+}
+
+/*
+ * Release a slot. The entry owning it must be removed or moved back to the
+ * first tier by the caller.
+ */
+always_inline void
+hicn_cs_arena_release (hicn_cs_arena_t *arena, u32 slot_id)
+{
+  hicn_cs_arena_slot_t *slot = hicn_cs_arena_get_slot (arena, slot_id);
+
+  ASSERT (slot->node_id != HICN_CS_ARENA_SLOT_FREE);
+  slot->node_id = HICN_CS_ARENA_SLOT_FREE;
+  arena->count--;
+}
+
+/*
+ * Copy a packet in a slot and assign it to a hashtable node. The slot must
+ * be free.
+ */
+always_inline void
+hicn_cs_arena_store (vlib_main_t *vm, hicn_cs_arena_t *arena, u32 slot_id,
+		     u32 node_id, vlib_buffer_t *b)
+{
+  hicn_cs_arena_slot_t *slot = hicn_cs_arena_get_slot (arena, slot_id);
+  u32 length = vlib_buffer_length_in_chain (vm, b);
+
+  ASSERT (slot->node_id == HICN_CS_ARENA_SLOT_FREE);
+  ASSERT (length <= HICN_CS_ARENA_DATA_SIZE);
+
+  vlib_buffer_contents (vm, vlib_get_buffer_index (vm, b), slot->data);
+  clib_memcpy_fast (slot->opaque2, b->opaque2, sizeof (slot->opaque2));
+  slot->length = length;
+  slot->node_id = node_id;
+
+  arena->count++;
+  arena->inserts++;
+}
+
+/*
+ * Fill a buffer with the packet held in a slot, allocating further buffers
+ * if it does not fit. Whatever the buffer contained is overwritten. Returns
+ * 0 if the packet could not be entirely copied.
+ */
+always_inline int
+hicn_cs_arena_load (vlib_main_t *vm, hicn_cs_arena_t *arena, u32 slot_id,
+		    vlib_buffer_t *b)
+{
+  hicn_cs_arena_slot_t *slot = hicn_cs_arena_get_slot (arena, slot_id);
+  vlib_buffer_t *last = b;
+
+  if (b->flags & VLIB_BUFFER_NEXT_PRESENT)
+    {
+      vlib_buffer_free_one (vm, b->next_buffer);
+      b->flags &= ~VLIB_BUFFER_NEXT_PRESENT;
+    }
+  b->current_length = 0;
+  b->total_length_not_including_first_buffer = 0;
+  b->flags |= VLIB_BUFFER_TOTAL_LENGTH_VALID;
+
+  if (vlib_buffer_chain_append_data_with_alloc (vm, b, &last, slot->data,
+						slot->length) != slot->length)
+    return 0;
+
+  clib_memcpy_fast (b->opaque2, slot->opaque2, sizeof (b->opaque2));
+  arena->hits++;
+
+  return 1;
+}
+
+#endif /* __HICN_CS_ARENA_H__ */
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables: eval: (c-set-style "gnu") End:
+ */
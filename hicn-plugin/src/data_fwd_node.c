@@ -66,7 +66,7 @@ hicn_data_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 
   u32 n_left_from, *from, *to_next;
   hicn_data_fwd_next_t next_index;
-  hicn_pit_cs_t *pitcs = &hicn_main.pitcs;
+  hicn_pit_cs_t *pitcs = hicn_pitcs_get (vm->thread_index);
   vl_api_hicn_api_node_stats_get_reply_t stats = { 0 };
   f64 tnow;
   u32 data_received = 1;
@@ -221,8 +221,11 @@ hicn_data_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 	       * Call the strategy callback since the
 	       * interest has been satisfied
 	       */
-	      strategy_vft0->hicn_receive_data (dpo_ctx_id0,
-						pitp->u.pit.pe_txnh);
+	      strategy_vft0->hicn_receive_data (
+		dpo_ctx_id0, pitp->u.pit.pe_txnh,
+		(pitp->shared.entry_flags & HICN_PCS_ENTRY_PIT_RETX_FLAG) ?
+			-1 :
+			tnow - pitp->shared.create_time);
 
 #if HICN_FEATURE_CS
 	      hicn_lifetime_t dmsg_lifetime;
@@ -33,134 +33,172 @@ always_inline u8 *hicn_data_pcslookup_format_trace (u8 *s, va_list *args);
 
 vlib_node_registration_t hicn_data_pcslookup_node;
 
+/*
+ * First stage of the lookup: parse the data, hash its name and prefetch the
+ * PCS bucket the hash maps to.
+ */
+always_inline void
+hicn_data_pcslookup_stage (vlib_buffer_t *b, hicn_hash_lookup_t *lk,
+			   hicn_hashtb_h pcs_table)
+{
+  lk->name_hash = 0;
+  lk->hicn = NULL;
+  lk->ret =
+    hicn_data_parse_pkt (b, &lk->name, &lk->namelen, &lk->hicn, &lk->isv6);
+
+  if (PREDICT_TRUE (lk->ret == HICN_ERROR_NONE))
+    lk->ret = hicn_hashtb_fullhash ((u8 *) &lk->name, lk->namelen,
+				    &lk->name_hash);
+
+  if (PREDICT_TRUE (lk->ret == HICN_ERROR_NONE))
+    hicn_hashtb_prefetch_bucket (pcs_table, lk->name_hash);
+}
+
+/*
+ * Second stage of the lookup: search the (hopefully cached) bucket and store
+ * the result in the buffer for the next nodes.
+ */
+always_inline u16
+hicn_data_pcslookup_resolve (vlib_main_t *vm, vlib_node_runtime_t *node,
+			     vlib_buffer_t *b, hicn_hash_lookup_t *lk,
+			     hicn_pit_cs_t *pitcs,
+			     vl_api_hicn_api_node_stats_get_reply_t *stats)
+{
+  u16 next = HICN_DATA_PCSLOOKUP_NEXT_ERROR_DROP;
+  u32 node_id = 0;
+  index_t dpo_ctx_id = 0;
+  u8 vft_id = 0;
+  u8 is_cs = 0;
+  u8 hash_entry_id = 0;
+  u8 bucket_is_overflown = 0;
+  u32 bucket_id = ~0;
+
+  /* Incr packet counter */
+  stats->pkts_processed += 1;
+
+  if (PREDICT_TRUE (lk->ret == HICN_ERROR_NONE))
+    {
+      int res = hicn_hashtb_lookup_node (
+	pitcs->pcs_table, (u8 *) &lk->name, lk->namelen, lk->name_hash,
+	1
+	/*is_data. Do not take lock if hit CS */
+	,
+	&node_id, &dpo_ctx_id, &vft_id, &is_cs, &hash_entry_id, &bucket_id,
+	&bucket_is_overflown);
+
+      stats->pkts_data_count += 1;
+
+      if (res == HICN_ERROR_NONE)
+	{
+	  /*
+	   * In case the result of the lookup
+	   * is a CS entry, the packet is
+	   * dropped
+	   */
+	  next = HICN_DATA_PCSLOOKUP_NEXT_DATA_FWD + is_cs;
+	}
+    }
+
+  hicn_store_internal_state (b, lk->name_hash, node_id, dpo_ctx_id, vft_id,
+			     hash_entry_id, bucket_id, bucket_is_overflown);
+
+  /* Maybe trace */
+  if (PREDICT_FALSE ((node->flags & VLIB_NODE_FLAG_TRACE) &&
+		     (b->flags & VLIB_BUFFER_IS_TRACED)))
+    {
+      hicn_data_pcslookup_trace_t *t =
+	vlib_add_trace (vm, node, b, sizeof (*t));
+      t->pkt_type = HICN_PKT_TYPE_CONTENT;
+      t->sw_if_index = vnet_buffer (b)->sw_if_index[VLIB_RX];
+      t->next_index = next;
+    }
+
+  return next;
+}
+
 /*
  * hICN node for handling data. It performs a lookup in the PIT.
+ *
+ * Lookups are pipelined: while packets i and i+1 are resolved, the names of
+ * packets i+2 and i+3 are already hashed and their buckets prefetched.
  */
 static uword
 hicn_data_pcslookup_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 			     vlib_frame_t *frame)
 {
-  u32 n_left_from, *from, *to_next;
-  hicn_data_pcslookup_next_t next_index;
+  u32 n_left_from, *from;
+  vlib_buffer_t *bufs[VLIB_FRAME_SIZE], **b;
+  u16 nexts[VLIB_FRAME_SIZE], *next;
+  hicn_hash_lookup_t lk[4];
   hicn_data_pcslookup_runtime_t *rt;
+  hicn_hashtb_h pcs_table;
   vl_api_hicn_api_node_stats_get_reply_t stats = { 0 };
+  u32 i;
 
   rt = vlib_node_get_runtime_data (vm, node->node_index);
 
   if (PREDICT_FALSE (rt->pitcs == NULL))
     {
-      rt->pitcs = &hicn_main.pitcs;
+      rt->pitcs = hicn_pitcs_get (vm->thread_index);
     }
+  pcs_table = rt->pitcs->pcs_table;
+
   from = vlib_frame_vector_args (frame);
   n_left_from = frame->n_vectors;
-  next_index = node->cached_next_index;
+  b = bufs;
+  next = nexts;
+  vlib_get_buffers (vm, from, bufs, n_left_from);
+
+  /* Fill the pipeline with the first two packets */
+  for (i = 0; i < 2 && i < n_left_from; i++)
+    hicn_data_pcslookup_stage (b[i], &lk[i], pcs_table);
+
+  i = 0;
+  while (n_left_from >= 4)
+    {
+      /* Prefetch the packets staged at the next iteration */
+      if (n_left_from >= 6)
+	{
+	  // Prefetch two cache lines-- 128 byte-- so that we load the
+	  // hicn_buffer_t as well
+	  CLIB_PREFETCH (b[4], 2 * CLIB_CACHE_LINE_BYTES, STORE);
+	  CLIB_PREFETCH (b[5], 2 * CLIB_CACHE_LINE_BYTES, STORE);
+	  CLIB_PREFETCH (b[4]->data, CLIB_CACHE_LINE_BYTES, LOAD);
+	  CLIB_PREFETCH (b[5]->data, CLIB_CACHE_LINE_BYTES, LOAD);
+	}
+
+      hicn_data_pcslookup_stage (b[2], &lk[(i + 2) & 3], pcs_table);
+      hicn_data_pcslookup_stage (b[3], &lk[(i + 3) & 3], pcs_table);
 
+      next[0] = hicn_data_pcslookup_resolve (vm, node, b[0], &lk[i & 3],
+					     rt->pitcs, &stats);
+      next[1] = hicn_data_pcslookup_resolve (vm, node, b[1],
+					     &lk[(i + 1) & 3], rt->pitcs,
+					     &stats);
+
+      b += 2;
+      next += 2;
+      n_left_from -= 2;
+      i += 2;
+    }
+
+  /* Drain the pipeline */
   while (n_left_from > 0)
     {
-      u32 n_left_to_next;
-      vlib_get_next_frame (vm, node, next_index, to_next, n_left_to_next);
+      if (n_left_from > 2)
+	hicn_data_pcslookup_stage (b[2], &lk[(i + 2) & 3], pcs_table);
 
-      while (n_left_from > 0 && n_left_to_next > 0)
-	{
-	  vlib_buffer_t *b0;
-	  u8 isv6;
-	  u8 *nameptr;
-	  u16 namelen;
-	  u32 bi0;
-	  u32 next0 = HICN_DATA_PCSLOOKUP_NEXT_ERROR_DROP;
-	  u64 name_hash = 0;
-	  hicn_name_t name;
-	  hicn_header_t *hicn0 = NULL;
-	  u32 node_id0 = 0;
-	  index_t dpo_ctx_id0 = 0;
-	  int ret0;
-	  u8 vft_id0;
-	  u8 is_cs0;
-	  u8 hash_entry_id = 0;
-	  u8 bucket_is_overflown = 0;
-	  u32 bucket_id = ~0;
-
-	  /* Prefetch for next iteration. */
-	  if (n_left_from > 1)
-	    {
-	      vlib_buffer_t *b1;
-	      b1 = vlib_get_buffer (vm, from[1]);
-	      // Prefetch two cache lines-- 128 byte-- so that we load the
-	      // hicn_buffer_t as well
-	      CLIB_PREFETCH (b1, 2 * CLIB_CACHE_LINE_BYTES, STORE);
-	      CLIB_PREFETCH (b1->data, CLIB_CACHE_LINE_BYTES, LOAD);
-	    }
-	  /* Dequeue a packet buffer */
-	  bi0 = from[0];
-	  from += 1;
-	  n_left_from -= 1;
-	  to_next[0] = bi0;
-	  to_next += 1;
-	  n_left_to_next -= 1;
-
-	  b0 = vlib_get_buffer (vm, bi0);
-	  next0 = HICN_DATA_PCSLOOKUP_NEXT_ERROR_DROP;
-
-	  /* Incr packet counter */
-	  stats.pkts_processed += 1;
-
-	  ret0 = hicn_data_parse_pkt (b0, &name, &namelen, &hicn0, &isv6);
-	  nameptr = (u8 *) (&name);
-
-	  if (PREDICT_TRUE (
-		ret0 == HICN_ERROR_NONE &&
-		hicn_hashtb_fullhash (nameptr, namelen, &name_hash) ==
-		  HICN_ERROR_NONE))
-	    {
-	      int res = hicn_hashtb_lookup_node (
-		rt->pitcs->pcs_table, nameptr, namelen, name_hash,
-		1
-		/*is_data. Do not take lock if hit CS */
-		,
-		&node_id0, &dpo_ctx_id0, &vft_id0, &is_cs0, &hash_entry_id,
-		&bucket_id, &bucket_is_overflown);
-
-	      stats.pkts_data_count += 1;
-
-	      if (res == HICN_ERROR_NONE)
-		{
-		  /*
-		   * In case the result of the lookup
-		   * is a CS entry, the packet is
-		   * dropped
-		   */
-		  next0 = HICN_DATA_PCSLOOKUP_NEXT_DATA_FWD + is_cs0;
-		}
-	    }
-
-	  hicn_store_internal_state (b0, name_hash, node_id0, dpo_ctx_id0,
-				     vft_id0, hash_entry_id, bucket_id,
-				     bucket_is_overflown);
+      next[0] = hicn_data_pcslookup_resolve (vm, node, b[0], &lk[i & 3],
+					     rt->pitcs, &stats);
 
-	  /*
-	   * Verify speculative enqueue, maybe switch current
-	   * next frame
-	   */
-	  /*
-	   * Fix in case of a wrong speculation. Needed to
-	   * clone the data in the right frame
-	   */
-	  vlib_validate_buffer_enqueue_x1 (vm, node, next_index, to_next,
-					   n_left_to_next, bi0, next0);
-
-	  /* Maybe trace */
-	  if (PREDICT_FALSE ((node->flags & VLIB_NODE_FLAG_TRACE) &&
-			     (b0->flags & VLIB_BUFFER_IS_TRACED)))
-	    {
-	      hicn_data_pcslookup_trace_t *t =
-		vlib_add_trace (vm, node, b0, sizeof (*t));
-	      t->pkt_type = HICN_PKT_TYPE_CONTENT;
-	      t->sw_if_index = vnet_buffer (b0)->sw_if_index[VLIB_RX];
-	      t->next_index = next0;
-	    }
-	}
-      vlib_put_next_frame (vm, node, next_index, n_left_to_next);
+      b += 1;
+      next += 1;
+      n_left_from -= 1;
+      i += 1;
     }
+
+  vlib_buffer_enqueue_to_next (vm, node, from, nexts, frame->n_vectors);
+
   /* Check the CS LRU, and trim if necessary. */
   u32 pit_int_count = hicn_pit_get_int_count (rt->pitcs);
   u32 pit_cs_count = hicn_pit_get_cs_count (rt->pitcs);
@@ -45,7 +45,17 @@ typedef struct hicn_face_bucket_s
 
 } hicn_face_bucket_t;
 
-extern hicn_face_bucket_t *hicn_face_bucket_pool;
+/*
+ * Pools of face buckets, one per thread. A PIT entry is only accessed by the
+ * thread owning its PIT/CS, so every thread allocates from its own pool.
+ */
+extern hicn_face_bucket_t **hicn_face_bucket_pools;
+
+always_inline hicn_face_bucket_t **
+hicn_face_db_pool (void)
+{
+  return vec_elt_at_index (hicn_face_bucket_pools, vlib_get_thread_index ());
+}
 
 typedef struct __attribute__ ((packed)) hicn_face_db_s
 {
@@ -77,20 +87,21 @@ hicn_face_db_get_dpo_face (u32 index, hicn_face_db_t * face_db)
   ASSERT (index < face_db->n_faces);
 
   return index < HICN_FACE_DB_INLINE_FACES ? (face_db->inline_faces[index]) :
-    (pool_elt_at_index (hicn_face_bucket_pool, face_db->next_bucket)->faces
+    (pool_elt_at_index (*hicn_face_db_pool (), face_db->next_bucket)->faces
       [(index - HICN_FACE_DB_INLINE_FACES) & (HICN_PIT_N_HOP_BUCKET - 1)]);
 }
 
 always_inline void
-hicn_face_db_init (int max_element)
+hicn_face_db_init (u32 thread_index, int max_element)
 {
-  pool_init_fixed (hicn_face_bucket_pool, max_element);
+  vec_validate (hicn_face_bucket_pools, thread_index);
+  pool_init_fixed (hicn_face_bucket_pools[thread_index], max_element);
 }
 
 always_inline hicn_face_bucket_t *
 hicn_face_db_get_bucket (u32 bucket_index)
 {
-  return pool_elt_at_index (hicn_face_bucket_pool, bucket_index);
+  return pool_elt_at_index (*hicn_face_db_pool (), bucket_index);
 }
 
 always_inline void
@@ -99,7 +110,7 @@ hicn_face_db_add_face (hicn_face_id_t face_id, hicn_face_db_t * face_db)
   //ASSERT (dpo->dpoi_index != ~0);
 
   hicn_face_bucket_t *faces_bkt =
-    pool_elt_at_index (hicn_face_bucket_pool, face_db->next_bucket);
+    pool_elt_at_index (*hicn_face_db_pool (), face_db->next_bucket);
 
   hicn_face_id_t *element =
     face_db->n_faces <
@@ -122,7 +133,7 @@ always_inline u8
 hicn_face_search (hicn_face_id_t index, hicn_face_db_t * face_db)
 {
   hicn_face_bucket_t *faces_bkt =
-    pool_elt_at_index (hicn_face_bucket_pool, face_db->next_bucket);
+    pool_elt_at_index (*hicn_face_db_pool (), face_db->next_bucket);
   u32 bitmap_index = index % HICN_PIT_N_HOP_BITMAP_SIZE;
 
   u32 position_array = bitmap_index / 8;
@@ -135,10 +146,10 @@ always_inline void
 hicn_faces_flush (hicn_face_db_t * face_db)
 {
   hicn_face_bucket_t *faces_bkt =
-    pool_elt_at_index (hicn_face_bucket_pool, face_db->next_bucket);
+    pool_elt_at_index (*hicn_face_db_pool (), face_db->next_bucket);
   clib_memset_u8 (&(faces_bkt->bitmap), 0, HICN_PIT_BITMAP_SIZE_BYTE);
   face_db->n_faces = 0;
-  pool_put_index (hicn_face_bucket_pool, face_db->next_bucket);
+  pool_put_index (*hicn_face_db_pool (), face_db->next_bucket);
 }
 
 
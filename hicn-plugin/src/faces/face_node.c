@@ -350,7 +350,7 @@ VLIB_REGISTER_NODE(hicn4_face_input_node) =
   /* edit / add dispositions here */
   .next_nodes =
   {
-    [HICN4_FACE_INPUT_NEXT_DATA] = "hicn-data-pcslookup",
+    [HICN4_FACE_INPUT_NEXT_DATA] = "hicn-data-handoff",
     [HICN4_FACE_INPUT_NEXT_MAPME] = "hicn-mapme-ack",
     [HICN4_FACE_INPUT_NEXT_ERROR_DROP] = "error-drop",
   },
@@ -427,7 +427,7 @@ VLIB_REGISTER_NODE(hicn6_face_input_node) =
   /* edit / add dispositions here */
   .next_nodes =
   {
-    [HICN6_FACE_INPUT_NEXT_DATA] = "hicn-data-pcslookup",
+    [HICN6_FACE_INPUT_NEXT_DATA] = "hicn-data-handoff",
     [HICN6_FACE_INPUT_NEXT_MAPME] = "hicn-mapme-ack",
     [HICN6_FACE_INPUT_NEXT_ERROR_DROP] = "error-drop",
   },
@@ -28,7 +28,8 @@
  *
  * Input face nodes follow hicn-face-input nodes and their purpose
  * is to retrieve the list of possible incoming faces for each the data packet.
- * The following node to the input face nodes is the hicn-data-pcslookup.
+ * The following node to the input face nodes is the hicn-data-handoff, that
+ * passes the packet to the hicn-data-pcslookup of the thread owning its name.
  * Output face nodes follow the strategy and the hicn-interest-hitpit nodes and
  * they perform the src nat on each interest packet. The node following the
  * output face nodes depends on the adjacency type. In case of ip, the following
@@ -431,7 +431,7 @@ VLIB_REGISTER_NODE (hicn4_iface_input_node) =
   /* edit / add dispositions*/
   .next_nodes =
   {
-    [HICN4_IFACE_INPUT_NEXT_INTEREST] = "hicn-interest-pcslookup",
+    [HICN4_IFACE_INPUT_NEXT_INTEREST] = "hicn-interest-handoff",
     [HICN4_IFACE_INPUT_NEXT_MAPME] = "hicn-mapme-ctrl",
     [HICN4_IFACE_INPUT_NEXT_ERROR_DROP] = "error-drop",
   },
@@ -505,7 +505,7 @@ VLIB_REGISTER_NODE (hicn6_iface_input_node) =
   /* edit / add dispositions*/
   .next_nodes =
   {
-    [HICN6_IFACE_INPUT_NEXT_INTEREST] = "hicn-interest-pcslookup",
+    [HICN6_IFACE_INPUT_NEXT_INTEREST] = "hicn-interest-handoff",
     [HICN6_IFACE_INPUT_NEXT_MAPME] = "hicn-mapme-ctrl",
     [HICN6_IFACE_INPUT_NEXT_ERROR_DROP] = "error-drop",
   },
@@ -29,7 +29,9 @@
  * Input iface nodes follow ip-lookup nodes and their purpose
  * is to create (or retrieve if already existing) the list incoming face
  * for each the interest packet.
- * The following node to the input iface nodes is the hicn-interest-pcslookup.
+ * The following node to the input iface nodes is the hicn-interest-handoff,
+ * that passes the packet to the hicn-interest-pcslookup of the thread owning
+ * its name.
  * Output iface nodes follow the hicn-data-fwd and the hicn-interest-hitcs nodes and
  * they perform the dst nat on each data packet. The node following the
  * output face nodes depends on the adjacency type. In case of ip, the following
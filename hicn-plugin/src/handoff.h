@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HICN_HANDOFF_H__
+#define __HICN_HANDOFF_H__
+
+#include <vlib/vlib.h>
+
+/**
+ * @file handoff.h
+ *
+ * The PIT/CS is partitioned among the forwarding threads. The handoff nodes
+ * sit between the face input nodes and the pcslookup nodes: they hash the
+ * name of every interest (hicn-interest-handoff) or data (hicn-data-handoff)
+ * and move the packet to the thread owning that name, so that an interest and
+ * the corresponding data are always processed by the same thread. With a
+ * single forwarding thread packets go straight to the pcslookup node.
+ */
+
+/* Trace context struct */
+typedef struct
+{
+  u32 next_worker_index;
+  u32 sw_if_index;
+  u8 pkt_type;
+} hicn_handoff_trace_t;
+
+typedef enum
+{
+  HICN_HANDOFF_NEXT_PCSLOOKUP,
+  HICN_HANDOFF_NEXT_ERROR_DROP,
+  HICN_HANDOFF_N_NEXT,
+} hicn_handoff_next_t;
+
+#define foreach_hicn_handoff_error                                            \
+  _ (CONGESTION_DROP, "congestion drop")                                      \
+  _ (SAME_WORKER, "same worker")                                              \
+  _ (DO_HANDOFF, "handed off to another worker")
+
+typedef enum
+{
+#define _(sym, str) HICN_HANDOFF_ERROR_##sym,
+  foreach_hicn_handoff_error
+#undef _
+    HICN_HANDOFF_N_ERROR,
+} hicn_handoff_error_t;
+
+#endif /* // __HICN_HANDOFF_H__ */
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables: eval: (c-set-style "gnu") End:
+ */
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vlib/vlib.h>
+#include <vnet/vnet.h>
+
+#include "handoff.h"
+#include "hashtb.h"
+#include "infra.h"
+#include "parser.h"
+
+/**
+ * @FILE This node hands off interests and data to the thread owning the
+ * PIT/CS entry of their name.
+ */
+
+/* Stats string values */
+static char *hicn_handoff_error_strings[] = {
+#define _(sym, string) string,
+  foreach_hicn_handoff_error
+#undef _
+};
+
+vlib_node_registration_t hicn_interest_handoff_node;
+vlib_node_registration_t hicn_data_handoff_node;
+
+always_inline uword
+hicn_handoff_inline (vlib_main_t *vm, vlib_node_runtime_t *node,
+		     vlib_frame_t *frame, u32 fq_index, u8 is_data)
+{
+  vlib_buffer_t *bufs[VLIB_FRAME_SIZE], **b;
+  u16 thread_indices[VLIB_FRAME_SIZE], *ti;
+  u32 n_left_from, *from, n_enq;
+  u32 thread_index = vm->thread_index;
+  u32 same_worker = 0, do_handoff = 0;
+
+  from = vlib_frame_vector_args (frame);
+  n_left_from = frame->n_vectors;
+
+  /* A single forwarding thread owns the whole PIT/CS */
+  if (hicn_main.pcs_first_thread == 0)
+    {
+      u16 nexts[VLIB_FRAME_SIZE];
+
+      clib_memset_u16 (nexts, HICN_HANDOFF_NEXT_PCSLOOKUP, n_left_from);
+      vlib_buffer_enqueue_to_next (vm, node, from, nexts, n_left_from);
+      return frame->n_vectors;
+    }
+
+  vlib_get_buffers (vm, from, bufs, n_left_from);
+  b = bufs;
+  ti = thread_indices;
+
+  while (n_left_from > 0)
+    {
+      hicn_name_t name;
+      hicn_header_t *hicn0;
+      u64 name_hash;
+      u16 namelen;
+      u8 isv6;
+      int ret;
+
+      /* Prefetch for next iteration. */
+      if (n_left_from > 4)
+	{
+	  vlib_prefetch_buffer_header (b[4], STORE);
+	  CLIB_PREFETCH (b[4]->data, CLIB_CACHE_LINE_BYTES, LOAD);
+	}
+
+      ret = is_data ?
+	      hicn_data_parse_pkt (b[0], &name, &namelen, &hicn0, &isv6) :
+	      hicn_interest_parse_pkt (b[0], &name, &namelen, &hicn0, &isv6);
+
+      /*
+       * Malformed packets are sent to a forwarding thread anyway, the
+       * pcslookup node drops them.
+       */
+      if (PREDICT_TRUE (ret == HICN_ERROR_NONE &&
+			hicn_hashtb_fullhash ((u8 *) &name, namelen,
+					      &name_hash) == HICN_ERROR_NONE))
+	ti[0] = hicn_pcs_thread_from_hash (name_hash);
+      else
+	ti[0] = hicn_main.pcs_first_thread;
+
+      if (ti[0] == thread_index)
+	same_worker++;
+      else
+	do_handoff++;
+
+      /* Maybe trace */
+      if (PREDICT_FALSE ((node->flags & VLIB_NODE_FLAG_TRACE) &&
+			 (b[0]->flags & VLIB_BUFFER_IS_TRACED)))
+	{
+	  hicn_handoff_trace_t *t =
+	    vlib_add_trace (vm, node, b[0], sizeof (*t));
+	  t->pkt_type = is_data ? HICN_PKT_TYPE_CONTENT : HICN_PKT_TYPE_INTEREST;
+	  t->sw_if_index = vnet_buffer (b[0])->sw_if_index[VLIB_RX];
+	  t->next_worker_index = ti[0];
+	}
+
+      b += 1;
+      ti += 1;
+      n_left_from -= 1;
+    }
+
+  n_enq = vlib_buffer_enqueue_to_thread (vm, fq_index, from, thread_indices,
+					 frame->n_vectors, 1);
+
+  if (n_enq < frame->n_vectors)
+    vlib_node_increment_counter (vm, node->node_index,
+				 HICN_HANDOFF_ERROR_CONGESTION_DROP,
+				 frame->n_vectors - n_enq);
+
+  vlib_node_increment_counter (vm, node->node_index,
+			       HICN_HANDOFF_ERROR_SAME_WORKER, same_worker);
+  vlib_node_increment_counter (vm, node->node_index,
+			       HICN_HANDOFF_ERROR_DO_HANDOFF, do_handoff);
+
+  return frame->n_vectors;
+}
+
+static uword
+hicn_interest_handoff_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
+			       vlib_frame_t *frame)
+{
+  return hicn_handoff_inline (vm, node, frame, hicn_main.interest_fq_index,
+			      0 /* is_data */);
+}
+
+static uword
+hicn_data_handoff_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
+			   vlib_frame_t *frame)
+{
+  return hicn_handoff_inline (vm, node, frame, hicn_main.data_fq_index,
+			      1 /* is_data */);
+}
+
+/* packet trace format function */
+static u8 *
+hicn_handoff_format_trace (u8 *s, va_list *args)
+{
+  CLIB_UNUSED (vlib_main_t * vm) = va_arg (*args, vlib_main_t *);
+  CLIB_UNUSED (vlib_node_t * node) = va_arg (*args, vlib_node_t *);
+  hicn_handoff_trace_t *t = va_arg (*args, hicn_handoff_trace_t *);
+
+  s = format (s, "HANDOFF: pkt: %d, sw_if_index %d, next worker %d",
+	      (int) t->pkt_type, t->sw_if_index, t->next_worker_index);
+  return (s);
+}
+
+/*
+ * Node registration for the handoff nodes
+ */
+VLIB_REGISTER_NODE(hicn_interest_handoff_node) =
+{
+  .function = hicn_interest_handoff_node_fn,
+  .name = "hicn-interest-handoff",
+  .vector_size = sizeof(u32),
+  .format_trace = hicn_handoff_format_trace,
+  .type = VLIB_NODE_TYPE_INTERNAL,
+  .n_errors = ARRAY_LEN(hicn_handoff_error_strings),
+  .error_strings = hicn_handoff_error_strings,
+  .n_next_nodes = HICN_HANDOFF_N_NEXT,
+  .next_nodes =
+  {
+    [HICN_HANDOFF_NEXT_PCSLOOKUP] = "hicn-interest-pcslookup",
+    [HICN_HANDOFF_NEXT_ERROR_DROP] = "error-drop",
+  },
+};
+
+VLIB_REGISTER_NODE(hicn_data_handoff_node) =
+{
+  .function = hicn_data_handoff_node_fn,
+  .name = "hicn-data-handoff",
+  .vector_size = sizeof(u32),
+  .format_trace = hicn_handoff_format_trace,
+  .type = VLIB_NODE_TYPE_INTERNAL,
+  .n_errors = ARRAY_LEN(hicn_handoff_error_strings),
+  .error_strings = hicn_handoff_error_strings,
+  .n_next_nodes = HICN_HANDOFF_N_NEXT,
+  .next_nodes =
+  {
+    [HICN_HANDOFF_NEXT_PCSLOOKUP] = "hicn-data-pcslookup",
+    [HICN_HANDOFF_NEXT_ERROR_DROP] = "error-drop",
+  },
+};
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables: eval: (c-set-style "gnu") End:
+ */
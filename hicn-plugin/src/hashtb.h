@@ -245,7 +245,7 @@ typedef struct __attribute__ ((packed))
 #define HICN_HASHTB_FILL_FACTOR    4
 
 #define HICN_HASHTB_MIN_ENTRIES  (1 << 4)	// includes dummy node 0 entry
-#define HICN_HASHTB_MAX_ENTRIES  (1 << 24)
+#define HICN_HASHTB_MAX_ENTRIES  (1 << 26)
 
 #define HICN_HASHTB_MIN_BUCKETS (1 << 10)
 
@@ -490,6 +490,32 @@ hicn_hashtb_bucket_idx (hicn_hashtb_h h, u64 hashval)
   return ((u32) (hashval & (h->ht_bucket_count - 1)));
 }
 
+/*
+ * Prefetch the bucket a hash value maps to. Buckets are two cache lines
+ * long, so both are pulled in.
+ */
+always_inline void
+hicn_hashtb_prefetch_bucket (hicn_hashtb_h h, u64 hashval)
+{
+  CLIB_PREFETCH (h->ht_buckets + hicn_hashtb_bucket_idx (h, hashval),
+		 sizeof (hicn_hash_bucket_t), LOAD);
+}
+
+/*
+ * Name parsed and hashed ahead of its lookup. Nodes processing a vector of
+ * packets fill this a couple of packets in advance and prefetch the bucket,
+ * so that the lookup does not stall on a cold cache line.
+ */
+typedef struct hicn_hash_lookup_s
+{
+  hicn_name_t name;
+  hicn_header_t *hicn;
+  u64 name_hash;
+  u16 namelen;
+  u8 isv6;
+  int ret;
+} hicn_hash_lookup_t;
+
 /*
  * Return a hash node struct from the free list, or NULL. Note that the
  * returned struct is _not_ cleared/zeroed - init is up to the caller.
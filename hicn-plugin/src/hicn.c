@@ -40,31 +40,69 @@ int hicn_infra_fwdr_initialized = 0;
 uint16_t hicn_infra_fast_timer; /* Counts at 1 second intervals */
 uint16_t hicn_infra_slow_timer; /* Counts at 1 minute intervals */
 
-hicn_face_bucket_t *hicn_face_bucket_pool;
+hicn_face_bucket_t **hicn_face_bucket_pools;
 
 /*
- * Init hicn forwarder with configurable PIT, CS sizes
+ * Init hicn forwarder with configurable PIT, CS sizes. Each forwarding thread
+ * gets its own PIT/CS, holding a share of the configured sizes: interests and
+ * data are handed off to the thread owning their name, so no table is ever
+ * accessed by two threads.
  */
 static int
-hicn_infra_fwdr_init (uint32_t shard_pit_size, uint32_t shard_cs_size)
+hicn_infra_fwdr_init (uint32_t pit_size, uint32_t cs_size)
 {
+  vlib_thread_main_t *tm = vlib_get_thread_main ();
   int ret = 0;
+  u32 i;
 
   if (hicn_infra_fwdr_initialized)
     {
       ret = HICN_ERROR_FWD_ALREADY_ENABLED;
       goto done;
     }
+
+  /* Packets are forwarded by the workers, or by the main thread alone */
+  hicn_main.pcs_n_threads = tm->n_vlib_mains > 1 ? tm->n_vlib_mains - 1 : 1;
+  hicn_main.pcs_first_thread = tm->n_vlib_mains > 1 ? 1 : 0;
+
   /* Init per worker limits */
-  hicn_infra_pit_size = shard_pit_size;
-  hicn_infra_cs_size = shard_cs_size;
+  hicn_infra_pit_size = clib_max (pit_size / hicn_main.pcs_n_threads,
+				  HICN_PARAM_PIT_ENTRIES_MIN);
+  hicn_infra_cs_size = cs_size / hicn_main.pcs_n_threads;
+  hicn_infra_cs_arena_size =
+    hicn_main.cs_arena_size / hicn_main.pcs_n_threads;
 
   /* Init the global time-compression counters */
   hicn_infra_fast_timer = 1;
   hicn_infra_slow_timer = 1;
 
-  ret = hicn_pit_create (&hicn_main.pitcs, hicn_infra_pit_size);
-  hicn_pit_set_lru_max (&hicn_main.pitcs, hicn_infra_cs_size);
+  vec_validate (hicn_main.pitcs, tm->n_vlib_mains - 1);
+  for (i = hicn_main.pcs_first_thread;
+       i < hicn_main.pcs_first_thread + hicn_main.pcs_n_threads; i++)
+    {
+      /* Entries moved to the arena stay in the PIT/CS hashtable */
+      ret = hicn_pit_create (hicn_pitcs_get (i),
+			     hicn_infra_pit_size + hicn_infra_cs_arena_size);
+      if (ret != HICN_ERROR_NONE)
+	goto done;
+
+      ret = hicn_cs_arena_init (&hicn_pitcs_get (i)->cs_arena,
+				hicn_infra_cs_arena_size);
+      if (ret != HICN_ERROR_NONE)
+	goto done;
+
+      hicn_pit_set_lru_max (hicn_pitcs_get (i), hicn_infra_cs_size);
+      hicn_face_db_init (i, hicn_infra_pit_size);
+    }
+
+  if (hicn_main.pcs_first_thread > 0)
+    {
+      hicn_main.interest_fq_index =
+	vlib_frame_queue_main_init (hicn_interest_pcslookup_node.index, 0);
+      hicn_main.data_fq_index =
+	vlib_frame_queue_main_init (hicn_data_pcslookup_node.index, 0);
+    }
+
 done:
   if ((ret == HICN_ERROR_NONE) && !hicn_infra_fwdr_initialized)
     {
@@ -165,8 +203,6 @@ hicn_infra_plugin_enable_disable (int enable_disable, int pit_size_req,
 
   ret = hicn_infra_fwdr_init (pit_size, cs_size);
 
-  hicn_face_db_init (pit_size);
-
   if (ret != HICN_ERROR_NONE)
     {
       goto done;
@@ -186,6 +222,7 @@ hicn_configure (vlib_main_t *vm, unformat_input_t *input)
   u32 pit_size = HICN_PARAM_PIT_ENTRIES_DFLT;
   u32 cs_size = HICN_PARAM_CS_ENTRIES_DFLT;
   u64 pit_lifetime_max_sec = HICN_PARAM_PIT_LIFETIME_DFLT_MAX_MS / SEC_MS;
+  u32 cs_arena_size = HICN_PARAM_CS_ARENA_ENTRIES_DFLT;
 
   vnet_link_t link;
 
@@ -195,6 +232,8 @@ hicn_configure (vlib_main_t *vm, unformat_input_t *input)
 	;
       else if (unformat (input, "cs-size %u", &cs_size))
 	;
+      else if (unformat (input, "cs-arena-size %u", &cs_arena_size))
+	;
       else if (unformat (input, "pit-lifetime-max %u", &pit_lifetime_max_sec))
 	;
       else if (unformat (input, "grab mpls-tunnels"))
@@ -205,6 +244,11 @@ hicn_configure (vlib_main_t *vm, unformat_input_t *input)
 
   unformat_free (input);
 
+  if (cs_arena_size > HICN_PARAM_CS_ARENA_ENTRIES_MAX)
+    return clib_error_return (0, "%s",
+			      get_error_string (HICN_ERROR_CS_CONFIG_SIZE_OOB));
+  hicn_main.cs_arena_size = cs_arena_size;
+
   hicn_infra_plugin_enable_disable (1, pit_size, pit_lifetime_max_sec, cs_size,
 				    link);
 
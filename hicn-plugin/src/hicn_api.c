@@ -104,11 +104,13 @@ vl_api_hicn_api_node_params_get_t_handler (
   REPLY_MACRO2 (VL_API_HICN_API_NODE_PARAMS_GET_REPLY, ({
 		  rmp->is_enabled = sm->is_enabled;
 		  rmp->feature_cs = HICN_FEATURE_CS;
-		  rmp->pit_max_size =
-		    clib_host_to_net_u32 (hicn_infra_pit_size);
+		  /* Sizes of all the per-thread tables together */
+		  rmp->pit_max_size = clib_host_to_net_u32 (
+		    hicn_infra_pit_size * sm->pcs_n_threads);
 		  rmp->pit_max_lifetime_sec =
 		    ((f64) sm->pit_lifetime_max_ms) / SEC_MS;
-		  rmp->cs_max_size = clib_host_to_net_u32 (hicn_infra_cs_size);
+		  rmp->cs_max_size = clib_host_to_net_u32 (
+		    hicn_infra_cs_size * sm->pcs_n_threads);
 		  rmp->retval = clib_host_to_net_i32 (rv);
 		}));
 }
@@ -38,8 +38,23 @@ typedef struct hicn_main_s
   /* Have we been enabled */
   u16 is_enabled;
 
-  /* Forwarder PIT/CS */
-  hicn_pit_cs_t pitcs;
+  /*
+   * Forwarder PIT/CS, one per thread (vector indexed by thread index). Only
+   * the forwarding threads (the workers, or the main thread if there are
+   * none) have a table allocated.
+   */
+  hicn_pit_cs_t *pitcs;
+
+  /* Forwarding threads, the ones owning a PIT/CS */
+  u32 pcs_first_thread;
+  u32 pcs_n_threads;
+
+  /* Frame queues used to hand off packets to the thread owning their name */
+  u32 interest_fq_index;
+  u32 data_fq_index;
+
+  /* Entries of the CS arena, split among the forwarding threads */
+  u32 cs_arena_size;
 
   /* Global PIT lifetime info */
   /*
@@ -56,16 +71,39 @@ extern hicn_main_t hicn_main;
 
 extern int hicn_infra_fwdr_initialized;
 
-/* PIT and CS size */
+/**
+ * @brief Return the PIT/CS owned by a thread
+ */
+always_inline hicn_pit_cs_t *
+hicn_pitcs_get (u32 thread_index)
+{
+  return vec_elt_at_index (hicn_main.pitcs, thread_index);
+}
+
+/**
+ * @brief Return the thread owning the PIT/CS entry of a name
+ *
+ * The high half of the hash is used, since the low bits select the bucket in
+ * the hash table.
+ */
+always_inline u32
+hicn_pcs_thread_from_hash (u64 name_hash)
+{
+  return hicn_main.pcs_first_thread +
+	 (u32) (name_hash >> 32) % hicn_main.pcs_n_threads;
+}
+
+/* PIT, CS and CS arena size of each forwarding thread */
 u32 hicn_infra_pit_size;
 u32 hicn_infra_cs_size;
+u32 hicn_infra_cs_arena_size;
 
 /**
  * @brief Enable and disable the hicn plugin
  *
  * Enable the time the hICN plugin and set the forwarder parameters.
  * @param enable_disable 1 if to enable, 0 otherwisw (currently only enable is supported)
- * @param pit_max_size Max size of the PIT
+ * @param pit_max_size Max size of the PIT, split among the forwarding threads
  * @param pit_max_lifetime_sec_req Maximum timeout allowed for a PIT entry lifetime
  * @param cs_max_size CS size. Must be <= than pit_max_size
  * @param cs_reserved_app Amount of CS reserved for application faces
@@ -79,6 +117,8 @@ hicn_infra_plugin_enable_disable (int enable_disable,
 
 
 /* vlib nodes that compose the hICN forwarder */
+extern vlib_node_registration_t hicn_interest_handoff_node;
+extern vlib_node_registration_t hicn_data_handoff_node;
 extern vlib_node_registration_t hicn_interest_pcslookup_node;
 extern vlib_node_registration_t hicn_data_pcslookup_node;
 extern vlib_node_registration_t hicn_data_fwd_node;
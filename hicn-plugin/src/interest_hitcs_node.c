@@ -89,6 +89,7 @@ hicn_interest_hitcs_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
   hicn_interest_hitcs_next_t next_index;
   hicn_interest_hitcs_runtime_t *rt;
   vl_api_hicn_api_node_stats_get_reply_t stats = { 0 };
+  u32 pkts_from_arena_count = 0;
   f64 tnow;
   int ret;
 
@@ -96,7 +97,7 @@ hicn_interest_hitcs_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 
   if (PREDICT_FALSE (rt->pitcs == NULL))
     {
-      rt->pitcs = &hicn_main.pitcs;
+      rt->pitcs = hicn_pitcs_get (vm->thread_index);
     }
   from = vlib_frame_vector_args (frame);
   n_left_from = frame->n_vectors;
@@ -180,8 +181,10 @@ hicn_interest_hitcs_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 	    }
 	  else
 	    {
+	      /* Entries in the arena are not tracked by the CS policy */
 	      if (PREDICT_TRUE (
-		    !(hash_entry0->he_flags & HICN_HASH_ENTRY_FLAG_DELETED)))
+		    !(hash_entry0->he_flags & HICN_HASH_ENTRY_FLAG_DELETED) &&
+		    !hicn_cs_entry_in_arena (pitp)))
 		hicn_pcs_cs_update (vm, rt->pitcs, pitp, pitp, node0);
 
 	      /*
@@ -192,7 +195,28 @@ hicn_interest_hitcs_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 				   HICN_INTEREST_HITCS_NEXT_IFACE4_OUT;
 	      vnet_buffer (b0)->ip.adj_index[VLIB_TX] = hicnb0->face_id;
 
-	      clone_from_cs (vm, &pitp->u.cs.cs_pkt_buf, b0, isv6);
+	      if (hicn_cs_entry_in_arena (pitp))
+		{
+		  if (PREDICT_FALSE (!hicn_cs_arena_load (
+			vm, &rt->pitcs->cs_arena, pitp->u.cs.cs_arena_slot,
+			b0)))
+		    {
+		      hicn_pcs_remove_lock (rt->pitcs, &pitp, &node0, vm,
+					    hash_entry0, dpo_vft0,
+					    &hicn_dpo_id0);
+		      vlib_node_increment_counter (
+			vm, hicn_interest_hitcs_node.index,
+			HICNFWD_ERROR_NO_BUFS, 1);
+		      drop_packet (&next0);
+		      goto end_processing;
+		    }
+
+		  /* Set flag for packet coming from CS */
+		  hicn_get_buffer (b0)->flags |= HICN_BUFFER_FLAGS_FROM_CS;
+		  pkts_from_arena_count++;
+		}
+	      else
+		clone_from_cs (vm, &pitp->u.cs.cs_pkt_buf, b0, isv6);
 
 	      stats.pkts_from_cache_count++;
 	      stats.pkts_data_count++;
@@ -232,6 +256,10 @@ hicn_interest_hitcs_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 			       HICNFWD_ERROR_CACHED,
 			       stats.pkts_from_cache_count);
 
+  vlib_node_increment_counter (vm, hicn_interest_hitcs_node.index,
+			       HICNFWD_ERROR_CACHED_ARENA,
+			       pkts_from_arena_count);
+
   vlib_node_increment_counter (vm, hicn_interest_hitcs_node.index,
 			       HICNFWD_ERROR_DATAS, stats.pkts_data_count);
 
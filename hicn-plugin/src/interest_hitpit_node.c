@@ -58,7 +58,7 @@ hicn_interest_hitpit_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 
   if (PREDICT_FALSE (rt->pitcs == NULL))
     {
-      rt->pitcs = &hicn_main.pitcs;
+      rt->pitcs = hicn_pitcs_get (vm->thread_index);
     }
   from = vlib_frame_vector_args (frame);
   n_left_from = frame->n_vectors;
@@ -147,7 +147,11 @@ hicn_interest_hitpit_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 	   */
 	  if (tnow > pitp->shared.expire_time)
 	    {
-	      strategy_vft0->hicn_on_interest_timeout (dpo_ctx_id0);
+	      strategy_vft0->hicn_on_interest_timeout (
+		dpo_ctx_id0,
+		(hash_entry0->he_flags & HICN_HASH_ENTRY_FLAG_CS_ENTRY) ?
+			-1 :
+			pitp->u.pit.pe_txnh);
 	      hicn_pcs_delete (rt->pitcs, &pitp, &node0, vm, hash_entry0,
 			       dpo_vft0, &hicn_dpo_id0);
 	      stats.pit_expired_count++;
@@ -187,6 +191,7 @@ hicn_interest_hitpit_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 		       * the PIT
 		       */
 		      pitp->u.pit.pe_txnh = nh_idx;
+		      pitp->shared.entry_flags |= HICN_PCS_ENTRY_PIT_RETX_FLAG;
 		      stats.interests_retx++;
 		    }
 		  else
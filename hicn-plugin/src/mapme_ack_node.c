@@ -40,33 +40,20 @@ static char *hicn_mapme_ack_error_strings[] = {
 };
 
 /*
- * @brief Process incoming ack messages (Interest Update Ack)
+ * @brief Remove the ingress face from the TFIB of an acknowledged prefix
  * @param vm vlib main data structure
- * @param b Control packet (IU)
+ * @param prefix Prefix carried by the IU Ack
+ * @param seq Sequence number of the IU Ack for this prefix
  * @param face_id Ingress face id
  */
-bool
-hicn_mapme_process_ack (vlib_main_t *vm, vlib_buffer_t *b,
-			hicn_face_id_t in_face)
+static_always_inline bool
+hicn_mapme_process_ack_prefix (vlib_main_t *vm, const hicn_prefix_t *prefix,
+			       seq_t seq, hicn_face_id_t in_face)
 {
   seq_t fib_seq;
   const dpo_id_t *dpo;
-  hicn_prefix_t prefix;
-  mapme_params_t params;
-  int rc;
-
-  /* Parse incoming message */
-  rc = hicn_mapme_parse_packet (vlib_buffer_get_current (b), &prefix, &params);
-  if (rc < 0)
-    goto ERR_PARSE;
-
-  /* if (params.seq == INVALID_SEQ) */
-  /*   { */
-  /*     DEBUG ("Invalid sequence number found in IU"); */
-  /*     return true; */
-  /*   } */
 
-  dpo = fib_epm_lookup (&(prefix.name), prefix.len);
+  dpo = fib_epm_lookup ((ip46_address_t *) &prefix->name, prefix->len);
   if (!dpo)
     {
       DEBUG ("Ignored ACK for non-existing FIB entry. Ignored.");
@@ -90,7 +77,7 @@ hicn_mapme_process_ack (vlib_main_t *vm, vlib_buffer_t *b,
    * As we always retransmit IU with the latest seq, we are not interested in
    * ACKs with inferior seq
    */
-  if (params.seq < fib_seq)
+  if (seq < fib_seq)
     {
       DEBUG ("Ignored ACK for low seq");
       return true;
@@ -105,9 +92,58 @@ hicn_mapme_process_ack (vlib_main_t *vm, vlib_buffer_t *b,
   retx_t *retx = vlib_process_signal_event_data (
     vm, hicn_mapme_eventmgr_process_node.index, HICN_MAPME_EVENT_FACE_PH_DEL,
     1, sizeof (retx_t));
-  *retx = (retx_t){ .prefix = prefix, .dpo = *dpo };
+  *retx = (retx_t){ .prefix = *prefix, .dpo = *dpo };
 
   return true;
+}
+
+/*
+ * @brief Process incoming ack messages (Interest Update Ack)
+ * @param vm vlib main data structure
+ * @param b Control packet (IU)
+ * @param face_id Ingress face id
+ *
+ * The ack of a batched IU acknowledges each of its prefixes.
+ */
+bool
+hicn_mapme_process_ack (vlib_main_t *vm, vlib_buffer_t *b,
+			hicn_face_id_t in_face)
+{
+  u8 *packet = vlib_buffer_get_current (b);
+  hicn_prefix_t prefix;
+  mapme_params_t params;
+  int rc;
+
+  if (hicn_mapme_is_batch (packet))
+    {
+      hicn_prefix_t prefixes[HICN_MAPME_BATCH_MAX];
+      seq_t seqs[HICN_MAPME_BATCH_MAX];
+      bool ok = true;
+
+      rc = hicn_mapme_parse_batch (packet, b->current_length, prefixes, seqs,
+				   HICN_MAPME_BATCH_MAX, &params);
+      if (rc < 0)
+	goto ERR_PARSE;
+
+      for (int i = 0; i < rc; i++)
+	ok &= hicn_mapme_process_ack_prefix (vm, &prefixes[i], seqs[i],
+					     in_face);
+
+      return ok;
+    }
+
+  /* Parse incoming message */
+  rc = hicn_mapme_parse_packet (packet, &prefix, &params);
+  if (rc < 0)
+    goto ERR_PARSE;
+
+  /* if (params.seq == INVALID_SEQ) */
+  /*   { */
+  /*     DEBUG ("Invalid sequence number found in IU"); */
+  /*     return true; */
+  /*   } */
+
+  return hicn_mapme_process_ack_prefix (vm, &prefix, params.seq, in_face);
 
 ERR_PARSE:
   return false;
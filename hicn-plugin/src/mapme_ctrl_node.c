@@ -48,47 +48,22 @@ static char *hicn_mapme_ctrl_error_strings[] = {
 };
 
 /*
- * @brief Process incoming control messages (Interest Update)
+ * @brief Update the FIB and TFIB of a prefix after an Interest Update
  * @param vm vlib main data structure
- * @param b Control packet (IU)
+ * @param prefix Prefix carried by the IU
+ * @param seq Sequence number of the IU for this prefix
  * @param face_id Ingress face id
  *
- * NOTE:
- *  - this function answers locally to the IU interest by replying with a Ack
- *  (Data) packet, unless in case of outdated information, in which we can
- *  consider the interest is dropped, and another IU (aka ICMP error) is sent
- * so that retransmissions stop.
+ * The IUs to be sent in turn are forged by the event manager.
  */
 static_always_inline bool
-hicn_mapme_process_ctrl (vlib_main_t *vm, vlib_buffer_t *b,
-			 hicn_face_id_t in_face_id)
+hicn_mapme_process_update (vlib_main_t *vm, const hicn_prefix_t *prefix,
+			   seq_t seq, hicn_face_id_t in_face_id)
 {
   seq_t fib_seq;
   const dpo_id_t *dpo;
-  hicn_prefix_t prefix;
-  mapme_params_t params;
-  int rc;
-
-  /* Parse incoming message */
-  rc = hicn_mapme_parse_packet (vlib_buffer_get_current (b), &prefix, &params);
-  if (rc < 0)
-    goto ERR_PARSE;
 
-  vlib_cli_output (vm, "IU - type:%d seq:%d len:%d", params.type, params.seq,
-		   prefix.len);
-
-  /* if (params.seq == INVALID_SEQ) */
-  /*   { */
-  /*     vlib_log_warn (mapme_main.log_class, */
-  /*                 "Invalid sequence number found in IU"); */
-
-  /*     return true; */
-  /*   } */
-
-  /* We forge the ACK which we be the packet forwarded by the node */
-  hicn_mapme_create_ack (vlib_buffer_get_current (b), &params);
-
-  dpo = fib_epm_lookup (&prefix.name, prefix.len);
+  dpo = fib_epm_lookup ((ip46_address_t *) &prefix->name, prefix->len);
   if (!dpo)
     {
 #ifdef HICN_MAPME_ALLOW_NONEXISTING_FIB_ENTRY
@@ -125,14 +100,14 @@ hicn_mapme_process_ctrl (vlib_main_t *vm, vlib_buffer_t *b,
 
   fib_seq = tfib->seq;
 
-  if (params.seq > fib_seq)
+  if (seq > fib_seq)
     {
       DEBUG (
 	"Higher sequence number than FIB %d > %d, updating seq and next hops",
-	params.seq, fib_seq);
+	seq, fib_seq);
 
       /* This has to be done first to allow processing ack */
-      tfib->seq = params.seq;
+      tfib->seq = seq;
 
       // in_face and next_hops are face_id_t
 
@@ -164,12 +139,12 @@ hicn_mapme_process_ctrl (vlib_main_t *vm, vlib_buffer_t *b,
       retx_t *retx = vlib_process_signal_event_data (
 	vm, hicn_mapme_eventmgr_process_node.index,
 	HICN_MAPME_EVENT_FACE_NH_SET, 1, sizeof (retx_t));
-      *retx = (retx_t){ .prefix = prefix, .dpo = *dpo };
+      *retx = (retx_t){ .prefix = *prefix, .dpo = *dpo };
     }
-  else if (params.seq == fib_seq)
+  else if (seq == fib_seq)
     {
       DEBUG ("Same sequence number than FIB %d > %d, adding next hop",
-	     params.seq, fib_seq);
+	     seq, fib_seq);
 
       /* Remove ingress face from TFIB in case it was present */
       hicn_mapme_tfib_del (tfib, in_face_id);
@@ -181,9 +156,9 @@ hicn_mapme_process_ctrl (vlib_main_t *vm, vlib_buffer_t *b,
       retx_t *retx = vlib_process_signal_event_data (
 	vm, hicn_mapme_eventmgr_process_node.index,
 	HICN_MAPME_EVENT_FACE_NH_ADD, 1, sizeof (retx_t));
-      *retx = (retx_t){ .prefix = prefix, .dpo = *dpo };
+      *retx = (retx_t){ .prefix = *prefix, .dpo = *dpo };
     }
-  else // params.seq < fib_seq
+  else // seq < fib_seq
     {
       /*
        * face is propagating outdated information, we can just consider it as a
@@ -194,11 +169,81 @@ hicn_mapme_process_ctrl (vlib_main_t *vm, vlib_buffer_t *b,
       retx_t *retx = vlib_process_signal_event_data (
 	vm, hicn_mapme_eventmgr_process_node.index,
 	HICN_MAPME_EVENT_FACE_PH_ADD, 1, sizeof (retx_t));
-      *retx = (retx_t){ .prefix = prefix, .dpo = *dpo };
+      *retx = (retx_t){ .prefix = *prefix, .dpo = *dpo };
     }
 
   /* We just raise events, the event_mgr is in charge of forging packet. */
 
+  return true;
+}
+
+/*
+ * @brief Process incoming control messages (Interest Update)
+ * @param vm vlib main data structure
+ * @param b Control packet (IU)
+ * @param face_id Ingress face id
+ * @return false if the packet could not be parsed, and has to be dropped
+ *
+ * NOTE:
+ *  - this function answers locally to the IU interest by replying with a Ack
+ *  (Data) packet, unless in case of outdated information, in which we can
+ *  consider the interest is dropped, and another IU (aka ICMP error) is sent
+ * so that retransmissions stop.
+ *  - a batched IU is acknowledged as a whole, then each of its prefixes is
+ *  processed as a regular IU.
+ */
+static_always_inline bool
+hicn_mapme_process_ctrl (vlib_main_t *vm, vlib_buffer_t *b,
+			 hicn_face_id_t in_face_id)
+{
+  u8 *packet = vlib_buffer_get_current (b);
+  hicn_prefix_t prefix;
+  mapme_params_t params;
+  int rc;
+
+  if (hicn_mapme_is_batch (packet))
+    {
+      hicn_prefix_t prefixes[HICN_MAPME_BATCH_MAX];
+      seq_t seqs[HICN_MAPME_BATCH_MAX];
+
+      /* The whole batch has to be in the first buffer */
+      rc = hicn_mapme_parse_batch (packet, b->current_length, prefixes, seqs,
+				   HICN_MAPME_BATCH_MAX, &params);
+      if (rc < 0)
+	goto ERR_PARSE;
+
+      DEBUG ("IU batch - type:%d id:%d count:%d", params.type, params.seq,
+	     rc);
+
+      hicn_mapme_create_ack (packet, &params);
+
+      for (int i = 0; i < rc; i++)
+	hicn_mapme_process_update (vm, &prefixes[i], seqs[i], in_face_id);
+
+      return true;
+    }
+
+  /* Parse incoming message */
+  rc = hicn_mapme_parse_packet (packet, &prefix, &params);
+  if (rc < 0)
+    goto ERR_PARSE;
+
+  vlib_cli_output (vm, "IU - type:%d seq:%d len:%d", params.type, params.seq,
+		   prefix.len);
+
+  /* if (params.seq == INVALID_SEQ) */
+  /*   { */
+  /*     vlib_log_warn (mapme_main.log_class, */
+  /*                 "Invalid sequence number found in IU"); */
+
+  /*     return true; */
+  /*   } */
+
+  /* We forge the ACK which we be the packet forwarded by the node */
+  hicn_mapme_create_ack (packet, &params);
+
+  hicn_mapme_process_update (vm, &prefix, params.seq, in_face_id);
+
   return true;
 
 // ERR_ACK_CREATE:
@@ -246,7 +291,8 @@ hicn_mapme_ctrl_node_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
 	   */
 	  u32 next0 = hicn_mapme_ctrl_get_iface_node (hb->face_id);
 
-	  hicn_mapme_process_ctrl (vm, b0, hb->face_id);
+	  if (!hicn_mapme_process_ctrl (vm, b0, hb->face_id))
+	    next0 = HICN_MAPME_CTRL_NEXT_ERROR_DROP;
 
 	  vnet_buffer (b0)->ip.adj_index[VLIB_TX] = hb->face_id;
 
@@ -27,22 +27,19 @@
 int
 hicn_mgmt_node_stats_get (vl_api_hicn_api_node_stats_get_reply_t * rmp)
 {
-  rmp->pkts_processed = 0;
-  rmp->pkts_interest_count = 0;
-  rmp->pkts_data_count = 0;
-  rmp->pkts_from_cache_count = 0;
-  rmp->pkts_no_pit_count = 0;
-  rmp->pit_expired_count = 0;
-  rmp->cs_expired_count = 0;
-  rmp->cs_lru_count = 0;
-  rmp->pkts_drop_no_buf = 0;
-  rmp->interests_aggregated = 0;
-  rmp->interests_retx = 0;
-  rmp->pit_entries_count =
-    clib_host_to_net_u64 (hicn_main.pitcs.pcs_pit_count);
-  rmp->cs_entries_count = clib_host_to_net_u64 (hicn_main.pitcs.pcs_cs_count);
-  rmp->cs_entries_ntw_count =
-    clib_host_to_net_u64 (hicn_main.pitcs.policy_state.count);
+  vl_api_hicn_api_node_stats_get_reply_t stats = { 0 };
+  hicn_pit_cs_t *pitcs;
+
+  /* Sum the counters of all the threads, then convert to network order */
+  vec_foreach (pitcs, hicn_main.pitcs)
+  {
+    if (pitcs->pcs_table == NULL)
+      continue;
+
+    stats.pit_entries_count += pitcs->pcs_pit_count;
+    stats.cs_entries_count += pitcs->pcs_cs_count;
+    stats.cs_entries_ntw_count += pitcs->policy_state.count;
+  }
 
   vlib_error_main_t *em;
   vlib_node_t *n;
@@ -53,39 +50,58 @@ hicn_mgmt_node_stats_get (vl_api_hicn_api_node_stats_get_reply_t * rmp)
 		       vlib_get_node (this_vlib_main,
 				      hicn_interest_pcslookup_node.index);
 		       u32 node_cntr_base_idx = n->error_heap_index;
-		       rmp->pkts_processed +=
-		       clib_host_to_net_u64 (em->counters[node_cntr_base_idx +
-							  HICNFWD_ERROR_PROCESSED]);
-		       rmp->pkts_interest_count +=
-		       clib_host_to_net_u64 (em->counters[node_cntr_base_idx +
-							  HICNFWD_ERROR_INTERESTS]);
+		       stats.pkts_processed +=
+		       em->counters[node_cntr_base_idx +
+				    HICNFWD_ERROR_PROCESSED];
+		       stats.pkts_interest_count +=
+		       em->counters[node_cntr_base_idx +
+				    HICNFWD_ERROR_INTERESTS];
 		       n =
 		       vlib_get_node (this_vlib_main,
 				      hicn_data_pcslookup_node.index);
 		       node_cntr_base_idx = n->error_heap_index;
-		       rmp->pkts_processed +=
-		       clib_host_to_net_u64 (em->counters[node_cntr_base_idx +
-							  HICNFWD_ERROR_PROCESSED]);
-		       rmp->pkts_data_count +=
-		       clib_host_to_net_u64 (em->counters[node_cntr_base_idx +
-							  HICNFWD_ERROR_DATAS]);
+		       stats.pkts_processed +=
+		       em->counters[node_cntr_base_idx +
+				    HICNFWD_ERROR_PROCESSED];
+		       stats.pkts_data_count +=
+		       em->counters[node_cntr_base_idx +
+				    HICNFWD_ERROR_DATAS];
 		       n =
 		       vlib_get_node (this_vlib_main,
 				      hicn_interest_hitcs_node.index);
 		       node_cntr_base_idx = n->error_heap_index;
-		       rmp->pkts_from_cache_count +=
-		       clib_host_to_net_u64 (em->counters[node_cntr_base_idx +
-							  HICNFWD_ERROR_CACHED]);
+		       stats.pkts_from_cache_count +=
+		       em->counters[node_cntr_base_idx +
+				    HICNFWD_ERROR_CACHED];
 		       n =
 		       vlib_get_node (this_vlib_main,
 				      hicn_interest_hitpit_node.index);
 		       node_cntr_base_idx = n->error_heap_index;
-		       rmp->interests_aggregated +=
-		       clib_host_to_net_u64 (em->counters[node_cntr_base_idx +
-							  HICNFWD_ERROR_INTEREST_AGG]);
-		       rmp->interests_retx +=
-		       clib_host_to_net_u64 (em->counters[node_cntr_base_idx +
-							  HICNFWD_ERROR_INT_RETRANS]);}));
+		       stats.interests_aggregated +=
+		       em->counters[node_cntr_base_idx +
+				    HICNFWD_ERROR_INTEREST_AGG];
+		       stats.interests_retx +=
+		       em->counters[node_cntr_base_idx +
+				    HICNFWD_ERROR_INT_RETRANS];}));
+
+  rmp->pkts_processed = clib_host_to_net_u64 (stats.pkts_processed);
+  rmp->pkts_interest_count = clib_host_to_net_u64 (stats.pkts_interest_count);
+  rmp->pkts_data_count = clib_host_to_net_u64 (stats.pkts_data_count);
+  rmp->pkts_from_cache_count =
+    clib_host_to_net_u64 (stats.pkts_from_cache_count);
+  rmp->pkts_no_pit_count = 0;
+  rmp->pit_expired_count = 0;
+  rmp->cs_expired_count = 0;
+  rmp->cs_lru_count = 0;
+  rmp->pkts_drop_no_buf = 0;
+  rmp->interests_aggregated =
+    clib_host_to_net_u64 (stats.interests_aggregated);
+  rmp->interests_retx = clib_host_to_net_u64 (stats.interests_retx);
+  rmp->pit_entries_count = clib_host_to_net_u64 (stats.pit_entries_count);
+  rmp->cs_entries_count = clib_host_to_net_u64 (stats.cs_entries_count);
+  rmp->cs_entries_ntw_count =
+    clib_host_to_net_u64 (stats.cs_entries_ntw_count);
+
   return (HICN_ERROR_NONE);
 }
 
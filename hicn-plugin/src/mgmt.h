@@ -89,6 +89,7 @@ update_node_counter (vlib_main_t * vm, u32 node_idx, u32 counter_idx, u64 val)
   _(INTERESTS, "hICN interests forwarded")			\
   _(DATAS, "hICN data msgs forwarded")				\
   _(CACHED, "Cached data ")					\
+  _(CACHED_ARENA, "Cached data from the CS arena")		\
   _(NO_PIT, "hICN no PIT entry drops")				\
   _(PIT_EXPIRED, "hICN expired PIT entries")			\
   _(CS_EXPIRED, "hICN expired CS entries")			\
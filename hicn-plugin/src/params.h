@@ -54,7 +54,7 @@ STATIC_ASSERT ((HICN_PARAM_FACES_MAX & (HICN_PARAM_FACES_MAX - 1)) == 0,
  */
 #define HICN_PARAM_PIT_ENTRIES_MIN    1024
 #define HICN_PARAM_PIT_ENTRIES_DFLT    1024 * 128
-#define HICN_PARAM_PIT_ENTRIES_MAX      2 * 1024 * 1024
+#define HICN_PARAM_PIT_ENTRIES_MAX      8 * 1024 * 1024
 
 // aggregation limit(interest previous hops)
 // Supported up to 516. For more than 4 faces this param must
@@ -92,6 +92,15 @@ STATIC_ASSERT ((HICN_PARAM_PIT_ENTRY_PHOPS_MAX <= HICN_PARAM_FACES_MAX),
 
 #define HICN_PARAM_CS_LRU_DEFAULT    (16 * 1024)
 
+/*
+ * CS arena compile-time parameters (second tier of the CS, not bound to the
+ * number of vlib buffers). Each entry takes a 2KB slot, so the max arena
+ * takes 64GB.
+ */
+#define HICN_PARAM_CS_ARENA_ENTRIES_MIN   0	// disabled
+#define HICN_PARAM_CS_ARENA_ENTRIES_DFLT  0
+#define HICN_PARAM_CS_ARENA_ENTRIES_MAX   32 * 1024 * 1024
+
 /* CS lifetime defines, in mseconds, integer type */
 #define HICN_PARAM_CS_LIFETIME_MIN      0
 #define HICN_PARAM_CS_LIFETIME_DFLT    (5 * 60 * 1000)	// 300 seconds
@@ -21,6 +21,7 @@
 #include "strategy_dpo_manager.h"
 #include "error.h"
 #include "cache_policies/cs_policy.h"
+#include "cs_arena.h"
 #include "faces/face.h"
 
 /**
@@ -32,6 +33,9 @@
  * hash table contains a PIT or CS entry, some counters to maintain the
  * status of the PIT/CS and the reference to the eviction policy for
  * the CS. The default eviction policy id FIFO.
+ *
+ * Entries evicted by the policy are moved to the CS arena (see cs_arena.h)
+ * when it is enabled, instead of being removed.
  */
 
 /* The PIT and CS are stored as a union */
@@ -71,6 +75,12 @@ typedef struct __attribute__ ((packed)) hicn_pcs_shared_s
 
 #define HICN_PCS_ENTRY_CS_FLAG 0x01
 
+/* CS entry whose packet is held in the CS arena rather than in a buffer */
+#define HICN_PCS_ENTRY_CS_ARENA_FLAG 0x02
+
+/* PIT entry whose interest has been retransmitted: its RTT is ambiguous */
+#define HICN_PCS_ENTRY_PIT_RETX_FLAG 0x04
+
 /*
  * PIT entry, unioned with a CS entry below
  */
@@ -91,7 +101,7 @@ typedef struct __attribute__ ((packed)) hicn_pit_entry_s
 
 } hicn_pit_entry_t;
 
-#define HICN_CS_ENTRY_OPAQUE_SIZE HICN_HASH_NODE_APP_DATA_SIZE - 36
+#define HICN_CS_ENTRY_OPAQUE_SIZE HICN_HASH_NODE_APP_DATA_SIZE - 40
 
 /*
  * CS entry, unioned with a PIT entry below
@@ -114,8 +124,12 @@ typedef struct __attribute__ ((packed)) hicn_cs_entry_s
   u32 cs_lru_prev;
   u32 cs_lru_next;
 
+  /* Slot in the CS arena, if HICN_PCS_ENTRY_CS_ARENA_FLAG is set */
+  /* 36B + 4B = 40B */
+  u32 cs_arena_slot;
+
   /* Reserved for implementing cache policy different than LRU */
-  /* 36B + (64 - 36)B = 64B */
+  /* 40B + (64 - 40)B = 64B */
   u8 opaque[HICN_CS_ENTRY_OPAQUE_SIZE];
 
 } __attribute__ ((packed)) hicn_cs_entry_t;
@@ -157,6 +171,9 @@ typedef struct hicn_pit_cs_s
   hicn_cs_policy_t policy_state;
   hicn_cs_policy_vft_t policy_vft;
 
+  /* Second tier of the CS */
+  hicn_cs_arena_t cs_arena;
+
 } hicn_pit_cs_t;
 
 /* Functions declarations */
@@ -170,6 +187,8 @@ always_inline void hicn_pit_to_cs (vlib_main_t *vm, hicn_pit_cs_t *pitcs,
 				   dpo_id_t *hicn_dpo_id,
 				   hicn_face_id_t inface_id, u8 is_appface);
 
+always_inline void hicn_pcs_cs_evict (vlib_main_t *vm, hicn_pit_cs_t *pitcs);
+
 always_inline void hicn_pcs_cs_update (vlib_main_t *vm, hicn_pit_cs_t *pitcs,
 				       hicn_pcs_entry_t *old_entry,
 				       hicn_pcs_entry_t *entry,
@@ -250,10 +269,11 @@ hicn_pit_init_data (hicn_pcs_entry_t *p)
   p->shared.entry_flags = 0;
   p->u.pit.faces.n_faces = 0;
   p->u.pit.faces.is_overflow = 0;
+  hicn_face_bucket_t **pool = hicn_face_db_pool ();
   hicn_face_bucket_t *face_bkt;
-  pool_get (hicn_face_bucket_pool, face_bkt);
+  pool_get (*pool, face_bkt);
 
-  p->u.pit.faces.next_bucket = face_bkt - hicn_face_bucket_pool;
+  p->u.pit.faces.next_bucket = face_bkt - *pool;
 }
 
 /* Init pit/cs data block (usually inside hash table node) */
@@ -324,6 +344,16 @@ hicn_cs_enabled (hicn_pit_cs_t *pit)
     }
 }
 
+/*
+ * Accessor for the tier of a CS entry: 1 if its packet is in the CS arena, 0
+ * if it is held in a vlib buffer.
+ */
+always_inline int
+hicn_cs_entry_in_arena (const hicn_pcs_entry_t *pcs)
+{
+  return (pcs->shared.entry_flags & HICN_PCS_ENTRY_CS_ARENA_FLAG) != 0;
+}
+
 /*
  * Delete a PIT/CS entry from the hashtable, freeing the hash node struct.
  * The caller's pointers are zeroed! If cs_trim is true, entry has already
@@ -343,8 +373,11 @@ hicn_pcs_delete_internal (hicn_pit_cs_t *pitcs, hicn_pcs_entry_t **pcs_entryp,
   if (hash_entry->he_flags & HICN_HASH_ENTRY_FLAG_CS_ENTRY)
     {
       pitcs->pcs_cs_dealloc++;
-      /* Free any associated packet buffer */
-      vlib_buffer_free_one (vm, pcs->u.cs.cs_pkt_buf);
+      /* Free any associated packet buffer or arena slot */
+      if (pcs->shared.entry_flags & HICN_PCS_ENTRY_CS_ARENA_FLAG)
+	hicn_cs_arena_release (&pitcs->cs_arena, pcs->u.cs.cs_arena_slot);
+      else
+	vlib_buffer_free_one (vm, pcs->u.cs.cs_pkt_buf);
       pcs->u.cs.cs_pkt_buf = ~0;
       ASSERT ((pcs->u.cs.cs_lru_prev == 0) &&
 	      (pcs->u.cs.cs_lru_prev == pcs->u.cs.cs_lru_next));
@@ -399,24 +432,7 @@ hicn_pit_to_cs (vlib_main_t *vm, hicn_pit_cs_t *pitcs,
   pitcs->pcs_cs_count++;
 
   if (policy_state->count > policy_state->max)
-    {
-      hicn_hash_node_t *node;
-      hicn_pcs_entry_t *pcs_entry;
-      hicn_hash_entry_t *hash_entry;
-      policy_vft->hicn_cs_delete_get (pitcs, policy_state, &node, &pcs_entry,
-				      &hash_entry);
-
-      /*
-       * We don't have to decrease the lock (therefore we cannot
-       * use hicn_pcs_cs_delete function)
-       */
-      policy_vft->hicn_cs_dequeue (pitcs, node, pcs_entry, policy_state);
-
-      hicn_cs_delete_trimmed (pitcs, &pcs_entry, hash_entry, &node, vm);
-
-      /* Update the global CS counter */
-      pitcs->pcs_cs_count--;
-    }
+    hicn_pcs_cs_evict (vm, pitcs);
 }
 
 /* Functions specific for PIT or CS */
@@ -444,24 +460,7 @@ hicn_pcs_cs_update (vlib_main_t *vm, hicn_pit_cs_t *pitcs,
       policy_vft->hicn_cs_insert (pitcs, node, old_entry, policy_state);
 
       if (policy_state->count > policy_state->max)
-	{
-	  hicn_hash_node_t *node;
-	  hicn_pcs_entry_t *pcs_entry;
-	  hicn_hash_entry_t *hash_entry;
-	  policy_vft->hicn_cs_delete_get (pitcs, policy_state, &node,
-					  &pcs_entry, &hash_entry);
-
-	  /*
-	   * We don't have to decrease the lock (therefore we cannot
-	   * use hicn_pcs_cs_delete function)
-	   */
-	  policy_vft->hicn_cs_dequeue (pitcs, node, pcs_entry, policy_state);
-
-	  hicn_cs_delete_trimmed (pitcs, &pcs_entry, hash_entry, &node, vm);
-
-	  /* Update the global CS counter */
-	  pitcs->pcs_cs_count--;
-	}
+	hicn_pcs_cs_evict (vm, pitcs);
     }
   else
     /* Update the CS LRU, moving this item to the head */
@@ -482,8 +481,10 @@ hicn_pcs_cs_delete (vlib_main_t *vm, hicn_pit_cs_t *pitcs,
       policy_state = &pitcs->policy_state;
       policy_vft = &pitcs->policy_vft;
 
-      policy_vft->hicn_cs_dequeue (pitcs, (*nodep), (*pcs_entryp),
-				   policy_state);
+      /* Entries in the arena have already left the policy queue */
+      if (!hicn_cs_entry_in_arena (*pcs_entryp))
+	policy_vft->hicn_cs_dequeue (pitcs, (*nodep), (*pcs_entryp),
+				     policy_state);
 
       /* Update the global CS counter */
       pitcs->pcs_cs_count--;
@@ -533,24 +534,7 @@ hicn_pcs_cs_insert (vlib_main_t *vm, hicn_pit_cs_t *pitcs,
       pitcs->pcs_cs_count++;
 
       if (policy_state->count > policy_state->max)
-	{
-	  hicn_hash_node_t *node;
-	  hicn_pcs_entry_t *pcs_entry;
-	  hicn_hash_entry_t *hash_entry;
-	  policy_vft->hicn_cs_delete_get (pitcs, policy_state, &node,
-					  &pcs_entry, &hash_entry);
-
-	  /*
-	   * We don't have to decrease the lock (therefore we cannot
-	   * use hicn_pcs_cs_delete function)
-	   */
-	  policy_vft->hicn_cs_dequeue (pitcs, node, pcs_entry, policy_state);
-
-	  hicn_cs_delete_trimmed (pitcs, &pcs_entry, hash_entry, &node, vm);
-
-	  /* Update the global CS counter */
-	  pitcs->pcs_cs_count--;
-	}
+	hicn_pcs_cs_evict (vm, pitcs);
     }
   return ret;
 }
@@ -584,6 +568,25 @@ hicn_pcs_cs_insert_update (vlib_main_t *vm, hicn_pit_cs_t *pitcs,
 	hicn_hashtb_node_from_idx (pitcs->pcs_table, *node_id);
       hicn_pcs_entry_t *pitp = hicn_pit_get_data (existing_node);
 
+      if (hicn_cs_entry_in_arena (pitp))
+	{
+	  /* The new packet brings the entry back to the first tier */
+	  hicn_cs_arena_release (&pitcs->cs_arena, pitp->u.cs.cs_arena_slot);
+	  pitp->shared.entry_flags &= ~HICN_PCS_ENTRY_CS_ARENA_FLAG;
+
+	  pitp->shared.create_time = entry->shared.create_time;
+	  pitp->shared.expire_time = entry->shared.expire_time;
+	  pitp->u.cs.cs_pkt_buf = entry->u.cs.cs_pkt_buf;
+	  pitp->u.cs.cs_rxface = entry->u.cs.cs_rxface;
+
+	  pitcs->policy_vft.hicn_cs_insert (pitcs, existing_node, pitp,
+					    &pitcs->policy_state);
+	  if (pitcs->policy_state.count > pitcs->policy_state.max)
+	    hicn_pcs_cs_evict (vm, pitcs);
+
+	  return (ret);
+	}
+
       /* Free associated packet buffer and update counter */
       pitcs->pcs_cs_dealloc++;
       vlib_buffer_free_one (vm, pitp->u.cs.cs_pkt_buf);
@@ -742,6 +745,129 @@ hicn_cs_delete_trimmed (hicn_pit_cs_t *pitcs, hicn_pcs_entry_t **pcs_entryp,
     }
 }
 
+/*
+ * Take the next slot of the CS arena. If it is in use, the entry holding it
+ * is removed from the PIT/CS. Slots of entries locked by packets in flight
+ * are skipped; ~0 is returned if no slot could be found.
+ */
+always_inline u32
+hicn_cs_arena_get_slot_id (vlib_main_t *vm, hicn_pit_cs_t *pitcs)
+{
+  hicn_cs_arena_t *arena = &pitcs->cs_arena;
+  hicn_cs_arena_slot_t *slot;
+  hicn_hash_node_t *node;
+  hicn_pcs_entry_t *pcs_entry;
+  hicn_hash_entry_t *hash_entry;
+  u32 slot_id;
+  int i;
+
+  for (i = 0; i < HICN_CS_ARENA_EVICT_TRIES; i++)
+    {
+      slot_id = arena->next;
+      if (++arena->next == arena->n_slots)
+	arena->next = 0;
+
+      slot = hicn_cs_arena_get_slot (arena, slot_id);
+      if (slot->node_id == HICN_CS_ARENA_SLOT_FREE)
+	return slot_id;
+
+      node = hicn_hashtb_node_from_idx (pitcs->pcs_table, slot->node_id);
+      hash_entry = hicn_hashtb_get_entry (
+	pitcs->pcs_table, node->entry_idx, node->bucket_id,
+	node->hn_flags & HICN_HASH_NODE_OVERFLOW_BUCKET);
+
+      if (hash_entry->locks > 0)
+	continue;
+
+      /* This releases the slot */
+      pcs_entry = hicn_pit_get_data (node);
+      hicn_cs_delete_trimmed (pitcs, &pcs_entry, hash_entry, &node, vm);
+      pitcs->pcs_cs_count--;
+      arena->evictions++;
+
+      return slot_id;
+    }
+
+  return ~0;
+}
+
+/*
+ * Move the packet of a CS entry, already dequeued from the policy, to the
+ * CS arena and free its buffer. Returns 0 if the arena is disabled or cannot
+ * take the packet, in which case the entry must be removed.
+ */
+always_inline int
+hicn_cs_arena_demote (vlib_main_t *vm, hicn_pit_cs_t *pitcs,
+		      hicn_hash_node_t *node, hicn_pcs_entry_t *pcs_entry)
+{
+  vlib_buffer_t *b;
+  word buffer_advance = 0;
+  u32 slot_id;
+
+  if (!hicn_cs_arena_enabled (&pitcs->cs_arena))
+    return 0;
+
+  /*
+   * Unless the packet was copied to the faces, the first two cache lines of
+   * the buffer have been cloned and skipped (see hicn_satisfy_faces)
+   */
+  b = vlib_get_buffer (vm, pcs_entry->u.cs.cs_pkt_buf);
+  if (!(hicn_get_buffer (b)->flags & HICN_BUFFER_FLAGS_PKT_LESS_TWO_CL))
+    buffer_advance = CLIB_CACHE_LINE_BYTES * 2;
+
+  if (vlib_buffer_length_in_chain (vm, b) + buffer_advance >
+      HICN_CS_ARENA_DATA_SIZE)
+    return 0;
+
+  slot_id = hicn_cs_arena_get_slot_id (vm, pitcs);
+  if (slot_id == ~0)
+    return 0;
+
+  vlib_buffer_advance (b, -buffer_advance);
+  hicn_cs_arena_store (vm, &pitcs->cs_arena, slot_id,
+		       hicn_hashtb_node_idx_from_node (pitcs->pcs_table, node),
+		       b);
+  vlib_buffer_advance (b, buffer_advance);
+
+  vlib_buffer_free_one (vm, pcs_entry->u.cs.cs_pkt_buf);
+  pcs_entry->u.cs.cs_pkt_buf = ~0;
+  pcs_entry->u.cs.cs_arena_slot = slot_id;
+  pcs_entry->shared.entry_flags |= HICN_PCS_ENTRY_CS_ARENA_FLAG;
+
+  return 1;
+}
+
+/*
+ * Evict the entry chosen by the CS policy. It is moved to the CS arena if
+ * possible, removed otherwise.
+ */
+always_inline void
+hicn_pcs_cs_evict (vlib_main_t *vm, hicn_pit_cs_t *pitcs)
+{
+  hicn_cs_policy_t *policy_state = &pitcs->policy_state;
+  hicn_cs_policy_vft_t *policy_vft = &pitcs->policy_vft;
+  hicn_hash_node_t *node;
+  hicn_pcs_entry_t *pcs_entry;
+  hicn_hash_entry_t *hash_entry;
+
+  policy_vft->hicn_cs_delete_get (pitcs, policy_state, &node, &pcs_entry,
+				  &hash_entry);
+
+  /*
+   * We don't have to decrease the lock (therefore we cannot
+   * use hicn_pcs_cs_delete function)
+   */
+  policy_vft->hicn_cs_dequeue (pitcs, node, pcs_entry, policy_state);
+
+  if (hicn_cs_arena_demote (vm, pitcs, node, pcs_entry))
+    return;
+
+  hicn_cs_delete_trimmed (pitcs, &pcs_entry, hash_entry, &node, vm);
+
+  /* Update the global CS counter */
+  pitcs->pcs_cs_count--;
+}
+
 /*
  * wrappable counter math (assumed uint16_t): return sum of addends
  */
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "dpo_ll.h"
+#include "strategy_ll.h"
+#include "../strategy_dpo_manager.h"
+#include "../strategy_dpo_ctx.h"
+
+/**
+ * @brief DPO type value for the ll_strategy
+ */
+static dpo_type_t hicn_dpo_type_ll;
+
+static const hicn_dpo_vft_t hicn_dpo_ll_vft = {
+  .hicn_dpo_is_type = &hicn_dpo_is_type_strategy_ll,
+  .hicn_dpo_get_type = &hicn_dpo_strategy_ll_get_type,
+  .hicn_dpo_module_init = &hicn_dpo_strategy_ll_module_init,
+  .hicn_dpo_create = &hicn_strategy_ll_ctx_create,
+  .hicn_dpo_add_update_nh = &hicn_strategy_ll_ctx_add_nh,
+  .hicn_dpo_del_nh = &hicn_strategy_ll_ctx_del_nh,
+  .hicn_dpo_format = &hicn_strategy_ll_format_ctx
+};
+
+int
+hicn_dpo_is_type_strategy_ll (const dpo_id_t * dpo)
+{
+  return dpo->dpoi_type == hicn_dpo_type_ll;
+}
+
+void
+hicn_dpo_strategy_ll_module_init (void)
+{
+  /*
+   * Register our type of dpo
+   */
+  hicn_dpo_type_ll =
+    hicn_dpo_register_new_type (hicn_nodes_strategy, &hicn_dpo_ll_vft,
+				hicn_ll_strategy_get_vft (),
+				&dpo_strategy_ll_ctx_vft);
+  hicn_strategy_ll_init ();
+}
+
+dpo_type_t
+hicn_dpo_strategy_ll_get_type (void)
+{
+  return hicn_dpo_type_ll;
+}
+
+u8 *
+hicn_strategy_ll_format_ctx (u8 * s, int n, ...)
+{
+  va_list args;
+  va_start (args, n);
+  s = format_hicn_strategy_ll_ctx (s, &args);
+  return s;
+}
+
+u8 *
+format_hicn_strategy_ll_ctx (u8 * s, va_list * ap)
+{
+  int i = 0;
+  index_t index = va_arg (*ap, index_t);
+  hicn_dpo_ctx_t *dpo_ctx = NULL;
+  hicn_strategy_ll_ctx_t *ll_dpo_ctx = NULL;
+  u32 indent = va_arg (*ap, u32);
+
+  dpo_ctx = hicn_strategy_dpo_ctx_get (index);
+  if (dpo_ctx == NULL)
+    return s;
+
+  ll_dpo_ctx = (hicn_strategy_ll_ctx_t *) dpo_ctx->data;
+
+  s = format (s, "hicn-ll");
+
+  for (i = 0; i < HICN_PARAM_FIB_ENTRY_NHOPS_MAX; i++)
+    {
+      u8 *buf = NULL;
+      if (i < dpo_ctx->entry_count)
+	buf = format (NULL, "FIB rtt %.1fms loss %.1f%%",
+		      ll_dpo_ctx->rtt[i] * HICN_STRATEGY_LL_RTT_UNIT * 1e3,
+		      100.0 * ll_dpo_ctx->loss[i] /
+		      HICN_STRATEGY_LL_LOSS_ONE);
+      else if (i >=
+	       HICN_PARAM_FIB_ENTRY_NHOPS_MAX - dpo_ctx->tfib_entry_count)
+	buf = format (NULL, "TFIB");
+      else
+	continue;
+
+      s = format (s, "\n");
+      s =
+        format (s, "%U ", format_hicn_face, dpo_ctx->next_hops[i],
+                indent);
+      s = format (s, " %v", buf);
+      vec_free (buf);
+    }
+
+  return (s);
+}
+
+void
+hicn_strategy_ll_ctx_create (fib_protocol_t proto, const hicn_face_id_t * next_hop,
+			     int nh_len, index_t * dpo_idx)
+{
+  hicn_strategy_ll_ctx_t *hicn_strategy_ll_ctx;
+  hicn_dpo_ctx_t *hicn_strategy_ctx;
+
+  /* Allocate a hicn_dpo_ctx on the vpp pool and initialize it */
+  hicn_strategy_ctx = hicn_strategy_dpo_ctx_alloc ();
+  hicn_strategy_ll_ctx = (hicn_strategy_ll_ctx_t *) hicn_strategy_ctx->data;
+
+  *dpo_idx = hicn_strategy_dpo_ctx_get_index (hicn_strategy_ctx);
+
+  init_dpo_ctx (hicn_strategy_ctx, next_hop, nh_len, hicn_dpo_type_ll, proto);
+
+  clib_memset (hicn_strategy_ll_ctx, 0, sizeof (hicn_strategy_ll_ctx_t));
+}
+
+int
+hicn_strategy_ll_ctx_add_nh (hicn_face_id_t nh, index_t dpo_idx)
+{
+  hicn_dpo_ctx_t *hicn_strategy_dpo_ctx = hicn_strategy_dpo_ctx_get (dpo_idx);
+  hicn_strategy_ll_ctx_t *hicn_strategy_ll_ctx;
+  u8 pos = 0;
+
+  if (hicn_strategy_dpo_ctx == NULL)
+    {
+      return HICN_ERROR_STRATEGY_NOT_FOUND;
+    }
+
+  if (hicn_strategy_dpo_ctx_add_nh (nh, hicn_strategy_dpo_ctx, &pos) ==
+      HICN_ERROR_NONE)
+    {
+      /* The new next hop has no sample yet */
+      hicn_strategy_ll_ctx =
+	(hicn_strategy_ll_ctx_t *) hicn_strategy_dpo_ctx->data;
+      hicn_strategy_ll_ctx->rtt[pos] = 0;
+      hicn_strategy_ll_ctx->loss[pos] = 0;
+    }
+
+  return HICN_ERROR_NONE;
+}
+
+int
+hicn_strategy_ll_ctx_del_nh (hicn_face_id_t face_id, index_t dpo_idx)
+{
+  hicn_dpo_ctx_t *hicn_strategy_dpo_ctx = hicn_strategy_dpo_ctx_get (dpo_idx);
+  hicn_strategy_ll_ctx_t *hicn_strategy_ll_ctx;
+  u8 last;
+  int i;
+
+  if (hicn_strategy_dpo_ctx == NULL)
+    {
+      return HICN_ERROR_STRATEGY_NOT_FOUND;
+    }
+
+  /*
+   * The last next hop takes the place of the deleted one (see
+   * hicn_strategy_dpo_ctx_del_nh), so its estimates must follow it.
+   */
+  hicn_strategy_ll_ctx =
+    (hicn_strategy_ll_ctx_t *) hicn_strategy_dpo_ctx->data;
+  last = hicn_strategy_dpo_ctx->entry_count - 1;
+  for (i = 0; i < hicn_strategy_dpo_ctx->entry_count; i++)
+    {
+      if (hicn_strategy_dpo_ctx->next_hops[i] == face_id)
+	{
+	  hicn_strategy_ll_ctx->rtt[i] = hicn_strategy_ll_ctx->rtt[last];
+	  hicn_strategy_ll_ctx->loss[i] = hicn_strategy_ll_ctx->loss[last];
+	  hicn_strategy_ll_ctx->rtt[last] = 0;
+	  hicn_strategy_ll_ctx->loss[last] = 0;
+	  break;
+	}
+    }
+
+  return hicn_strategy_dpo_ctx_del_nh (face_id, hicn_strategy_dpo_ctx);
+}
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables:
+ * eval: (c-set-style "gnu")
+ * End:
+ */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HICN_DPO_LL_H__
+#define __HICN_DPO_LL_H__
+
+#include <vnet/dpo/dpo.h>
+#include "../strategy_dpo_ctx.h"
+
+/**
+ * @file dpo_ll.h
+ *
+ * This file implements the strategy vtf (see strategy.h) and
+ * the dpo vft (see strategy_dpo_manager.h) for the strategy
+ * low latency.
+ */
+
+/* Unit of the smoothed RTT stored for each next hop, in seconds */
+#define HICN_STRATEGY_LL_RTT_UNIT 1e-4
+
+/* Weight of a new sample in the RTT and loss averages is 2^-shift */
+#define HICN_STRATEGY_LL_EWMA_SHIFT 3
+
+/* Loss estimate meaning "every interest is lost" */
+#define HICN_STRATEGY_LL_LOSS_ONE 255
+
+/*
+ * One interest out of HICN_STRATEGY_LL_PROBE_INTERVAL is sent to the next
+ * hops in turn, whatever their weight, to keep the estimates of the slower
+ * ones up to date.
+ */
+#define HICN_STRATEGY_LL_PROBE_INTERVAL 64
+
+/**
+ * Context for the Low Latency strategy
+ */
+typedef struct hicn_strategy_ll_ctx_s
+{
+  /* Smoothed RTT of each next hop, in HICN_STRATEGY_LL_RTT_UNIT. 0 if no
+   * data has been received yet */
+  u16 rtt[HICN_PARAM_FIB_ENTRY_NHOPS_MAX];
+
+  /* Loss estimate of each next hop, over HICN_STRATEGY_LL_LOSS_ONE */
+  u8 loss[HICN_PARAM_FIB_ENTRY_NHOPS_MAX];
+
+  /*
+   * Probe counters, incremented atomically by the forwarding threads: the
+   * next hop probed is probe_nhop modulo the number of next hops, a probe is
+   * sent every HICN_STRATEGY_LL_PROBE_INTERVAL interests.
+   */
+  u8 probe_nhop;
+  u8 n_since_probe;
+} hicn_strategy_ll_ctx_t;
+
+STATIC_ASSERT (sizeof (hicn_strategy_ll_ctx_t) <=
+		 STRUCT_SIZE_OF (hicn_dpo_ctx_t, data),
+	       "hicn_strategy_ll_ctx_t does not fit in the dpo ctx");
+
+/**
+ * @brief Format the dpo ctx for a human-readable string
+ *
+ * @param s String to which to append the formatted dpo ctx
+ * @param ap List of parameters for the formatting
+ *
+ * @result The string with the formatted dpo ctx
+ */
+u8 *format_hicn_strategy_ll_ctx (u8 * s, va_list * ap);
+
+const static dpo_vft_t dpo_strategy_ll_ctx_vft = {
+  .dv_lock = hicn_strategy_dpo_ctx_lock,
+  .dv_unlock = hicn_strategy_dpo_ctx_unlock,
+  .dv_format = format_hicn_strategy_ll_ctx,
+};
+
+/**
+ * @brief Create a new low latency ctx
+ *
+ * @param proto The protocol to which the dpo is meant for (see vpp docs)
+ * @param next_hop A list of next hops to be inserted in the dpo ctx
+ * @param nh_len Size of the list
+ * @param dpo_idx index_t that will hold the index of the created dpo ctx
+ * @return HICN_ERROR_NONE if the creation was fine, otherwise EINVAL
+ */
+void
+hicn_strategy_ll_ctx_create (fib_protocol_t proto, const hicn_face_id_t * next_hop,
+			     int nh_len, index_t * dpo_idx);
+
+/**
+ * @brief Add or update a next hop in the dpo ctx. The estimates of a new
+ * next hop start empty.
+ *
+ * @param nh Next hop to insert in the dpo ctx
+ * @param dpo_idx Index of the dpo ctx to update with the new or updated next
+ * hop
+ * @return HICN_ERROR_NONE if the update or insert was fine,
+ * otherwise HICN_ERROR_DPO_CTX_NOT_FOUND
+ */
+int hicn_strategy_ll_ctx_add_nh (hicn_face_id_t nh, index_t dpo_idx);
+
+/**
+ * @brief Delete a next hop in the dpo ctx.
+ *
+ * @param face_id Face identifier of the next hop
+ * @param dpo_idx Index of the dpo ctx to update with the new or updated next
+ * hop
+ * @return HICN_ERROR_NONE if the update or insert was fine,
+ * otherwise HICN_ERROR_DPO_CTS_NOT_FOUND
+ */
+int hicn_strategy_ll_ctx_del_nh (hicn_face_id_t face_id, index_t dpo_idx);
+
+/**
+ * @brief Return true if the dpo is of type strategy ll
+ *
+ * @param dpo Dpo to check the type
+ */
+int hicn_dpo_is_type_strategy_ll (const dpo_id_t * dpo);
+
+/**
+ * @brief Initialize the Low Latency strategy
+ */
+void hicn_dpo_strategy_ll_module_init (void);
+
+/**
+ * @brief Return the dpo type for the Low Latency strategy
+ */
+dpo_type_t hicn_dpo_strategy_ll_get_type (void);
+
+/**
+ * @brief Format the dpo ctx for the strategy Low Latency. To
+ * call from other functions
+ *
+ * @param s String to append the formatted dpo ctx
+ * @param ... List of arguments to format
+ */
+u8 *hicn_strategy_ll_format_ctx (u8 * s, int n, ...);
+
+
+#endif // __HICN_DPO_LL_H__
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables:
+ * eval: (c-set-style "gnu")
+ * End:
+ */
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vppinfra/random.h>
+
+#include "dpo_ll.h"
+#include "strategy_ll.h"
+#include "../strategy.h"
+#include "../strategy_dpo_ctx.h"
+#include "../faces/face.h"
+#include "../hashtb.h"
+#include "../strategy_dpo_manager.h"
+
+/*
+ * Strategy that sends interests to the next hops with the lowest latency,
+ * using the per next hop RTT and loss estimates stored in the dpo ctx.
+ */
+void hicn_receive_data_ll (index_t dpo_idx, int nh_idx, f64 rtt);
+void hicn_add_interest_ll (index_t dpo_idx, hicn_hash_entry_t *pit_entry);
+void hicn_on_interest_timeout_ll (index_t dpo_idx, int nh_idx);
+u32 hicn_select_next_hop_ll (index_t dpo_idx, int *nh_idx,
+			     hicn_face_id_t *outface);
+u8 *hicn_strategy_format_trace_ll (u8 *s, hicn_strategy_trace_t *t);
+u8 *hicn_strategy_format_ll (u8 *s, va_list *ap);
+
+static hicn_strategy_vft_t hicn_strategy_ll_vft = {
+  .hicn_receive_data = &hicn_receive_data_ll,
+  .hicn_add_interest = &hicn_add_interest_ll,
+  .hicn_on_interest_timeout = &hicn_on_interest_timeout_ll,
+  .hicn_select_next_hop = &hicn_select_next_hop_ll,
+  .hicn_format_strategy_trace = &hicn_strategy_format_trace_ll,
+  .hicn_format_strategy = &hicn_strategy_format_ll
+};
+
+/*
+ * Return the vft of the strategy.
+ */
+hicn_strategy_vft_t *
+hicn_ll_strategy_get_vft (void)
+{
+  return &hicn_strategy_ll_vft;
+}
+
+/*
+ * State of the random number generator of each thread. The dpo ctx is
+ * shared by all the forwarding threads.
+ */
+static u32 *hicn_strategy_ll_seeds;
+
+void
+hicn_strategy_ll_init (void)
+{
+  vlib_thread_main_t *tm = vlib_get_thread_main ();
+  u32 seed = random_default_seed ();
+  int i;
+
+  vec_validate (hicn_strategy_ll_seeds, tm->n_vlib_mains - 1);
+  for (i = 0; i < vec_len (hicn_strategy_ll_seeds); i++)
+    hicn_strategy_ll_seeds[i] = seed + i;
+}
+
+/*
+ * Draw a next hop with a probability proportional to
+ * (1 - loss) / rtt^2. Next hops without RTT samples are given the lowest
+ * RTT known, so that they are tried.
+ */
+always_inline int
+hicn_strategy_ll_draw (hicn_strategy_ll_ctx_t *ll_ctx, u8 entry_count)
+{
+  f64 weight[HICN_PARAM_FIB_ENTRY_NHOPS_MAX];
+  u16 rtt[HICN_PARAM_FIB_ENTRY_NHOPS_MAX];
+  f64 total = 0, r;
+  u16 min_rtt = ~0;
+  int i;
+
+  for (i = 0; i < entry_count; i++)
+    {
+      rtt[i] = clib_atomic_load_relax_n (&ll_ctx->rtt[i]);
+      if (rtt[i] && rtt[i] < min_rtt)
+	min_rtt = rtt[i];
+    }
+
+  for (i = 0; i < entry_count; i++)
+    {
+      f64 w = rtt[i] ? rtt[i] : min_rtt;
+      weight[i] = (f64) (HICN_STRATEGY_LL_LOSS_ONE + 1 -
+			 clib_atomic_load_relax_n (&ll_ctx->loss[i])) /
+		  (w * w);
+      total += weight[i];
+    }
+
+  r = random_f64 (vec_elt_at_index (hicn_strategy_ll_seeds,
+				    vlib_get_thread_index ())) *
+      total;
+  for (i = 0; i < entry_count - 1; i++)
+    {
+      if (r < weight[i])
+	break;
+      r -= weight[i];
+    }
+
+  return i;
+}
+
+/* DPO should be give in input as it containes all the information to calculate
+ * the next hops*/
+u32
+hicn_select_next_hop_ll (index_t dpo_idx, int *nh_idx, hicn_face_id_t *outface)
+{
+  hicn_dpo_ctx_t *dpo_ctx = hicn_strategy_dpo_ctx_get (dpo_idx);
+  hicn_strategy_ll_ctx_t *hicn_strategy_ll_ctx;
+  int i;
+
+  if (dpo_ctx == NULL)
+    return HICN_ERROR_STRATEGY_NOT_FOUND;
+
+  if (PREDICT_FALSE (dpo_ctx->entry_count == 0))
+    return HICN_ERROR_STRATEGY_NH_NOT_FOUND;
+
+  hicn_strategy_ll_ctx = (hicn_strategy_ll_ctx_t *) dpo_ctx->data;
+
+  if (PREDICT_FALSE (
+	clib_atomic_fetch_add_relax (&hicn_strategy_ll_ctx->n_since_probe, 1) %
+	  HICN_STRATEGY_LL_PROBE_INTERVAL ==
+	HICN_STRATEGY_LL_PROBE_INTERVAL - 1))
+    {
+      /* Probe the next hops in turn */
+      i = clib_atomic_fetch_add_relax (&hicn_strategy_ll_ctx->probe_nhop, 1) %
+	  dpo_ctx->entry_count;
+    }
+  else
+    {
+      i = hicn_strategy_ll_draw (hicn_strategy_ll_ctx, dpo_ctx->entry_count);
+    }
+
+  *nh_idx = i;
+  *outface = dpo_ctx->next_hops[i];
+
+  return HICN_ERROR_NONE;
+}
+
+void
+hicn_add_interest_ll (index_t dpo_ctx_idx, hicn_hash_entry_t *hash_entry)
+{
+  hash_entry->dpo_ctx_id = dpo_ctx_idx;
+  dpo_id_t hicn_dpo_id = { .dpoi_type = hicn_dpo_strategy_ll_get_type (),
+			   .dpoi_proto = 0,
+			   .dpoi_next_node = 0,
+			   .dpoi_index = dpo_ctx_idx };
+  hicn_strategy_dpo_ctx_lock (&hicn_dpo_id);
+  hash_entry->vft_id = hicn_dpo_get_vft_id (&hicn_dpo_id);
+}
+
+void
+hicn_on_interest_timeout_ll (index_t dpo_idx, int nh_idx)
+{
+  hicn_dpo_ctx_t *dpo_ctx = hicn_strategy_dpo_ctx_get (dpo_idx);
+  hicn_strategy_ll_ctx_t *hicn_strategy_ll_ctx;
+  u8 loss;
+
+  if (dpo_ctx == NULL || nh_idx < 0 || nh_idx >= dpo_ctx->entry_count)
+    return;
+
+  hicn_strategy_ll_ctx = (hicn_strategy_ll_ctx_t *) dpo_ctx->data;
+
+  /* Move the loss estimate towards HICN_STRATEGY_LL_LOSS_ONE */
+  loss = clib_atomic_load_relax_n (&hicn_strategy_ll_ctx->loss[nh_idx]);
+  loss += (HICN_STRATEGY_LL_LOSS_ONE - loss) >> HICN_STRATEGY_LL_EWMA_SHIFT;
+  clib_atomic_store_relax_n (&hicn_strategy_ll_ctx->loss[nh_idx], loss);
+}
+
+void
+hicn_receive_data_ll (index_t dpo_idx, int nh_idx, f64 rtt)
+{
+  hicn_dpo_ctx_t *dpo_ctx = hicn_strategy_dpo_ctx_get (dpo_idx);
+  hicn_strategy_ll_ctx_t *hicn_strategy_ll_ctx;
+  int sample, srtt;
+  u8 loss;
+
+  if (dpo_ctx == NULL || nh_idx < 0 || nh_idx >= dpo_ctx->entry_count)
+    return;
+
+  hicn_strategy_ll_ctx = (hicn_strategy_ll_ctx_t *) dpo_ctx->data;
+
+  /*
+   * The estimates are updated by every forwarding thread without locks:
+   * concurrent updates may lose a sample, which the averages absorb.
+   * Retransmitted interests give no RTT sample (Karn's algorithm).
+   */
+  if (rtt >= 0)
+    {
+      sample = clib_max (rtt / HICN_STRATEGY_LL_RTT_UNIT, 1);
+      sample = clib_min (sample, (u16) ~0);
+
+      srtt = clib_atomic_load_relax_n (&hicn_strategy_ll_ctx->rtt[nh_idx]);
+      if (srtt == 0)
+	srtt = sample;
+      else
+	srtt += (sample - srtt) / (1 << HICN_STRATEGY_LL_EWMA_SHIFT);
+
+      clib_atomic_store_relax_n (&hicn_strategy_ll_ctx->rtt[nh_idx],
+				 (u16) clib_max (srtt, 1));
+    }
+
+  /* Move the loss estimate towards 0 */
+  loss = clib_atomic_load_relax_n (&hicn_strategy_ll_ctx->loss[nh_idx]);
+  loss -= loss >> HICN_STRATEGY_LL_EWMA_SHIFT;
+  clib_atomic_store_relax_n (&hicn_strategy_ll_ctx->loss[nh_idx], loss);
+}
+
+/* packet trace format function */
+u8 *
+hicn_strategy_format_trace_ll (u8 *s, hicn_strategy_trace_t *t)
+{
+  s = format (s, "Strategy_ll: pkt: %d, sw_if_index %d, next index %d",
+	      (int) t->pkt_type, t->sw_if_index, t->next_index);
+  return (s);
+}
+
+u8 *
+hicn_strategy_format_ll (u8 *s, va_list *ap)
+{
+
+  u32 indent = va_arg (*ap, u32);
+  s = format (s,
+	      "Low Latency: next hop is drawn at random, favoring the ones "
+	      "with the lowest RTT and losses. Slower next hops are probed "
+	      "periodically.\n",
+	      indent);
+  return (s);
+}
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables:
+ * eval: (c-set-style "gnu")
+ * End:
+ */
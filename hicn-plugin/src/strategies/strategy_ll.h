@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __HICN_STRATEGY_LL_H__
+#define __HICN_STRATEGY_LL_H__
+
+#include "../strategy.h"
+
+/**
+ * @file strategy_ll.h
+ *
+ * This file implements the low latency strategy. In this strategy each next
+ * hop is weighted by its smoothed RTT (measured from the PIT entry creation
+ * to the data arrival) and its loss rate, and the next hop is drawn at
+ * random according to these weights, so that most interests go to the
+ * fastest faces. Some interests are periodically sent to every next hop to
+ * probe the slower ones.
+ */
+
+/**
+ * @brief Return the vft for the Low Latency strategy
+ */
+hicn_strategy_vft_t *hicn_ll_strategy_get_vft (void);
+
+/**
+ * @brief Allocate the per-thread state of the Low Latency strategy
+ */
+void hicn_strategy_ll_init (void);
+
+#endif // __HICN_STRATEGY_LL_H__
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables:
+ * eval: (c-set-style "gnu")
+ * End:
+ */
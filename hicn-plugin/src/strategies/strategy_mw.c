@@ -21,9 +21,9 @@
 
 /* Simple strategy that chooses the next hop with the maximum weight */
 /* It does not require to exend the hicn_dpo */
-void hicn_receive_data_mw (index_t dpo_idx, int nh_idx);
+void hicn_receive_data_mw (index_t dpo_idx, int nh_idx, f64 rtt);
 void hicn_add_interest_mw (index_t dpo_idx, hicn_hash_entry_t *pit_entry);
-void hicn_on_interest_timeout_mw (index_t dpo_idx);
+void hicn_on_interest_timeout_mw (index_t dpo_idx, int nh_idx);
 u32 hicn_select_next_hop_mw (index_t dpo_idx, int *nh_idx,
 			     hicn_face_id_t *outface);
 u32 get_strategy_node_index_mw (void);
@@ -89,13 +89,13 @@ hicn_add_interest_mw (index_t dpo_ctx_idx, hicn_hash_entry_t *hash_entry)
 }
 
 void
-hicn_on_interest_timeout_mw (index_t dpo_idx)
+hicn_on_interest_timeout_mw (index_t dpo_idx, int nh_idx)
 {
   /* Nothign to do in the mw strategy when we receive an interest */
 }
 
 void
-hicn_receive_data_mw (index_t dpo_idx, int nh_idx)
+hicn_receive_data_mw (index_t dpo_idx, int nh_idx, f64 rtt)
 {
 }
 
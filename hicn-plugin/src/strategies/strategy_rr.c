@@ -22,9 +22,9 @@
 
 /* Simple strategy that chooses the next hop with the maximum weight */
 /* It does not require to exend the hicn_dpo */
-void hicn_receive_data_rr (index_t dpo_idx, int nh_idx);
+void hicn_receive_data_rr (index_t dpo_idx, int nh_idx, f64 rtt);
 void hicn_add_interest_rr (index_t dpo_idx, hicn_hash_entry_t *pit_entry);
-void hicn_on_interest_timeout_rr (index_t dpo_idx);
+void hicn_on_interest_timeout_rr (index_t dpo_idx, int nh_idx);
 u32 hicn_select_next_hop_rr (index_t dpo_idx, int *nh_idx,
 			     hicn_face_id_t *outface);
 u8 *hicn_strategy_format_trace_rr (u8 *s, hicn_strategy_trace_t *t);
@@ -82,13 +82,13 @@ hicn_add_interest_rr (index_t dpo_ctx_idx, hicn_hash_entry_t *hash_entry)
 }
 
 void
-hicn_on_interest_timeout_rr (index_t dpo_idx)
+hicn_on_interest_timeout_rr (index_t dpo_idx, int nh_idx)
 {
   /* Nothing to do in the rr strategy when we receive an interest */
 }
 
 void
-hicn_receive_data_rr (index_t dpo_idx, int nh_idx)
+hicn_receive_data_rr (index_t dpo_idx, int nh_idx, f64 rtt)
 {
 }
 
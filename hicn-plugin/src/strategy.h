@@ -49,8 +49,13 @@ typedef struct
 
 typedef struct hicn_strategy_vft_s
 {
-  void (*hicn_receive_data) (index_t dpo_idx, int nh_idx);
-  void (*hicn_on_interest_timeout) (index_t dpo_idx);
+  /*
+   * Data received through next hop nh_idx, rtt seconds after the interest.
+   * rtt is negative if the interest was retransmitted.
+   */
+  void (*hicn_receive_data) (index_t dpo_idx, int nh_idx, f64 rtt);
+  /* Interest forwarded to nh_idx expired, nh_idx is -1 if unknown */
+  void (*hicn_on_interest_timeout) (index_t dpo_idx, int nh_idx);
   void (*hicn_add_interest) (index_t dpo_idx, hicn_hash_entry_t * pit_entry);
     u32 (*hicn_select_next_hop) (index_t dpo_idx, int *nh_idx,
 				 hicn_face_id_t* outface);
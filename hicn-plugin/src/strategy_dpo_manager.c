@@ -19,6 +19,7 @@
 #include "strategy_dpo_ctx.h"
 #include "strategies/dpo_mw.h"
 #include "strategies/dpo_rr.h"
+#include "strategies/dpo_ll.h"
 #include "strategy.h"
 #include "faces/face.h"
 
@@ -98,6 +99,7 @@ hicn_dpos_init (void)
   hicn_strategy_init_dpo_ctx_pool ();
   hicn_dpo_strategy_mw_module_init ();
   hicn_dpo_strategy_rr_module_init ();
+  hicn_dpo_strategy_ll_module_init ();
 
   default_dpo.hicn_dpo_is_type = &hicn_dpo_is_type_strategy_mw;
   default_dpo.hicn_dpo_get_type = &hicn_dpo_strategy_mw_get_type;
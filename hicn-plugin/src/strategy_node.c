@@ -172,7 +172,7 @@ hicn_strategy_fn (vlib_main_t *vm, vlib_node_runtime_t *node,
   n_left_from = frame->n_vectors;
   next_index = (hicn_strategy_next_t) node->cached_next_index;
   rt = vlib_node_get_runtime_data (vm, hicn_strategy_node.index);
-  rt->pitcs = &hicn_main.pitcs;
+  rt->pitcs = hicn_pitcs_get (vm->thread_index);
   /* Capture time in vpp terms */
   tnow = vlib_time_now (vm);
 
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file packet_bench.c
+ * @brief Compare the vft-based packet accessors with the format-specialized
+ * ones of packet_inline.h, and the vectorized checksum with the scalar one.
+ *
+ * Usage: hicn-packet-bench [iterations]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <hicn/hicn.h>
+#include <hicn/packet_inline.h>
+
+#define N_PACKETS     1024
+#define PACKET_SIZE   256
+#define PAYLOAD_SIZE  64
+#define DEFAULT_ITERS 10000
+#define CSUM_MAX_SIZE 2048
+#define CSUM_MTU      1400
+
+typedef struct
+{
+  hicn_format_t format;
+  const char *name;
+} bench_format_t;
+
+static const bench_format_t formats[] = {
+  { HF_INET_TCP, "inet_tcp" },
+  { HF_INET6_TCP, "inet6_tcp" },
+  { HF_INET_TCP_AH, "inet_tcp_ah" },
+  { HF_INET6_TCP_AH, "inet6_tcp_ah" },
+};
+
+static u8 packets[N_PACKETS][PACKET_SIZE];
+static u8 csum_buffer[CSUM_MAX_SIZE + 8];
+
+/* Prevents the compiler from optimizing the loops away */
+static volatile u32 sink;
+
+static double
+now (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int
+init_packets (hicn_format_t format)
+{
+  hicn_name_t name = { .type = HNT_UNSPEC };
+  size_t header_length;
+  int i;
+
+  if (hicn_name_create (_is_ipv4 (format) ? "10.0.0.1" : "b001::1", 0,
+			&name) < 0)
+    return -1;
+
+  for (i = 0; i < N_PACKETS; i++)
+    {
+      hicn_header_t *h = (hicn_header_t *) packets[i];
+
+      memset (h, 0, PACKET_SIZE);
+      if (hicn_packet_init_header (format, h) < 0)
+	return -1;
+      if (_is_ah (format) && hicn_packet_set_signature_size (format, h, 32) < 0)
+	return -1;
+
+      hicn_name_set_seq_number (&name, i);
+      if (hicn_interest_set_name (format, h, &name) < 0 ||
+	  hicn_interest_set_lifetime (h, 1000 + i) < 0 ||
+	  hicn_packet_get_header_length (format, h, &header_length) < 0 ||
+	  header_length + PAYLOAD_SIZE > PACKET_SIZE ||
+	  hicn_packet_set_payload_length (format, h, PAYLOAD_SIZE) < 0)
+	return -1;
+
+      memset ((u8 *) h + header_length, i, PAYLOAD_SIZE);
+    }
+
+  return 0;
+}
+
+/* Check that both APIs agree on the content of every packet */
+static int
+check_packets (hicn_format_t format)
+{
+  hicn_name_t name_vft, name_inline;
+  u32 lifetime_vft, lifetime_inline;
+  size_t len_vft, len_inline;
+  int i;
+
+  for (i = 0; i < N_PACKETS; i++)
+    {
+      hicn_header_t *h = (hicn_header_t *) packets[i];
+
+      if (hicn_interest_get_name (format, h, &name_vft) < 0 ||
+	  hicn_inline_interest_get_name (format, h, &name_inline) < 0 ||
+	  hicn_name_compare (&name_vft, &name_inline, true) != 0)
+	return -1;
+
+      if (hicn_interest_get_lifetime (h, &lifetime_vft) < 0 ||
+	  hicn_inline_interest_get_lifetime (format, h, &lifetime_inline) <
+	    0 ||
+	  lifetime_vft != lifetime_inline)
+	return -1;
+
+      if (hicn_packet_get_payload_length (format, h, &len_vft) < 0 ||
+	  hicn_inline_packet_get_payload_length (format, h, &len_inline) < 0 ||
+	  len_vft != len_inline)
+	return -1;
+    }
+
+  return 0;
+}
+
+/* Check the incremental checksum updates against a full verification */
+static int
+check_rewrites (hicn_format_t format)
+{
+  int i;
+
+#define _(FMT, fmt, hdr, ipver, IPVER, ah_length)                           \
+  case HF_##FMT:                                                            \
+    hicn_##fmt##_compute_checksum (h);                                      \
+    hicn_##fmt##_rewrite_name_suffix (h, ~i);                               \
+    hicn_##fmt##_rewrite_lifetime (h, 1000 * i);                            \
+    hicn_##fmt##_rewrite_path_label (h, 0x5a000000 ^ i);                    \
+    if (hicn_##fmt##_verify_checksum (h) < 0 ||                             \
+	hicn_##fmt##_get_lifetime (h) != _hicn_tcp_get_lifetime (&ref.tcp))  \
+      return -1;                                                            \
+    break;
+
+  for (i = 0; i < N_PACKETS; i++)
+    {
+      hicn_header_t *h = (hicn_header_t *) packets[i];
+      hicn_protocol_t ref;
+
+      memset (&ref, 0, sizeof (ref));
+      _hicn_tcp_set_lifetime (&ref.tcp, 1000 * i);
+
+      switch (format)
+	{
+	  foreach_hicn_inline_format
+	default:
+	  return -1;
+	}
+    }
+#undef _
+
+  return 0;
+}
+
+/* The scalar loop csum used before the vectorized kernels */
+static u16
+csum_scalar (const void *addr, size_t size, u16 init)
+{
+  u32 sum = init;
+  const u16 *bytes = (u16 *) addr;
+
+  while (size > 1)
+    {
+      sum += *bytes++;
+      size -= sizeof (u16);
+    }
+
+  if (size)
+    sum += *(const u8 *) bytes;
+
+  sum = (sum & 0xffff) + (sum >> 16);
+  sum = (sum & 0xffff) + (sum >> 16);
+
+  return (u16) ~sum;
+}
+
+/* Check csum against the scalar loop for all sizes and alignments */
+static int
+check_csum (void)
+{
+  size_t size, offset;
+
+  for (size = 0; size < sizeof (csum_buffer); size++)
+    csum_buffer[size] = (u8) rand ();
+
+  for (offset = 0; offset < 8; offset++)
+    for (size = 0; size <= CSUM_MAX_SIZE; size++)
+      {
+	u16 init = (u16) (size * 31);
+	if (csum (csum_buffer + offset, size, init) !=
+	    csum_scalar (csum_buffer + offset, size, init))
+	  return -1;
+      }
+
+  return 0;
+}
+
+static double
+bench_csum (u16 (*fn) (const void *, size_t, u16), int iters)
+{
+  u32 acc = 0;
+  double start = now ();
+  int it;
+
+  for (it = 0; it < iters * 100; it++)
+    acc += fn (csum_buffer, CSUM_MTU, (u16) it);
+
+  sink = acc;
+  return (now () - start) * 1e9 / ((double) iters * 100);
+}
+
+/* csum is always_inline, it needs a wrapper to be passed to bench_csum */
+static u16
+csum_vector (const void *addr, size_t size, u16 init)
+{
+  return csum (addr, size, init);
+}
+
+static double
+bench_vft (hicn_format_t format, int iters)
+{
+  hicn_name_t name;
+  u32 lifetime, acc = 0;
+  size_t payload_length;
+  double start = now ();
+  int it, i;
+
+  for (it = 0; it < iters; it++)
+    for (i = 0; i < N_PACKETS; i++)
+      {
+	hicn_header_t *h = (hicn_header_t *) packets[i];
+
+	hicn_interest_get_name (format, h, &name);
+	hicn_interest_get_lifetime (h, &lifetime);
+	hicn_packet_get_payload_length (format, h, &payload_length);
+	acc += name.ip4.suffix + lifetime + (u32) payload_length;
+      }
+
+  sink = acc;
+  return (now () - start) * 1e9 / ((double) iters * N_PACKETS);
+}
+
+static double
+bench_inline (hicn_format_t format, int iters)
+{
+  hicn_name_t name;
+  u32 lifetime, acc = 0;
+  size_t payload_length;
+  double start = now ();
+  int it, i;
+
+  for (it = 0; it < iters; it++)
+    for (i = 0; i < N_PACKETS; i++)
+      {
+	hicn_header_t *h = (hicn_header_t *) packets[i];
+
+	hicn_inline_interest_get_name (format, h, &name);
+	hicn_inline_interest_get_lifetime (format, h, &lifetime);
+	hicn_inline_packet_get_payload_length (format, h, &payload_length);
+	acc += name.ip4.suffix + lifetime + (u32) payload_length;
+      }
+
+  sink = acc;
+  return (now () - start) * 1e9 / ((double) iters * N_PACKETS);
+}
+
+int
+main (int argc, char *argv[])
+{
+  int iters = DEFAULT_ITERS;
+  int i;
+
+  if (argc > 1)
+    iters = atoi (argv[1]);
+
+  if (iters <= 0)
+    {
+      fprintf (stderr, "Usage: %s [iterations]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+
+  printf ("%-14s %14s %14s %8s\n", "format", "vft (ns/pkt)",
+	  "inline (ns/pkt)", "speedup");
+
+  for (i = 0; i < sizeof (formats) / sizeof (*formats); i++)
+    {
+      double t_vft, t_inline;
+
+      if (init_packets (formats[i].format) < 0 ||
+	  check_packets (formats[i].format) < 0)
+	{
+	  fprintf (stderr, "%s: accessors disagree\n", formats[i].name);
+	  return EXIT_FAILURE;
+	}
+
+      if (check_rewrites (formats[i].format) < 0)
+	{
+	  fprintf (stderr, "%s: invalid checksum after rewrite\n",
+		   formats[i].name);
+	  return EXIT_FAILURE;
+	}
+
+      t_vft = bench_vft (formats[i].format, iters);
+      t_inline = bench_inline (formats[i].format, iters);
+
+      printf ("%-14s %14.2f %14.2f %7.2fx\n", formats[i].name, t_vft,
+	      t_inline, t_vft / t_inline);
+    }
+
+  if (check_csum () < 0)
+    {
+      fprintf (stderr, "csum: vectorized and scalar checksums disagree\n");
+      return EXIT_FAILURE;
+    }
+
+  {
+    double t_scalar = bench_csum (csum_scalar, iters);
+    double t_vector = bench_csum (csum_vector, iters);
+
+    printf ("\n%-14s %14s %14s %8s\n", "checksum", "scalar (ns)",
+	    "vector (ns)", "speedup");
+    printf ("%-14s %14.2f %14.2f %7.2fx\n", "1400 bytes", t_scalar, t_vector,
+	    t_scalar / t_vector);
+  }
+
+  return EXIT_SUCCESS;
+}
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables:
+ * eval: (c-set-style "gnu")
+ * End:
+ */
@@ -266,6 +266,37 @@ void hicn_packet_dump (const uint8_t * buffer, size_t len);
 
 #endif /* ! HICN_VPP_PLUGIN */
 
+/*
+ * Buffers at least this large are summed by the vectorized kernels of
+ * checksum.c, smaller ones (e.g. pseudo headers) by the inline loop below.
+ */
+#define HICN_CSUM_VECTOR_MIN_SIZE 64
+
+/**
+ * @brief Adds the 16 bit words of a buffer to a one's complement sum
+ * @param [in] addr - Pointer to buffer start
+ * @param [in] size - Size of buffer
+ * @param [in] sum - Sum to add the buffer to
+ * @return Unfolded sum, to be reduced with hicn_csum_fold
+ *
+ * The implementation (AVX2, SSE4.2 or generic) is picked at the first call
+ * according to the features of the CPU.
+ */
+u64 hicn_csum_partial (const void *addr, size_t size, u64 sum);
+
+/**
+ * @brief Reduces a sum returned by hicn_csum_partial to 16 bits
+ */
+always_inline u16
+hicn_csum_fold (u64 sum)
+{
+  sum = (sum & 0xffffffff) + (sum >> 32);
+  sum = (sum & 0xffffffff) + (sum >> 32);
+  sum = (sum & 0xffff) + (sum >> 16);
+  sum = (sum & 0xffff) + (sum >> 16);
+  return (u16) sum;
+}
+
 /**
  * @brief Computes buffer checksum
  * @param [in] addr - Pointer to buffer start
@@ -276,6 +307,9 @@ void hicn_packet_dump (const uint8_t * buffer, size_t len);
 always_inline u16
 csum (const void *addr, size_t size, u16 init)
 {
+  if (size >= HICN_CSUM_VECTOR_MIN_SIZE)
+    return (u16) ~hicn_csum_fold (hicn_csum_partial (addr, size, init));
+
   u32 sum = init;
   const u16 *bytes = (u16 *) addr;
 
@@ -294,6 +328,43 @@ csum (const void *addr, size_t size, u16 init)
   return (u16) ~ sum;
 }
 
+/*
+ * Incremental checksum update (RFC 1624)
+ *
+ * When a 16 bit word m of a packet becomes m', its checksum HC becomes
+ * HC' = ~(~HC + ~m + m') (eqn. 3). Words are taken as stored in the packet,
+ * and must be at an even offset from the start of the checksummed data.
+ */
+
+/**
+ * @brief Updates a checksum after a 16 bit word of the packet has changed
+ * @param [in] csum - Checksum of the packet before the change
+ * @param [in] old_val - Previous value of the word
+ * @param [in] new_val - New value of the word
+ * @return Checksum of the packet after the change
+ */
+always_inline u16
+hicn_csum_update_u16 (u16 csum, u16 old_val, u16 new_val)
+{
+  u32 sum = (u16) ~csum;
+  sum += (u16) ~old_val;
+  sum += new_val;
+  sum = (sum & 0xffff) + (sum >> 16);
+  sum = (sum & 0xffff) + (sum >> 16);
+  return (u16) ~sum;
+}
+
+/**
+ * @brief Updates a checksum after a 32 bit word of the packet has changed
+ */
+always_inline u16
+hicn_csum_update_u32 (u16 csum, u32 old_val, u32 new_val)
+{
+  csum = hicn_csum_update_u16 (csum, (u16) old_val, (u16) new_val);
+  return hicn_csum_update_u16 (csum, (u16) (old_val >> 16),
+			       (u16) (new_val >> 16));
+}
+
 /*
  * Useful aliases
  */
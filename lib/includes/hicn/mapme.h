@@ -82,6 +82,23 @@ size_t hicn_mapme_create_ack (u8 * buf, const mapme_params_t * params);
 int hicn_mapme_parse_packet (const u8 * packet, hicn_prefix_t * prefix,
 			     mapme_params_t * params);
 
+/*
+ * Batched updates : a single packet carries the (prefix, seq) tuples of up to
+ * HICN_MAPME_BATCH_MAX prefixes. params->seq identifies the batch and is
+ * echoed in the acknowledgement, which also carries the tuples.
+ *
+ * hicn_mapme_parse_batch returns the number of tuples, or an error if the
+ * packet is not exactly a header and count tuples long according to its IP
+ * header, or if that length exceeds the len bytes received.
+ */
+size_t hicn_mapme_create_batch (u8 * buf, const hicn_prefix_t * prefixes,
+				const seq_t * seqs, size_t count,
+				const mapme_params_t * params);
+bool hicn_mapme_is_batch (const u8 * packet);
+int hicn_mapme_parse_batch (const u8 * packet, size_t len,
+			    hicn_prefix_t * prefixes, seq_t * seqs, size_t max,
+			    mapme_params_t * params);
+
 /* Implementation & parsing : ICMP Redirect */
 
 #define HICN_MAPME_ACK_FLAG (0x20 | 0x60)
@@ -91,6 +108,7 @@ int hicn_mapme_parse_packet (const u8 * packet, hicn_prefix_t * prefix,
 #define HICN_MAPME_ICMP_TYPE_ACK_IPV4 (HICN_MAPME_ICMP_TYPE_IPV4 | HICN_MAPME_ACK_FLAG)
 #define HICN_MAPME_ICMP_TYPE_ACK_IPV6 (HICN_MAPME_ICMP_TYPE_IPV6 | HICN_MAPME_ACK_FLAG)
 #define HICN_MAPME_ICMP_CODE 0	/* Redirect Datagrams for the Network (or subnet) */
+#define HICN_MAPME_ICMP_CODE_BATCH 1	/* Redirect Datagrams for the Host */
 
 #define HICN_MAPME_TYPE_IS_IU(type)     ((type == HICN_MAPME_ICMP_TYPE_IPV4)     || (type == HICN_MAPME_ICMP_TYPE_IPV6))
 #define HICN_MAPME_TYPE_IS_IU_ACK(type) ((type == HICN_MAPME_ICMP_TYPE_ACK_IPV4) || (type == HICN_MAPME_ICMP_TYPE_ACK_IPV6))
@@ -100,6 +118,8 @@ int hicn_mapme_parse_packet (const u8 * packet, hicn_prefix_t * prefix,
 
 #define HICN_IS_MAPME(type, code) (HICN_MAPME_IS_IU(type, code) || HICN_MAPME_IS_ACK(type, code))
 
+#define HICN_MAPME_IS_BATCH(type, code) ((HICN_MAPME_TYPE_IS_IU(type) || HICN_MAPME_TYPE_IS_IU_ACK(type)) && (code == HICN_MAPME_ICMP_CODE_BATCH))
+
 /* Fast check for ACK flag */
 #define HICN_MAPME_IS_ACK_FAST(icmp_type) (icmp_type & HICN_MAPME_ACK_FLAG)
 
@@ -146,10 +166,64 @@ typedef union
 #define HICN_MAPME_V4_HDRLEN sizeof(hicn_mapme_v4_header_t)
 #define HICN_MAPME_V6_HDRLEN sizeof(hicn_mapme_v6_header_t)
 
+/*
+ * Batched updates share the layout of the headers above, with the sequence
+ * number replaced by a batch identifier and the prefix length by the number
+ * of tuples following the header.
+ */
+
+/** @brief MAP-Me batch header for IPv4 */
+typedef struct
+{
+  _ipv4_header_t ip;
+  _icmprd4_header_t icmp_rd;
+  seq_t batch;
+  u16 count;
+  u8 _pad[2];
+} hicn_mapme_v4_batch_header_t;
+
+/** @brief MAP-Me batch header for IPv6 */
+typedef struct
+{
+  _ipv6_header_t ip;
+  _icmprd_header_t icmp_rd;
+  seq_t batch;
+  u16 count;
+  u8 _pad[2];
+} hicn_mapme_v6_batch_header_t;
+
+/*
+ * The length of the MAP-Me tuple struct must be 24 bytes.
+ */
+#define EXPECTED_MAPME_TUPLE_LEN 24
+
+/** @brief (prefix, seq) tuple of a MAP-Me batch */
+typedef struct
+{
+  ip46_address_t name;
+  seq_t seq;
+  u8 len;
+  u8 _pad[3];
+} hicn_mapme_tuple_t;
+
+#define HICN_MAPME_TUPLE_LEN sizeof(hicn_mapme_tuple_t)
+
+/* Keeps the largest (IPv4) batch within a 1500 bytes MTU */
+#define HICN_MAPME_BATCH_MAX 56
+
+#define HICN_MAPME_V4_BATCH_LEN(count) (HICN_MAPME_V4_HDRLEN + (count) * HICN_MAPME_TUPLE_LEN)
+#define HICN_MAPME_V6_BATCH_LEN(count) (HICN_MAPME_V6_HDRLEN + (count) * HICN_MAPME_TUPLE_LEN)
+
 static_assert (EXPECTED_MAPME_V4_HDRLEN == HICN_MAPME_V4_HDRLEN,
 	       "Size of MAPME_V4 struct does not match its expected size.");
 static_assert (EXPECTED_MAPME_V6_HDRLEN == HICN_MAPME_V6_HDRLEN,
 	       "Size of MAPME_V6 struct does not match its expected size.");
+static_assert (sizeof (hicn_mapme_v4_batch_header_t) == HICN_MAPME_V4_HDRLEN,
+	       "Size of MAPME_V4 batch struct does not match its expected size.");
+static_assert (sizeof (hicn_mapme_v6_batch_header_t) == HICN_MAPME_V6_HDRLEN,
+	       "Size of MAPME_V6 batch struct does not match its expected size.");
+static_assert (EXPECTED_MAPME_TUPLE_LEN == HICN_MAPME_TUPLE_LEN,
+	       "Size of MAPME tuple struct does not match its expected size.");
 
 #endif /* HICN_MAPME_H */
 
@@ -0,0 +1,543 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file packet_inline.h
+ * @brief Format-specialized packet accessors.
+ *
+ * The functions in compat.h find the layout of a packet by walking the
+ * hicn_ops_vft[] chain (e.g. IPv6 -> TCP -> AH), which costs several
+ * indirect calls per field. This file provides the same accessors as static
+ * inline functions, one set per concrete format:
+ *
+ *  - hicn_inet_tcp_*      HF_INET_TCP
+ *  - hicn_inet6_tcp_*     HF_INET6_TCP
+ *  - hicn_inet_tcp_ah_*   HF_INET_TCP_AH
+ *  - hicn_inet6_tcp_ah_*  HF_INET6_TCP_AH
+ *
+ * so that callers that already know the format of a packet access its fields
+ * at fixed offsets. The hicn_inline_* functions switch on the format and fall
+ * back to the compat.h API for the other formats (ICMP).
+ *
+ * No validation is performed: the packet must be of the given format and its
+ * headers must be contiguous in memory.
+ */
+
+#ifndef HICN_PACKET_INLINE_H
+#define HICN_PACKET_INLINE_H
+
+#ifndef _WIN32
+#include <arpa/inet.h> // ntohs
+#endif
+#include <stdbool.h>
+#include <string.h> // memcpy
+
+#include <hicn/compat.h>
+#include <hicn/error.h>
+#include <hicn/header.h>
+#include <hicn/name.h>
+
+/*
+ * Format table: format, function prefix, hicn_header_t member, IP helpers,
+ * IP header length macro prefix and length of the AH header and signature.
+ * The last field is evaluated with the packet header in h.
+ */
+#define foreach_hicn_inline_format                                           \
+  _ (INET_TCP, inet_tcp, v4, ipv4, IPV4, 0)                                  \
+  _ (INET6_TCP, inet6_tcp, v6, ipv6, IPV6, 0)                                \
+  _ (INET_TCP_AH, inet_tcp_ah, v4ah, ipv4, IPV4,                             \
+     AH_HDRLEN + (h->v4ah.ah.payloadlen << 2))                               \
+  _ (INET6_TCP_AH, inet6_tcp_ah, v6ah, ipv6, IPV6,                           \
+     AH_HDRLEN + (h->v6ah.ah.payloadlen << 2))
+
+/*
+ * IPv4 helpers
+ */
+
+always_inline size_t
+_hicn_ipv4_get_ip_payload_length (const _ipv4_header_t *ip)
+{
+  return ntohs (ip->len) - IPV4_HDRLEN;
+}
+
+always_inline void
+_hicn_ipv4_set_ip_payload_length (_ipv4_header_t *ip, size_t length)
+{
+  ip->len = htons ((u16) (length + IPV4_HDRLEN));
+}
+
+always_inline void
+_hicn_ipv4_get_name (const _ipv4_header_t *ip, const _tcp_header_t *tcp,
+		     hicn_name_t *name, bool is_interest)
+{
+  name->ip4.prefix_as_ip4 = is_interest ? ip->daddr : ip->saddr;
+  name->ip4.suffix = ntohl (tcp->name_suffix);
+#ifndef HICN_VPP_PLUGIN
+  name->type = HNT_CONTIGUOUS_V4;
+  name->len = HICN_V4_NAME_LEN;
+#endif /* HICN_VPP_PLUGIN */
+}
+
+always_inline void
+_hicn_ipv4_set_name (_ipv4_header_t *ip, _tcp_header_t *tcp,
+		     const hicn_name_t *name, bool is_interest)
+{
+  if (is_interest)
+    ip->daddr = name->ip4.prefix_as_ip4;
+  else
+    ip->saddr = name->ip4.prefix_as_ip4;
+  tcp->name_suffix = htonl (name->ip4.suffix);
+}
+
+always_inline void
+_hicn_ipv4_update_ip_checksum (_ipv4_header_t *ip)
+{
+  ip->csum = 0;
+  ip->csum = csum (ip, IPV4_HDRLEN, 0);
+}
+
+always_inline bool
+_hicn_ipv4_verify_ip_checksum (const _ipv4_header_t *ip)
+{
+  return csum (ip, IPV4_HDRLEN, 0) == 0;
+}
+
+always_inline u16
+_hicn_ipv4_pseudo_header_checksum (const _ipv4_header_t *ip, u16 partial_csum)
+{
+  ipv4_pseudo_header_t psh;
+
+  psh.ip_src = ip->saddr;
+  psh.ip_dst = ip->daddr;
+  psh.size = htons ((u16) _hicn_ipv4_get_ip_payload_length (ip));
+  psh.zero = 0;
+  psh.protocol = ip->protocol;
+
+  if (partial_csum != 0)
+    partial_csum = ~partial_csum;
+  return csum (&psh, IPV4_PSHDRLEN, partial_csum);
+}
+
+/*
+ * IPv6 helpers
+ */
+
+always_inline size_t
+_hicn_ipv6_get_ip_payload_length (const _ipv6_header_t *ip)
+{
+  return ntohs (ip->len);
+}
+
+always_inline void
+_hicn_ipv6_set_ip_payload_length (_ipv6_header_t *ip, size_t length)
+{
+  ip->len = htons ((u16) length);
+}
+
+always_inline void
+_hicn_ipv6_get_name (const _ipv6_header_t *ip, const _tcp_header_t *tcp,
+		     hicn_name_t *name, bool is_interest)
+{
+  name->ip6.prefix_as_ip6 = is_interest ? ip->daddr : ip->saddr;
+  name->ip6.suffix = ntohl (tcp->name_suffix);
+#ifndef HICN_VPP_PLUGIN
+  name->type = HNT_CONTIGUOUS_V6;
+  name->len = HICN_V6_NAME_LEN;
+#endif /* HICN_VPP_PLUGIN */
+}
+
+always_inline void
+_hicn_ipv6_set_name (_ipv6_header_t *ip, _tcp_header_t *tcp,
+		     const hicn_name_t *name, bool is_interest)
+{
+  if (is_interest)
+    ip->daddr = name->ip6.prefix_as_ip6;
+  else
+    ip->saddr = name->ip6.prefix_as_ip6;
+  tcp->name_suffix = htonl (name->ip6.suffix);
+}
+
+/* IPv6 has no header checksum */
+always_inline void
+_hicn_ipv6_update_ip_checksum (_ipv6_header_t *ip)
+{
+}
+
+always_inline bool
+_hicn_ipv6_verify_ip_checksum (const _ipv6_header_t *ip)
+{
+  return true;
+}
+
+always_inline u16
+_hicn_ipv6_pseudo_header_checksum (const _ipv6_header_t *ip, u16 partial_csum)
+{
+  ipv6_pseudo_header_t psh;
+
+  psh.ip_src = ip->saddr;
+  psh.ip_dst = ip->daddr;
+  /* Size is u32 and not u16, we cannot copy and need to care about endianness */
+  psh.size = htonl (ntohs (ip->len));
+  psh.zeros = 0;
+  psh.zero = 0;
+  psh.protocol = ip->nxt;
+
+  if (partial_csum != 0)
+    partial_csum = ~partial_csum;
+  return csum (&psh, IPV6_PSHDRLEN, partial_csum);
+}
+
+/*
+ * TCP helpers, shared by all the formats
+ */
+
+always_inline u32
+_hicn_tcp_get_lifetime (const _tcp_header_t *tcp)
+{
+  return ntohs (tcp->urg_ptr) << (tcp->data_offset_and_reserved & 0xF);
+}
+
+always_inline void
+_hicn_tcp_set_lifetime (_tcp_header_t *tcp, u32 lifetime)
+{
+  u8 multiplier = 0;
+  u32 lifetime_scaled = lifetime;
+
+  if (PREDICT_FALSE (lifetime >= HICN_MAX_LIFETIME))
+    {
+      tcp->urg_ptr = htons (HICN_MAX_LIFETIME_SCALED);
+      tcp->data_offset_and_reserved =
+	(tcp->data_offset_and_reserved & ~0x0F) | HICN_MAX_LIFETIME_MULTIPLIER;
+      return;
+    }
+
+  while (lifetime_scaled > HICN_MAX_LIFETIME_SCALED &&
+	 multiplier <= HICN_MAX_LIFETIME_MULTIPLIER)
+    {
+      multiplier++;
+      lifetime_scaled = lifetime_scaled >> 1;
+    }
+
+  tcp->urg_ptr = htons ((u16) lifetime_scaled);
+  tcp->data_offset_and_reserved =
+    (tcp->data_offset_and_reserved & ~0x0F) | multiplier;
+}
+
+/* The ECE flag is unset in interests and set in data packets */
+always_inline bool
+_hicn_tcp_is_interest (const _tcp_header_t *tcp)
+{
+  return !(tcp->flags & HICN_TCP_FLAG_ECE);
+}
+
+always_inline void
+_hicn_tcp_mark (_tcp_header_t *tcp, bool is_interest)
+{
+  if (is_interest)
+    tcp->flags &= ~HICN_TCP_FLAG_ECE;
+  else
+    tcp->flags |= HICN_TCP_FLAG_ECE;
+}
+
+/*
+ * Set the TCP checksum over length bytes starting at the TCP header.
+ * partial_csum is the checksum of the pseudo header and of the bytes that
+ * follow, if any.
+ */
+always_inline void
+_hicn_tcp_update_checksum (_tcp_header_t *tcp, size_t length,
+			   u16 partial_csum)
+{
+  tcp->csum = 0;
+  if (PREDICT_TRUE (partial_csum != 0))
+    partial_csum = ~partial_csum;
+  tcp->csum = csum (tcp, length, partial_csum);
+}
+
+/*
+ * Field rewrites keeping the TCP checksum valid. The checksum is updated
+ * incrementally (RFC 1624) instead of being recomputed over the whole
+ * packet, so it must be valid beforehand.
+ */
+
+always_inline void
+_hicn_tcp_rewrite_name_suffix (_tcp_header_t *tcp, u32 suffix)
+{
+  u32 new_val = htonl (suffix);
+
+  tcp->csum = hicn_csum_update_u32 (tcp->csum, tcp->name_suffix, new_val);
+  tcp->name_suffix = new_val;
+}
+
+always_inline void
+_hicn_tcp_rewrite_path_label (_tcp_header_t *tcp, u32 path_label)
+{
+  tcp->csum = hicn_csum_update_u32 (tcp->csum, tcp->seq_ack, path_label);
+  tcp->seq_ack = path_label;
+}
+
+/* The lifetime spans the multiplier in the data offset byte and urg_ptr */
+always_inline void
+_hicn_tcp_rewrite_lifetime (_tcp_header_t *tcp, u32 lifetime)
+{
+  u16 old_offset_flags, new_offset_flags;
+  u16 old_urg_ptr = tcp->urg_ptr;
+
+  memcpy (&old_offset_flags, &tcp->data_offset_and_reserved, sizeof (u16));
+  _hicn_tcp_set_lifetime (tcp, lifetime);
+  memcpy (&new_offset_flags, &tcp->data_offset_and_reserved, sizeof (u16));
+
+  tcp->csum =
+    hicn_csum_update_u16 (tcp->csum, old_offset_flags, new_offset_flags);
+  tcp->csum = hicn_csum_update_u16 (tcp->csum, old_urg_ptr, tcp->urg_ptr);
+}
+
+/*
+ * Per format accessors
+ */
+
+#define _(FMT, fmt, hdr, ipver, IPVER, ah_length)                            \
+  /* Length of all the headers, signature included */                        \
+  always_inline size_t hicn_##fmt##_get_header_length (                      \
+    const hicn_header_t *h)                                                  \
+  {                                                                          \
+    return IPVER##_HDRLEN + TCP_HDRLEN + (ah_length);                        \
+  }                                                                          \
+                                                                             \
+  always_inline size_t hicn_##fmt##_get_payload_length (                     \
+    const hicn_header_t *h)                                                  \
+  {                                                                          \
+    return _hicn_##ipver##_get_ip_payload_length (&h->hdr.ip) - TCP_HDRLEN - \
+	   (ah_length);                                                      \
+  }                                                                          \
+                                                                             \
+  always_inline void hicn_##fmt##_set_payload_length (hicn_header_t *h,      \
+						      size_t length)         \
+  {                                                                          \
+    _hicn_##ipver##_set_ip_payload_length (&h->hdr.ip,                       \
+					length + TCP_HDRLEN + (ah_length));  \
+  }                                                                          \
+                                                                             \
+  always_inline void hicn_##fmt##_get_interest_name (const hicn_header_t *h, \
+						     hicn_name_t *name)      \
+  {                                                                          \
+    _hicn_##ipver##_get_name (&h->hdr.ip, &h->hdr.tcp, name, true);          \
+  }                                                                          \
+                                                                             \
+  always_inline void hicn_##fmt##_set_interest_name (                        \
+    hicn_header_t *h, const hicn_name_t *name)                               \
+  {                                                                          \
+    _hicn_tcp_mark (&h->hdr.tcp, true);                                      \
+    _hicn_##ipver##_set_name (&h->hdr.ip, &h->hdr.tcp, name, true);          \
+  }                                                                          \
+                                                                             \
+  always_inline void hicn_##fmt##_get_data_name (const hicn_header_t *h,     \
+						 hicn_name_t *name)          \
+  {                                                                          \
+    _hicn_##ipver##_get_name (&h->hdr.ip, &h->hdr.tcp, name, false);         \
+  }                                                                          \
+                                                                             \
+  always_inline void hicn_##fmt##_set_data_name (hicn_header_t *h,           \
+						 const hicn_name_t *name)    \
+  {                                                                          \
+    _hicn_tcp_mark (&h->hdr.tcp, false);                                     \
+    _hicn_##ipver##_set_name (&h->hdr.ip, &h->hdr.tcp, name, false);         \
+  }                                                                          \
+                                                                             \
+  always_inline bool hicn_##fmt##_is_interest (const hicn_header_t *h)       \
+  {                                                                          \
+    return _hicn_tcp_is_interest (&h->hdr.tcp);                              \
+  }                                                                          \
+                                                                             \
+  always_inline u32 hicn_##fmt##_get_lifetime (const hicn_header_t *h)       \
+  {                                                                          \
+    return _hicn_tcp_get_lifetime (&h->hdr.tcp);                             \
+  }                                                                          \
+                                                                             \
+  always_inline void hicn_##fmt##_set_lifetime (hicn_header_t *h,            \
+						u32 lifetime)                \
+  {                                                                          \
+    _hicn_tcp_set_lifetime (&h->hdr.tcp, lifetime);                          \
+  }                                                                          \
+                                                                             \
+  always_inline u32 hicn_##fmt##_get_path_label (const hicn_header_t *h)     \
+  {                                                                          \
+    return h->hdr.tcp.seq_ack;                                               \
+  }                                                                          \
+                                                                             \
+  /* Checksums of the whole packet, payload included */                      \
+  always_inline void hicn_##fmt##_compute_checksum (hicn_header_t *h)        \
+  {                                                                          \
+    _hicn_##ipver##_update_ip_checksum (&h->hdr.ip);                         \
+    _hicn_tcp_update_checksum (                                              \
+      &h->hdr.tcp, _hicn_##ipver##_get_ip_payload_length (&h->hdr.ip),       \
+      _hicn_##ipver##_pseudo_header_checksum (&h->hdr.ip, 0));               \
+  }                                                                          \
+                                                                             \
+  /*                                                                         \
+   * Checksums of the headers only, init_sum being the checksum of the bytes \
+   * following the TCP header (AH and payload).                              \
+   */                                                                        \
+  always_inline void hicn_##fmt##_compute_header_checksum (hicn_header_t *h, \
+							   u16 init_sum)     \
+  {                                                                          \
+    _hicn_##ipver##_update_ip_checksum (&h->hdr.ip);                         \
+    _hicn_tcp_update_checksum (                                              \
+      &h->hdr.tcp, TCP_HDRLEN,                                               \
+      _hicn_##ipver##_pseudo_header_checksum (&h->hdr.ip, init_sum));        \
+  }                                                                          \
+                                                                             \
+  always_inline int hicn_##fmt##_verify_checksum (const hicn_header_t *h)    \
+  {                                                                          \
+    u16 partial_csum;                                                        \
+                                                                             \
+    if (!_hicn_##ipver##_verify_ip_checksum (&h->hdr.ip))                    \
+      return HICN_LIB_ERROR_CORRUPTED_PACKET;                                \
+                                                                             \
+    partial_csum = ~_hicn_##ipver##_pseudo_header_checksum (&h->hdr.ip, 0);  \
+    if (csum (&h->hdr.tcp,                                                   \
+	      _hicn_##ipver##_get_ip_payload_length (&h->hdr.ip),            \
+	      partial_csum) != 0)                                            \
+      return HICN_LIB_ERROR_CORRUPTED_PACKET;                                \
+                                                                             \
+    return HICN_LIB_ERROR_NONE;                                              \
+  }                                                                          \
+                                                                             \
+  /* Rewrites with an incremental update of the TCP checksum */              \
+  always_inline void hicn_##fmt##_rewrite_name_suffix (hicn_header_t *h,     \
+						       u32 suffix)           \
+  {                                                                          \
+    _hicn_tcp_rewrite_name_suffix (&h->hdr.tcp, suffix);                     \
+  }                                                                          \
+                                                                             \
+  always_inline void hicn_##fmt##_rewrite_path_label (hicn_header_t *h,      \
+						      u32 path_label)        \
+  {                                                                          \
+    _hicn_tcp_rewrite_path_label (&h->hdr.tcp, path_label);                  \
+  }                                                                          \
+                                                                             \
+  always_inline void hicn_##fmt##_rewrite_lifetime (hicn_header_t *h,        \
+						    u32 lifetime)            \
+  {                                                                          \
+    _hicn_tcp_rewrite_lifetime (&h->hdr.tcp, lifetime);                      \
+  }
+foreach_hicn_inline_format
+#undef _
+
+/*
+ * Dispatch on the format, with a fallback to compat.h
+ */
+
+#define _(FMT, fmt, hdr, ipver, IPVER, ah_length)                            \
+  case HF_##FMT:                                                             \
+    hicn_##fmt##_get_interest_name (h, name);                                \
+    return HICN_LIB_ERROR_NONE;
+
+always_inline int
+hicn_inline_interest_get_name (hicn_format_t format, const hicn_header_t *h,
+			       hicn_name_t *name)
+{
+  switch (format)
+    {
+      foreach_hicn_inline_format
+    default:
+      return hicn_interest_get_name (format, h, name);
+    }
+}
+#undef _
+
+#define _(FMT, fmt, hdr, ipver, IPVER, ah_length)                            \
+  case HF_##FMT:                                                             \
+    hicn_##fmt##_get_data_name (h, name);                                    \
+    return HICN_LIB_ERROR_NONE;
+
+always_inline int
+hicn_inline_data_get_name (hicn_format_t format, const hicn_header_t *h,
+			   hicn_name_t *name)
+{
+  switch (format)
+    {
+      foreach_hicn_inline_format
+    default:
+      return hicn_data_get_name (format, h, name);
+    }
+}
+#undef _
+
+#define _(FMT, fmt, hdr, ipver, IPVER, ah_length)                            \
+  case HF_##FMT:                                                             \
+    *lifetime = hicn_##fmt##_get_lifetime (h);                               \
+    return HICN_LIB_ERROR_NONE;
+
+always_inline int
+hicn_inline_interest_get_lifetime (hicn_format_t format,
+				   const hicn_header_t *h, u32 *lifetime)
+{
+  switch (format)
+    {
+      foreach_hicn_inline_format
+    default:
+      return hicn_interest_get_lifetime (h, lifetime);
+    }
+}
+#undef _
+
+#define _(FMT, fmt, hdr, ipver, IPVER, ah_length)                            \
+  case HF_##FMT:                                                             \
+    *header_length = hicn_##fmt##_get_header_length (h);                     \
+    return HICN_LIB_ERROR_NONE;
+
+always_inline int
+hicn_inline_packet_get_header_length (hicn_format_t format,
+				      const hicn_header_t *h,
+				      size_t *header_length)
+{
+  switch (format)
+    {
+      foreach_hicn_inline_format
+    default:
+      return hicn_packet_get_header_length (format, h, header_length);
+    }
+}
+#undef _
+
+#define _(FMT, fmt, hdr, ipver, IPVER, ah_length)                            \
+  case HF_##FMT:                                                             \
+    *payload_length = hicn_##fmt##_get_payload_length (h);                   \
+    return HICN_LIB_ERROR_NONE;
+
+always_inline int
+hicn_inline_packet_get_payload_length (hicn_format_t format,
+				       const hicn_header_t *h,
+				       size_t *payload_length)
+{
+  switch (format)
+    {
+      foreach_hicn_inline_format
+    default:
+      return hicn_packet_get_payload_length (format, h, payload_length);
+    }
+}
+#undef _
+
+#endif /* HICN_PACKET_INLINE_H */
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables:
+ * eval: (c-set-style "gnu")
+ * End:
+ */
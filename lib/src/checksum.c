@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file checksum.c
+ * @brief Vectorized computation of the Internet checksum (RFC 1071).
+ *
+ * The one's complement sum of the 16 bit words of a buffer is equal, once
+ * folded, to the sum of its 32 bit words: all kernels below therefore add
+ * 32 bit words into 64 bit accumulators, which cannot overflow for any
+ * realistic packet size, and leave the folding to hicn_csum_fold.
+ */
+
+#include <string.h>
+
+#include <hicn/common.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HICN_CSUM_X86 1
+#include <immintrin.h>
+#endif
+
+/*
+ * Adds the last (size < 4) bytes of a buffer, consistently with csum: the
+ * trailing byte, if any, is added as is.
+ */
+always_inline u64
+csum_tail (const u8 * p, size_t size, u64 sum)
+{
+  if (size >= 2)
+    {
+      u16 w;
+      memcpy (&w, p, sizeof (w));
+      sum += w;
+      p += 2;
+      size -= 2;
+    }
+  if (size)
+    sum += *p;
+  return sum;
+}
+
+/*
+ * Portable kernel. The loop is simple enough to be vectorized by the
+ * compiler on any target, including NEON.
+ */
+static u64
+csum_partial_generic (const void *addr, size_t size, u64 sum)
+{
+  const u8 *p = (const u8 *) addr;
+  u64 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+  u32 w[4];
+
+  for (; size >= 16; p += 16, size -= 16)
+    {
+      memcpy (w, p, sizeof (w));
+      s0 += w[0];
+      s1 += w[1];
+      s2 += w[2];
+      s3 += w[3];
+    }
+  for (; size >= 4; p += 4, size -= 4)
+    {
+      memcpy (w, p, sizeof (w[0]));
+      s0 += w[0];
+    }
+
+  sum += s0 + s1 + s2 + s3;
+  return csum_tail (p, size, sum);
+}
+
+#ifdef HICN_CSUM_X86
+
+/* Sums the two 64 bit lanes of a SSE register */
+__attribute__ ((target ("sse4.2")))
+static inline u64
+csum_hsum128 (__m128i v)
+{
+  return (u64) _mm_cvtsi128_si64 (v) + (u64) _mm_extract_epi64 (v, 1);
+}
+
+__attribute__ ((target ("sse4.2")))
+static u64
+csum_partial_sse42 (const void *addr, size_t size, u64 sum)
+{
+  const u8 *p = (const u8 *) addr;
+  __m128i acc0 = _mm_setzero_si128 ();
+  __m128i acc1 = _mm_setzero_si128 ();
+
+  for (; size >= 32; p += 32, size -= 32)
+    {
+      __m128i a = _mm_loadu_si128 ((const __m128i *) p);
+      __m128i b = _mm_loadu_si128 ((const __m128i *) (p + 16));
+
+      acc0 = _mm_add_epi64 (acc0, _mm_cvtepu32_epi64 (a));
+      acc1 = _mm_add_epi64 (acc1, _mm_cvtepu32_epi64 (_mm_srli_si128 (a, 8)));
+      acc0 = _mm_add_epi64 (acc0, _mm_cvtepu32_epi64 (b));
+      acc1 = _mm_add_epi64 (acc1, _mm_cvtepu32_epi64 (_mm_srli_si128 (b, 8)));
+    }
+
+  sum += csum_hsum128 (_mm_add_epi64 (acc0, acc1));
+  return csum_partial_generic (p, size, sum);
+}
+
+__attribute__ ((target ("avx2")))
+static u64
+csum_partial_avx2 (const void *addr, size_t size, u64 sum)
+{
+  const u8 *p = (const u8 *) addr;
+  const __m256i zero = _mm256_setzero_si256 ();
+  __m256i acc0 = _mm256_setzero_si256 ();
+  __m256i acc1 = _mm256_setzero_si256 ();
+
+  for (; size >= 64; p += 64, size -= 64)
+    {
+      __m256i a = _mm256_loadu_si256 ((const __m256i *) p);
+      __m256i b = _mm256_loadu_si256 ((const __m256i *) (p + 32));
+
+      /* Lane order does not matter for a sum */
+      acc0 = _mm256_add_epi64 (acc0, _mm256_unpacklo_epi32 (a, zero));
+      acc1 = _mm256_add_epi64 (acc1, _mm256_unpackhi_epi32 (a, zero));
+      acc0 = _mm256_add_epi64 (acc0, _mm256_unpacklo_epi32 (b, zero));
+      acc1 = _mm256_add_epi64 (acc1, _mm256_unpackhi_epi32 (b, zero));
+    }
+
+  acc0 = _mm256_add_epi64 (acc0, acc1);
+  sum += (u64) _mm256_extract_epi64 (acc0, 0);
+  sum += (u64) _mm256_extract_epi64 (acc0, 1);
+  sum += (u64) _mm256_extract_epi64 (acc0, 2);
+  sum += (u64) _mm256_extract_epi64 (acc0, 3);
+  return csum_partial_generic (p, size, sum);
+}
+
+#endif /* HICN_CSUM_X86 */
+
+typedef u64 (*csum_partial_fn) (const void *addr, size_t size, u64 sum);
+
+static u64 csum_partial_resolve (const void *addr, size_t size, u64 sum);
+
+/*
+ * Kernel in use, selected by csum_partial_resolve at the first call. Racing
+ * threads all store the same value, so no synchronization is needed.
+ */
+static csum_partial_fn csum_partial_impl = csum_partial_resolve;
+
+static u64
+csum_partial_resolve (const void *addr, size_t size, u64 sum)
+{
+  csum_partial_fn fn = csum_partial_generic;
+
+#ifdef HICN_CSUM_X86
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx2"))
+    fn = csum_partial_avx2;
+  else if (__builtin_cpu_supports ("sse4.2"))
+    fn = csum_partial_sse42;
+#endif
+
+  csum_partial_impl = fn;
+  return fn (addr, size, sum);
+}
+
+u64
+hicn_csum_partial (const void *addr, size_t size, u64 sum)
+{
+  return csum_partial_impl (addr, size, sum);
+}
+
+/*
+ * fd.io coding-style-patch-verification: ON
+ *
+ * Local Variables:
+ * eval: (c-set-style "gnu")
+ * End:
+ */
@@ -102,6 +102,113 @@ hicn_mapme_create_packet (u8 * buf, const hicn_prefix_t * prefix,
     return hicn_mapme_v4_create_packet (buf, prefix, params);
 }
 
+static void
+hicn_mapme_fill_tuples (hicn_mapme_tuple_t * tuples,
+			const hicn_prefix_t * prefixes, const seq_t * seqs,
+			size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+    {
+      /* *INDENT-OFF* */
+      tuples[i] = (hicn_mapme_tuple_t) {
+	.name = prefixes[i].name,
+	.seq = htonl(seqs[i]),
+	.len = prefixes[i].len,
+      };
+      /* *INDENT-ON* */
+    }
+}
+
+size_t
+hicn_mapme_v4_create_batch (u8 * buf, const hicn_prefix_t * prefixes,
+			    const seq_t * seqs, size_t count,
+			    const mapme_params_t * params)
+{
+  hicn_mapme_v4_batch_header_t *mh = (hicn_mapme_v4_batch_header_t *) buf;
+  size_t len = HICN_MAPME_V4_BATCH_LEN (count);
+  /* *INDENT-OFF* */
+  *mh = (hicn_mapme_v4_batch_header_t) {
+    .ip = {
+      .version_ihl = (IPV4_DEFAULT_VERSION << 4) | (0x0f & IPV4_DEFAULT_IHL),
+      .tos = IPV4_DEFAULT_TOS,
+      .len = htons(len),
+      .id = htons(IPV4_DEFAULT_ID),
+      .frag_off = htons(IPV4_DEFAULT_FRAG_OFF),
+      .ttl = HICN_MAPME_TTL,
+      .protocol = IPPROTO_ICMP,
+      .csum = 0,
+      .saddr.as_u32 = 0,
+      .daddr = prefixes[0].name.ip4,
+     },
+    .icmp_rd = {
+      .type = ((params->type == UPDATE) || (params->type == NOTIFICATION)) ? HICN_MAPME_ICMP_TYPE_IPV4 : HICN_MAPME_ICMP_TYPE_ACK_IPV4,
+      .code = HICN_MAPME_ICMP_CODE_BATCH,
+      .csum = 0,
+      .ip = prefixes[0].name.ip4,
+    },
+    .batch = htonl(params->seq),
+    .count = htons(count),
+  };
+  /* *INDENT-ON* */
+  hicn_mapme_fill_tuples ((hicn_mapme_tuple_t *) (mh + 1), prefixes, seqs,
+			  count);
+
+  return len;
+}
+
+size_t
+hicn_mapme_v6_create_batch (u8 * buf, const hicn_prefix_t * prefixes,
+			    const seq_t * seqs, size_t count,
+			    const mapme_params_t * params)
+{
+  hicn_mapme_v6_batch_header_t *mh = (hicn_mapme_v6_batch_header_t *) buf;
+  size_t len = HICN_MAPME_V6_BATCH_LEN (count);
+  /* *INDENT-OFF* */
+  *mh = (hicn_mapme_v6_batch_header_t) {
+    .ip = {
+      .saddr = {{0}},
+      .daddr = prefixes[0].name.ip6,
+      .version_class_flow = htonl(
+          (IPV6_DEFAULT_VERSION       << 28) |
+          (IPV6_DEFAULT_TRAFFIC_CLASS << 20) |
+          (IPV6_DEFAULT_FLOW_LABEL     & 0xfffff)),
+      .len = htons(len - IPV6_HDRLEN),
+      .nxt = IPPROTO_ICMPV6,
+      .hlim = HICN_MAPME_TTL,
+     },
+    .icmp_rd = {
+      .type = ((params->type == UPDATE) || (params->type == NOTIFICATION)) ? HICN_MAPME_ICMP_TYPE_IPV6 : HICN_MAPME_ICMP_TYPE_ACK_IPV6,
+      .code = HICN_MAPME_ICMP_CODE_BATCH,
+      .csum = 0,
+      .res = 0,
+      .tgt = prefixes[0].name.ip6,
+      .dst = prefixes[0].name.ip6,
+    },
+    .batch = htonl(params->seq),
+    .count = htons(count),
+  };
+  /* *INDENT-ON* */
+  hicn_mapme_fill_tuples ((hicn_mapme_tuple_t *) (mh + 1), prefixes, seqs,
+			  count);
+
+  return len;
+}
+
+size_t
+hicn_mapme_create_batch (u8 * buf, const hicn_prefix_t * prefixes,
+			 const seq_t * seqs, size_t count,
+			 const mapme_params_t * params)
+{
+  if (count == 0 || count > HICN_MAPME_BATCH_MAX)
+    return 0;
+
+  /* We currently ignore subsequent protocol definitions */
+  if (PREDICT_TRUE (params->protocol == IPPROTO_IPV6))
+    return hicn_mapme_v6_create_batch (buf, prefixes, seqs, count, params);
+  else
+    return hicn_mapme_v4_create_batch (buf, prefixes, seqs, count, params);
+}
+
 size_t
 hicn_mapme_v4_create_ack (u8 * buf, const mapme_params_t * params)
 {
@@ -115,6 +222,12 @@ hicn_mapme_v4_create_ack (u8 * buf, const mapme_params_t * params)
   mh->icmp_rd.type = HICN_MAPME_ICMP_TYPE_ACK_IPV4;
   mh->icmp_rd.csum = 0;
 
+  /* A batch is acknowledged with all its tuples */
+  if (mh->icmp_rd.code == HICN_MAPME_ICMP_CODE_BATCH)
+    return HICN_MAPME_V4_BATCH_LEN (ntohs
+				    (((hicn_mapme_v4_batch_header_t *)
+				      mh)->count));
+
   return HICN_MAPME_V4_HDRLEN;
 }
 
@@ -131,6 +244,12 @@ hicn_mapme_v6_create_ack (u8 * buf, const mapme_params_t * params)
   mh->icmp_rd.type = HICN_MAPME_ICMP_TYPE_ACK_IPV6;
   mh->icmp_rd.csum = 0;
 
+  /* A batch is acknowledged with all its tuples */
+  if (mh->icmp_rd.code == HICN_MAPME_ICMP_CODE_BATCH)
+    return HICN_MAPME_V6_BATCH_LEN (ntohs
+				    (((hicn_mapme_v6_batch_header_t *)
+				      mh)->count));
+
   return HICN_MAPME_V6_HDRLEN;
 }
 
@@ -207,6 +326,109 @@ hicn_mapme_parse_packet (const u8 * packet, hicn_prefix_t * prefix,
     }
 }
 
+bool
+hicn_mapme_is_batch (const u8 * packet)
+{
+  const hicn_mapme_header_t *mh = (const hicn_mapme_header_t *) packet;
+
+  switch (HICN_IP_VERSION (packet))
+    {
+    case 4:
+      return mh->v4.ip.protocol == IPPROTO_ICMP
+	&& HICN_MAPME_IS_BATCH (mh->v4.icmp_rd.type, mh->v4.icmp_rd.code);
+    case 6:
+      return mh->v6.ip.nxt == IPPROTO_ICMPV6
+	&& HICN_MAPME_IS_BATCH (mh->v6.icmp_rd.type, mh->v6.icmp_rd.code);
+    default:
+      return false;
+    }
+}
+
+static void
+hicn_mapme_parse_tuples (const hicn_mapme_tuple_t * tuples,
+			 hicn_prefix_t * prefixes, seq_t * seqs, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+    {
+      /* *INDENT-OFF* */
+      prefixes[i] = (hicn_prefix_t) {
+	.name = tuples[i].name,
+	.len = tuples[i].len,
+      };
+      /* *INDENT-ON* */
+      seqs[i] = ntohl (tuples[i].seq);
+    }
+}
+
+int
+hicn_mapme_parse_batch (const u8 * packet, size_t len,
+			hicn_prefix_t * prefixes, seq_t * seqs, size_t max,
+			mapme_params_t * params)
+{
+  size_t count;
+
+  if (len == 0)
+    return HICN_LIB_ERROR_CORRUPTED_PACKET;
+
+  switch (HICN_IP_VERSION (packet))
+    {
+    case 4:
+      {
+	hicn_mapme_v4_batch_header_t *mh =
+	  (hicn_mapme_v4_batch_header_t *) packet;
+	if (len < HICN_MAPME_V4_HDRLEN)
+	  return HICN_LIB_ERROR_CORRUPTED_PACKET;
+
+	count = ntohs (mh->count);
+	if (count > max)
+	  return HICN_LIB_ERROR_UNEXPECTED;
+	if (ntohs (mh->ip.len) != HICN_MAPME_V4_BATCH_LEN (count)
+	    || HICN_MAPME_V4_BATCH_LEN (count) > len)
+	  return HICN_LIB_ERROR_CORRUPTED_PACKET;
+
+	/* *INDENT-OFF* */
+	*params = (mapme_params_t) {
+	  .protocol = IPPROTO_IP,
+	  .type = (mh->icmp_rd.type == HICN_MAPME_ICMP_TYPE_IPV4) ? UPDATE : UPDATE_ACK,
+	  .seq = ntohl (mh->batch),
+	};
+	/* *INDENT-ON* */
+	hicn_mapme_parse_tuples ((const hicn_mapme_tuple_t *) (mh + 1),
+				 prefixes, seqs, count);
+	break;
+      }
+    case 6:
+      {
+	hicn_mapme_v6_batch_header_t *mh =
+	  (hicn_mapme_v6_batch_header_t *) packet;
+	if (len < HICN_MAPME_V6_HDRLEN)
+	  return HICN_LIB_ERROR_CORRUPTED_PACKET;
+
+	count = ntohs (mh->count);
+	if (count > max)
+	  return HICN_LIB_ERROR_UNEXPECTED;
+	if (IPV6_HDRLEN + ntohs (mh->ip.len) != HICN_MAPME_V6_BATCH_LEN (count)
+	    || HICN_MAPME_V6_BATCH_LEN (count) > len)
+	  return HICN_LIB_ERROR_CORRUPTED_PACKET;
+
+	/* *INDENT-OFF* */
+	*params = (mapme_params_t) {
+	  .protocol = IPPROTO_IPV6,
+	  .type = (mh->icmp_rd.type == HICN_MAPME_ICMP_TYPE_IPV6) ? UPDATE : UPDATE_ACK,
+	  .seq = ntohl (mh->batch),
+	};
+	/* *INDENT-ON* */
+	hicn_mapme_parse_tuples ((const hicn_mapme_tuple_t *) (mh + 1),
+				 prefixes, seqs, count);
+	break;
+      }
+    default:
+      return HICN_LIB_ERROR_UNEXPECTED;
+    }
+
+  return (int) count;
+}
+
 /*
  * fd.io coding-style-patch-verification: ON
  *
@@ -17,6 +17,8 @@
 
 #include <hicn/transport/auth/crypto_hash.h>
 
+#include <vector>
+
 extern "C" {
 #include <parc/security/parc_CryptoHasher.h>
 };
@@ -61,6 +63,19 @@ class CryptoHasher {
     return hash;
   }
 
+  // Return how many buffers hashBuffers processes in a single pass for the
+  // given hash type, or 0 if buffers are hashed one at a time.
+  static std::size_t getMultiBufferLanes(CryptoHashType hash_type);
+
+  // Compute the digests of n buffers. SHA-256 digests are computed 8 (AVX2)
+  // or 16 (AVX-512) buffers at a time by a multi-buffer kernel when this is
+  // faster than the single-buffer path; otherwise each buffer is hashed on its
+  // own. Element i of the result is the digest of buffers[i].
+  static std::vector<CryptoHash> hashBuffers(CryptoHashType hash_type,
+                                             const uint8_t *const *buffers,
+                                             const std::size_t *lengths,
+                                             std::size_t n);
+
  private:
   PARCCryptoHasher* hasher_;
   bool managed_;
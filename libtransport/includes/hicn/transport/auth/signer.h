@@ -16,6 +16,7 @@
 #pragma once
 
 #include <hicn/transport/auth/common.h>
+#include <hicn/transport/auth/crypto_hasher.h>
 #include <hicn/transport/errors/errors.h>
 
 extern "C" {
@@ -40,6 +41,16 @@ class Signer {
   // Sign a packet.
   virtual void signPacket(PacketPtr packet);
 
+  // Sign a packet, computing its digest with the given hasher instead of the
+  // one owned by the PARC signer. Several threads can sign with the same
+  // signer as long as each one uses its own hasher.
+  virtual void signPacket(PacketPtr packet, CryptoHasher &hasher);
+
+  // Return true if packets can be signed concurrently using signPacket with
+  // one hasher per thread. Keyed (HMAC) signers cannot, since the key lives
+  // in the PARC hasher.
+  bool supportsConcurrentSigning() const;
+
   // Set the signer object used to sign packets.
   void setSigner(PARCSigner *signer);
 
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <hicn/transport/auth/common.h>
+#include <hicn/transport/auth/crypto_hash.h>
+#include <hicn/transport/errors/runtime_exception.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace transport {
+namespace auth {
+
+// Packet digests announced by manifests, stored in a flat array sorted by
+// suffix. Lookups are binary searches and the storage is reused, so that once
+// the array has reached its working size adding the entries of a manifest
+// does not allocate.
+class SuffixHashes {
+ public:
+  static constexpr std::size_t max_digest_size = 64;
+
+  struct Entry {
+    Suffix suffix;
+    CryptoHashType type;
+    bool erased;
+    uint8_t digest[max_digest_size];
+  };
+
+  SuffixHashes() : sorted_size_(0), erased_(0), unsorted_(false) {}
+
+  // Add the digest of packet 'suffix'. A digest added for a suffix which is
+  // already present replaces the old one right away, new suffixes are only
+  // visible to find after the next call to sort. If a new suffix is added
+  // more than once before that, the last digest is kept.
+  void add(Suffix suffix, CryptoHashType type, const uint8_t *digest) {
+    auto size = hash_size_map.find(type);
+    if (size == hash_size_map.end() || size->second > max_digest_size) {
+      throw errors::RuntimeException("Unsupported manifest hash algorithm.");
+    }
+
+    Entry *entry = lookup(suffix);
+    if (entry) {
+      if (entry->erased) {
+        entry->erased = false;
+        erased_--;
+      }
+    } else {
+      entries_.emplace_back();
+      entry = &entries_.back();
+      entry->suffix = suffix;
+      entry->erased = false;
+      unsorted_ = true;
+    }
+
+    entry->type = type;
+    std::memcpy(entry->digest, digest, size->second);
+  }
+
+  // Add all the entries of a manifest. Entries must provide getSuffix() and
+  // getHash(), like the entries of a decoded manifest.
+  template <typename Entries>
+  void add(const Entries &entries, CryptoHashType type) {
+    for (const auto &entry : entries) {
+      add(entry.getSuffix(), type, entry.getHash());
+    }
+  }
+
+  // Merge the entries added since the last call and drop the erased ones.
+  void sort() {
+    if (erased_) {
+      entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                    [](const Entry &e) { return e.erased; }),
+                     entries_.end());
+      erased_ = 0;
+    }
+
+    // The erased entries and the new ones may have the same count, so the
+    // sizes do not tell whether there is something to merge.
+    if (unsorted_) {
+      auto by_suffix = [](const Entry &a, const Entry &b) {
+        return a.suffix < b.suffix;
+      };
+      std::stable_sort(entries_.begin(), entries_.end(), by_suffix);
+
+      // Entries with the same suffix are in insertion order, keep the last
+      auto out = entries_.begin();
+      for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        auto next = it + 1;
+        if (next != entries_.end() && next->suffix == it->suffix) {
+          continue;
+        }
+        if (out != it) {
+          *out = *it;
+        }
+        ++out;
+      }
+      entries_.erase(out, entries_.end());
+      unsorted_ = false;
+    }
+
+    sorted_size_ = entries_.size();
+  }
+
+  const Entry *find(Suffix suffix) const {
+    const Entry *entry = const_cast<SuffixHashes *>(this)->lookup(suffix);
+    return entry && !entry->erased ? entry : nullptr;
+  }
+
+  // Forget the digest of packet 'suffix', typically once it has been used.
+  void erase(Suffix suffix) {
+    Entry *entry = lookup(suffix);
+    if (entry && !entry->erased) {
+      entry->erased = true;
+      erased_++;
+    }
+  }
+
+  // Number of entries visible to find.
+  std::size_t size() const { return sorted_size_ - erased_; }
+
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    entries_.clear();
+    sorted_size_ = 0;
+    erased_ = 0;
+    unsorted_ = false;
+  }
+
+ private:
+  Entry *lookup(Suffix suffix) {
+    auto end = entries_.begin() + sorted_size_;
+    auto it = std::lower_bound(
+        entries_.begin(), end, suffix,
+        [](const Entry &e, Suffix s) { return e.suffix < s; });
+    return it != end && it->suffix == suffix ? &*it : nullptr;
+  }
+
+  std::vector<Entry> entries_;
+  std::size_t sorted_size_;
+  std::size_t erased_;
+  bool unsorted_;
+};
+
+}  // namespace auth
+}  // namespace transport
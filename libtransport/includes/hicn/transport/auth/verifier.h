@@ -17,6 +17,7 @@
 
 #include <hicn/transport/auth/common.h>
 #include <hicn/transport/auth/policies.h>
+#include <hicn/transport/auth/suffix_hashes.h>
 #include <hicn/transport/core/content_object.h>
 #include <hicn/transport/errors/errors.h>
 #include <hicn/transport/interfaces/callbacks.h>
@@ -78,6 +79,31 @@ class Verifier {
     return verifyPackets(std::vector<PacketPtr>{packet}, suffix_map).front();
   }
 
+  // Same as above, with the hashes of the manifests stored in a flat array
+  // sorted by suffix instead of a map.
+  virtual std::vector<VerificationPolicy> verifyPackets(
+      const std::vector<PacketPtr> &packets,
+      const SuffixHashes &suffix_hashes);
+  VerificationPolicy verifyPackets(PacketPtr packet,
+                                   const SuffixHashes &suffix_hashes) {
+    return verifyPackets(std::vector<PacketPtr>{packet}, suffix_hashes)
+        .front();
+  }
+
+  // Same as verifyPackets with manifest hashes, but without calling the
+  // VerificationFailedCallback. Only packet hashes are computed, so this can be
+  // called concurrently from several threads.
+  virtual std::vector<VerificationPolicy> checkPacketHashes(
+      const std::vector<PacketPtr> &packets,
+      const std::unordered_map<Suffix, HashEntry> &suffix_map);
+  virtual std::vector<VerificationPolicy> checkPacketHashes(
+      const std::vector<PacketPtr> &packets,
+      const SuffixHashes &suffix_hashes);
+
+  // Return whether verifyPacket can be called concurrently from several
+  // threads on this verifier.
+  virtual bool supportsConcurrentVerification() const { return false; }
+
   // Add a general PARC key which can be used to verify packet signatures.
   void addKey(PARCKey *key);
 
@@ -96,6 +122,10 @@ class Verifier {
 
   static size_t getSignatureSize(const PacketPtr);
 
+  // Call VerificationFailedCallback if it is set and update the packet policy.
+  void callVerificationFailedCallback(PacketPtr packet,
+                                      VerificationPolicy &policy);
+
  protected:
   PARCCryptoHasher *hasher_;
   PARCVerifier *verifier_;
@@ -105,9 +135,9 @@ class Verifier {
   // Internally compute a packet hash using the hasher object.
   virtual CryptoHash computeHash(PacketPtr packet);
 
-  // Call VerificationFailedCallback if it is set and update the packet policy.
-  void callVerificationFailedCallback(PacketPtr packet,
-                                      VerificationPolicy &policy);
+  // Compute the hash of a packet signed with the given key and hash type.
+  virtual CryptoHash computeHash(PacketPtr packet, PARCKeyId *key_id,
+                                 PARCCryptoHashType hash_type);
 };
 
 class VoidVerifier : public Verifier {
@@ -122,6 +152,20 @@ class VoidVerifier : public Verifier {
   std::vector<VerificationPolicy> verifyPackets(
       const std::vector<PacketPtr> &packets,
       const std::unordered_map<Suffix, HashEntry> &suffix_map) override;
+
+  std::vector<VerificationPolicy> verifyPackets(
+      const std::vector<PacketPtr> &packets,
+      const SuffixHashes &suffix_hashes) override;
+
+  std::vector<VerificationPolicy> checkPacketHashes(
+      const std::vector<PacketPtr> &packets,
+      const std::unordered_map<Suffix, HashEntry> &suffix_map) override;
+
+  std::vector<VerificationPolicy> checkPacketHashes(
+      const std::vector<PacketPtr> &packets,
+      const SuffixHashes &suffix_hashes) override;
+
+  bool supportsConcurrentVerification() const override { return true; }
 };
 
 class AsymmetricVerifier : public Verifier {
@@ -138,6 +182,16 @@ class AsymmetricVerifier : public Verifier {
 
   // Extract the public key of a certificate file.
   void setCertificate(const std::string &cert_path);
+
+  // Packets are hashed with a local hasher unless one was set with setHasher,
+  // so that several threads can verify packets at the same time.
+  bool supportsConcurrentVerification() const override {
+    return hasher_ == nullptr;
+  }
+
+ protected:
+  CryptoHash computeHash(PacketPtr packet, PARCKeyId *key_id,
+                         PARCCryptoHashType hash_type) override;
 };
 
 class SymmetricVerifier : public Verifier {
@@ -157,8 +211,7 @@ class SymmetricVerifier : public Verifier {
   // Construct a signer object. Passphrase must be set beforehand.
   void setSigner(const PARCCryptoSuite &suite);
 
-  virtual std::vector<VerificationPolicy> verifyPackets(
-      const std::vector<PacketPtr> &packets) override;
+  bool verifyPacket(PacketPtr packet) override;
 
  protected:
   PARCBuffer *passphrase_;
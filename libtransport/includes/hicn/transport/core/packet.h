@@ -180,17 +180,15 @@ class Packet : public utils::MemBuf,
 
   virtual auth::CryptoHash computeDigest(auth::CryptoHashType algorithm) const;
 
-  void setChecksum() {
-    uint16_t partial_csum =
-        csum(data() + HICN_V6_TCP_HDRLEN, length() - HICN_V6_TCP_HDRLEN, 0);
-
-    for (utils::MemBuf *current = next(); current != this;
-         current = current->next()) {
-      partial_csum = csum(current->data(), current->length(), ~partial_csum);
-    }
+  // Compute the digests of several packets in one go, using the multi-buffer
+  // hashing of auth::CryptoHasher. Element i of the result is the digest of
+  // packets[i], as computeDigest would return it.
+  static std::vector<auth::CryptoHash> computeDigests(
+      auth::CryptoHashType algorithm, Packet *const *packets, std::size_t n);
 
+  void setChecksum() {
     if (hicn_packet_compute_header_checksum(format_, packet_start_,
-                                            partial_csum) < 0) {
+                                            payloadChecksum()) < 0) {
       throw errors::MalformedPacketException();
     }
   }
@@ -221,6 +219,19 @@ class Packet : public utils::MemBuf,
   uint8_t getTTL() const;
 
  private:
+  // Checksum of everything after the TCP header, along the whole MemBuf chain
+  uint16_t payloadChecksum() const {
+    uint64_t sum = hicn_csum_partial(data() + HICN_V6_TCP_HDRLEN,
+                                     length() - HICN_V6_TCP_HDRLEN, 0);
+
+    for (const utils::MemBuf *current = next(); current != this;
+         current = current->next()) {
+      sum = hicn_csum_partial(current->data(), current->length(), sum);
+    }
+
+    return static_cast<uint16_t>(~hicn_csum_fold(sum));
+  }
+
   virtual void resetForHash() = 0;
   void setSignatureSize(std::size_t size_bytes);
   void prependPayload(const uint8_t **buffer, std::size_t *size);
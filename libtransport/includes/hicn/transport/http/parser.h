@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace transport {
+
+namespace http {
+
+// Non owning reference to a part of the buffer being parsed.
+struct HTTPStringView {
+  const char *data = nullptr;
+  std::size_t length = 0;
+
+  std::string str() const { return std::string(data, length); }
+
+  bool empty() const { return length == 0; }
+
+  std::string lowercase() const;
+
+  bool equalsIgnoreCase(const char *s, std::size_t size) const;
+
+  bool equalsIgnoreCase(const char *s) const {
+    return equalsIgnoreCase(s, std::strlen(s));
+  }
+
+  bool contains(const char *s) const;
+
+  // Decimal value of the view, false if it is not a number.
+  bool toNumber(std::size_t &value) const;
+};
+
+struct HTTPHeaderView {
+  HTTPStringView name;
+  HTTPStringView value;
+};
+
+// Zero copy HTTP/1.x tokenizer. The request (or status) line and the header
+// lines are split in place, with SIMD scans of the buffer on x86: no string
+// is allocated and the views are valid as long as the buffer is.
+class HTTPMessageView {
+ public:
+  static constexpr std::size_t max_headers = 64;
+
+  // Tokenize the message header in buffer. Return the length of the header,
+  // final empty line included, or 0 if it is incomplete or malformed.
+  std::size_t parse(const uint8_t *buffer, std::size_t size);
+
+  // Method, target and version of a request; version, status code and
+  // reason of a response.
+  const HTTPStringView &startLine(std::size_t i) const {
+    return start_line_[i];
+  }
+
+  std::size_t headerCount() const { return header_count_; }
+
+  const HTTPHeaderView &header(std::size_t i) const { return headers_[i]; }
+
+  // Case insensitive lookup, nullptr if the header is not there.
+  const HTTPStringView *find(const char *name) const;
+
+  // Version number of a "HTTP/x.y" string, false if it is not one.
+  static bool parseVersion(const HTTPStringView &token,
+                           HTTPStringView &version);
+
+ private:
+  HTTPStringView start_line_[3];
+  HTTPHeaderView headers_[max_headers];
+  std::size_t header_count_ = 0;
+};
+
+}  // end namespace http
+
+}  // end namespace transport
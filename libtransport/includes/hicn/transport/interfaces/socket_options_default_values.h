@@ -40,6 +40,8 @@ static constexpr uint32_t key_locator_size = 60;          // bytes
 static constexpr uint32_t limit_guard = 80;               // bytes
 static constexpr uint32_t digest_size = 34;               // bytes
 static constexpr uint32_t max_out_of_order_segments = 3;  // content object
+static constexpr uint32_t signing_threads = 0;  // sign on production thread
+static constexpr uint32_t verification_threads = 0;  // verify on portal thread
 
 // RAAQM
 static constexpr int sample_number = 30;
@@ -49,6 +51,7 @@ static constexpr double drop_factor = 0.2;
 static constexpr double minimum_drop_probability = 0.00001;
 static constexpr int path_id = 0;
 static constexpr double rate_alpha = 0.8;
+static constexpr bool interest_pacing = false;
 
 // Rate estimation
 static constexpr uint32_t batch = 50;
@@ -57,7 +57,9 @@ typedef enum {
   SIGNER = 121,
   VERIFIER = 122,
   STATS_INTERVAL = 125,
-  SUFFIX_STRATEGY = 126
+  SUFFIX_STRATEGY = 126,
+  SIGNING_THREADS = 127,
+  VERIFICATION_THREADS = 128
 } GeneralTransportOptions;
 
 typedef enum {
@@ -68,7 +70,8 @@ typedef enum {
   MINIMUM_DROP_PROBABILITY = 205,
   PATH_ID = 206,
   RTT_STATS = 207,
-  PER_SESSION_CWINDOW_RESET = 208
+  PER_SESSION_CWINDOW_RESET = 208,
+  INTEREST_PACING = 209
 } RaaqmTransportOptions;
 
 typedef enum {
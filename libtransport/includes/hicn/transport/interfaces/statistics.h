@@ -53,7 +53,10 @@ class TransportStatistics {
         status_(-1),
         // avg_data_rtt_(0),
         avg_pending_pkt_(0.0),
-        received_nacks_(0) {}
+        received_nacks_(0),
+        verification_queue_depth_(0),
+        avg_verification_latency_(0.0),
+        pacing_rate_(0.0) {}
 
   TRANSPORT_ALWAYS_INLINE void updateRetxCount(uint64_t retx) {
     retx_count_ += retx;
@@ -110,6 +113,20 @@ class TransportStatistics {
     received_nacks_ += nacks;
   }
 
+  TRANSPORT_ALWAYS_INLINE void updateVerificationQueueDepth(uint32_t depth) {
+    verification_queue_depth_ = depth;
+  }
+
+  TRANSPORT_ALWAYS_INLINE void updateAverageVerificationLatency(
+      uint64_t latency) {
+    avg_verification_latency_ = (alpha_ * avg_verification_latency_) +
+                                ((1. - alpha_) * double(latency));
+  }
+
+  TRANSPORT_ALWAYS_INLINE void updatePacingRate(double rate) {
+    pacing_rate_ = rate;
+  }
+
   TRANSPORT_ALWAYS_INLINE uint64_t getRetxCount() const { return retx_count_; }
 
   TRANSPORT_ALWAYS_INLINE uint64_t getBytesRecv() const {
@@ -156,6 +173,20 @@ class TransportStatistics {
     return received_nacks_;
   }
 
+  TRANSPORT_ALWAYS_INLINE uint32_t getVerificationQueueDepth() const {
+    return verification_queue_depth_;
+  }
+
+  // Average time in microseconds between the submission of a packet to the
+  // verification pool and the delivery of its verification result.
+  TRANSPORT_ALWAYS_INLINE double getAverageVerificationLatency() const {
+    return avg_verification_latency_;
+  }
+
+  // Rate in interests per second at which the consumer paces its interests,
+  // or 0 if interests are not paced.
+  TRANSPORT_ALWAYS_INLINE double getPacingRate() const { return pacing_rate_; }
+
   TRANSPORT_ALWAYS_INLINE void setAlpha(double val) { alpha_ = val; }
 
   TRANSPORT_ALWAYS_INLINE void reset() {
@@ -173,6 +204,9 @@ class TransportStatistics {
     // avg_data_rtt_ = 0;
     avg_pending_pkt_ = 0;
     received_nacks_ = 0;
+    verification_queue_depth_ = 0;
+    avg_verification_latency_ = 0;
+    pacing_rate_ = 0;
   }
 
  private:
@@ -191,6 +225,9 @@ class TransportStatistics {
   int status_;  // transport status (e.g. sync status, congestion etc.)
   double avg_pending_pkt_;
   uint32_t received_nacks_;
+  uint32_t verification_queue_depth_;
+  double avg_verification_latency_;
+  double pacing_rate_;
 };
 
 }  // namespace interface
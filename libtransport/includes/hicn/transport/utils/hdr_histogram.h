@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace utils {
+
+/**
+ * High dynamic range histogram, following the layout of HdrHistogram
+ * (http://hdrhistogram.org). Values in [1, highest_trackable_value] are
+ * recorded with a relative error bounded by 10^-significant_figures, using
+ * a fixed amount of memory and O(1) work per sample.
+ *
+ * Values are split in buckets covering a power of two each; every bucket is
+ * divided in linear sub-buckets, whose width doubles from one bucket to the
+ * next. Not thread safe: use one histogram per thread and merge them with
+ * add().
+ */
+class HdrHistogram {
+ public:
+  HdrHistogram(uint64_t highest_trackable_value = 3600000000ULL,
+               int significant_figures = 3)
+      : highest_trackable_value_(std::max<uint64_t>(highest_trackable_value,
+                                                    2)),
+        significant_figures_(significant_figures) {
+    if (significant_figures < 1 || significant_figures > 5) {
+      throw std::invalid_argument(
+          "HdrHistogram: significant figures must be in [1, 5]");
+    }
+
+    uint64_t largest_single_unit_resolution =
+        2 * static_cast<uint64_t>(std::pow(10, significant_figures));
+    sub_bucket_count_magnitude_ = static_cast<int>(std::ceil(
+        std::log2(static_cast<double>(largest_single_unit_resolution))));
+    sub_bucket_half_count_magnitude_ = sub_bucket_count_magnitude_ - 1;
+    sub_bucket_count_ = 1ULL << sub_bucket_count_magnitude_;
+    sub_bucket_half_count_ = sub_bucket_count_ / 2;
+    sub_bucket_mask_ = sub_bucket_count_ - 1;
+
+    // Number of buckets needed to cover highest_trackable_value
+    uint64_t smallest_untrackable_value = sub_bucket_count_;
+    bucket_count_ = 1;
+    while (smallest_untrackable_value <= highest_trackable_value_) {
+      if (smallest_untrackable_value >
+          std::numeric_limits<uint64_t>::max() / 2) {
+        bucket_count_++;
+        break;
+      }
+      smallest_untrackable_value <<= 1;
+      bucket_count_++;
+    }
+
+    counts_.resize((bucket_count_ + 1) * sub_bucket_half_count_, 0);
+    reset();
+  }
+
+  void reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    total_count_ = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+    sum_ = 0;
+  }
+
+  /**
+   * Record a value, clamped to [1, highest_trackable_value].
+   */
+  void record(uint64_t value, uint64_t count = 1) {
+    value = std::min(std::max<uint64_t>(value, 1), highest_trackable_value_);
+    counts_[countsIndex(value)] += count;
+    total_count_ += count;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    sum_ += static_cast<double>(value) * count;
+  }
+
+  /**
+   * Add the samples of another histogram with the same configuration.
+   */
+  void add(const HdrHistogram &other) {
+    if (other.counts_.size() != counts_.size() ||
+        other.sub_bucket_count_ != sub_bucket_count_) {
+      throw std::invalid_argument("HdrHistogram: incompatible histograms");
+    }
+
+    for (std::size_t i = 0; i < counts_.size(); i++) {
+      counts_[i] += other.counts_[i];
+    }
+
+    total_count_ += other.total_count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+  }
+
+  uint64_t totalCount() const { return total_count_; }
+
+  uint64_t min() const { return total_count_ ? min_ : 0; }
+
+  uint64_t max() const { return max_; }
+
+  double mean() const { return total_count_ ? sum_ / total_count_ : 0; }
+
+  /**
+   * Smallest recorded value v such that percentile % of the samples are
+   * less than or equal to v (up to the histogram resolution).
+   */
+  uint64_t valueAtPercentile(double percentile) const {
+    if (total_count_ == 0) {
+      return 0;
+    }
+
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    uint64_t count_at_percentile = static_cast<uint64_t>(
+        percentile / 100.0 * static_cast<double>(total_count_) + 0.5);
+    count_at_percentile = std::max<uint64_t>(count_at_percentile, 1);
+
+    uint64_t total = 0;
+    for (std::size_t i = 0; i < counts_.size(); i++) {
+      total += counts_[i];
+      if (total >= count_at_percentile) {
+        return std::min(highestEquivalentValue(valueFromIndex(i)), max_);
+      }
+    }
+
+    return max_;
+  }
+
+  uint64_t highestTrackableValue() const { return highest_trackable_value_; }
+
+  int significantFigures() const { return significant_figures_; }
+
+ private:
+  int bucketIndex(uint64_t value) const {
+    // Index of the highest bit set, with all values below sub_bucket_count_
+    // in bucket 0
+    int pow2_ceiling = 64 - countLeadingZeros(value | sub_bucket_mask_);
+    return pow2_ceiling - (sub_bucket_half_count_magnitude_ + 1);
+  }
+
+  std::size_t countsIndex(uint64_t value) const {
+    int bucket_index = bucketIndex(value);
+    uint64_t sub_bucket_index = value >> bucket_index;
+    return ((static_cast<std::size_t>(bucket_index) + 1)
+            << sub_bucket_half_count_magnitude_) +
+           (sub_bucket_index - sub_bucket_half_count_);
+  }
+
+  uint64_t valueFromIndex(std::size_t index) const {
+    int bucket_index =
+        static_cast<int>(index >> sub_bucket_half_count_magnitude_) - 1;
+    uint64_t sub_bucket_index =
+        (index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+
+    if (bucket_index < 0) {
+      sub_bucket_index -= sub_bucket_half_count_;
+      bucket_index = 0;
+    }
+
+    return sub_bucket_index << bucket_index;
+  }
+
+  uint64_t highestEquivalentValue(uint64_t value) const {
+    int bucket_index = bucketIndex(value);
+    uint64_t sub_bucket_index = value >> bucket_index;
+    uint64_t lowest = sub_bucket_index << bucket_index;
+
+    if (sub_bucket_index >= sub_bucket_count_) {
+      bucket_index++;
+    }
+
+    return lowest + (1ULL << bucket_index) - 1;
+  }
+
+  static int countLeadingZeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(value);
+#else
+    int n = 0;
+    for (uint64_t bit = 1ULL << 63; bit && !(value & bit); bit >>= 1) {
+      n++;
+    }
+    return n;
+#endif
+  }
+
+  uint64_t highest_trackable_value_;
+  int significant_figures_;
+  int sub_bucket_count_magnitude_;
+  int sub_bucket_half_count_magnitude_;
+  uint64_t sub_bucket_count_;
+  uint64_t sub_bucket_half_count_;
+  uint64_t sub_bucket_mask_;
+  std::size_t bucket_count_;
+  std::vector<uint64_t> counts_;
+  uint64_t total_count_;
+  uint64_t min_;
+  uint64_t max_;
+  double sum_;
+};
+
+}  // namespace utils
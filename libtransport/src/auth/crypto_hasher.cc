@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <auth/sha256_multibuffer.h>
+#include <hicn/transport/auth/crypto_hasher.h>
+
+namespace transport {
+namespace auth {
+
+std::size_t CryptoHasher::getMultiBufferLanes(CryptoHashType hash_type) {
+  return hash_type == CryptoHashType::SHA_256 ? sha256MultiBufferLanes() : 0;
+}
+
+std::vector<CryptoHash> CryptoHasher::hashBuffers(CryptoHashType hash_type,
+                                                  const uint8_t *const *buffers,
+                                                  const std::size_t *lengths,
+                                                  std::size_t n) {
+  std::vector<CryptoHash> digests;
+  digests.reserve(n);
+
+  if (getMultiBufferLanes(hash_type) && n > 1) {
+    std::vector<uint8_t> raw_digests(n * SHA256_DIGEST_SIZE);
+    sha256MultiBuffer(buffers, lengths, n, raw_digests.data());
+
+    for (std::size_t i = 0; i < n; i++) {
+      digests.emplace_back(raw_digests.data() + i * SHA256_DIGEST_SIZE,
+                           SHA256_DIGEST_SIZE, hash_type);
+    }
+
+    return digests;
+  }
+
+  CryptoHasher hasher(hash_type);
+  for (std::size_t i = 0; i < n; i++) {
+    digests.emplace_back(
+        hasher.init().updateBytes(buffers[i], lengths[i]).finalize());
+  }
+
+  return digests;
+}
+
+}  // namespace auth
+}  // namespace transport
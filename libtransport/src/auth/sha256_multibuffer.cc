@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <auth/sha256_multibuffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHA256_MB_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace transport {
+namespace auth {
+
+namespace {
+
+static constexpr std::size_t SHA256_BLOCK_SIZE = 64;
+
+static const uint32_t sha256_h0[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                      0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                      0x1f83d9ab, 0x5be0cd19};
+
+static const uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+static inline uint32_t loadBigEndian32(const uint8_t *p) {
+  return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) |
+         (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+static inline void storeBigEndian32(uint8_t *p, uint32_t v) {
+  p[0] = uint8_t(v >> 24);
+  p[1] = uint8_t(v >> 16);
+  p[2] = uint8_t(v >> 8);
+  p[3] = uint8_t(v);
+}
+
+/*
+ * A message split in full blocks, read in place, and a padded tail of one or
+ * two blocks.
+ */
+struct Sha256Lane {
+  void set(const uint8_t *message, std::size_t length) {
+    data = message;
+    full_blocks = length / SHA256_BLOCK_SIZE;
+
+    std::size_t remainder = length % SHA256_BLOCK_SIZE;
+    tail_blocks = remainder + 9 > SHA256_BLOCK_SIZE ? 2 : 1;
+
+    std::memset(tail, 0, sizeof(tail));
+    if (remainder) {
+      std::memcpy(tail, message + full_blocks * SHA256_BLOCK_SIZE, remainder);
+    }
+    tail[remainder] = 0x80;
+
+    uint64_t bit_length = uint64_t(length) * 8;
+    uint8_t *end = tail + tail_blocks * SHA256_BLOCK_SIZE;
+    storeBigEndian32(end - 8, uint32_t(bit_length >> 32));
+    storeBigEndian32(end - 4, uint32_t(bit_length));
+  }
+
+  std::size_t blocks() const { return full_blocks + tail_blocks; }
+
+  const uint8_t *block(std::size_t b) const {
+    return b < full_blocks ? data + b * SHA256_BLOCK_SIZE
+                           : tail + (b - full_blocks) * SHA256_BLOCK_SIZE;
+  }
+
+  const uint8_t *data;
+  std::size_t full_blocks;
+  std::size_t tail_blocks;
+  uint8_t tail[2 * SHA256_BLOCK_SIZE];
+};
+
+namespace generic {
+
+struct Scalar {
+  static constexpr std::size_t lanes = 1;
+  using Reg = uint32_t;
+
+  static inline Reg set1(uint32_t x) { return x; }
+  static inline Reg load(const uint32_t *p) { return *p; }
+  static inline void store(uint32_t *p, Reg x) { *p = x; }
+  static inline Reg add(Reg a, Reg b) { return a + b; }
+  static inline Reg xor_(Reg a, Reg b) { return a ^ b; }
+  static inline Reg and_(Reg a, Reg b) { return a & b; }
+  static inline Reg or_(Reg a, Reg b) { return a | b; }
+  static inline Reg andnot(Reg a, Reg b) { return ~a & b; }
+  template <int n>
+  static inline Reg shr(Reg x) {
+    return x >> n;
+  }
+  template <int n>
+  static inline Reg ror(Reg x) {
+    return (x >> n) | (x << (32 - n));
+  }
+};
+
+#include <auth/sha256_multibuffer_kernel.h>
+
+}  // namespace generic
+
+#ifdef SHA256_MB_X86
+
+namespace sse2 {
+
+struct Sse2 {
+  static constexpr std::size_t lanes = 4;
+  using Reg = __m128i;
+
+  static inline Reg set1(uint32_t x) { return _mm_set1_epi32(int(x)); }
+  static inline Reg load(const uint32_t *p) {
+    return _mm_load_si128(reinterpret_cast<const __m128i *>(p));
+  }
+  static inline void store(uint32_t *p, Reg x) {
+    _mm_store_si128(reinterpret_cast<__m128i *>(p), x);
+  }
+  static inline Reg add(Reg a, Reg b) { return _mm_add_epi32(a, b); }
+  static inline Reg xor_(Reg a, Reg b) { return _mm_xor_si128(a, b); }
+  static inline Reg and_(Reg a, Reg b) { return _mm_and_si128(a, b); }
+  static inline Reg or_(Reg a, Reg b) { return _mm_or_si128(a, b); }
+  static inline Reg andnot(Reg a, Reg b) { return _mm_andnot_si128(a, b); }
+  template <int n>
+  static inline Reg shr(Reg x) {
+    return _mm_srli_epi32(x, n);
+  }
+  template <int n>
+  static inline Reg ror(Reg x) {
+    return _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n));
+  }
+};
+
+#include <auth/sha256_multibuffer_kernel.h>
+
+}  // namespace sse2
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+namespace avx2 {
+
+struct Avx2 {
+  static constexpr std::size_t lanes = 8;
+  using Reg = __m256i;
+
+  static inline Reg set1(uint32_t x) { return _mm256_set1_epi32(int(x)); }
+  static inline Reg load(const uint32_t *p) {
+    return _mm256_load_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static inline void store(uint32_t *p, Reg x) {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), x);
+  }
+  static inline Reg add(Reg a, Reg b) { return _mm256_add_epi32(a, b); }
+  static inline Reg xor_(Reg a, Reg b) { return _mm256_xor_si256(a, b); }
+  static inline Reg and_(Reg a, Reg b) { return _mm256_and_si256(a, b); }
+  static inline Reg or_(Reg a, Reg b) { return _mm256_or_si256(a, b); }
+  static inline Reg andnot(Reg a, Reg b) { return _mm256_andnot_si256(a, b); }
+  template <int n>
+  static inline Reg shr(Reg x) {
+    return _mm256_srli_epi32(x, n);
+  }
+  template <int n>
+  static inline Reg ror(Reg x) {
+    return _mm256_or_si256(_mm256_srli_epi32(x, n),
+                           _mm256_slli_epi32(x, 32 - n));
+  }
+};
+
+#include <auth/sha256_multibuffer_kernel.h>
+
+}  // namespace avx2
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+namespace avx512 {
+
+// The maskz forms of the intrinsics avoid _mm512_undefined_epi32, which
+// trips -Wmaybe-uninitialized on some GCC versions.
+struct Avx512 {
+  static constexpr std::size_t lanes = 16;
+  using Reg = __m512i;
+
+  static inline Reg set1(uint32_t x) { return _mm512_set1_epi32(int(x)); }
+  static inline Reg load(const uint32_t *p) { return _mm512_load_si512(p); }
+  static inline void store(uint32_t *p, Reg x) { _mm512_store_si512(p, x); }
+  static inline Reg add(Reg a, Reg b) { return _mm512_add_epi32(a, b); }
+  static inline Reg xor_(Reg a, Reg b) { return _mm512_xor_si512(a, b); }
+  static inline Reg and_(Reg a, Reg b) { return _mm512_and_si512(a, b); }
+  static inline Reg or_(Reg a, Reg b) { return _mm512_or_si512(a, b); }
+  static inline Reg andnot(Reg a, Reg b) {
+    return _mm512_maskz_andnot_epi32(0xffff, a, b);
+  }
+  template <int n>
+  static inline Reg shr(Reg x) {
+    return _mm512_maskz_srli_epi32(0xffff, x, n);
+  }
+  template <int n>
+  static inline Reg ror(Reg x) {
+    return _mm512_maskz_ror_epi32(0xffff, x, n);
+  }
+};
+
+#include <auth/sha256_multibuffer_kernel.h>
+
+}  // namespace avx512
+
+#pragma GCC pop_options
+
+#endif  // SHA256_MB_X86
+
+using KernelFn = void (*)(const Sha256Lane *, std::size_t, uint8_t *);
+
+struct Sha256Dispatch {
+  Sha256Dispatch() : lanes(1), multi_buffer(false), kernel(nullptr) {
+    select();
+  }
+
+  void select() {
+    lanes = 1;
+    multi_buffer = false;
+    kernel = &generic::sha256Kernel<generic::Scalar>;
+
+#ifdef SHA256_MB_X86
+    // With SHA-NI the single-buffer path of OpenSSL is faster than 8 lanes of
+    // AVX2; only 16 lanes of AVX-512 beat it.
+    unsigned int eax, ebx, ecx, edx;
+    bool sha_ni = __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+                  (ebx & bit_SHA);
+
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      lanes = avx512::Avx512::lanes;
+      kernel = &avx512::sha256Kernel<avx512::Avx512>;
+      multi_buffer = true;
+    } else if (__builtin_cpu_supports("avx2")) {
+      lanes = avx2::Avx2::lanes;
+      kernel = &avx2::sha256Kernel<avx2::Avx2>;
+      multi_buffer = !sha_ni;
+    } else {
+      lanes = sse2::Sse2::lanes;
+      kernel = &sse2::sha256Kernel<sse2::Sse2>;
+      multi_buffer = false;
+    }
+#endif
+  }
+
+  bool force(Sha256Kernel forced) {
+    switch (forced) {
+      case Sha256Kernel::AUTO:
+        select();
+        return true;
+      case Sha256Kernel::GENERIC:
+        lanes = generic::Scalar::lanes;
+        kernel = &generic::sha256Kernel<generic::Scalar>;
+        return true;
+#ifdef SHA256_MB_X86
+      case Sha256Kernel::SSE2:
+        lanes = sse2::Sse2::lanes;
+        kernel = &sse2::sha256Kernel<sse2::Sse2>;
+        return true;
+      case Sha256Kernel::AVX2:
+        if (!__builtin_cpu_supports("avx2")) {
+          return false;
+        }
+        lanes = avx2::Avx2::lanes;
+        kernel = &avx2::sha256Kernel<avx2::Avx2>;
+        return true;
+      case Sha256Kernel::AVX512:
+        if (!__builtin_cpu_supports("avx512f")) {
+          return false;
+        }
+        lanes = avx512::Avx512::lanes;
+        kernel = &avx512::sha256Kernel<avx512::Avx512>;
+        return true;
+#endif
+      default:
+        return false;
+    }
+  }
+
+  std::size_t lanes;
+  bool multi_buffer;
+  KernelFn kernel;
+};
+
+static Sha256Dispatch &getDispatch() {
+  static Sha256Dispatch dispatch;
+  return dispatch;
+}
+
+}  // namespace
+
+std::size_t sha256MultiBufferLanes() {
+  const Sha256Dispatch &dispatch = getDispatch();
+  return dispatch.multi_buffer ? dispatch.lanes : 0;
+}
+
+bool sha256MultiBufferSetKernel(Sha256Kernel kernel) {
+  return getDispatch().force(kernel);
+}
+
+void sha256MultiBuffer(const uint8_t *const *messages,
+                       const std::size_t *lengths, std::size_t n,
+                       uint8_t *digests) {
+  const Sha256Dispatch &dispatch = getDispatch();
+  Sha256Lane lanes[16];
+
+  for (std::size_t i = 0; i < n; i += dispatch.lanes) {
+    std::size_t count = std::min(dispatch.lanes, n - i);
+    for (std::size_t l = 0; l < count; l++) {
+      lanes[l].set(messages[i + l], lengths[i + l]);
+    }
+
+    dispatch.kernel(lanes, count, digests + i * SHA256_DIGEST_SIZE);
+  }
+}
+
+}  // namespace auth
+}  // namespace transport
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace transport {
+namespace auth {
+
+static constexpr std::size_t SHA256_DIGEST_SIZE = 32;
+
+// Return the number of messages hashed in parallel by the multi-buffer SHA-256
+// kernel selected for this CPU (16 with AVX-512, 8 with AVX2), or 0 if the
+// single-buffer implementation of OpenSSL is expected to be faster (SHA-NI
+// without AVX-512, or no AVX2 at all).
+std::size_t sha256MultiBufferLanes();
+
+// Compute the SHA-256 digest of n messages, sha256MultiBufferLanes() at a
+// time. The digest of messages[i] is written at digests + 32 * i. When
+// sha256MultiBufferLanes() is 0 this still works, using 4 lanes of SSE2 on
+// x86 or a portable single-lane kernel elsewhere.
+void sha256MultiBuffer(const uint8_t *const *messages,
+                       const std::size_t *lengths, std::size_t n,
+                       uint8_t *digests);
+
+enum class Sha256Kernel { AUTO, GENERIC, SSE2, AVX2, AVX512 };
+
+// Force the kernel used by sha256MultiBuffer, AUTO goes back to the one
+// selected for this CPU. Meant for tests, it must not be called while hashing.
+// Return false, and leave the kernel unchanged, if the CPU cannot run it.
+bool sha256MultiBufferSetKernel(Sha256Kernel kernel);
+
+}  // namespace auth
+}  // namespace transport
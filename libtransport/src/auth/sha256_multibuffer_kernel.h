@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Generic multi-lane SHA-256 compression loop. This file has no include
+ * guard on purpose: sha256_multibuffer.cc includes it once per instruction
+ * set, inside a namespace and a target pragma, so that every copy of the
+ * kernel is compiled for its own ISA.
+ *
+ * V must provide:
+ *   - static constexpr std::size_t lanes;
+ *   - using Reg = <vector register type>;
+ *   - set1, load, store, add, xor_, and_, or_, andnot, shr<n>, ror<n>.
+ */
+
+template <typename V>
+static inline typename V::Reg sigma0(typename V::Reg x) {
+  return V::xor_(V::xor_(V::template ror<7>(x), V::template ror<18>(x)),
+                 V::template shr<3>(x));
+}
+
+template <typename V>
+static inline typename V::Reg sigma1(typename V::Reg x) {
+  return V::xor_(V::xor_(V::template ror<17>(x), V::template ror<19>(x)),
+                 V::template shr<10>(x));
+}
+
+template <typename V>
+static inline typename V::Reg Sigma0(typename V::Reg x) {
+  return V::xor_(V::xor_(V::template ror<2>(x), V::template ror<13>(x)),
+                 V::template ror<22>(x));
+}
+
+template <typename V>
+static inline typename V::Reg Sigma1(typename V::Reg x) {
+  return V::xor_(V::xor_(V::template ror<6>(x), V::template ror<11>(x)),
+                 V::template ror<25>(x));
+}
+
+template <typename V>
+static inline typename V::Reg ch(typename V::Reg e, typename V::Reg f,
+                                 typename V::Reg g) {
+  return V::xor_(V::and_(e, f), V::andnot(e, g));
+}
+
+template <typename V>
+static inline typename V::Reg maj(typename V::Reg a, typename V::Reg b,
+                                  typename V::Reg c) {
+  return V::or_(V::and_(a, b), V::and_(c, V::or_(a, b)));
+}
+
+/*
+ * Hash up to V::lanes messages. Lanes with fewer blocks keep being fed a
+ * dummy block once they are done; their digest is extracted right after
+ * their last block.
+ */
+template <typename V>
+static void sha256Kernel(const Sha256Lane *lanes, std::size_t n,
+                         uint8_t *digests) {
+  using Reg = typename V::Reg;
+  static const uint8_t zero_block[SHA256_BLOCK_SIZE] = {0};
+
+  Reg state[8];
+  for (int i = 0; i < 8; i++) {
+    state[i] = V::set1(sha256_h0[i]);
+  }
+
+  std::size_t max_blocks = 0;
+  for (std::size_t l = 0; l < n; l++) {
+    max_blocks = std::max(max_blocks, lanes[l].blocks());
+  }
+
+  alignas(64) uint32_t words[V::lanes];
+  const uint8_t *blocks[V::lanes];
+
+  for (std::size_t b = 0; b < max_blocks; b++) {
+    for (std::size_t l = 0; l < V::lanes; l++) {
+      blocks[l] = (l < n && b < lanes[l].blocks()) ? lanes[l].block(b)
+                                                   : zero_block;
+    }
+
+    Reg w[16];
+    for (int t = 0; t < 16; t++) {
+      for (std::size_t l = 0; l < V::lanes; l++) {
+        words[l] = loadBigEndian32(blocks[l] + 4 * t);
+      }
+      w[t] = V::load(words);
+    }
+
+    Reg a = state[0], b_ = state[1], c = state[2], d = state[3];
+    Reg e = state[4], f = state[5], g = state[6], h = state[7];
+
+    for (int t = 0; t < 64; t++) {
+      Reg wt;
+      if (t < 16) {
+        wt = w[t];
+      } else {
+        wt = V::add(V::add(sigma1<V>(w[(t - 2) & 15]), w[(t - 7) & 15]),
+                    V::add(sigma0<V>(w[(t - 15) & 15]), w[t & 15]));
+        w[t & 15] = wt;
+      }
+
+      Reg t1 = V::add(V::add(h, Sigma1<V>(e)),
+                      V::add(ch<V>(e, f, g), V::add(V::set1(sha256_k[t]), wt)));
+      Reg t2 = V::add(Sigma0<V>(a), maj<V>(a, b_, c));
+      h = g;
+      g = f;
+      f = e;
+      e = V::add(d, t1);
+      d = c;
+      c = b_;
+      b_ = a;
+      a = V::add(t1, t2);
+    }
+
+    state[0] = V::add(state[0], a);
+    state[1] = V::add(state[1], b_);
+    state[2] = V::add(state[2], c);
+    state[3] = V::add(state[3], d);
+    state[4] = V::add(state[4], e);
+    state[5] = V::add(state[5], f);
+    state[6] = V::add(state[6], g);
+    state[7] = V::add(state[7], h);
+
+    for (std::size_t l = 0; l < n; l++) {
+      if (lanes[l].blocks() != b + 1) {
+        continue;
+      }
+
+      uint8_t *digest = digests + l * SHA256_DIGEST_SIZE;
+      for (int i = 0; i < 8; i++) {
+        V::store(words, state[i]);
+        storeBigEndian32(digest + 4 * i, words[l]);
+      }
+    }
+  }
+}
@@ -43,6 +43,12 @@ Signer::~Signer() {
 
 void Signer::signPacket(PacketPtr packet) {
   parcAssertNotNull(signer_, "Expected non-null signer");
+  CryptoHasher hasher(parcSigner_GetCryptoHasher(signer_));
+  signPacket(packet, hasher);
+}
+
+void Signer::signPacket(PacketPtr packet, CryptoHasher &hasher) {
+  parcAssertNotNull(signer_, "Expected non-null signer");
 
   const utils::MemBuf &header_chain = *packet;
   core::Packet::Format format = packet->getFormat();
@@ -74,7 +80,6 @@ void Signer::signPacket(PacketPtr packet) {
   packet->setKeyId(key_id);
 
   // Calculate hash
-  CryptoHasher hasher(parcSigner_GetCryptoHasher(signer_));
   const utils::MemBuf *current = &header_chain;
 
   hasher.init();
@@ -103,6 +108,16 @@ void Signer::signPacket(PacketPtr packet) {
   parcSignature_Release(&signature);
 }
 
+bool Signer::supportsConcurrentSigning() const {
+  switch (getCryptoSuite()) {
+    case CryptoSuite::HMAC_SHA256:
+    case CryptoSuite::HMAC_SHA512:
+      return false;
+    default:
+      return true;
+  }
+}
+
 void Signer::setSigner(PARCSigner *signer) {
   parcAssertNotNull(signer, "Expected non-null signer");
 
@@ -108,9 +108,7 @@ bool Verifier::verifyPacket(PacketPtr packet) {
   packet->resetForHash();
 
   // Compute the packet hash
-  if (!hasher_)
-    setHasher(parcVerifier_GetCryptoHasher(verifier_, key_id, hash_type));
-  CryptoHash local_hash = computeHash(packet);
+  CryptoHash local_hash = computeHash(packet, key_id, hash_type);
 
   // Compare the packet signature to the locally computed one
   valid_packet = parcVerifier_VerifyDigestSignature(
@@ -146,32 +144,115 @@ vector<VerificationPolicy> Verifier::verifyPackets(
 vector<VerificationPolicy> Verifier::verifyPackets(
     const vector<PacketPtr> &packets,
     const unordered_map<Suffix, HashEntry> &suffix_map) {
+  vector<VerificationPolicy> policies = checkPacketHashes(packets, suffix_map);
+
+  for (unsigned int i = 0; i < packets.size(); ++i) {
+    callVerificationFailedCallback(packets[i], policies[i]);
+  }
+
+  return policies;
+}
+
+vector<VerificationPolicy> Verifier::verifyPackets(
+    const vector<PacketPtr> &packets, const SuffixHashes &suffix_hashes) {
+  vector<VerificationPolicy> policies =
+      checkPacketHashes(packets, suffix_hashes);
+
+  for (unsigned int i = 0; i < packets.size(); ++i) {
+    callVerificationFailedCallback(packets[i], policies[i]);
+  }
+
+  return policies;
+}
+
+namespace {
+
+// Hash expected for a packet, or a null digest if the packet is not covered
+// by any manifest.
+struct ExpectedHash {
+  CryptoHashType type;
+  const uint8_t *digest;
+};
+
+// Compare the packets with the hashes returned by lookup(suffix).
+template <typename Lookup>
+vector<VerificationPolicy> checkHashes(const vector<PacketPtr> &packets,
+                                       Lookup &&lookup) {
   vector<VerificationPolicy> policies(packets.size(),
                                       VerificationPolicy::UNKNOWN);
 
+  // Look up the manifest entry of every packet
+  vector<ExpectedHash> entries(packets.size());
   for (unsigned int i = 0; i < packets.size(); ++i) {
-    uint32_t suffix = packets[i]->getName().getSuffix();
-    auto manifest_hash = suffix_map.find(suffix);
+    entries[i] = lookup(packets[i]->getName().getSuffix());
+  }
+
+  // Hash all the packets covered by a manifest in one multi-buffer pass per
+  // hash type (in practice there is only one)
+  vector<bool> hashed(packets.size(), false);
+  for (unsigned int i = 0; i < packets.size(); ++i) {
+    if (!entries[i].digest || hashed[i]) {
+      continue;
+    }
 
-    if (manifest_hash != suffix_map.end()) {
-      CryptoHashType hash_type = manifest_hash->second.first;
-      CryptoHash packet_hash = packets[i]->computeDigest(hash_type);
+    CryptoHashType hash_type = entries[i].type;
+    vector<unsigned int> indexes;
+    vector<PacketPtr> batch;
+
+    for (unsigned int j = i; j < packets.size(); ++j) {
+      if (entries[j].digest && !hashed[j] && entries[j].type == hash_type) {
+        hashed[j] = true;
+        indexes.push_back(j);
+        batch.push_back(packets[j]);
+      }
+    }
+
+    vector<CryptoHash> packet_hashes =
+        core::Packet::computeDigests(hash_type, batch.data(), batch.size());
+
+    for (unsigned int k = 0; k < indexes.size(); ++k) {
+      unsigned int index = indexes[k];
 
       if (!CryptoHash::compareBinaryDigest(
-              packet_hash.getDigest<uint8_t>().data(),
-              manifest_hash->second.second.data(), hash_type)) {
-        policies[i] = VerificationPolicy::ABORT;
+              packet_hashes[k].getDigest<uint8_t>().data(),
+              entries[index].digest, hash_type)) {
+        policies[index] = VerificationPolicy::ABORT;
       } else {
-        policies[i] = VerificationPolicy::ACCEPT;
+        policies[index] = VerificationPolicy::ACCEPT;
       }
     }
-
-    callVerificationFailedCallback(packets[i], policies[i]);
   }
 
   return policies;
 }
 
+}  // namespace
+
+vector<VerificationPolicy> Verifier::checkPacketHashes(
+    const vector<PacketPtr> &packets,
+    const unordered_map<Suffix, HashEntry> &suffix_map) {
+  return checkHashes(packets, [&suffix_map](Suffix suffix) {
+    auto it = suffix_map.find(suffix);
+    if (it == suffix_map.end()) {
+      return ExpectedHash{CryptoHashType::NULL_HASH, nullptr};
+    }
+
+    return ExpectedHash{it->second.first, it->second.second.data()};
+  });
+}
+
+vector<VerificationPolicy> Verifier::checkPacketHashes(
+    const vector<PacketPtr> &packets, const SuffixHashes &suffix_hashes) {
+  return checkHashes(packets, [&suffix_hashes](Suffix suffix) {
+    const SuffixHashes::Entry *entry = suffix_hashes.find(suffix);
+    if (!entry) {
+      return ExpectedHash{CryptoHashType::NULL_HASH, nullptr};
+    }
+
+    return ExpectedHash{entry->type, entry->digest};
+  });
+}
+
 void Verifier::addKey(PARCKey *key) { parcVerifier_AddKey(verifier_, key); }
 
 void Verifier::setHasher(PARCCryptoHasher *hasher) {
@@ -213,6 +294,13 @@ CryptoHash Verifier::computeHash(PacketPtr packet) {
   return crypto_hasher.finalize();
 }
 
+CryptoHash Verifier::computeHash(PacketPtr packet, PARCKeyId *key_id,
+                                 PARCCryptoHashType hash_type) {
+  if (!hasher_)
+    setHasher(parcVerifier_GetCryptoHasher(verifier_, key_id, hash_type));
+  return computeHash(packet);
+}
+
 void Verifier::callVerificationFailedCallback(PacketPtr packet,
                                               VerificationPolicy &policy) {
   if (verification_failed_cb_ == interface::VOID_HANDLER) {
@@ -241,6 +329,22 @@ vector<VerificationPolicy> VoidVerifier::verifyPackets(
   return vector<VerificationPolicy>(packets.size(), VerificationPolicy::ACCEPT);
 }
 
+vector<VerificationPolicy> VoidVerifier::verifyPackets(
+    const vector<PacketPtr> &packets, const SuffixHashes &suffix_hashes) {
+  return vector<VerificationPolicy>(packets.size(), VerificationPolicy::ACCEPT);
+}
+
+vector<VerificationPolicy> VoidVerifier::checkPacketHashes(
+    const vector<PacketPtr> &packets,
+    const unordered_map<Suffix, HashEntry> &suffix_map) {
+  return vector<VerificationPolicy>(packets.size(), VerificationPolicy::ACCEPT);
+}
+
+vector<VerificationPolicy> VoidVerifier::checkPacketHashes(
+    const vector<PacketPtr> &packets, const SuffixHashes &suffix_hashes) {
+  return vector<VerificationPolicy>(packets.size(), VerificationPolicy::ACCEPT);
+}
+
 AsymmetricVerifier::AsymmetricVerifier(PARCKey *pub_key) { addKey(pub_key); }
 
 AsymmetricVerifier::AsymmetricVerifier(const string &cert_path) {
@@ -267,6 +371,26 @@ void AsymmetricVerifier::setCertificate(const string &cert_path) {
   parcCertificateFactory_Release(&factory);
 }
 
+CryptoHash AsymmetricVerifier::computeHash(PacketPtr packet, PARCKeyId *key_id,
+                                           PARCCryptoHashType hash_type) {
+  if (hasher_) {
+    return Verifier::computeHash(packet, key_id, hash_type);
+  }
+
+  CryptoHasher crypto_hasher(static_cast<CryptoHashType>(hash_type));
+  const utils::MemBuf &header_chain = *packet;
+  const utils::MemBuf *current = &header_chain;
+
+  crypto_hasher.init();
+
+  do {
+    crypto_hasher.updateBytes(current->data(), current->length());
+    current = current->next();
+  } while (current != &header_chain);
+
+  return crypto_hasher.finalize();
+}
+
 SymmetricVerifier::SymmetricVerifier(const string &passphrase)
     : passphrase_(nullptr), signer_(nullptr) {
   setPassphrase(passphrase);
@@ -309,26 +433,14 @@ void SymmetricVerifier::setSigner(const PARCCryptoSuite &suite) {
   parcKey_Release(&key);
 }
 
-vector<VerificationPolicy> SymmetricVerifier::verifyPackets(
-    const vector<PacketPtr> &packets) {
-  vector<VerificationPolicy> policies(packets.size(), VerificationPolicy::DROP);
-
-  for (unsigned int i = 0; i < packets.size(); ++i) {
-    auto suite =
-        static_cast<PARCCryptoSuite>(packets[i]->getValidationAlgorithm());
-
-    if (!signer_ || suite != parcSigner_GetCryptoSuite(signer_)) {
-      setSigner(suite);
-    }
-
-    if (verifyPacket(packets[i])) {
-      policies[i] = VerificationPolicy::ACCEPT;
-    }
+bool SymmetricVerifier::verifyPacket(PacketPtr packet) {
+  auto suite = static_cast<PARCCryptoSuite>(packet->getValidationAlgorithm());
 
-    callVerificationFailedCallback(packets[i], policies[i]);
+  if (!signer_ || suite != parcSigner_GetCryptoSuite(signer_)) {
+    setSigner(suite);
   }
 
-  return policies;
+  return Verifier::verifyPacket(packet);
 }
 
 }  // namespace auth
@@ -22,6 +22,7 @@ extern "C" {
 TRANSPORT_CLANG_DISABLE_WARNING("-Wextern-c-compat")
 #endif
 #include <hicn/hicn.h>
+#include <hicn/packet_inline.h>
 #include <hicn/util/ip_address.h>
 }
 
@@ -40,9 +41,9 @@ ContentObject::ContentObject(const Name &name, Packet::Format format,
     throw errors::RuntimeException("Error filling the packet name.");
   }
 
-  if (TRANSPORT_EXPECT_FALSE(hicn_data_get_name(format_, packet_start_,
-                                                name_.getStructReference()) <
-                             0)) {
+  if (TRANSPORT_EXPECT_FALSE(hicn_inline_data_get_name(
+                                 format_, packet_start_,
+                                 name_.getStructReference()) < 0)) {
     throw errors::MalformedPacketException();
   }
 }
@@ -80,9 +81,9 @@ ContentObject::~ContentObject() {}
 
 const Name &ContentObject::getName() const {
   if (!name_) {
-    if (hicn_data_get_name(format_, packet_start_,
-                           (hicn_name_t *)name_.getConstStructReference()) <
-        0) {
+    if (hicn_inline_data_get_name(
+            format_, packet_start_,
+            (hicn_name_t *)name_.getConstStructReference()) < 0) {
       throw errors::MalformedPacketException();
     }
   }
@@ -98,8 +99,8 @@ void ContentObject::setName(const Name &name) {
     throw errors::RuntimeException("Error setting content object name.");
   }
 
-  if (hicn_data_get_name(format_, packet_start_, name_.getStructReference()) <
-      0) {
+  if (hicn_inline_data_get_name(format_, packet_start_,
+                                name_.getStructReference()) < 0) {
     throw errors::MalformedPacketException();
   }
 }
@@ -111,8 +112,8 @@ void ContentObject::setName(Name &&name) {
         "Error getting the payload length from content object.");
   }
 
-  if (hicn_data_get_name(format_, packet_start_, name_.getStructReference()) <
-      0) {
+  if (hicn_inline_data_get_name(format_, packet_start_,
+                                name_.getStructReference()) < 0) {
     throw errors::MalformedPacketException();
   }
 }
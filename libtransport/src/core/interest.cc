@@ -22,6 +22,7 @@ extern "C" {
 TRANSPORT_CLANG_DISABLE_WARNING("-Wextern-c-compat")
 #endif
 #include <hicn/hicn.h>
+#include <hicn/packet_inline.h>
 }
 
 #include <cstring>
@@ -39,8 +40,8 @@ Interest::Interest(const Name &interest_name, Packet::Format format,
     throw errors::MalformedPacketException();
   }
 
-  if (hicn_interest_get_name(format_, packet_start_,
-                             name_.getStructReference()) < 0) {
+  if (hicn_inline_interest_get_name(format_, packet_start_,
+                                    name_.getStructReference()) < 0) {
     throw errors::MalformedPacketException();
   }
 }
@@ -54,8 +55,8 @@ Interest::Interest(hicn_format_t format, std::size_t additional_header_size)
 #endif
 
 Interest::Interest(MemBuf &&buffer) : Packet(std::move(buffer)) {
-  if (hicn_interest_get_name(format_, packet_start_,
-                             name_.getStructReference()) < 0) {
+  if (hicn_inline_interest_get_name(format_, packet_start_,
+                                    name_.getStructReference()) < 0) {
     throw errors::MalformedPacketException();
   }
 }
@@ -77,9 +78,9 @@ Interest::~Interest() {}
 
 const Name &Interest::getName() const {
   if (!name_) {
-    if (hicn_interest_get_name(format_, packet_start_,
-                               (hicn_name_t *)name_.getConstStructReference()) <
-        0) {
+    if (hicn_inline_interest_get_name(
+            format_, packet_start_,
+            (hicn_name_t *)name_.getConstStructReference()) < 0) {
       throw errors::MalformedPacketException();
     }
   }
@@ -95,8 +96,8 @@ void Interest::setName(const Name &name) {
     throw errors::RuntimeException("Error setting interest name.");
   }
 
-  if (hicn_interest_get_name(format_, packet_start_,
-                             name_.getStructReference()) < 0) {
+  if (hicn_inline_interest_get_name(format_, packet_start_,
+                                    name_.getStructReference()) < 0) {
     throw errors::MalformedPacketException();
   }
 }
@@ -107,8 +108,8 @@ void Interest::setName(Name &&name) {
     throw errors::RuntimeException("Error setting interest name.");
   }
 
-  if (hicn_interest_get_name(format_, packet_start_,
-                             name_.getStructReference()) < 0) {
+  if (hicn_inline_interest_get_name(format_, packet_start_,
+                                    name_.getStructReference()) < 0) {
     throw errors::MalformedPacketException();
   }
 }
@@ -140,7 +141,8 @@ void Interest::setLifetime(uint32_t lifetime) {
 uint32_t Interest::getLifetime() const {
   uint32_t lifetime = 0;
 
-  if (hicn_interest_get_lifetime(packet_start_, &lifetime) < 0) {
+  if (hicn_inline_interest_get_lifetime(format_, packet_start_, &lifetime) <
+      0) {
     throw errors::MalformedPacketException();
   }
 
@@ -149,9 +149,9 @@ std::size_t FixedManifestEncoder::getManifestEntrySizeImpl() {
 FixedManifestDecoder::FixedManifestDecoder(Packet &packet)
     : packet_(packet),
       manifest_header_(reinterpret_cast<ManifestHeader *>(
-          packet_.getPayload()->writableData())),
-      manifest_entries_(reinterpret_cast<ManifestEntry *>(
-          packet_.getPayload()->writableData() + sizeof(ManifestHeader))) {}
+          packet_.writableData() + packet_.headerSize())),
+      manifest_entries_(
+          reinterpret_cast<ManifestEntry *>(manifest_header_ + 1)) {}
 
 FixedManifestDecoder::~FixedManifestDecoder() {}
 
@@ -182,16 +182,8 @@ FixedManifestDecoder::getNextSegmentCalculationStrategyImpl() const {
 }
 
 typename Fixed::SuffixList FixedManifestDecoder::getSuffixHashListImpl() {
-  typename Fixed::SuffixList hash_list;
-
-  for (int i = 0; i < manifest_header_->number_of_entries; i++) {
-    hash_list.insert(hash_list.end(),
-                     std::make_pair(ntohl(manifest_entries_[i].suffix),
-                                    reinterpret_cast<uint8_t *>(
-                                        &manifest_entries_[i].hash[0])));
-  }
-
-  return hash_list;
+  return ManifestEntryView(manifest_entries_,
+                           manifest_header_->number_of_entries);
 }
 
 core::Name FixedManifestDecoder::getBaseNameImpl() const {
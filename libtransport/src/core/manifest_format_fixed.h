@@ -49,15 +49,6 @@ class FixedManifestEncoder;
 class FixedManifestDecoder;
 class Packet;
 
-struct Fixed {
-  using Encoder = FixedManifestEncoder;
-  using Decoder = FixedManifestDecoder;
-  using Hash = auth::CryptoHash;
-  using HashType = auth::CryptoHashType;
-  using Suffix = uint32_t;
-  using SuffixList = std::list<std::pair<uint32_t, uint8_t *>>;
-};
-
 struct Flags {
   std::uint8_t ipv6 : 1;
   std::uint8_t is_last : 1;
@@ -67,6 +58,48 @@ struct Flags {
 struct ManifestEntry {
   std::uint32_t suffix;
   std::uint32_t hash[8];
+
+  std::uint32_t getSuffix() const { return ntohl(suffix); }
+
+  const std::uint8_t *getHash() const {
+    return reinterpret_cast<const std::uint8_t *>(&hash[0]);
+  }
+};
+
+// Zero-copy view over the entries of a received manifest. Entries are read in
+// place from the packet payload: the view is valid as long as the manifest
+// packet is.
+class ManifestEntryView {
+ public:
+  using const_iterator = const ManifestEntry *;
+
+  ManifestEntryView() : entries_(nullptr), size_(0) {}
+
+  ManifestEntryView(const ManifestEntry *entries, std::size_t size)
+      : entries_(entries), size_(size) {}
+
+  const_iterator begin() const { return entries_; }
+
+  const_iterator end() const { return entries_ + size_; }
+
+  const ManifestEntry &operator[](std::size_t i) const { return entries_[i]; }
+
+  std::size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+ private:
+  const ManifestEntry *entries_;
+  std::size_t size_;
+};
+
+struct Fixed {
+  using Encoder = FixedManifestEncoder;
+  using Decoder = FixedManifestDecoder;
+  using Hash = auth::CryptoHash;
+  using HashType = auth::CryptoHashType;
+  using Suffix = uint32_t;
+  using SuffixList = ManifestEntryView;
 };
 
 struct ManifestHeader {
@@ -71,7 +71,7 @@ class ManifestInline
     base_name_ = ManifestBase::decoder_.getBaseName();
     next_segment_strategy_ =
         ManifestBase::decoder_.getNextSegmentCalculationStrategy();
-    suffix_hash_map_ = ManifestBase::decoder_.getSuffixHashList();
+    suffix_list_ = ManifestBase::decoder_.getSuffixHashList();
 
     return *this;
   }
@@ -93,8 +93,9 @@ class ManifestInline
     return *this;
   }
 
-  // Call this function only after the decode function!
-  const SuffixList &getSuffixList() { return suffix_hash_map_; }
+  // Call this function only after the decode function! The entries are read
+  // in place from the manifest payload.
+  const SuffixList &getSuffixList() { return suffix_list_; }
 
   ManifestInline &setNextSegmentCalculationStrategy(
       NextSegmentCalculationStrategy strategy) {
@@ -109,19 +110,20 @@ class ManifestInline
   }
 
   // Convert several manifests into a single map from suffixes to packet hashes.
-  // All manifests must have been decoded beforehand.
+  // All manifests must have been decoded beforehand. This copies every hash:
+  // verification uses getSuffixList and auth::SuffixHashes instead.
   static std::unordered_map<Suffix, HashEntry> getSuffixMap(
       const std::vector<ManifestInline *> &manifests) {
     std::unordered_map<Suffix, HashEntry> suffix_map;
 
     for (auto manifest_ptr : manifests) {
       HashType hash_algorithm = manifest_ptr->getHashAlgorithm();
-      SuffixList suffix_list = manifest_ptr->getSuffixList();
+      std::size_t hash_size = auth::hash_size_map[hash_algorithm];
 
-      for (auto it = suffix_list.begin(); it != suffix_list.end(); ++it) {
-        std::vector<uint8_t> hash(
-            it->second, it->second + auth::hash_size_map[hash_algorithm]);
-        suffix_map[it->first] = {hash_algorithm, hash};
+      for (const auto &entry : manifest_ptr->getSuffixList()) {
+        suffix_map[entry.getSuffix()] = {
+            hash_algorithm,
+            std::vector<uint8_t>(entry.getHash(), entry.getHash() + hash_size)};
       }
     }
 
@@ -135,7 +137,7 @@ class ManifestInline
  private:
   core::Name base_name_;
   NextSegmentCalculationStrategy next_segment_strategy_;
-  SuffixList suffix_hash_map_;
+  SuffixList suffix_list_;
 };
 
 }  // namespace core
@@ -18,11 +18,15 @@
 #include <hicn/transport/utils/hash.h>
 #include <hicn/transport/utils/log.h>
 
+#include <cstring>
+#include <vector>
+
 extern "C" {
 #ifndef _WIN32
 TRANSPORT_CLANG_DISABLE_WARNING("-Wextern-c-compat")
 #endif
 #include <hicn/error.h>
+#include <hicn/packet_inline.h>
 }
 
 namespace transport {
@@ -106,8 +110,8 @@ std::size_t Packet::getHeaderSizeFromBuffer(Format format,
                                             const uint8_t *buffer) {
   size_t header_length;
 
-  if (hicn_packet_get_header_length(format, (hicn_header_t *)buffer,
-                                    &header_length) < 0) {
+  if (hicn_inline_packet_get_header_length(
+          format, (const hicn_header_t *)buffer, &header_length) < 0) {
     throw errors::MalformedPacketException();
   }
 
@@ -150,8 +154,8 @@ std::size_t Packet::getPayloadSizeFromBuffer(Format format,
                                              const uint8_t *buffer) {
   std::size_t payload_length;
   if (TRANSPORT_EXPECT_FALSE(
-          hicn_packet_get_payload_length(format, (hicn_header_t *)buffer,
-                                         &payload_length) < 0)) {
+          hicn_inline_packet_get_payload_length(
+              format, (const hicn_header_t *)buffer, &payload_length) < 0)) {
     throw errors::MalformedPacketException();
   }
 
@@ -413,17 +417,61 @@ auth::CryptoHash Packet::computeDigest(auth::CryptoHashType algorithm) const {
   return hasher.finalize();
 }
 
-bool Packet::checkIntegrity() const {
-  uint16_t partial_csum =
-      csum(data() + HICN_V6_TCP_HDRLEN, length() - HICN_V6_TCP_HDRLEN, 0);
+std::vector<auth::CryptoHash> Packet::computeDigests(
+    auth::CryptoHashType algorithm, Packet *const *packets, std::size_t n) {
+  std::vector<hicn_header_t> header_copies(n);
+  std::vector<const uint8_t *> buffers(n);
+  std::vector<std::size_t> lengths(n);
+
+  // Chained packets are copied in a single scratch buffer, so that every
+  // packet is hashed from contiguous memory.
+  std::size_t scratch_size = 0;
+  for (std::size_t i = 0; i < n; i++) {
+    lengths[i] = packets[i]->computeChainDataLength();
+    if (packets[i]->isChained()) {
+      scratch_size += lengths[i];
+    }
+  }
+
+  std::vector<uint8_t> scratch(scratch_size);
+  uint8_t *scratch_ptr = scratch.data();
+
+  for (std::size_t i = 0; i < n; i++) {
+    Packet *packet = packets[i];
+
+    // Copy IP+TCP/ICMP header before zeroing them
+    hicn_packet_copy_header(packet->format_, packet->packet_start_,
+                            &header_copies[i], false);
+    packet->resetForHash();
 
-  for (const utils::MemBuf *current = next(); current != this;
-       current = current->next()) {
-    partial_csum = csum(current->data(), current->length(), ~partial_csum);
+    if (!packet->isChained()) {
+      buffers[i] = packet->data();
+      continue;
+    }
+
+    buffers[i] = scratch_ptr;
+    const utils::MemBuf *current = packet;
+    do {
+      std::memcpy(scratch_ptr, current->data(), current->length());
+      scratch_ptr += current->length();
+      current = current->next();
+    } while (current != packet);
+  }
+
+  auto digests = auth::CryptoHasher::hashBuffers(algorithm, buffers.data(),
+                                                 lengths.data(), n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    hicn_packet_copy_header(packets[i]->format_, &header_copies[i],
+                            packets[i]->packet_start_, false);
   }
 
+  return digests;
+}
+
+bool Packet::checkIntegrity() const {
   if (hicn_packet_check_integrity_no_payload(format_, packet_start_,
-                                             partial_csum) < 0) {
+                                             payloadChecksum()) < 0) {
     return false;
   }
 
@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hicn/transport/http/parser.h>
+#include <http/parser_kernel.h>
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define HTTP_PARSER_X86 1
+#include <immintrin.h>
+#endif
+
+namespace transport {
+
+namespace http {
+
+namespace {
+
+// Scanning kernels: return the first occurrence of a or b in [p, end), or
+// end. Header lines are a few tens of bytes, so most of the time is spent in
+// these scans and not in the per line logic.
+typedef const char *(*ScanFn)(const char *p, const char *end, char a, char b);
+
+const char *scanGeneric(const char *p, const char *end, char a, char b) {
+  for (; p < end; p++) {
+    if (*p == a || *p == b) {
+      return p;
+    }
+  }
+
+  return end;
+}
+
+#ifdef HTTP_PARSER_X86
+
+// Same as picohttpparser: pcmpestri looks for any byte of a set of 2.
+__attribute__((target("sse4.2"))) const char *scanSse42(const char *p,
+                                                         const char *end,
+                                                         char a, char b) {
+  const __m128i set = _mm_setr_epi8(a, b, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                    0, 0);
+
+  for (; end - p >= 16; p += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    int i = _mm_cmpestri(
+        set, 2, block, 16,
+        _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+    if (i != 16) {
+      return p + i;
+    }
+  }
+
+  return scanGeneric(p, end, a, b);
+}
+
+__attribute__((target("avx2"))) const char *scanAvx2(const char *p,
+                                                      const char *end, char a,
+                                                      char b) {
+  const __m256i va = _mm256_set1_epi8(a);
+  const __m256i vb = _mm256_set1_epi8(b);
+
+  for (; end - p >= 32; p += 32) {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, va),
+                        _mm256_cmpeq_epi8(block, vb))));
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+
+  return scanGeneric(p, end, a, b);
+}
+
+#endif  // HTTP_PARSER_X86
+
+ScanFn selectScan() {
+#ifdef HTTP_PARSER_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return scanAvx2;
+  } else if (__builtin_cpu_supports("sse4.2")) {
+    return scanSse42;
+  }
+#endif
+
+  return scanGeneric;
+}
+
+// Selected once, when the library is loaded.
+ScanFn scan = selectScan();
+
+inline char toLower(char c) {
+  return c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t'; }
+
+// Position after the end of line at eol, nullptr if it is incomplete or is
+// a lone CR.
+inline const char *skipEndOfLine(const char *eol, const char *end) {
+  if (*eol == '\n') {
+    return eol + 1;
+  }
+
+  if (eol + 1 < end && eol[1] == '\n') {
+    return eol + 2;
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+bool httpParserSetKernel(HTTPScanKernel kernel) {
+  switch (kernel) {
+    case HTTPScanKernel::AUTO:
+      scan = selectScan();
+      return true;
+    case HTTPScanKernel::GENERIC:
+      scan = scanGeneric;
+      return true;
+#ifdef HTTP_PARSER_X86
+    case HTTPScanKernel::SSE42:
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("sse4.2")) {
+        scan = scanSse42;
+        return true;
+      }
+      return false;
+    case HTTPScanKernel::AVX2:
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2")) {
+        scan = scanAvx2;
+        return true;
+      }
+      return false;
+#endif
+    default:
+      return false;
+  }
+}
+
+std::string HTTPStringView::lowercase() const {
+  std::string ret(data, length);
+  std::transform(ret.begin(), ret.end(), ret.begin(), toLower);
+  return ret;
+}
+
+bool HTTPStringView::equalsIgnoreCase(const char *s, std::size_t size) const {
+  if (size != length) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < size; i++) {
+    if (toLower(data[i]) != toLower(s[i])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool HTTPStringView::contains(const char *s) const {
+  const char *end = data + length;
+  return std::search(data, end, s, s + std::strlen(s)) != end;
+}
+
+bool HTTPStringView::toNumber(std::size_t &value) const {
+  constexpr std::size_t max = std::numeric_limits<std::size_t>::max();
+
+  if (empty()) {
+    return false;
+  }
+
+  value = 0;
+  for (std::size_t i = 0; i < length; i++) {
+    if (data[i] < '0' || data[i] > '9') {
+      return false;
+    }
+
+    std::size_t digit = data[i] - '0';
+    if (value > (max - digit) / 10) {
+      return false;
+    }
+
+    value = value * 10 + digit;
+  }
+
+  return true;
+}
+
+std::size_t HTTPMessageView::parse(const uint8_t *buffer, std::size_t size) {
+  const char *begin = reinterpret_cast<const char *>(buffer);
+  const char *end = begin + size;
+  const char *p = begin;
+
+  header_count_ = 0;
+
+  // Start line: the last token is the rest of the line, since the reason
+  // phrase of a response may contain spaces.
+  const char *eol = scan(p, end, '\r', '\n');
+  if (eol == end) {
+    return 0;
+  }
+
+  for (std::size_t i = 0; i < 3; i++) {
+    const char *space =
+        i < 2 ? static_cast<const char *>(std::memchr(p, ' ', eol - p))
+              : nullptr;
+    if (!space) {
+      if (i == 0) {
+        return 0;
+      }
+
+      start_line_[i] = {p, static_cast<std::size_t>(eol - p)};
+      p = eol;
+      continue;
+    }
+
+    start_line_[i] = {p, static_cast<std::size_t>(space - p)};
+    for (p = space + 1; p < eol && *p == ' '; p++) {
+    }
+  }
+
+  if (!(p = skipEndOfLine(eol, end))) {
+    return 0;
+  }
+
+  // Header lines, up to the empty line
+  while (p < end) {
+    if (*p == '\r' || *p == '\n') {
+      p = skipEndOfLine(p, end);
+      return p ? p - begin : 0;
+    }
+
+    if (header_count_ == max_headers) {
+      return 0;
+    }
+
+    const char *colon = scan(p, end, ':', '\n');
+    if (colon == end || *colon != ':' || colon == p) {
+      return 0;
+    }
+
+    HTTPHeaderView &header = headers_[header_count_++];
+    header.name = {p, static_cast<std::size_t>(colon - p)};
+
+    for (p = colon + 1; p < end && isBlank(*p); p++) {
+    }
+
+    if ((eol = scan(p, end, '\r', '\n')) == end) {
+      return 0;
+    }
+
+    const char *value_end = eol;
+    while (value_end > p && isBlank(value_end[-1])) {
+      value_end--;
+    }
+
+    header.value = {p, static_cast<std::size_t>(value_end - p)};
+
+    if (!(p = skipEndOfLine(eol, end))) {
+      return 0;
+    }
+  }
+
+  return 0;
+}
+
+const HTTPStringView *HTTPMessageView::find(const char *name) const {
+  std::size_t size = std::strlen(name);
+
+  for (std::size_t i = 0; i < header_count_; i++) {
+    if (headers_[i].name.equalsIgnoreCase(name, size)) {
+      return &headers_[i].value;
+    }
+  }
+
+  return nullptr;
+}
+
+bool HTTPMessageView::parseVersion(const HTTPStringView &token,
+                                   HTTPStringView &version) {
+  static constexpr char prefix[] = "HTTP/";
+  static constexpr std::size_t prefix_length = sizeof(prefix) - 1;
+
+  if (token.length <= prefix_length ||
+      std::memcmp(token.data, prefix, prefix_length)) {
+    return false;
+  }
+
+  version = {token.data + prefix_length, token.length - prefix_length};
+  return true;
+}
+
+}  // namespace http
+
+}  // namespace transport
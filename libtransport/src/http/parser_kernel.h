@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+namespace transport {
+
+namespace http {
+
+enum class HTTPScanKernel { AUTO, GENERIC, SSE42, AVX2 };
+
+// Force the scanning kernel of HTTPMessageView, AUTO goes back to the one
+// selected for this CPU. Meant for tests, it must not be called while parsing.
+// Return false, and leave the kernel unchanged, if the CPU cannot run it.
+bool httpParserSetKernel(HTTPScanKernel kernel);
+
+}  // end namespace http
+
+}  // end namespace transport
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <hicn/transport/http/parser.h>
 #include <hicn/transport/http/request.h>
 #include <hicn/transport/utils/uri.h>
 
@@ -73,66 +74,27 @@ std::size_t HTTPRequest::parseHeaders(const uint8_t *buffer, std::size_t size,
                                       HTTPHeaders &headers,
                                       std::string &http_version,
                                       std::string &method, std::string &url) {
-  const char *crlf2 = "\r\n\r\n";
-  const char *begin = (const char *)buffer;
-  const char *end = begin + size;
-  const char *begincrlf2 = (const char *)crlf2;
-  const char *endcrlf2 = begincrlf2 + strlen(crlf2);
-  auto it = std::search(begin, end, begincrlf2, endcrlf2);
-
-  if (it != end) {
-    std::stringstream ss;
-    ss.str(std::string(begin, it + 2));
-
-    std::string line;
-    getline(ss, line);
-    std::istringstream line_s(line);
-    std::string _http_version;
-
-    line_s >> method;
-    line_s >> url;
-    line_s >> _http_version;
-    std::size_t separator;
-    if ((separator = _http_version.find('/')) != std::string::npos) {
-      if (_http_version.substr(0, separator) != "HTTP") {
-        return 0;
-      }
-      http_version = _http_version.substr(
-          separator + 1, _http_version.length() - separator - 1);
-    } else {
-      return 0;
-    }
+  HTTPMessageView message;
+  HTTPStringView version;
+
+  std::size_t length = message.parse(buffer, size);
+  if (!length ||
+      !HTTPMessageView::parseVersion(message.startLine(2), version)) {
+    return 0;
+  }
+
+  method = message.startLine(0).str();
+  url = message.startLine(1).str();
+  http_version = version.str();
 
-    std::size_t param_end;
-    std::size_t value_start;
-    std::string header_key, header_value;
-    while (getline(ss, line)) {
-      if ((param_end = line.find(':')) != std::string::npos) {
-        value_start = param_end + 1;
-        if ((value_start) < line.size()) {
-          if (line[value_start] == ' ') {
-            value_start++;
-          }
-          if (value_start < line.size()) {
-            header_key = line.substr(0, param_end);
-            header_value =
-                line.substr(value_start, line.size() - value_start - 1);
-            std::transform(header_key.begin(), header_key.end(),
-                           header_key.begin(),
-                           [](unsigned char c) { return std::tolower(c); });
-            std::transform(header_value.begin(), header_value.end(),
-                           header_value.begin(),
-                           [](unsigned char c) { return std::tolower(c); });
-            headers[header_key] = header_value;
-          }
-        }
-      } else {
-        return 0;
-      }
+  for (std::size_t i = 0; i < message.headerCount(); i++) {
+    const HTTPHeaderView &header = message.header(i);
+    if (!header.value.empty()) {
+      headers[header.name.lowercase()] = header.value.lowercase();
     }
   }
 
-  return it + strlen(crlf2) - begin;
+  return length;
 }
 
 }  // namespace http
@@ -14,6 +14,7 @@
  */
 
 #include <hicn/transport/errors/errors.h>
+#include <hicn/transport/http/parser.h>
 #include <hicn/transport/http/response.h>
 
 #include <algorithm>
@@ -58,60 +59,27 @@ std::size_t HTTPResponse::parseHeaders(const uint8_t *buffer, std::size_t size,
                                        std::string &http_version,
                                        std::string &status_code,
                                        std::string &status_string) {
-  const char *crlf2 = "\r\n\r\n";
-  const char *begin = (const char *)buffer;
-  const char *end = begin + size;
-  const char *begincrlf2 = (const char *)crlf2;
-  const char *endcrlf2 = begincrlf2 + strlen(crlf2);
-  auto it = std::search(begin, end, begincrlf2, endcrlf2);
-  if (it != end) {
-    std::stringstream ss;
-    ss.str(std::string(begin, it + 2));
-
-    std::string line;
-    getline(ss, line);
-    std::istringstream line_s(line);
-    std::string _http_version;
-
-    line_s >> _http_version;
-    std::size_t separator;
-    if ((separator = _http_version.find('/')) != std::string::npos) {
-      if (_http_version.substr(0, separator) != "HTTP") {
-        return 0;
-      }
-      http_version =
-          line.substr(separator + 1, _http_version.length() - separator - 1);
-    } else {
-      return 0;
-    }
+  HTTPMessageView message;
+  HTTPStringView version;
+
+  std::size_t length = message.parse(buffer, size);
+  if (!length ||
+      !HTTPMessageView::parseVersion(message.startLine(0), version)) {
+    return 0;
+  }
+
+  http_version = version.str();
+  status_code = message.startLine(1).str();
+  status_string = message.startLine(2).str();
 
-    line_s >> status_code;
-    line_s >> status_string;
-
-    std::size_t param_end;
-    std::size_t value_start;
-    while (getline(ss, line)) {
-      if ((param_end = line.find(':')) != std::string::npos) {
-        value_start = param_end + 1;
-        if ((value_start) < line.size()) {
-          if (line[value_start] == ' ') {
-            value_start++;
-          }
-          if (value_start < line.size()) {
-            auto header = line.substr(0, param_end);
-            std::transform(header.begin(), header.end(), header.begin(),
-                           [](unsigned char c) { return std::tolower(c); });
-            headers[header] =
-                line.substr(value_start, line.size() - value_start - 1);
-          }
-        }
-      } else {
-        return 0;
-      }
+  for (std::size_t i = 0; i < message.headerCount(); i++) {
+    const HTTPHeaderView &header = message.header(i);
+    if (!header.value.empty()) {
+      headers[header.name.lowercase()] = header.value.str();
     }
   }
 
-  return it + strlen(crlf2) - begin;
+  return length;
 }
 
 void HTTPResponse::parse(std::unique_ptr<utils::MemBuf> &&response) {
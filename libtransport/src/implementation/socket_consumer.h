@@ -59,6 +59,8 @@ class ConsumerSocket : public Socket {
         verifier_(std::make_shared<auth::VoidVerifier>()),
         verify_signature_(false),
         reset_window_(false),
+        interest_pacing_(default_values::interest_pacing),
+        verification_threads_(default_values::verification_threads),
         on_interest_output_(VOID_HANDLER),
         on_interest_timeout_(VOID_HANDLER),
         on_interest_satisfied_(VOID_HANDLER),
@@ -265,6 +267,10 @@ class ConsumerSocket : public Socket {
         timer_interval_milliseconds_ = socket_option_value;
         break;
 
+      case GeneralTransportOptions::VERIFICATION_THREADS:
+        verification_threads_ = socket_option_value;
+        break;
+
       default:
         return SOCKET_OPTION_NOT_SET;
     }
@@ -328,6 +334,11 @@ class ConsumerSocket : public Socket {
           result = SOCKET_OPTION_SET;
           break;
 
+        case RaaqmTransportOptions::INTEREST_PACING:
+          interest_pacing_ = socket_option_value;
+          result = SOCKET_OPTION_SET;
+          break;
+
         default:
           return result;
       }
@@ -532,6 +543,10 @@ class ConsumerSocket : public Socket {
         socket_option_value = timer_interval_milliseconds_;
         break;
 
+      case GeneralTransportOptions::VERIFICATION_THREADS:
+        socket_option_value = verification_threads_;
+        break;
+
       default:
         return SOCKET_OPTION_NOT_GET;
     }
@@ -553,6 +568,10 @@ class ConsumerSocket : public Socket {
         socket_option_value = reset_window_;
         break;
 
+      case RaaqmTransportOptions::INTEREST_PACING:
+        socket_option_value = interest_pacing_;
+        break;
+
       default:
         return SOCKET_OPTION_NOT_GET;
     }
@@ -780,6 +799,8 @@ class ConsumerSocket : public Socket {
   PARCKeyId *key_id_;
   std::atomic_bool verify_signature_;
   bool reset_window_;
+  bool interest_pacing_;
+  uint32_t verification_threads_;
 
   ConsumerInterestCallback on_interest_retransmission_;
   ConsumerInterestCallback on_interest_output_;
@@ -52,6 +52,7 @@ class ProducerSocket : public Socket {
         async_thread_(),
         making_manifest_(false),
         hash_algorithm_(auth::CryptoHashType::SHA_256),
+        signing_threads_(default_values::signing_threads),
         suffix_strategy_(core::NextSegmentCalculationStrategy::INCREMENTAL),
         on_interest_input_(VOID_HANDLER),
         on_interest_dropped_input_buffer_(VOID_HANDLER),
@@ -180,6 +181,10 @@ class ProducerSocket : public Socket {
         content_object_expiry_time_ = socket_option_value;
         break;
 
+      case GeneralTransportOptions::SIGNING_THREADS:
+        signing_threads_ = socket_option_value;
+        break;
+
       default:
         return SOCKET_OPTION_NOT_SET;
     }
@@ -428,6 +433,10 @@ class ProducerSocket : public Socket {
         socket_option_value = content_object_expiry_time_;
         break;
 
+      case GeneralTransportOptions::SIGNING_THREADS:
+        socket_option_value = signing_threads_;
+        break;
+
       default:
         return SOCKET_OPTION_NOT_SET;
     }
@@ -686,6 +695,7 @@ class ProducerSocket : public Socket {
   std::atomic<bool> making_manifest_;
   std::atomic<auth::CryptoHashType> hash_algorithm_;
   std::atomic<auth::CryptoSuite> crypto_suite_;
+  std::atomic<uint32_t> signing_threads_;
   utils::SpinLock signer_lock_;
   std::shared_ptr<auth::Signer> signer_;
   core::NextSegmentCalculationStrategy suffix_strategy_;
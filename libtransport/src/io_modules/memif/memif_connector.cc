@@ -33,24 +33,44 @@ struct memif_connection {
   uint16_t index;
   /* memif conenction handle */
   memif_conn_handle_t conn;
-  /* transmit queue id */
-  uint16_t tx_qid;
-  /* tx buffers */
-  memif_buffer_t *tx_bufs;
-  /* allocated tx buffers counter */
-  /* number of tx buffers pointing to shared memory */
-  uint16_t tx_buf_num;
-  /* rx buffers */
-  memif_buffer_t *rx_bufs;
-  /* allcoated rx buffers counter */
-  /* number of rx buffers pointing to shared memory */
-  uint16_t rx_buf_num;
+  /* control socket of the connection */
+  memif_socket_handle_t socket;
   /* interface ip address */
   uint8_t ip_addr[4];
 };
 
+/* A queue pair, served by its own thread */
+struct MemifConnector::Queue {
+  explicit Queue(uint16_t id)
+      : qid(id),
+        send_timer(std::make_unique<utils::FdDeadlineTimer>(event_reactor)),
+        stop_timer(std::make_unique<utils::FdDeadlineTimer>(event_reactor)),
+        timer_set(false),
+        tx_bufs(MAX_MEMIF_BUFS),
+        tx_buf_num(0),
+        rx_bufs(MAX_MEMIF_BUFS) {}
+
+  uint16_t qid;
+  std::unique_ptr<std::thread> worker;
+  utils::EpollEventReactor event_reactor;
+  std::unique_ptr<utils::FdDeadlineTimer> send_timer;
+  std::unique_ptr<utils::FdDeadlineTimer> stop_timer;
+  std::atomic_bool timer_set;
+
+  /* tx buffers pointing to shared memory */
+  std::vector<memif_buffer_t> tx_bufs;
+  uint16_t tx_buf_num;
+  utils::SpinLock output_lock;
+  PacketQueue output_buffer;
+
+  /* rx buffers pointing to shared memory */
+  std::vector<memif_buffer_t> rx_bufs;
+  PacketRing input_buffer;
+};
+
 std::once_flag MemifConnector::flag_;
 utils::EpollEventReactor MemifConnector::main_event_reactor_;
+std::mutex MemifConnector::main_event_reactor_mutex_;
 
 MemifConnector::MemifConnector(PacketReceivedCallback &&receive_callback,
                                PacketSentCallback &&packet_sent,
@@ -60,14 +80,8 @@ MemifConnector::MemifConnector(PacketReceivedCallback &&receive_callback,
                                std::string app_name)
     : Connector(std::move(receive_callback), std::move(packet_sent),
                 std::move(close_callback), std::move(on_reconnect)),
-      memif_worker_(nullptr),
-      timer_set_(false),
-      send_timer_(std::make_unique<utils::FdDeadlineTimer>(event_reactor_)),
-      disconnect_timer_(
-          std::make_unique<utils::FdDeadlineTimer>(event_reactor_)),
       io_service_(io_service),
       memif_connection_(std::make_unique<memif_connection_t>()),
-      tx_buf_counter_(0),
       is_reconnection_(false),
       data_available_(false),
       app_name_(app_name),
@@ -87,41 +101,76 @@ void MemifConnector::init() {
   }
 }
 
-void MemifConnector::connect(uint32_t memif_id, long memif_mode) {
-  state_ = State::CONNECTING;
+void MemifConnector::connect(uint32_t memif_id, long memif_mode,
+                             const std::string &socket_filename,
+                             std::uint16_t num_queues) {
+  setState(State::CONNECTING);
 
   memif_id_ = memif_id;
-  socket_filename_ = "/run/vpp/memif.sock";
+  socket_filename_ = socket_filename;
+
+  for (uint16_t qid = 0; qid < num_queues; qid++) {
+    queues_.emplace_back(std::make_unique<Queue>(qid));
+  }
 
   createMemif(memif_id, memif_mode, nullptr);
 
   work_ = std::make_unique<asio::io_service::work>(io_service_);
 
-  while (state_ != State::CONNECTED) {
-    MemifConnector::main_event_reactor_.runOneEvent();
+  // Other connectors may be waiting for their connection at the same time,
+  // e.g. the two ends of a memif in the same process. Whoever gets the main
+  // reactor runs it, the others wait for it to change their state.
+  while (true) {
+    bool event_run = false;
+    {
+      std::unique_lock<std::mutex> reactor_lock(main_event_reactor_mutex_,
+                                                std::try_to_lock);
+      if (reactor_lock.owns_lock() && state_ == State::CONNECTING) {
+        MemifConnector::main_event_reactor_.runOneEvent();
+        event_run = true;
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(state_mutex_);
+    if (!event_run) {
+      state_cv_.wait_for(lock, std::chrono::milliseconds(1),
+                         [this]() { return state_ != State::CONNECTING; });
+    }
+
+    if (state_ != State::CONNECTING) {
+      break;
+    }
+  }
+
+  if (TRANSPORT_EXPECT_FALSE(state_ != State::CONNECTED)) {
+    throw errors::RuntimeException("memif disconnected while connecting");
   }
 
   int err;
 
-  /* get interrupt queue id */
-  int fd = -1;
-  err = memif_get_queue_efd(memif_connection_->conn, 0, &fd);
-  if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS)) {
-    TRANSPORT_LOGE("memif_get_queue_efd: %s", memif_strerror(err));
-    return;
-  }
+  for (auto &queue : queues_) {
+    Queue *q = queue.get();
+
+    /* get interrupt queue id */
+    int fd = -1;
+    err = memif_get_queue_efd(memif_connection_->conn, q->qid, &fd);
+    if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS)) {
+      TRANSPORT_LOGE("memif_get_queue_efd: %s", memif_strerror(err));
+      return;
+    }
 
-  // Remove fd from main epoll
-  main_event_reactor_.delFileDescriptor(fd);
+    // Remove fd from main epoll
+    main_event_reactor_.delFileDescriptor(fd);
 
-  // Add fd to epoll of instance
-  event_reactor_.addFileDescriptor(
-      fd, EPOLLIN, [this](const utils::Event &evt) -> int {
-        return onInterrupt(memif_connection_->conn, this, 0);
-      });
+    // Add fd to epoll of the queue
+    q->event_reactor.addFileDescriptor(
+        fd, EPOLLIN, [this, q](const utils::Event &evt) -> int {
+          return onInterrupt(memif_connection_->conn, this, q->qid);
+        });
 
-  memif_worker_ = std::make_unique<std::thread>(
-      std::bind(&MemifConnector::threadMain, this));
+    q->worker = std::make_unique<std::thread>(
+        std::bind(&MemifConnector::threadMain, this, std::ref(*q)));
+  }
 }
 
 int MemifConnector::createMemif(uint32_t index, uint8_t mode, char *s) {
@@ -134,8 +183,8 @@ int MemifConnector::createMemif(uint32_t index, uint8_t mode, char *s) {
   args.is_master = mode;
   args.log2_ring_size = MEMIF_LOG2_RING_SIZE;
   args.buffer_size = MEMIF_BUF_SIZE;
-  args.num_s2m_rings = 1;
-  args.num_m2s_rings = 1;
+  args.num_s2m_rings = uint8_t(queues_.size());
+  args.num_m2s_rings = uint8_t(queues_.size());
   strncpy((char *)args.interface_name, IF_NAME, strlen(IF_NAME) + 1);
   args.mode = memif_interface_mode_t::MEMIF_INTERFACE_MODE_IP;
 
@@ -147,6 +196,7 @@ int MemifConnector::createMemif(uint32_t index, uint8_t mode, char *s) {
     throw errors::RuntimeException(memif_strerror(err));
   }
 
+  c->socket = args.socket;
   args.interface_id = index;
   /* last argument for memif_create (void * private_ctx) is used by user
      to identify connection. this context is returned with callbacks */
@@ -162,14 +212,6 @@ int MemifConnector::createMemif(uint32_t index, uint8_t mode, char *s) {
   }
 
   c->index = (uint16_t)index;
-  c->tx_qid = 0;
-  /* alloc memif buffers */
-  c->rx_buf_num = 0;
-  c->rx_bufs = static_cast<memif_buffer_t *>(
-      malloc(sizeof(memif_buffer_t) * MAX_MEMIF_BUFS));
-  c->tx_buf_num = 0;
-  c->tx_bufs = static_cast<memif_buffer_t *>(
-      malloc(sizeof(memif_buffer_t) * MAX_MEMIF_BUFS));
 
   // memif_set_rx_mode (c->conn, MEMIF_RX_MODE_POLLING, 0);
 
@@ -179,20 +221,6 @@ int MemifConnector::createMemif(uint32_t index, uint8_t mode, char *s) {
 int MemifConnector::deleteMemif() {
   memif_connection_t *c = memif_connection_.get();
 
-  if (c->rx_bufs) {
-    free(c->rx_bufs);
-  }
-
-  c->rx_bufs = nullptr;
-  c->rx_buf_num = 0;
-
-  if (c->tx_bufs) {
-    free(c->tx_bufs);
-  }
-
-  c->tx_bufs = nullptr;
-  c->tx_buf_num = 0;
-
   int err;
   /* disconenct then delete memif connection */
   err = memif_delete(&c->conn);
@@ -205,6 +233,12 @@ int MemifConnector::deleteMemif() {
     TRANSPORT_LOGE("memif delete fail");
   }
 
+  err = memif_delete_socket(&c->socket);
+
+  if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS)) {
+    TRANSPORT_LOGE("memif_delete_socket: %s", memif_strerror(err));
+  }
+
   return 0;
 }
 
@@ -256,60 +290,58 @@ int MemifConnector::controlFdUpdate(int fd, uint8_t events, void *private_ctx) {
       });
 }
 
-int MemifConnector::bufferAlloc(long n, uint16_t qid) {
-  memif_connection_t *c = memif_connection_.get();
+int MemifConnector::bufferAlloc(Queue &queue, long n) {
   int err;
-  uint16_t r;
+  uint16_t r = 0;
   /* set data pointer to shared memory and set buffer_len to shared mmeory
    * buffer len */
-  err = memif_buffer_alloc(c->conn, qid, c->tx_bufs, n, &r, 2000);
+  err = memif_buffer_alloc(memif_connection_->conn, queue.qid,
+                           queue.tx_bufs.data(), n, &r, 2000);
 
-  if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS)) {
+  /* a full ring is not an error: we send what we got and retry later */
+  if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS &&
+                             err != MEMIF_ERR_NOBUF_RING)) {
     TRANSPORT_LOGE("memif_buffer_alloc: %s", memif_strerror(err));
     return -1;
   }
 
-  c->tx_buf_num += r;
+  queue.tx_buf_num += r;
   return r;
 }
 
-int MemifConnector::txBurst(uint16_t qid) {
-  memif_connection_t *c = memif_connection_.get();
+int MemifConnector::txBurst(Queue &queue) {
   int err;
   uint16_t r;
   /* inform peer memif interface about data in shared memory buffers */
   /* mark memif buffers as free */
-  err = memif_tx_burst(c->conn, qid, c->tx_bufs, c->tx_buf_num, &r);
-
-  if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS)) {
-    TRANSPORT_LOGE("memif_tx_burst: %s", memif_strerror(err));
-  }
-
-  // err = memif_refill_queue(c->conn, qid, r, 0);
+  err = memif_tx_burst(memif_connection_->conn, queue.qid,
+                       queue.tx_bufs.data(), queue.tx_buf_num, &r);
 
   if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS)) {
     TRANSPORT_LOGE("memif_tx_burst: %s", memif_strerror(err));
-    c->tx_buf_num -= r;
+    queue.tx_buf_num -= r;
     return -1;
   }
 
-  c->tx_buf_num -= r;
+  queue.tx_buf_num -= r;
   return 0;
 }
 
-void MemifConnector::sendCallback(const std::error_code &ec) {
-  timer_set_ = false;
+void MemifConnector::sendCallback(Queue &queue, const std::error_code &ec) {
+  queue.timer_set = false;
 
   if (TRANSPORT_EXPECT_TRUE(!ec && state_ == State::CONNECTED)) {
-    doSend();
+    doSend(queue);
   }
 }
 
-void MemifConnector::processInputBuffer(std::uint16_t total_packets) {
+void MemifConnector::processInputBuffer(Queue &queue,
+                                        std::uint16_t total_packets) {
   utils::MemBuf::Ptr ptr;
 
   for (; total_packets > 0; total_packets--) {
-    if (input_buffer_.pop(ptr)) {
+    if (queue.input_buffer.pop(ptr)) {
+      receiveSuccess(*ptr);
       receive_callback_(this, *ptr, std::make_error_code(std::errc(0)));
     }
   }
@@ -319,8 +351,12 @@ void MemifConnector::processInputBuffer(std::uint16_t total_packets) {
    connection (multiple connections WIP) */
 int MemifConnector::onConnect(memif_conn_handle_t conn, void *private_ctx) {
   MemifConnector *connector = (MemifConnector *)private_ctx;
-  connector->state_ = State::CONNECTED;
-  memif_refill_queue(conn, 0, -1, 0);
+
+  for (auto &queue : connector->queues_) {
+    memif_refill_queue(conn, queue->qid, -1, 0);
+  }
+
+  connector->setState(State::CONNECTED);
 
   return 0;
 }
@@ -329,23 +365,32 @@ int MemifConnector::onConnect(memif_conn_handle_t conn, void *private_ctx) {
    identify connection (multiple connections WIP) */
 int MemifConnector::onDisconnect(memif_conn_handle_t conn, void *private_ctx) {
   MemifConnector *connector = (MemifConnector *)private_ctx;
-  connector->state_ = State::CLOSED;
+  connector->setState(State::CLOSED);
   return 0;
 }
 
-void MemifConnector::threadMain() { event_reactor_.runEventLoop(1000); }
+void MemifConnector::setState(State state) {
+  {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    state_ = state;
+  }
+  state_cv_.notify_all();
+}
+
+void MemifConnector::threadMain(Queue &queue) {
+  queue.event_reactor.runEventLoop(1000);
+}
 
 int MemifConnector::onInterrupt(memif_conn_handle_t conn, void *private_ctx,
                                 uint16_t qid) {
   MemifConnector *connector = (MemifConnector *)private_ctx;
-
-  memif_connection_t *c = connector->memif_connection_.get();
+  Queue &queue = *connector->queues_[qid];
   int err = MEMIF_ERR_SUCCESS, ret_val;
   uint16_t total_packets = 0;
-  uint16_t rx;
+  uint16_t rx = 0;
 
   do {
-    err = memif_rx_burst(conn, qid, c->rx_bufs, MAX_MEMIF_BUFS, &rx);
+    err = memif_rx_burst(conn, qid, queue.rx_bufs.data(), MAX_MEMIF_BUFS, &rx);
     ret_val = err;
 
     if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS &&
@@ -354,21 +399,18 @@ int MemifConnector::onInterrupt(memif_conn_handle_t conn, void *private_ctx,
       goto error;
     }
 
-    c->rx_buf_num += rx;
-
     if (TRANSPORT_EXPECT_FALSE(connector->io_service_.stopped())) {
       TRANSPORT_LOGE("socket stopped: ignoring %u packets", rx);
       goto error;
     }
 
-    std::size_t packet_length;
     for (int i = 0; i < rx; i++) {
+      memif_buffer_t *b = &queue.rx_bufs[i];
       auto buffer = connector->getRawBuffer();
-      packet_length = (c->rx_bufs + i)->len;
-      std::memcpy(buffer.first, (c->rx_bufs + i)->data, packet_length);
-      auto packet = connector->getPacketFromBuffer(buffer.first, packet_length);
+      std::memcpy(buffer.first, b->data, b->len);
+      auto packet = connector->getPacketFromBuffer(buffer.first, b->len);
 
-      if (!connector->input_buffer_.push(std::move(packet))) {
+      if (!queue.input_buffer.push(std::move(packet))) {
         TRANSPORT_LOGE("Error pushing packet. Ring buffer full.");
 
         // TODO Here we should consider the possibility to signal the congestion
@@ -377,109 +419,147 @@ int MemifConnector::onInterrupt(memif_conn_handle_t conn, void *private_ctx,
       }
     }
 
-    /* mark memif buffers and shared memory buffers as free */
-    /* free processed buffers */
-
+    /* the packets were copied: give all the buffers back to the peer, so
+     * that packets held by the application never pin the ring */
     err = memif_refill_queue(conn, qid, rx, 0);
 
     if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS)) {
       TRANSPORT_LOGE("memif_buffer_free: %s", memif_strerror(err));
     }
 
-    c->rx_buf_num -= rx;
     total_packets += rx;
-
   } while (ret_val == MEMIF_ERR_NOBUF);
 
-  connector->io_service_.post(
-      std::bind(&MemifConnector::processInputBuffer, connector, total_packets));
+  connector->io_service_.post(std::bind(&MemifConnector::processInputBuffer,
+                                        connector, std::ref(queue),
+                                        total_packets));
 
   return 0;
 
 error:
-  err = memif_refill_queue(c->conn, qid, rx, 0);
+  err = memif_refill_queue(conn, qid, rx, 0);
 
   if (TRANSPORT_EXPECT_FALSE(err != MEMIF_ERR_SUCCESS)) {
     TRANSPORT_LOGE("memif_buffer_free: %s", memif_strerror(err));
   }
-  c->rx_buf_num -= rx;
+
+  if (total_packets > 0) {
+    connector->io_service_.post(std::bind(&MemifConnector::processInputBuffer,
+                                          connector, std::ref(queue),
+                                          total_packets));
+  }
 
   return 0;
 }
 
 void MemifConnector::close() {
-  if (state_ != State::CLOSED) {
-    disconnect_timer_->expiresFromNow(std::chrono::microseconds(50));
-    disconnect_timer_->asyncWait([this](const std::error_code &ec) {
-      deleteMemif();
-      event_reactor_.stop();
-      work_.reset();
-    });
-
-    if (memif_worker_ && memif_worker_->joinable()) {
-      memif_worker_->join();
+  if (memif_connection_->conn == nullptr) {
+    return;
+  }
+
+  for (auto &queue : queues_) {
+    Queue *q = queue.get();
+    q->stop_timer->expiresFromNow(std::chrono::microseconds(50));
+    q->stop_timer->asyncWait(
+        [q](const std::error_code &ec) { q->event_reactor.stop(); });
+  }
+
+  for (auto &queue : queues_) {
+    if (queue->worker && queue->worker->joinable()) {
+      queue->worker->join();
     }
   }
+
+  deleteMemif();
+  setState(State::CLOSED);
+  work_.reset();
+}
+
+MemifConnector::Queue &MemifConnector::selectQueue(Packet &packet) {
+  if (queues_.size() == 1) {
+    return *queues_[0];
+  }
+
+  // Packets of the same prefix always go through the same queue
+  return *queues_[packet.getName().getHash32(false) % queues_.size()];
 }
 
 void MemifConnector::send(Packet &packet) {
+  Queue &queue = selectQueue(packet);
+
   {
-    utils::SpinLock::Acquire locked(write_msgs_lock_);
-    output_buffer_.push_back(packet.shared_from_this());
+    utils::SpinLock::Acquire locked(queue.output_lock);
+    queue.output_buffer.push_back(packet.shared_from_this());
   }
 #if CANCEL_TIMER
-  if (!timer_set_) {
-    timer_set_ = true;
-    send_timer_->expiresFromNow(std::chrono::microseconds(50));
-    send_timer_->asyncWait(
-        std::bind(&MemifConnector::sendCallback, this, std::placeholders::_1));
-  }
+  scheduleSend(queue);
 #endif
 }
 
-int MemifConnector::doSend() {
-  std::size_t max = 0;
+void MemifConnector::scheduleSend(Queue &queue) {
+  if (!queue.timer_set.exchange(true)) {
+    queue.send_timer->expiresFromNow(std::chrono::microseconds(50));
+    queue.send_timer->asyncWait(std::bind(&MemifConnector::sendCallback, this,
+                                          std::ref(queue),
+                                          std::placeholders::_1));
+  }
+}
+
+int MemifConnector::doSend(Queue &queue) {
+  PacketQueue packets;
   int32_t n = 0;
-  std::size_t size = 0;
 
   {
-    utils::SpinLock::Acquire locked(write_msgs_lock_);
-    size = output_buffer_.size();
+    utils::SpinLock::Acquire locked(queue.output_lock);
+    packets.swap(queue.output_buffer);
   }
 
-  do {
-    max = size < MAX_MEMIF_BUFS ? size : MAX_MEMIF_BUFS;
-    n = bufferAlloc(max, memif_connection_->tx_qid);
+  while (!packets.empty()) {
+    std::size_t max = packets.size() < MAX_MEMIF_BUFS ? packets.size()
+                                                      : MAX_MEMIF_BUFS;
+    n = bufferAlloc(queue, max);
 
     if (TRANSPORT_EXPECT_FALSE(n < 0)) {
       TRANSPORT_LOGE("Error allocating buffers.");
-      return -1;
+      break;
     }
 
-    for (uint16_t i = 0; i < n; i++) {
-      utils::SpinLock::Acquire locked(write_msgs_lock_);
+    if (n == 0) {
+      break;
+    }
 
-      auto packet = output_buffer_.front().get();
+    for (uint16_t i = 0; i < n; i++) {
+      auto packet = packets.front().get();
       const utils::MemBuf *current = packet;
       std::size_t offset = 0;
       uint8_t *shared_buffer =
-          reinterpret_cast<uint8_t *>(memif_connection_->tx_bufs[i].data);
+          reinterpret_cast<uint8_t *>(queue.tx_bufs[i].data);
       do {
         std::memcpy(shared_buffer + offset, current->data(), current->length());
         offset += current->length();
         current = current->next();
       } while (current != packet);
 
-      memif_connection_->tx_bufs[i].len = uint32_t(offset);
+      queue.tx_bufs[i].len = uint32_t(offset);
 
-      output_buffer_.pop_front();
+      sendSuccess(*packet);
+      packets.pop_front();
     }
 
-    txBurst(memif_connection_->tx_qid);
+    txBurst(queue);
+  }
+
+  if (TRANSPORT_EXPECT_FALSE(!packets.empty())) {
+    // The ring is full: keep the order and retry later
+    {
+      utils::SpinLock::Acquire locked(queue.output_lock);
+      queue.output_buffer.insert(queue.output_buffer.begin(), packets.begin(),
+                                 packets.end());
+    }
 
-    utils::SpinLock::Acquire locked(write_msgs_lock_);
-    size = output_buffer_.size();
-  } while (size > 0);
+    scheduleSend(queue);
+    return -1;
+  }
 
   return 0;
 }
@@ -24,9 +24,11 @@
 #include <utils/fd_deadline_timer.h>
 
 #include <asio.hpp>
+#include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #define _Static_assert static_assert
 
@@ -38,6 +40,7 @@ typedef struct memif_connection memif_connection_t;
 
 #define APP_NAME "libtransport"
 #define IF_NAME "vpp_connection"
+#define MEMIF_DEFAULT_SOCKET "/run/vpp/memif.sock"
 
 #define MEMIF_BUF_SIZE 2048
 #define MEMIF_LOG2_RING_SIZE 13
@@ -47,6 +50,8 @@ class MemifConnector : public Connector {
   using memif_conn_handle_t = void *;
   using PacketRing = utils::CircularFifo<utils::MemBuf::Ptr, queue_size>;
 
+  struct Queue;
+
  public:
   MemifConnector(PacketReceivedCallback &&receive_callback,
                  PacketSentCallback &&packet_sent,
@@ -63,14 +68,24 @@ class MemifConnector : public Connector {
 
   void close() override;
 
-  void connect(uint32_t memif_id, long memif_mode);
+  /**
+   * Connect to the memif memif_id listening on socket_filename. Each of the
+   * num_queues queues is served by its own thread.
+   */
+  void connect(uint32_t memif_id, long memif_mode,
+               const std::string &socket_filename = MEMIF_DEFAULT_SOCKET,
+               std::uint16_t num_queues = 1);
 
   TRANSPORT_ALWAYS_INLINE uint32_t getMemifId() { return memif_id_; };
 
+  std::uint16_t getQueueNumber() { return std::uint16_t(queues_.size()); }
+
  private:
   void init();
 
-  int doSend();
+  int doSend(Queue &queue);
+
+  void scheduleSend(Queue &queue);
 
   int createMemif(uint32_t index, uint8_t mode, char *s);
 
@@ -87,39 +102,38 @@ class MemifConnector : public Connector {
   static int onInterrupt(memif_conn_handle_t conn, void *private_ctx,
                          uint16_t qid);
 
-  void threadMain();
+  void threadMain(Queue &queue);
+
+  int txBurst(Queue &queue);
 
-  int txBurst(uint16_t qid);
+  int bufferAlloc(Queue &queue, long n);
 
-  int bufferAlloc(long n, uint16_t qid);
+  Queue &selectQueue(Packet &packet);
 
-  void sendCallback(const std::error_code &ec);
+  void sendCallback(Queue &queue, const std::error_code &ec);
 
-  void processInputBuffer(std::uint16_t total_packets);
+  void processInputBuffer(Queue &queue, std::uint16_t total_packets);
+
+  void setState(State state);
 
  private:
   static utils::EpollEventReactor main_event_reactor_;
-  static std::unique_ptr<std::thread> main_worker_;
-
-  int epfd;
-  std::unique_ptr<std::thread> memif_worker_;
-  utils::EpollEventReactor event_reactor_;
-  std::atomic_bool timer_set_;
-  std::unique_ptr<utils::FdDeadlineTimer> send_timer_;
-  std::unique_ptr<utils::FdDeadlineTimer> disconnect_timer_;
+  static std::mutex main_event_reactor_mutex_;
+
+  std::vector<std::unique_ptr<Queue>> queues_;
   asio::io_service &io_service_;
   std::unique_ptr<asio::io_service::work> work_;
   std::unique_ptr<memif_connection_t> memif_connection_;
-  uint16_t tx_buf_counter_;
 
-  PacketRing input_buffer_;
+  // Signals the state changes made by the thread running the main reactor
+  std::mutex state_mutex_;
+  std::condition_variable state_cv_;
+
   bool is_reconnection_;
   bool data_available_;
   uint32_t memif_id_;
   uint8_t memif_mode_;
   std::string app_name_;
-  uint16_t transmission_index_;
-  utils::SpinLock write_msgs_lock_;
   std::string socket_filename_;
 
   static std::once_flag flag_;
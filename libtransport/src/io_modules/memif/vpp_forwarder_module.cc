@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <core/global_configuration.h>
 #include <hicn/transport/config.h>
 #include <hicn/transport/errors/not_implemented_exception.h>
 #include <io_modules/memif/hicn_vapi.h>
@@ -27,23 +28,49 @@ extern "C" {
 typedef enum { MASTER = 0, SLAVE = 1 } memif_role_t;
 
 #define MEMIF_DEFAULT_RING_SIZE 2048
-#define MEMIF_DEFAULT_RX_QUEUES 1
-#define MEMIF_DEFAULT_TX_QUEUES 1
+#define MEMIF_DEFAULT_QUEUES 1
 #define MEMIF_DEFAULT_BUFFER_SIZE 2048
 
 namespace transport {
 
 namespace core {
 
+constexpr char VPPForwarderModule::memif_config_section[];
+
 VPPForwarderModule::VPPForwarderModule()
     : IoModule(),
       connector_(nullptr),
       sw_if_index_(~0),
       face_id1_(~0),
       face_id2_(~0),
-      is_consumer_(false) {}
+      is_consumer_(false),
+      num_queues_(MEMIF_DEFAULT_QUEUES) {
+  using namespace std::placeholders;
+  GlobalConfiguration::getInstance().registerConfigurationParser(
+      memif_config_section,
+      std::bind(&VPPForwarderModule::parseMemifConfiguration, this, _1, _2));
+}
+
+VPPForwarderModule::~VPPForwarderModule() {
+  GlobalConfiguration::getInstance().unregisterConfigurationParser(
+      memif_config_section);
+  delete connector_;
+}
+
+void VPPForwarderModule::parseMemifConfiguration(
+    const libconfig::Setting &memif_config, std::error_code &ec) {
+  int queues = num_queues_;
 
-VPPForwarderModule::~VPPForwarderModule() { delete connector_; }
+  if (memif_config.lookupValue("queues", queues)) {
+    if (queues < 1 || queues > 255) {
+      TRANSPORT_LOGE("Invalid number of memif queues: %d", queues);
+    } else {
+      num_queues_ = std::uint16_t(queues);
+    }
+  }
+
+  TRANSPORT_LOGD("memif queues: %u", num_queues_);
+}
 
 void VPPForwarderModule::init(
     Connector::PacketReceivedCallback &&receive_callback,
@@ -98,8 +125,8 @@ uint32_t VPPForwarderModule::getMemifConfiguration() {
   input_params.id = memif_id_;
   input_params.role = memif_role_t::MASTER;
   input_params.mode = memif_interface_mode_t::MEMIF_INTERFACE_MODE_IP;
-  input_params.rx_queues = MEMIF_DEFAULT_RX_QUEUES;
-  input_params.tx_queues = MEMIF_DEFAULT_TX_QUEUES;
+  input_params.rx_queues = uint8_t(num_queues_);
+  input_params.tx_queues = uint8_t(num_queues_);
   input_params.ring_size = MEMIF_DEFAULT_RING_SIZE;
   input_params.buffer_size = MEMIF_DEFAULT_BUFFER_SIZE;
 
@@ -171,7 +198,7 @@ void VPPForwarderModule::connect(bool is_consumer) {
     consumerConnection();
   }
 
-  connector_->connect(memif_id_, 0);
+  connector_->connect(memif_id_, 0, MEMIF_DEFAULT_SOCKET, num_queues_);
   connector_->setRole(is_consumer_ ? Connector::Role::CONSUMER
                                    : Connector::Role::PRODUCER);
 }
@@ -18,6 +18,8 @@
 #include <hicn/transport/core/io_module.h>
 #include <hicn/transport/core/prefix.h>
 
+#include <libconfig.h++>
+
 #ifdef always_inline
 #undef always_inline
 #endif
@@ -31,8 +33,16 @@ namespace core {
 
 class MemifConnector;
 
+/**
+ * The memif can be tuned in the "memif" section of the configuration file:
+ *
+ *   memif = {
+ *     queues = 2;  // queue pairs, each served by its own thread
+ *   };
+ */
 class VPPForwarderModule : public IoModule {
   static constexpr std::uint16_t interface_mtu = 1500;
+  static constexpr char memif_config_section[] = "memif";
 
  public:
   VPPForwarderModule();
@@ -64,6 +74,8 @@ class VPPForwarderModule : public IoModule {
   uint32_t getMemifConfiguration();
   void consumerConnection();
   void producerConnection();
+  void parseMemifConfiguration(const libconfig::Setting &memif_config,
+                               std::error_code &ec);
 
  private:
   MemifConnector *connector_;
@@ -73,6 +85,7 @@ class VPPForwarderModule : public IoModule {
   uint32_t face_id1_;
   uint32_t face_id2_;
   bool is_consumer_;
+  std::uint16_t num_queues_;
   vapi_ctx_t sock_;
 };
 
@@ -23,8 +23,6 @@ namespace protocol {
 
 void IncrementalIndexer::onContentObject(core::Interest &interest,
                                          core::ContentObject &content_object) {
-  using namespace interface;
-
   TRANSPORT_LOGD("Received content %s",
                  content_object.getName().toString().c_str());
 
@@ -32,9 +30,35 @@ void IncrementalIndexer::onContentObject(core::Interest &interest,
     final_suffix_ = content_object.getName().getSuffix();
   }
 
-  auto ret = verifier_->verifyPackets(&content_object);
+  VerificationPool *verification_pool =
+      transport_protocol_->getVerificationPool();
+
+  if (verification_pool) {
+    std::weak_ptr<bool> token = verification_token_;
+    core::Interest::Ptr interest_ptr = interest.shared_from_this();
+    core::ContentObject::Ptr content_ptr = content_object.shared_from_this();
+
+    verification_pool->verifySignatures(
+        verifier_, {content_ptr},
+        [this, token, interest_ptr,
+         content_ptr](std::vector<auth::VerificationPolicy> &policies) {
+          if (!token.expired()) {
+            applyPolicy(*interest_ptr, *content_ptr, policies.front());
+          }
+        });
+    return;
+  }
+
+  applyPolicy(interest, content_object,
+              verifier_->verifyPackets(&content_object));
+}
+
+void IncrementalIndexer::applyPolicy(core::Interest &interest,
+                                     core::ContentObject &content_object,
+                                     auth::VerificationPolicy policy) {
+  using namespace interface;
 
-  switch (ret) {
+  switch (policy) {
     case auth::VerificationPolicy::ACCEPT: {
       reassembly_->reassemble(content_object);
       break;
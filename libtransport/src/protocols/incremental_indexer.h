@@ -22,6 +22,7 @@
 #include <implementation/socket_consumer.h>
 #include <protocols/indexer.h>
 #include <protocols/reassembly.h>
+#include <protocols/verification_pool.h>
 
 #include <deque>
 
@@ -47,7 +48,8 @@ class IncrementalIndexer : public Indexer {
         first_suffix_(0),
         next_download_suffix_(0),
         next_reassembly_suffix_(0),
-        verifier_(nullptr) {
+        verifier_(nullptr),
+        verification_token_(std::make_shared<bool>(true)) {
     if (reassembly_) {
       reassembly_->setIndexer(this);
     }
@@ -65,7 +67,8 @@ class IncrementalIndexer : public Indexer {
         first_suffix_(other.first_suffix_),
         next_download_suffix_(other.next_download_suffix_),
         next_reassembly_suffix_(other.next_reassembly_suffix_),
-        verifier_(nullptr) {
+        verifier_(nullptr),
+        verification_token_(std::make_shared<bool>(true)) {
     if (reassembly_) {
       reassembly_->setIndexer(this);
     }
@@ -80,6 +83,8 @@ class IncrementalIndexer : public Indexer {
     final_suffix_ = std::numeric_limits<uint32_t>::max();
     next_download_suffix_ = offset;
     next_reassembly_suffix_ = offset;
+    // Drop the results of the verifications still running on the pool
+    verification_token_ = std::make_shared<bool>(true);
   }
 
   /**
@@ -124,6 +129,10 @@ class IncrementalIndexer : public Indexer {
   }
 
  protected:
+  virtual void applyPolicy(core::Interest &interest,
+                           core::ContentObject &content_object,
+                           auth::VerificationPolicy policy);
+
   implementation::ConsumerSocket *socket_;
   Reassembly *reassembly_;
   TransportProtocol *transport_protocol_;
@@ -132,6 +141,9 @@ class IncrementalIndexer : public Indexer {
   uint32_t next_download_suffix_;
   uint32_t next_reassembly_suffix_;
   std::shared_ptr<auth::Verifier> verifier_;
+  // Results coming back from the verification pool are only applied if the
+  // token they captured is still alive.
+  std::shared_ptr<bool> verification_token_;
 };
 
 }  // namespace protocol
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2017-2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <hicn/transport/utils/chrono_typedefs.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace transport {
+
+namespace protocol {
+
+/**
+ * Token bucket releasing interests at gain * window / min RTT. The gain
+ * follows a BBR-style cycle, one phase per min RTT: probe for more bandwidth,
+ * drain the queue built by the probe, then cruise for six RTTs.
+ *
+ * Times are in microseconds, rates in interests per microsecond.
+ */
+class InterestPacer {
+ public:
+  static constexpr std::size_t gain_cycle_length = 8;
+
+  // Minimum time between two batches of paced interests
+  static constexpr double min_interval = 100;
+
+  InterestPacer() { reset(utils::SteadyClock::now()); }
+
+  void reset(const utils::TimePoint &now) {
+    tokens_ = 0;
+    rate_ = 0;
+    last_update_ = now;
+    gain_index_ = 0;
+    gain_start_ = now;
+  }
+
+  /**
+   * Advance the gain cycle and earn tokens for the time elapsed since the
+   * last update. At most two batches worth of tokens are kept, to avoid
+   * bursts after an idle period. Returns the current rate.
+   */
+  double update(const utils::TimePoint &now, double window, double min_rtt) {
+    min_rtt = std::max(min_rtt, 1.);
+
+    if (elapsed(gain_start_, now) >= min_rtt) {
+      gain_index_ = (gain_index_ + 1) % gain_cycle_length;
+      gain_start_ = now;
+    }
+
+    rate_ = getGain() * window / min_rtt;
+    tokens_ = std::min(tokens_ + elapsed(last_update_, now) * rate_,
+                       std::max(1., 2 * min_interval * rate_));
+    last_update_ = now;
+
+    return rate_;
+  }
+
+  // Take one token, if any
+  bool consume() {
+    if (tokens_ < 1) {
+      return false;
+    }
+
+    tokens_ -= 1;
+    return true;
+  }
+
+  // Time until the next interest (or batch) can leave
+  double getWaitTime() const {
+    if (rate_ <= 0) {
+      return min_interval;
+    }
+
+    return std::max((1 - tokens_) / rate_, double(min_interval));
+  }
+
+  // While probing, allow up to gain * window interests in flight
+  double getMaxInFlight(double window) const {
+    return std::max(getGain(), 1.) * window;
+  }
+
+  double getGain() const {
+    static constexpr double gain_cycle[gain_cycle_length] = {1.25, 0.75, 1, 1,
+                                                             1,    1,    1, 1};
+    return gain_cycle[gain_index_];
+  }
+
+  std::size_t getGainPhase() const { return gain_index_; }
+
+  double getRate() const { return rate_; }
+
+  double getTokens() const { return tokens_; }
+
+ private:
+  static double elapsed(const utils::TimePoint &from,
+                        const utils::TimePoint &to) {
+    return double(
+        std::chrono::duration_cast<utils::Microseconds>(to - from).count());
+  }
+
+  double tokens_;
+  double rate_;
+  utils::TimePoint last_update_;
+  std::size_t gain_index_;
+  utils::TimePoint gain_start_;
+};
+
+}  // end namespace protocol
+
+}  // end namespace transport
@@ -61,8 +61,36 @@ void ManifestIncrementalIndexer::onUntrustedManifest(
   auto manifest =
       std::make_unique<ContentObjectManifest>(std::move(content_object));
 
+  VerificationPool *verification_pool =
+      transport_protocol_->getVerificationPool();
+
+  if (verification_pool) {
+    // Verification callbacks must be copyable: the manifest travels in a
+    // shared holder until it is handed back to the portal thread.
+    auto holder = std::make_shared<std::unique_ptr<ContentObjectManifest>>(
+        std::move(manifest));
+    std::weak_ptr<bool> token = verification_token_;
+    core::Interest::Ptr interest_ptr = interest.shared_from_this();
+
+    verification_pool->verifySignatures(
+        verifier_, {core::Packet::Ptr(holder, holder->get())},
+        [this, token, interest_ptr,
+         holder](std::vector<auth::VerificationPolicy> &policies) {
+          if (!token.expired()) {
+            onManifestVerified(*interest_ptr, std::move(*holder),
+                               policies.front());
+          }
+        });
+    return;
+  }
+
   auth::VerificationPolicy policy = verifier_->verifyPackets(manifest.get());
+  onManifestVerified(interest, std::move(manifest), policy);
+}
 
+void ManifestIncrementalIndexer::onManifestVerified(
+    core::Interest &interest, std::unique_ptr<ContentObjectManifest> manifest,
+    auth::VerificationPolicy policy) {
   manifest->decode();
 
   if (policy != auth::VerificationPolicy::ACCEPT) {
@@ -86,39 +114,62 @@ void ManifestIncrementalIndexer::processTrustedManifest(
       suffix_strategy_->setFinalSuffix(manifest->getFinalBlockNumber());
 
       // The packets to verify with the received manifest
-      std::vector<auth::PacketPtr> packets;
-
-      // Convert the received manifest to a map of packet suffixes to hashes
-      std::unordered_map<auth::Suffix, auth::HashEntry> current_manifest =
-          core::ContentObjectManifest::getSuffixMap(manifest.get());
-
-      // Update 'suffix_map_' with new hashes from the received manifest and
-      // build 'packets'
-      for (auto it = current_manifest.begin(); it != current_manifest.end();) {
-        if (unverified_segments_.find(it->first) ==
-            unverified_segments_.end()) {
-          suffix_map_[it->first] = std::move(it->second);
-          current_manifest.erase(it++);
+      std::vector<InterestContentPair> segments;
+      VerificationPool::Packets packets;
+      auth::SuffixHashes segment_hashes;
+
+      // Read the manifest entries in place: hashes of segments not received
+      // yet go to 'suffix_hashes_', the others are checked right away
+      auth::CryptoHashType hash_type = manifest->getHashAlgorithm();
+      for (const auto &entry : manifest->getSuffixList()) {
+        auto segment = unverified_segments_.find(entry.getSuffix());
+        if (segment == unverified_segments_.end()) {
+          suffix_hashes_.add(entry.getSuffix(), hash_type, entry.getHash());
           continue;
         }
 
-        packets.push_back(unverified_segments_[it->first].second.get());
-        it++;
+        segment_hashes.add(entry.getSuffix(), hash_type, entry.getHash());
+        segments.push_back(std::move(segment->second));
+        packets.push_back(segments.back().second);
+        unverified_segments_.erase(segment);
       }
 
-      // Verify unverified segments using the received manifest
-      std::vector<auth::VerificationPolicy> policies =
-          verifier_->verifyPackets(packets, current_manifest);
+      suffix_hashes_.sort();
+      segment_hashes.sort();
+
+      VerificationPool *verification_pool =
+          transport_protocol_->getVerificationPool();
+
+      if (verification_pool && !packets.empty()) {
+        // Check all the segments in one batch on the pool
+        std::weak_ptr<bool> token = verification_token_;
+
+        verification_pool->verifyHashes(
+            verifier_, std::move(packets), std::move(segment_hashes),
+            [this, token,
+             segments](std::vector<auth::VerificationPolicy> &policies) {
+              if (token.expired()) {
+                return;
+              }
+
+              for (unsigned int i = 0; i < segments.size(); ++i) {
+                applyPolicy(*segments[i].first, *segments[i].second,
+                            policies[i]);
+              }
+            });
+      } else if (!packets.empty()) {
+        // Verify unverified segments using the received manifest
+        std::vector<auth::PacketPtr> raw_packets;
+        for (auto &packet : packets) {
+          raw_packets.push_back(packet.get());
+        }
 
-      for (unsigned int i = 0; i < packets.size(); ++i) {
-        auth::Suffix suffix = packets[i]->getName().getSuffix();
+        std::vector<auth::VerificationPolicy> policies =
+            verifier_->verifyPackets(raw_packets, segment_hashes);
 
-        if (policies[i] != auth::VerificationPolicy::UNKNOWN) {
-          unverified_segments_.erase(suffix);
+        for (unsigned int i = 0; i < segments.size(); ++i) {
+          applyPolicy(*segments[i].first, *segments[i].second, policies[i]);
         }
-
-        applyPolicy(*unverified_segments_[suffix].first,
-                    *unverified_segments_[suffix].second, policies[i]);
       }
 
       reassembly_->reassemble(std::move(manifest));
@@ -136,8 +187,35 @@ void ManifestIncrementalIndexer::processTrustedManifest(
 void ManifestIncrementalIndexer::onUntrustedContentObject(
     Interest &interest, ContentObject &content_object) {
   auth::Suffix suffix = content_object.getName().getSuffix();
+
+  VerificationPool *verification_pool =
+      transport_protocol_->getVerificationPool();
+  const auth::SuffixHashes::Entry *entry = suffix_hashes_.find(suffix);
+
+  if (verification_pool && entry) {
+    // The manifest is already there: hash the segment on the pool too
+    auth::SuffixHashes segment_hashes;
+    segment_hashes.add(suffix, entry->type, entry->digest);
+    segment_hashes.sort();
+    suffix_hashes_.erase(suffix);
+
+    std::weak_ptr<bool> token = verification_token_;
+    InterestContentPair segment(interest.shared_from_this(),
+                                content_object.shared_from_this());
+
+    verification_pool->verifyHashes(
+        verifier_, {segment.second}, std::move(segment_hashes),
+        [this, token,
+         segment](std::vector<auth::VerificationPolicy> &policies) {
+          if (!token.expired()) {
+            applyPolicy(*segment.first, *segment.second, policies.front());
+          }
+        });
+    return;
+  }
+
   auth::VerificationPolicy policy =
-      verifier_->verifyPackets(&content_object, suffix_map_);
+      verifier_->verifyPackets(&content_object, suffix_hashes_);
 
   switch (policy) {
     case auth::VerificationPolicy::UNKNOWN: {
@@ -146,7 +224,7 @@ void ManifestIncrementalIndexer::onUntrustedContentObject(
       break;
     }
     default: {
-      suffix_map_.erase(suffix);
+      suffix_hashes_.erase(suffix);
       break;
     }
   }
@@ -209,7 +287,7 @@ uint32_t ManifestIncrementalIndexer::getNextReassemblySegment() {
 
 void ManifestIncrementalIndexer::reset(std::uint32_t offset) {
   IncrementalIndexer::reset(offset);
-  suffix_map_.clear();
+  suffix_hashes_.clear();
   unverified_segments_.clear();
   SuffixQueue empty;
   std::swap(suffix_queue_, empty);
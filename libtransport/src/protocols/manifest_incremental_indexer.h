@@ -16,6 +16,7 @@
 #pragma once
 
 #include <hicn/transport/auth/common.h>
+#include <hicn/transport/auth/suffix_hashes.h>
 #include <implementation/socket.h>
 #include <protocols/incremental_indexer.h>
 #include <utils/suffix_strategy.h>
@@ -67,19 +68,23 @@ class ManifestIncrementalIndexer : public IncrementalIndexer {
   SuffixQueue suffix_queue_;
 
   // Hash verification
-  std::unordered_map<auth::Suffix, auth::HashEntry> suffix_map_;
+  auth::SuffixHashes suffix_hashes_;
   std::unordered_map<auth::Suffix, InterestContentPair> unverified_segments_;
 
+  void applyPolicy(core::Interest &interest,
+                   core::ContentObject &content_object,
+                   auth::VerificationPolicy policy) override;
+
  private:
   void onUntrustedManifest(core::Interest &interest,
                            core::ContentObject &content_object);
+  void onManifestVerified(core::Interest &interest,
+                          std::unique_ptr<ContentObjectManifest> manifest,
+                          auth::VerificationPolicy policy);
   void processTrustedManifest(core::Interest &interest,
                               std::unique_ptr<ContentObjectManifest> manifest);
   void onUntrustedContentObject(core::Interest &interest,
                                 core::ContentObject &content_object);
-  void applyPolicy(core::Interest &interest,
-                   core::ContentObject &content_object,
-                   auth::VerificationPolicy policy);
 };
 
 }  // end namespace protocol
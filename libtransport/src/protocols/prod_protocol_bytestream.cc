@@ -102,6 +102,12 @@ uint32_t ByteStreamProductionProtocol::produceStream(
   std::shared_ptr<auth::Signer> signer;
   socket_->getSocketOption(GeneralTransportOptions::SIGNER, signer);
 
+  // Number of threads used to sign or hash packets. 0 means inline.
+  uint32_t signing_threads;
+  socket_->getSocketOption(GeneralTransportOptions::SIGNING_THREADS,
+                           signing_threads);
+  updateSigningStage(signing_threads);
+
   auto buffer_size = buffer->length();
   int bytes_segmented = 0;
   std::size_t header_size;
@@ -179,8 +185,9 @@ uint32_t ByteStreamProductionProtocol::produceStream(
   for (unsigned int packaged_segments = 0;
        packaged_segments < number_of_segments; packaged_segments++) {
     if (making_manifest) {
-      if (manifest->estimateManifestSize(2) >
+      if (manifest->estimateManifestSize(content_queue_.size() + 2) >
           data_packet_size - manifest_header_size) {
+        addContentHashesToManifest(*manifest, hash_algo);
         manifest->encode();
 
         // If identity set, sign manifest
@@ -195,12 +202,7 @@ uint32_t ByteStreamProductionProtocol::produceStream(
                        manifest->getName().toString().c_str());
 
         // Send content objects stored in the queue
-        while (!content_queue_.empty()) {
-          passContentObjectToCallbacks(content_queue_.front());
-          TRANSPORT_LOGD("Send content %s",
-                         content_queue_.front()->getName().toString().c_str());
-          content_queue_.pop();
-        }
+        flushContentQueue();
 
         // Create new manifest. The reference to the last manifest has been
         // acquired in the passContentObjectToCallbacks function, so we can
@@ -246,10 +248,15 @@ uint32_t ByteStreamProductionProtocol::produceStream(
     content_object->appendPayload(std::move(b));
 
     if (making_manifest) {
-      using namespace std::chrono_literals;
-      auth::CryptoHash hash = content_object->computeDigest(hash_algo);
-      manifest->addSuffixHash(content_suffix, hash);
-      content_queue_.push(content_object);
+      // The digest is computed when the manifest is complete, so that the
+      // whole manifest worth of segments is hashed in one batch.
+      content_queue_.push_back(content_object);
+    } else if (signer && signing_stage_) {
+      content_queue_.push_back(content_object);
+      if (content_queue_.size() >= burst_size) {
+        signing_stage_->signBatch(*signer, content_queue_);
+        flushContentQueue();
+      }
     } else {
       if (signer) {
         signer->signPacket(content_object.get());
@@ -260,11 +267,17 @@ uint32_t ByteStreamProductionProtocol::produceStream(
     }
   }
 
+  if (!making_manifest && !content_queue_.empty()) {
+    signing_stage_->signBatch(*signer, content_queue_);
+    flushContentQueue();
+  }
+
   if (making_manifest) {
     if (is_last_manifest) {
       manifest->setFinalManifest(is_last_manifest);
     }
 
+    addContentHashesToManifest(*manifest, hash_algo);
     manifest->encode();
 
     if (signer) {
@@ -274,12 +287,7 @@ uint32_t ByteStreamProductionProtocol::produceStream(
     passContentObjectToCallbacks(manifest);
     TRANSPORT_LOGD("Send manifest %s", manifest->getName().toString().c_str());
 
-    while (!content_queue_.empty()) {
-      passContentObjectToCallbacks(content_queue_.front());
-      TRANSPORT_LOGD("Send content %s",
-                     content_queue_.front()->getName().toString().c_str());
-      content_queue_.pop();
-    }
+    flushContentQueue();
   }
 
   portal_->getIoService().post([this]() {
@@ -344,6 +352,48 @@ void ByteStreamProductionProtocol::scheduleSendBurst() {
   });
 }
 
+void ByteStreamProductionProtocol::updateSigningStage(uint32_t n_threads) {
+  if (!n_threads) {
+    signing_stage_.reset();
+  } else if (!signing_stage_ ||
+             signing_stage_->getThreadNumber() != n_threads) {
+    signing_stage_ = std::make_unique<SigningStage>(n_threads);
+  }
+}
+
+void ByteStreamProductionProtocol::addContentHashesToManifest(
+    ContentObjectManifest &manifest, auth::CryptoHashType hash_algo) {
+  std::vector<auth::CryptoHash> digests;
+
+  if (signing_stage_) {
+    signing_stage_->hashBatch(hash_algo, content_queue_, digests);
+  } else {
+    std::vector<core::Packet *> packets;
+    packets.reserve(content_queue_.size());
+    for (auto &content_object : content_queue_) {
+      packets.push_back(content_object.get());
+    }
+
+    digests =
+        core::Packet::computeDigests(hash_algo, packets.data(), packets.size());
+  }
+
+  for (std::size_t i = 0; i < content_queue_.size(); i++) {
+    manifest.addSuffixHash(content_queue_[i]->getName().getSuffix(),
+                           digests[i]);
+  }
+}
+
+void ByteStreamProductionProtocol::flushContentQueue() {
+  for (auto &content_object : content_queue_) {
+    passContentObjectToCallbacks(content_object);
+    TRANSPORT_LOGD("Send content %s",
+                   content_object->getName().toString().c_str());
+  }
+
+  content_queue_.clear();
+}
+
 void ByteStreamProductionProtocol::passContentObjectToCallbacks(
     const std::shared_ptr<ContentObject> &content_object) {
   output_buffer_.insert(content_object);
@@ -17,9 +17,11 @@
 
 #include <hicn/transport/utils/ring_buffer.h>
 #include <protocols/production_protocol.h>
+#include <protocols/signing_stage.h>
 
 #include <atomic>
-#include <queue>
+#include <memory>
+#include <vector>
 
 namespace transport {
 
@@ -60,10 +62,16 @@ class ByteStreamProductionProtocol : public ProductionProtocol {
   void passContentObjectToCallbacks(
       const std::shared_ptr<ContentObject> &content_object);
   void scheduleSendBurst();
+  void updateSigningStage(uint32_t n_threads);
+  void addContentHashesToManifest(ContentObjectManifest &manifest,
+                                  auth::CryptoHashType hash_algo);
+  void flushContentQueue();
 
  private:
-  // While manifests are being built, contents are stored in a queue
-  std::queue<std::shared_ptr<ContentObject>> content_queue_;
+  // While manifests are being built, or while a batch of packets waits to be
+  // signed, contents are stored in a queue
+  std::vector<std::shared_ptr<ContentObject>> content_queue_;
+  std::unique_ptr<SigningStage> signing_stage_;
   utils::CircularFifo<std::shared_ptr<ContentObject>, 2048>
       object_queue_for_callbacks_;
 };
@@ -37,7 +37,11 @@ RaaqmTransportProtocol::RaaqmTransportProtocol(
       cur_path_(nullptr),
       t0_(utils::SteadyClock::now()),
       rate_estimator_(nullptr),
-      schedule_interests_(true) {
+      schedule_interests_(true),
+      pacing_(default_values::interest_pacing),
+      pacing_timer_(
+          std::make_unique<asio::steady_timer>(portal_->getIoService())),
+      pacing_timer_on_(false) {
   init();
 }
 
@@ -95,6 +99,8 @@ int RaaqmTransportProtocol::start() {
     path_table_[default_values::path_id] = std::move(cur_path);
   }
 
+  socket_->getSocketOption(RaaqmTransportOptions::INTEREST_PACING, pacing_);
+
   portal_->setConsumerCallback(this);
   return TransportProtocol::start();
 }
@@ -118,6 +124,11 @@ void RaaqmTransportProtocol::reset() {
   interests_in_flight_ = 0;
   t0_ = utils::SteadyClock::now();
 
+  // Reset pacing
+  pacing_timer_->cancel();
+  pacing_timer_on_ = false;
+  pacer_.reset(t0_);
+
   // Optionally reset congestion window
   bool reset_window;
   socket_->getSocketOption(RaaqmTransportOptions::PER_SESSION_CWINDOW_RESET,
@@ -465,29 +476,79 @@ void RaaqmTransportProtocol::scheduleNextInterests() {
     interest_to_retransmit_.pop();
   }
 
-  uint32_t index = IndexManager::invalid_index;
+  // Pace interests once the path RTT is known
+  if (pacing_ && cur_path_ && cur_path_->getRttQueueSize()) {
+    schedulePacedInterests();
+    return;
+  }
 
   // Send the interest needed for filling the window
-  while (interests_in_flight_ < current_window_size_) {
-    if (interest_to_retransmit_.size() > 0) {
-      sendInterest(std::move(interest_to_retransmit_.front()));
-      interest_to_retransmit_.pop();
-    } else {
-      if (TRANSPORT_EXPECT_FALSE(!is_running_ && !is_first_)) {
-        TRANSPORT_LOGI("Adios");
-        break;
-      }
+  bool more = true;
+  while (more && interests_in_flight_ < current_window_size_) {
+    sendNextInterest(more);
+  }
+}
 
-      index = index_manager_->getNextSuffix();
-      if (index == IndexManager::invalid_index) {
-        break;
-      }
+void RaaqmTransportProtocol::schedulePacedInterests() {
+  if (pacing_timer_on_) {
+    // Wait for the next batch
+    return;
+  }
+
+  double rate = pacer_.update(utils::SteadyClock::now(), current_window_size_,
+                              cur_path_->getRttMin());
+  stats_->updatePacingRate(rate * 1e6);
+
+  // The portal has no batch send: paced interests still leave one by one,
+  // the pacer only decides how many go in each batch.
+  double max_in_flight = pacer_.getMaxInFlight(current_window_size_);
+
+  bool more = true;
+  while (more && interests_in_flight_ < max_in_flight) {
+    if (pacer_.getTokens() < 1) {
+      // Come back when the next interest (or batch) can leave
+      pacing_timer_on_ = true;
+      pacing_timer_->expires_from_now(
+          utils::Microseconds(static_cast<int64_t>(pacer_.getWaitTime())));
+      pacing_timer_->async_wait([this](std::error_code ec) {
+        if (ec) return;
+        if (!pacing_timer_on_) return;
+
+        pacing_timer_on_ = false;
+        scheduleNextInterests();
+      });
+      break;
+    }
 
-      sendInterest(index);
+    sendNextInterest(more);
+    if (more) {
+      pacer_.consume();
     }
   }
 }
 
+void RaaqmTransportProtocol::sendNextInterest(bool &more) {
+  if (interest_to_retransmit_.size() > 0) {
+    sendInterest(std::move(interest_to_retransmit_.front()));
+    interest_to_retransmit_.pop();
+    return;
+  }
+
+  if (TRANSPORT_EXPECT_FALSE(!is_running_ && !is_first_)) {
+    TRANSPORT_LOGI("Adios");
+    more = false;
+    return;
+  }
+
+  uint32_t index = index_manager_->getNextSuffix();
+  if (index == IndexManager::invalid_index) {
+    more = false;
+    return;
+  }
+
+  sendInterest(index);
+}
+
 void RaaqmTransportProtocol::sendInterest(std::uint64_t next_suffix) {
   auto interest = core::PacketManager<>::getInstance().getPacket<Interest>();
   core::Name *name;
@@ -523,6 +584,8 @@ void RaaqmTransportProtocol::onContentReassembled(std::error_code ec) {
   rate_estimator_->onDownloadFinished();
   TransportProtocol::onContentReassembled(ec);
   schedule_interests_ = false;
+  pacing_timer_->cancel();
+  pacing_timer_on_ = false;
 }
 
 void RaaqmTransportProtocol::updateRtt(uint64_t segment) {
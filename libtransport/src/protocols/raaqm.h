@@ -18,10 +18,12 @@
 #include <hicn/transport/utils/chrono_typedefs.h>
 #include <protocols/byte_stream_reassembly.h>
 #include <protocols/congestion_window_protocol.h>
+#include <protocols/interest_pacer.h>
 #include <protocols/raaqm_data_path.h>
 #include <protocols/rate_estimation.h>
 #include <protocols/transport_protocol.h>
 
+#include <asio/steady_timer.hpp>
 #include <queue>
 #include <vector>
 
@@ -75,6 +77,10 @@ class RaaqmTransportProtocol : public TransportProtocol,
 
   virtual void scheduleNextInterests() override;
 
+  void schedulePacedInterests();
+
+  void sendNextInterest(bool &more);
+
   void sendInterest(std::uint64_t next_suffix);
 
   void sendInterest(Interest::Ptr &&interest);
@@ -133,6 +139,13 @@ class RaaqmTransportProtocol : public TransportProtocol,
   unsigned int lte_delay_;
 
   bool schedule_interests_;
+
+  // Interest pacing: interests leave at gain * window / min RTT, in small
+  // batches released by a high-resolution timer.
+  bool pacing_;
+  std::unique_ptr<asio::steady_timer> pacing_timer_;
+  bool pacing_timer_on_;
+  InterestPacer pacer_;
 };
 
 }  // end namespace protocol
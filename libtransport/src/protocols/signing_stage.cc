@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <protocols/signing_stage.h>
+
+namespace transport {
+
+namespace protocol {
+
+SigningStage::SigningStage(std::size_t n_threads) : workers_(n_threads) {}
+
+void SigningStage::signBatch(auth::Signer &signer,
+                             const std::vector<ContentObjectPtr> &batch) {
+  if (!signer.supportsConcurrentSigning()) {
+    // The key of HMAC signers is bound to the PARC hasher, which cannot be
+    // shared across threads.
+    for (auto &content_object : batch) {
+      signer.signPacket(content_object.get());
+    }
+
+    return;
+  }
+
+  auth::CryptoHashType hash_type = signer.getCryptoHashType();
+  workers_.parallelFor(batch.size(), [&](std::size_t begin, std::size_t end) {
+    auth::CryptoHasher hasher(hash_type);
+    for (std::size_t i = begin; i < end; i++) {
+      signer.signPacket(batch[i].get(), hasher);
+    }
+  });
+}
+
+void SigningStage::hashBatch(auth::CryptoHashType hash_type,
+                             const std::vector<ContentObjectPtr> &batch,
+                             std::vector<auth::CryptoHash> &digests) {
+  digests.resize(batch.size());
+  workers_.parallelFor(batch.size(), [&](std::size_t begin, std::size_t end) {
+    // Each worker hashes its range with the multi-buffer hasher
+    std::vector<core::Packet *> packets;
+    packets.reserve(end - begin);
+    for (std::size_t i = begin; i < end; i++) {
+      packets.push_back(batch[i].get());
+    }
+
+    auto chunk_digests = core::Packet::computeDigests(
+        hash_type, packets.data(), packets.size());
+    for (std::size_t i = begin; i < end; i++) {
+      digests[i] = chunk_digests[i - begin];
+    }
+  });
+}
+
+}  // end namespace protocol
+
+}  // end namespace transport
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <hicn/transport/auth/signer.h>
+#include <hicn/transport/core/content_object.h>
+#include <utils/worker_pool.h>
+
+#include <memory>
+#include <vector>
+
+namespace transport {
+
+namespace protocol {
+
+/**
+ * Signing stage of the producer pipeline. Batches of packets are signed (or
+ * hashed, when only manifests carry a signature) on a pool of worker threads.
+ * Every call blocks until the whole batch has been processed, so the caller
+ * keeps emitting packets in their original order.
+ */
+class SigningStage {
+ public:
+  using ContentObjectPtr = std::shared_ptr<core::ContentObject>;
+
+  SigningStage(std::size_t n_threads);
+
+  std::size_t getThreadNumber() const { return workers_.size(); }
+
+  // Sign all the packets of the batch in place.
+  void signBatch(auth::Signer &signer,
+                 const std::vector<ContentObjectPtr> &batch);
+
+  // Compute the digest of every packet of the batch. digests[i] is the digest
+  // of batch[i].
+  void hashBatch(auth::CryptoHashType hash_type,
+                 const std::vector<ContentObjectPtr> &batch,
+                 std::vector<auth::CryptoHash> &digests);
+
+ private:
+  utils::WorkerPool workers_;
+};
+
+}  // end namespace protocol
+
+}  // end namespace transport
@@ -64,6 +64,18 @@ int TransportProtocol::start() {
 
   socket_->getSocketOption(GeneralTransportOptions::ASYNC_MODE, is_async_);
 
+  // (Re)create the verification pool if the number of threads changed
+  uint32_t verification_threads = 0;
+  socket_->getSocketOption(GeneralTransportOptions::VERIFICATION_THREADS,
+                           verification_threads);
+  if (verification_threads == 0) {
+    verification_pool_.reset();
+  } else if (!verification_pool_ ||
+             verification_pool_->getThreadNumber() != verification_threads) {
+    verification_pool_ = std::make_shared<VerificationPool>(
+        verification_threads, portal_->getIoService(), stats_);
+  }
+
   // Set it is the first time we schedule an interest
   is_first_ = true;
 
@@ -23,6 +23,7 @@
 #include <protocols/data_processing_events.h>
 #include <protocols/indexer.h>
 #include <protocols/reassembly.h>
+#include <protocols/verification_pool.h>
 
 #include <atomic>
 
@@ -70,6 +71,12 @@ class TransportProtocol : public core::Portal::ConsumerCallback,
                                ContentObject &content_object) override = 0;
   virtual void onReassemblyFailed(std::uint32_t missing_segment) override = 0;
 
+  // Pool verifying packets off the portal thread, or nullptr if packets are
+  // verified inline.
+  TRANSPORT_ALWAYS_INLINE VerificationPool *getVerificationPool() {
+    return verification_pool_.get();
+  }
+
  protected:
   // Consumer Callback
   virtual void reset() = 0;
@@ -86,6 +93,7 @@ class TransportProtocol : public core::Portal::ConsumerCallback,
   // True if it si the first time we schedule an interest
   std::atomic<bool> is_first_;
   interface::TransportStatistics *stats_;
+  std::shared_ptr<VerificationPool> verification_pool_;
 
   // Callbacks
   interface::ConsumerInterestCallback *on_interest_retransmission_;
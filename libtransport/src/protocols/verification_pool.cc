@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hicn/transport/utils/log.h>
+#include <protocols/verification_pool.h>
+
+namespace transport {
+
+namespace protocol {
+
+VerificationPool::VerificationPool(std::size_t n_threads,
+                                   asio::io_service &io_service,
+                                   interface::TransportStatistics *stats)
+    : io_service_(io_service),
+      stats_(stats),
+      queue_depth_(0),
+      workers_(n_threads) {}
+
+void VerificationPool::verifySignatures(
+    std::shared_ptr<auth::Verifier> verifier, Packets packets,
+    VerificationCallback &&callback) {
+  auto start = utils::SteadyClock::now();
+  std::weak_ptr<VerificationPool> self = shared_from_this();
+
+  stats_->updateVerificationQueueDepth(++queue_depth_);
+
+  workers_.post([this, self, verifier = std::move(verifier),
+                 packets = std::move(packets),
+                 callback = std::move(callback), start]() mutable {
+    std::vector<auth::VerificationPolicy> policies(
+        packets.size(), auth::VerificationPolicy::DROP);
+
+    {
+      std::unique_lock<std::mutex> lck(verifier_mutex_, std::defer_lock);
+      if (!verifier->supportsConcurrentVerification()) {
+        lck.lock();
+      }
+
+      for (std::size_t i = 0; i < packets.size(); i++) {
+        try {
+          if (verifier->verifyPacket(packets[i].get())) {
+            policies[i] = auth::VerificationPolicy::ACCEPT;
+          }
+        } catch (const errors::MalformedAHPacketException &e) {
+          TRANSPORT_LOGE("Dropping packet without authentication header: %s",
+                         e.what());
+        } catch (const std::exception &e) {
+          TRANSPORT_LOGE("Dropping packet, verification failed: %s",
+                         e.what());
+        } catch (...) {
+          TRANSPORT_LOGE("Dropping packet, verification failed");
+        }
+      }
+    }
+
+    io_service_.post([self, verifier = std::move(verifier),
+                      packets = std::move(packets),
+                      policies = std::move(policies),
+                      callback = std::move(callback), start]() mutable {
+      if (auto pool = self.lock()) {
+        pool->onVerificationDone(std::move(verifier), std::move(packets),
+                                 policies, callback, start);
+      }
+    });
+  });
+}
+
+void VerificationPool::verifyHashes(std::shared_ptr<auth::Verifier> verifier,
+                                    Packets packets,
+                                    auth::SuffixHashes suffix_hashes,
+                                    VerificationCallback &&callback) {
+  auto start = utils::SteadyClock::now();
+  std::weak_ptr<VerificationPool> self = shared_from_this();
+
+  stats_->updateVerificationQueueDepth(++queue_depth_);
+
+  workers_.post([this, self, verifier = std::move(verifier),
+                 packets = std::move(packets),
+                 suffix_hashes = std::move(suffix_hashes),
+                 callback = std::move(callback), start]() mutable {
+    std::vector<auth::PacketPtr> raw_packets;
+    raw_packets.reserve(packets.size());
+    for (auto &packet : packets) {
+      raw_packets.push_back(packet.get());
+    }
+
+    // Hashing does not touch the verifier state, no need to serialize
+    std::vector<auth::VerificationPolicy> policies;
+    try {
+      policies = verifier->checkPacketHashes(raw_packets, suffix_hashes);
+    } catch (const std::exception &e) {
+      TRANSPORT_LOGE("Dropping packets, hash verification failed: %s",
+                     e.what());
+    } catch (...) {
+      TRANSPORT_LOGE("Dropping packets, hash verification failed");
+    }
+
+    if (policies.size() != packets.size()) {
+      policies.assign(packets.size(), auth::VerificationPolicy::DROP);
+    }
+
+    io_service_.post([self, verifier = std::move(verifier),
+                      packets = std::move(packets),
+                      policies = std::move(policies),
+                      callback = std::move(callback), start]() mutable {
+      if (auto pool = self.lock()) {
+        pool->onVerificationDone(std::move(verifier), std::move(packets),
+                                 policies, callback, start);
+      }
+    });
+  });
+}
+
+void VerificationPool::onVerificationDone(
+    std::shared_ptr<auth::Verifier> verifier, Packets packets,
+    std::vector<auth::VerificationPolicy> &policies,
+    VerificationCallback &callback, const utils::TimePoint &start) {
+  auto latency = std::chrono::duration_cast<utils::Microseconds>(
+                     utils::SteadyClock::now() - start)
+                     .count();
+
+  stats_->updateVerificationQueueDepth(--queue_depth_);
+  stats_->updateAverageVerificationLatency(latency);
+
+  for (std::size_t i = 0; i < packets.size(); i++) {
+    verifier->callVerificationFailedCallback(packets[i].get(), policies[i]);
+  }
+
+  callback(policies);
+}
+
+}  // end namespace protocol
+
+}  // end namespace transport
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <hicn/transport/auth/suffix_hashes.h>
+#include <hicn/transport/auth/verifier.h>
+#include <hicn/transport/core/packet.h>
+#include <hicn/transport/interfaces/statistics.h>
+#include <hicn/transport/utils/chrono_typedefs.h>
+#include <utils/worker_pool.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace transport {
+
+namespace protocol {
+
+/**
+ * Verification stage of the consumer pipeline. Signatures and manifest hashes
+ * are checked on a pool of worker threads, so that expensive asymmetric
+ * verifications do not block interest scheduling on the portal thread.
+ *
+ * Results are handed back to the portal thread: the verification failed
+ * callback of the verifier and the completion callback of each request run
+ * there, in the order in which the verifications complete. Packets are kept
+ * alive by the pool until then.
+ */
+class VerificationPool
+    : public std::enable_shared_from_this<VerificationPool> {
+ public:
+  using Packets = std::vector<core::Packet::Ptr>;
+  using VerificationCallback =
+      std::function<void(std::vector<auth::VerificationPolicy> &policies)>;
+
+  VerificationPool(std::size_t n_threads, asio::io_service &io_service,
+                   interface::TransportStatistics *stats);
+
+  std::size_t getThreadNumber() const { return workers_.size(); }
+
+  // Number of verification requests submitted and not yet completed.
+  std::size_t getQueueDepth() const { return queue_depth_; }
+
+  // Verify the signature of every packet.
+  void verifySignatures(std::shared_ptr<auth::Verifier> verifier,
+                        Packets packets, VerificationCallback &&callback);
+
+  // Verify every packet against the hashes of a manifest. Only packet digests
+  // are computed, in one multi-buffer pass per batch.
+  void verifyHashes(std::shared_ptr<auth::Verifier> verifier, Packets packets,
+                    auth::SuffixHashes suffix_hashes,
+                    VerificationCallback &&callback);
+
+ private:
+  void onVerificationDone(std::shared_ptr<auth::Verifier> verifier,
+                          Packets packets,
+                          std::vector<auth::VerificationPolicy> &policies,
+                          VerificationCallback &callback,
+                          const utils::TimePoint &start);
+
+  asio::io_service &io_service_;
+  interface::TransportStatistics *stats_;
+  std::size_t queue_depth_;
+  // Serializes verifiers that cannot be used from several threads.
+  std::mutex verifier_mutex_;
+  // Declared last so that the workers are joined before the other members
+  // are destroyed.
+  utils::WorkerPool workers_;
+};
+
+}  // end namespace protocol
+
+}  // end namespace transport
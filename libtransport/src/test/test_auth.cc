@@ -19,6 +19,12 @@
 #include <hicn/transport/auth/signer.h>
 #include <hicn/transport/auth/verifier.h>
 #include <hicn/transport/core/content_object.h>
+#include <hicn/transport/interfaces/statistics.h>
+#include <protocols/signing_stage.h>
+#include <protocols/verification_pool.h>
+
+#include <chrono>
+#include <thread>
 
 namespace transport {
 namespace auth {
@@ -106,5 +112,228 @@ TEST_F(AuthTest, HMACVerifier) {
   ASSERT_EQ(verifier->verifyPackets(&packet), VerificationPolicy::ACCEPT);
 }
 
+TEST_F(AuthTest, SigningStage) {
+  Identity identity("test_rsa.p12", PASSPHRASE, CryptoSuite::RSA_SHA256, 1024u,
+                    30, "SigningStage");
+  std::shared_ptr<Signer> rsa_signer = identity.getSigner();
+  std::shared_ptr<Signer> hmac_signer =
+      std::make_shared<SymmetricSigner>(CryptoSuite::HMAC_SHA256, PASSPHRASE);
+
+  PARCKey *key = parcSigner_CreatePublicKey(rsa_signer->getParcSigner());
+  std::shared_ptr<Verifier> rsa_verifier =
+      std::make_shared<AsymmetricVerifier>(key);
+  std::shared_ptr<Verifier> hmac_verifier =
+      std::make_shared<SymmetricVerifier>(PASSPHRASE);
+
+  protocol::SigningStage stage(4);
+  ASSERT_TRUE(rsa_signer->supportsConcurrentSigning());
+  ASSERT_FALSE(hmac_signer->supportsConcurrentSigning());
+
+  for (auto &pair : {std::make_pair(rsa_signer, rsa_verifier),
+                     std::make_pair(hmac_signer, hmac_verifier)}) {
+    std::vector<std::shared_ptr<core::ContentObject>> batch;
+    for (uint8_t i = 0; i < 37; i++) {
+      auto packet = std::make_shared<core::ContentObject>(
+          HF_INET6_TCP_AH, pair.first->getSignatureSize());
+      uint8_t buffer[256];
+      std::memset(buffer, i, sizeof(buffer));
+      packet->appendPayload(buffer, sizeof(buffer));
+      batch.push_back(packet);
+    }
+
+    stage.signBatch(*pair.first, batch);
+
+    for (auto &packet : batch) {
+      ASSERT_EQ(pair.second->verifyPackets(packet.get()),
+                VerificationPolicy::ACCEPT);
+    }
+
+    // Digests computed in parallel match the sequential ones
+    std::vector<CryptoHash> digests;
+    stage.hashBatch(CryptoHashType::SHA_256, batch, digests);
+    ASSERT_EQ(digests.size(), batch.size());
+
+    for (std::size_t i = 0; i < batch.size(); i++) {
+      CryptoHash expected = batch[i]->computeDigest(CryptoHashType::SHA_256);
+      ASSERT_TRUE(CryptoHash::compareBinaryDigest(
+          digests[i].getDigest<uint8_t>().data(),
+          expected.getDigest<uint8_t>().data(), CryptoHashType::SHA_256));
+    }
+  }
+
+  parcKey_Release(&key);
+}
+
+TEST_F(AuthTest, VerificationPool) {
+  Identity identity("test_rsa.p12", PASSPHRASE, CryptoSuite::RSA_SHA256, 1024u,
+                    30, "VerificationPool");
+  std::shared_ptr<Signer> signer = identity.getSigner();
+
+  PARCKey *key = parcSigner_CreatePublicKey(signer->getParcSigner());
+  std::shared_ptr<Verifier> verifier =
+      std::make_shared<AsymmetricVerifier>(key);
+  ASSERT_TRUE(verifier->supportsConcurrentVerification());
+
+  asio::io_service io_service;
+  asio::io_service::work work(io_service);
+  interface::TransportStatistics stats;
+  auto pool =
+      std::make_shared<protocol::VerificationPool>(4, io_service, &stats);
+
+  // Sign a batch of packets and corrupt one of them
+  protocol::VerificationPool::Packets packets;
+  SuffixHashes suffix_hashes;
+  for (uint32_t i = 0; i < 16; i++) {
+    auto packet = std::make_shared<core::ContentObject>(
+        core::Name("b001::abcd", i), HF_INET6_TCP_AH,
+        signer->getSignatureSize());
+    uint8_t buffer[256];
+    std::memset(buffer, i, sizeof(buffer));
+    packet->appendPayload(buffer, sizeof(buffer));
+    signer->signPacket(packet.get());
+
+    CryptoHash hash = packet->computeDigest(CryptoHashType::SHA_256);
+    suffix_hashes.add(i, CryptoHashType::SHA_256,
+                      hash.getDigest<uint8_t>().data());
+    packets.push_back(packet);
+  }
+  suffix_hashes.sort();
+  utils::MemBuf *payload = packets[5]->prev();
+  payload->writableData()[payload->length() - 1] ^= 0xff;
+
+  // Signatures are verified on the pool, results come back on io_service
+  std::vector<VerificationPolicy> result;
+  pool->verifySignatures(
+      verifier, packets,
+      [&result](std::vector<VerificationPolicy> &policies) {
+        result = policies;
+      });
+  ASSERT_EQ(pool->getQueueDepth(), 1u);
+  ASSERT_EQ(stats.getVerificationQueueDepth(), 1u);
+
+  io_service.run_one();
+  ASSERT_EQ(pool->getQueueDepth(), 0u);
+  ASSERT_EQ(stats.getVerificationQueueDepth(), 0u);
+  ASSERT_EQ(result.size(), packets.size());
+  for (std::size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(result[i], i == 5 ? VerificationPolicy::DROP
+                                : VerificationPolicy::ACCEPT);
+  }
+
+  // Manifest-covered packets are checked by hash only
+  result.clear();
+  pool->verifyHashes(verifier, packets, suffix_hashes,
+                     [&result](std::vector<VerificationPolicy> &policies) {
+                       result = policies;
+                     });
+
+  io_service.run_one();
+  ASSERT_EQ(result.size(), packets.size());
+  for (std::size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(result[i], i == 5 ? VerificationPolicy::ABORT
+                                : VerificationPolicy::ACCEPT);
+  }
+
+  parcKey_Release(&key);
+}
+
+TEST_F(AuthTest, VerificationPoolCatchesVerifierErrors) {
+  // A verifier that fails with something else than a malformed packet
+  class ThrowingVerifier : public VoidVerifier {
+   public:
+    bool verifyPacket(PacketPtr packet) override {
+      throw std::runtime_error("verifier failure");
+    }
+
+    std::vector<VerificationPolicy> checkPacketHashes(
+        const std::vector<PacketPtr> &packets,
+        const SuffixHashes &suffix_hashes) override {
+      throw std::runtime_error("verifier failure");
+    }
+  };
+
+  asio::io_service io_service;
+  asio::io_service::work work(io_service);
+  interface::TransportStatistics stats;
+  auto pool =
+      std::make_shared<protocol::VerificationPool>(2, io_service, &stats);
+  std::shared_ptr<Verifier> verifier = std::make_shared<ThrowingVerifier>();
+
+  protocol::VerificationPool::Packets packets;
+  for (uint32_t i = 0; i < 4; i++) {
+    packets.push_back(std::make_shared<core::ContentObject>(
+        core::Name("b001::abcd", i), HF_INET6_TCP_AH));
+  }
+
+  // Every packet is reported as failed, the worker survives
+  std::vector<VerificationPolicy> result;
+  pool->verifySignatures(
+      verifier, packets,
+      [&result](std::vector<VerificationPolicy> &policies) {
+        result = policies;
+      });
+  io_service.run_one();
+  ASSERT_EQ(result.size(), packets.size());
+  for (auto policy : result) {
+    ASSERT_EQ(policy, VerificationPolicy::DROP);
+  }
+
+  result.clear();
+  pool->verifyHashes(verifier, packets, SuffixHashes(),
+                     [&result](std::vector<VerificationPolicy> &policies) {
+                       result = policies;
+                     });
+  io_service.run_one();
+  ASSERT_EQ(result.size(), packets.size());
+  for (auto policy : result) {
+    ASSERT_EQ(policy, VerificationPolicy::DROP);
+  }
+  ASSERT_EQ(pool->getQueueDepth(), 0u);
+}
+
+TEST_F(AuthTest, VerificationPoolDestroyedWithPendingRequests) {
+  // A verifier slow enough for requests to be queued at destruction
+  class SlowVerifier : public VoidVerifier {
+   public:
+    bool verifyPacket(PacketPtr packet) override {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      return true;
+    }
+
+    bool supportsConcurrentVerification() const override { return true; }
+  };
+
+  asio::io_service io_service;
+  asio::io_service::work work(io_service);
+  interface::TransportStatistics stats;
+  std::shared_ptr<Verifier> verifier = std::make_shared<SlowVerifier>();
+
+  protocol::VerificationPool::Packets packets;
+  for (uint32_t i = 0; i < 4; i++) {
+    packets.push_back(std::make_shared<core::ContentObject>(
+        core::Name("b001::abcd", i), HF_INET6_TCP_AH));
+  }
+
+  // Destroying the pool joins its threads, whatever the requests in flight
+  std::size_t completed = 0;
+  for (std::size_t n_threads : {1, 2, 4, 8}) {
+    auto pool = std::make_shared<protocol::VerificationPool>(
+        n_threads, io_service, &stats);
+    ASSERT_EQ(pool->getThreadNumber(), n_threads);
+
+    for (int i = 0; i < 64; i++) {
+      pool->verifySignatures(
+          verifier, packets,
+          [&completed](std::vector<VerificationPolicy> &) { completed++; });
+    }
+
+    pool.reset();
+  }
+
+  // Results of the destroyed pools are never delivered
+  io_service.poll();
+  ASSERT_EQ(completed, 0u);
+}
+
 }  // namespace auth
 }  // namespace transport
@@ -17,6 +17,7 @@
 #include <core/manifest_inline.h>
 #include <gtest/gtest.h>
 #include <hicn/transport/auth/crypto_hash_type.h>
+#include <hicn/transport/auth/suffix_hashes.h>
 #include <test/packet_samples.h>
 
 #include <climits>
@@ -220,6 +221,111 @@ TEST_F(ManifestTest, SetSuffixList) {
   delete[] entries;
 }
 
+TEST_F(ManifestTest, DecodeSuffixList) {
+  manifest1_.clear();
+  manifest1_.setVersion(ManifestVersion::VERSION_1);
+  manifest1_.setHashAlgorithm(auth::CryptoHashType::SHA_256);
+
+  // Add entries in decreasing suffix order
+  std::vector<uint8_t> data[4];
+  for (uint32_t i = 0; i < 4; i++) {
+    data[i].assign(32, static_cast<uint8_t>(i));
+    manifest1_.addSuffixHash(
+        10 - i, auth::CryptoHash(data[i].data(), data[i].size(),
+                                 auth::CryptoHashType::SHA_256));
+  }
+
+  manifest1_.encode();
+
+  // Decode a copy of the manifest, as a consumer would
+  ContentObject co(manifest1_);
+  ContentObjectManifest received(std::move(co));
+  received.decode();
+
+  // Entries are read in place from the payload
+  const auto &suffix_list = received.getSuffixList();
+  ASSERT_EQ(suffix_list.size(), 4u);
+
+  uint32_t i = 0;
+  for (const auto &entry : suffix_list) {
+    ASSERT_EQ(entry.getSuffix(), 10 - i);
+    ASSERT_EQ(std::memcmp(entry.getHash(), data[i].data(), 32), 0);
+    i++;
+  }
+
+  // Lookups go through a flat array sorted by suffix
+  auth::SuffixHashes suffix_hashes;
+  suffix_hashes.add(suffix_list, received.getHashAlgorithm());
+  ASSERT_EQ(suffix_hashes.find(10), nullptr);
+
+  suffix_hashes.sort();
+  ASSERT_EQ(suffix_hashes.size(), 4u);
+  ASSERT_EQ(suffix_hashes.find(11), nullptr);
+
+  for (i = 0; i < 4; i++) {
+    const auth::SuffixHashes::Entry *entry = suffix_hashes.find(10 - i);
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->type, auth::CryptoHashType::SHA_256);
+    ASSERT_EQ(std::memcmp(entry->digest, data[i].data(), 32), 0);
+  }
+
+  suffix_hashes.erase(9);
+  ASSERT_EQ(suffix_hashes.find(9), nullptr);
+  ASSERT_EQ(suffix_hashes.size(), 3u);
+
+  suffix_hashes.sort();
+  ASSERT_EQ(suffix_hashes.size(), 3u);
+  ASSERT_NE(suffix_hashes.find(8), nullptr);
+}
+
+TEST_F(ManifestTest, SuffixHashesMergeAfterErase) {
+  auth::SuffixHashes suffix_hashes;
+  uint8_t digest[32] = {0};
+
+  for (uint32_t suffix : {10, 20, 30, 40}) {
+    digest[0] = suffix;
+    suffix_hashes.add(suffix, auth::CryptoHashType::SHA_256, digest);
+  }
+  suffix_hashes.sort();
+
+  // As many new entries as erased ones
+  suffix_hashes.erase(10);
+  suffix_hashes.erase(20);
+  for (uint32_t suffix : {25, 5}) {
+    digest[0] = suffix;
+    suffix_hashes.add(suffix, auth::CryptoHashType::SHA_256, digest);
+  }
+  suffix_hashes.sort();
+
+  ASSERT_EQ(suffix_hashes.size(), 4u);
+  ASSERT_EQ(suffix_hashes.find(10), nullptr);
+  ASSERT_EQ(suffix_hashes.find(20), nullptr);
+  for (uint32_t suffix : {5, 25, 30, 40}) {
+    const auth::SuffixHashes::Entry *entry = suffix_hashes.find(suffix);
+    ASSERT_NE(entry, nullptr);
+    ASSERT_EQ(entry->digest[0], suffix);
+  }
+}
+
+TEST_F(ManifestTest, SuffixHashesKeepLastDuplicate) {
+  auth::SuffixHashes suffix_hashes;
+  uint8_t digest[32] = {0};
+
+  for (uint8_t version = 1; version <= 3; version++) {
+    digest[0] = version;
+    suffix_hashes.add(7, auth::CryptoHashType::SHA_256, digest);
+  }
+  suffix_hashes.sort();
+
+  ASSERT_EQ(suffix_hashes.size(), 1u);
+  ASSERT_EQ(suffix_hashes.find(7)->digest[0], 3);
+
+  // Once sorted, the entry is replaced in place
+  digest[0] = 4;
+  suffix_hashes.add(7, auth::CryptoHashType::SHA_256, digest);
+  ASSERT_EQ(suffix_hashes.find(7)->digest[0], 4);
+}
+
 }  // namespace core
 
 }  // namespace transport
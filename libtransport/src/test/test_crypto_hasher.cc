@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <auth/sha256_multibuffer.h>
+#include <gtest/gtest.h>
+#include <hicn/transport/auth/crypto_hasher.h>
+#include <hicn/transport/core/content_object.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace transport {
+namespace auth {
+
+namespace {
+class CryptoHasherTest : public ::testing::Test {
+ protected:
+  CryptoHasherTest() {
+    // Messages of all the lengths around the SHA-256 padding boundaries
+    for (std::size_t length = 0; length < 300; length++) {
+      std::vector<uint8_t> message(length);
+      for (std::size_t i = 0; i < length; i++) {
+        message[i] = static_cast<uint8_t>(i * 7 + length);
+      }
+      messages_.push_back(std::move(message));
+    }
+  }
+
+  ~CryptoHasherTest() {}
+
+  CryptoHash singleBufferHash(const std::vector<uint8_t> &message) {
+    CryptoHasher hasher(CryptoHashType::SHA_256);
+    return hasher.init().updateBytes(message.data(), message.size()).finalize();
+  }
+
+  std::vector<std::vector<uint8_t>> messages_;
+};
+}  // namespace
+
+TEST_F(CryptoHasherTest, MultiBufferKernel) {
+  std::vector<const uint8_t *> buffers;
+  std::vector<std::size_t> lengths;
+
+  for (auto &message : messages_) {
+    buffers.push_back(message.data());
+    lengths.push_back(message.size());
+  }
+
+  // Every kernel the CPU can run, not only the one the dispatcher picks
+  for (Sha256Kernel kernel :
+       {Sha256Kernel::GENERIC, Sha256Kernel::SSE2, Sha256Kernel::AVX2,
+        Sha256Kernel::AVX512}) {
+    if (!sha256MultiBufferSetKernel(kernel)) {
+      continue;
+    }
+
+    std::vector<uint8_t> digests(messages_.size() * SHA256_DIGEST_SIZE);
+    sha256MultiBuffer(buffers.data(), lengths.data(), buffers.size(),
+                      digests.data());
+
+    for (std::size_t i = 0; i < messages_.size(); i++) {
+      CryptoHash expected = singleBufferHash(messages_[i]);
+      EXPECT_TRUE(CryptoHash::compareBinaryDigest(
+          digests.data() + i * SHA256_DIGEST_SIZE,
+          expected.getDigest<uint8_t>().data(), CryptoHashType::SHA_256))
+          << "kernel " << static_cast<int>(kernel) << " length "
+          << messages_[i].size();
+    }
+  }
+
+  ASSERT_TRUE(sha256MultiBufferSetKernel(Sha256Kernel::AUTO));
+}
+
+TEST_F(CryptoHasherTest, HashBuffers) {
+  std::vector<const uint8_t *> buffers;
+  std::vector<std::size_t> lengths;
+
+  for (auto &message : messages_) {
+    buffers.push_back(message.data());
+    lengths.push_back(message.size());
+  }
+
+  auto digests = CryptoHasher::hashBuffers(
+      CryptoHashType::SHA_256, buffers.data(), lengths.data(), buffers.size());
+  ASSERT_EQ(digests.size(), messages_.size());
+
+  for (std::size_t i = 0; i < messages_.size(); i++) {
+    CryptoHash expected = singleBufferHash(messages_[i]);
+    EXPECT_TRUE(CryptoHash::compareBinaryDigest(
+        digests[i].getDigest<uint8_t>().data(),
+        expected.getDigest<uint8_t>().data(), CryptoHashType::SHA_256));
+  }
+}
+
+TEST_F(CryptoHasherTest, PacketDigests) {
+  std::vector<std::shared_ptr<core::ContentObject>> content_objects;
+  std::vector<core::Packet *> packets;
+
+  for (std::size_t i = 0; i < 19; i++) {
+    auto content_object =
+        std::make_shared<core::ContentObject>(HF_INET6_TCP);
+    content_object->appendPayload(messages_[i * 13].data(),
+                                  messages_[i * 13].size());
+    content_objects.push_back(content_object);
+    packets.push_back(content_object.get());
+  }
+
+  auto digests = core::Packet::computeDigests(CryptoHashType::SHA_256,
+                                              packets.data(), packets.size());
+  ASSERT_EQ(digests.size(), packets.size());
+
+  for (std::size_t i = 0; i < packets.size(); i++) {
+    CryptoHash expected = packets[i]->computeDigest(CryptoHashType::SHA_256);
+    EXPECT_TRUE(CryptoHash::compareBinaryDigest(
+        digests[i].getDigest<uint8_t>().data(),
+        expected.getDigest<uint8_t>().data(), CryptoHashType::SHA_256));
+  }
+}
+
+// Throughput of single-buffer vs multi-buffer hashing of MTU-sized packets.
+// Run with --gtest_also_run_disabled_tests.
+TEST_F(CryptoHasherTest, DISABLED_Benchmark) {
+  static constexpr std::size_t packet_size = 1500;
+  static constexpr std::size_t n_packets = 1024;
+  static constexpr std::size_t rounds = 100;
+
+  std::vector<uint8_t> data(packet_size * n_packets, 0xab);
+  std::vector<const uint8_t *> buffers;
+  std::vector<std::size_t> lengths(n_packets, packet_size);
+  for (std::size_t i = 0; i < n_packets; i++) {
+    buffers.push_back(data.data() + i * packet_size);
+  }
+
+  auto t0 = std::chrono::steady_clock::now();
+  CryptoHasher hasher(CryptoHashType::SHA_256);
+  for (std::size_t r = 0; r < rounds; r++) {
+    for (std::size_t i = 0; i < n_packets; i++) {
+      hasher.init().updateBytes(buffers[i], packet_size).finalize();
+    }
+  }
+
+  auto t1 = std::chrono::steady_clock::now();
+  std::vector<uint8_t> digests(n_packets * SHA256_DIGEST_SIZE);
+  for (std::size_t r = 0; r < rounds; r++) {
+    sha256MultiBuffer(buffers.data(), lengths.data(), n_packets,
+                      digests.data());
+  }
+
+  auto t2 = std::chrono::steady_clock::now();
+
+  double single = std::chrono::duration<double>(t1 - t0).count();
+  double multi = std::chrono::duration<double>(t2 - t1).count();
+
+  std::cout << "single-buffer: " << rounds * n_packets / single
+            << " hashes/s" << std::endl;
+  std::cout << "multi-buffer (" << sha256MultiBufferLanes()
+            << " lanes selected): " << rounds * n_packets / multi
+            << " hashes/s" << std::endl;
+}
+
+}  // namespace auth
+}  // namespace transport
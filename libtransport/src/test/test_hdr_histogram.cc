@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <hicn/transport/utils/hdr_histogram.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace utils {
+
+namespace {
+
+// Relative error allowed by 3 significant figures
+static constexpr double kTolerance = 1e-3;
+
+void expectNear(uint64_t expected, uint64_t actual) {
+  EXPECT_LE(std::abs(static_cast<double>(actual) - expected),
+            kTolerance * expected + 1)
+      << "expected " << expected << ", got " << actual;
+}
+
+}  // namespace
+
+TEST(HdrHistogramTest, Empty) {
+  HdrHistogram h;
+
+  EXPECT_EQ(h.totalCount(), 0u);
+  EXPECT_EQ(h.min(), 0u);
+  EXPECT_EQ(h.max(), 0u);
+  EXPECT_EQ(h.valueAtPercentile(50), 0u);
+  EXPECT_EQ(h.mean(), 0);
+}
+
+TEST(HdrHistogramTest, SmallValuesAreExact) {
+  HdrHistogram h;
+
+  for (uint64_t v = 1; v <= 1000; v++) {
+    h.record(v);
+  }
+
+  EXPECT_EQ(h.totalCount(), 1000u);
+  EXPECT_EQ(h.min(), 1u);
+  EXPECT_EQ(h.max(), 1000u);
+  EXPECT_EQ(h.valueAtPercentile(50), 500u);
+  EXPECT_EQ(h.valueAtPercentile(99), 990u);
+  EXPECT_EQ(h.valueAtPercentile(100), 1000u);
+  EXPECT_DOUBLE_EQ(h.mean(), 500.5);
+}
+
+TEST(HdrHistogramTest, PercentilesOfUniformDistribution) {
+  HdrHistogram h;
+
+  for (uint64_t v = 1; v <= 1000000; v++) {
+    h.record(v);
+  }
+
+  expectNear(500000, h.valueAtPercentile(50));
+  expectNear(990000, h.valueAtPercentile(99));
+  expectNear(999000, h.valueAtPercentile(99.9));
+  EXPECT_EQ(h.max(), 1000000u);
+}
+
+TEST(HdrHistogramTest, PercentilesOfRandomSamples) {
+  HdrHistogram h(10000000000ULL, 3);
+  std::vector<uint64_t> samples;
+  std::mt19937_64 rng(42);
+  std::lognormal_distribution<double> dist(8, 2);
+
+  for (int i = 0; i < 100000; i++) {
+    uint64_t v = std::max<uint64_t>(1, static_cast<uint64_t>(dist(rng)));
+    v = std::min(v, h.highestTrackableValue());
+    samples.push_back(v);
+    h.record(v);
+  }
+
+  std::sort(samples.begin(), samples.end());
+  for (double p : {50.0, 90.0, 99.0, 99.9}) {
+    auto rank = static_cast<std::size_t>(p / 100 * samples.size() + 0.5);
+    expectNear(samples[rank - 1], h.valueAtPercentile(p));
+  }
+}
+
+TEST(HdrHistogramTest, ValuesAreClamped) {
+  HdrHistogram h(1000, 2);
+
+  h.record(0);
+  h.record(5000);
+
+  EXPECT_EQ(h.min(), 1u);
+  EXPECT_EQ(h.max(), 1000u);
+}
+
+TEST(HdrHistogramTest, Add) {
+  HdrHistogram a, b;
+
+  for (uint64_t v = 1; v <= 1000; v++) {
+    a.record(v);
+    b.record(v + 1000);
+  }
+
+  a.add(b);
+
+  EXPECT_EQ(a.totalCount(), 2000u);
+  EXPECT_EQ(a.min(), 1u);
+  EXPECT_EQ(a.max(), 2000u);
+  expectNear(1000, a.valueAtPercentile(50));
+
+  HdrHistogram c(1000, 2);
+  EXPECT_THROW(a.add(c), std::invalid_argument);
+}
+
+TEST(HdrHistogramTest, Reset) {
+  HdrHistogram h;
+
+  h.record(42, 10);
+  EXPECT_EQ(h.totalCount(), 10u);
+
+  h.reset();
+  EXPECT_EQ(h.totalCount(), 0u);
+  EXPECT_EQ(h.valueAtPercentile(99), 0u);
+}
+
+}  // namespace utils
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
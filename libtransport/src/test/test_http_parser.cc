@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <hicn/transport/http/parser.h>
+#include <hicn/transport/http/request.h>
+#include <hicn/transport/http/response.h>
+#include <http/parser_kernel.h>
+
+#include <chrono>
+#include <string>
+
+namespace transport {
+namespace http {
+
+namespace {
+
+// Headers captured between a DASH player and the http-proxy
+const std::string request =
+    "GET /dash/bbb/bbb_30fps.mpd HTTP/1.1\r\n"
+    "Host: hicn-http-proxy\r\n"
+    "Connection: keep-alive\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36 (KHTML, "
+    "like Gecko) Chrome/88.0.4324.150 Safari/537.36\r\n"
+    "Accept: */*\r\n"
+    "Origin: http://dashif.org\r\n"
+    "Referer: http://dashif.org/\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Accept-Language: en-US,en;q=0.9\r\n"
+    "\r\n";
+
+const std::string response =
+    "HTTP/1.1 200 OK\r\n"
+    "Server: nginx/1.18.0 (Ubuntu)\r\n"
+    "Date: Tue, 16 Feb 2021 10:20:42 GMT\r\n"
+    "Content-Type: video/iso.segment\r\n"
+    "Content-Length: 1139238\r\n"
+    "Last-Modified: Mon, 15 Feb 2021 09:12:10 GMT\r\n"
+    "Connection: keep-alive\r\n"
+    "ETag: \"602a3a4a-116226\"\r\n"
+    "Access-Control-Allow-Origin: *\r\n"
+    "Accept-Ranges: bytes\r\n"
+    "\r\n";
+
+const uint8_t *bytes(const std::string &s) {
+  return reinterpret_cast<const uint8_t *>(s.data());
+}
+
+}  // namespace
+
+// Every test runs with each scanning kernel the CPU can run, not only the one
+// selected for it
+class HTTPParserTest : public ::testing::TestWithParam<HTTPScanKernel> {
+ protected:
+  void SetUp() override {
+    if (!httpParserSetKernel(GetParam())) {
+      GTEST_SKIP() << "kernel not supported by this CPU";
+    }
+  }
+
+  void TearDown() override {
+    ASSERT_TRUE(httpParserSetKernel(HTTPScanKernel::AUTO));
+  }
+};
+
+TEST_P(HTTPParserTest, Request) {
+  HTTPMessageView message;
+  ASSERT_EQ(message.parse(bytes(request), request.size()), request.size());
+
+  EXPECT_EQ(message.startLine(0).str(), "GET");
+  EXPECT_EQ(message.startLine(1).str(), "/dash/bbb/bbb_30fps.mpd");
+  EXPECT_EQ(message.startLine(2).str(), "HTTP/1.1");
+  EXPECT_EQ(message.headerCount(), 8u);
+
+  // Lookup is case insensitive, values are returned as they are
+  auto value = message.find("user-agent");
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(value->str().substr(0, 11), "Mozilla/5.0");
+  EXPECT_EQ(value->str().substr(value->length - 13), "Safari/537.36");
+  ASSERT_NE(message.find("ACCEPT-LANGUAGE"), nullptr);
+  EXPECT_EQ(message.find("Accept-Language")->str(), "en-US,en;q=0.9");
+  EXPECT_EQ(message.find("content-length"), nullptr);
+}
+
+TEST_P(HTTPParserTest, Response) {
+  HTTPMessageView message;
+  HTTPStringView version;
+  std::size_t content_length;
+
+  ASSERT_EQ(message.parse(bytes(response), response.size()), response.size());
+  ASSERT_TRUE(HTTPMessageView::parseVersion(message.startLine(0), version));
+  EXPECT_EQ(version.str(), "1.1");
+  EXPECT_EQ(message.startLine(1).str(), "200");
+  EXPECT_EQ(message.startLine(2).str(), "OK");
+
+  ASSERT_NE(message.find("Content-Length"), nullptr);
+  ASSERT_TRUE(message.find("Content-Length")->toNumber(content_length));
+  EXPECT_EQ(content_length, 1139238u);
+  EXPECT_EQ(message.find("etag")->str(), "\"602a3a4a-116226\"");
+}
+
+TEST_P(HTTPParserTest, BodyIsNotParsed) {
+  std::string message_with_body = response + "Host: not a header\r\n\r\n";
+  HTTPMessageView message;
+  EXPECT_EQ(message.parse(bytes(message_with_body), message_with_body.size()),
+            response.size());
+  EXPECT_EQ(message.find("host"), nullptr);
+}
+
+TEST_P(HTTPParserTest, Incomplete) {
+  // Every prefix, so that the end of the buffer falls at every offset of the
+  // SIMD blocks
+  HTTPMessageView message;
+  for (std::size_t i = 0; i < request.size(); i++) {
+    EXPECT_EQ(message.parse(bytes(request), i), 0u) << i;
+  }
+}
+
+TEST_P(HTTPParserTest, Malformed) {
+  HTTPMessageView message;
+  std::string no_colon = "GET / HTTP/1.1\r\nHost\r\n\r\n";
+  std::string no_name = "GET / HTTP/1.1\r\n: value\r\n\r\n";
+  std::string lone_cr = "GET / HTTP/1.1\rHost: a\r\n\r\n";
+
+  EXPECT_EQ(message.parse(bytes(no_colon), no_colon.size()), 0u);
+  EXPECT_EQ(message.parse(bytes(no_name), no_name.size()), 0u);
+  EXPECT_EQ(message.parse(bytes(lone_cr), lone_cr.size()), 0u);
+
+  HTTPStringView version;
+  HTTPStringView token = {"HTTX/1.1", 8};
+  EXPECT_FALSE(HTTPMessageView::parseVersion(token, version));
+}
+
+TEST_P(HTTPParserTest, BareLineFeedsAndBlanks) {
+  std::string message_lf = "HTTP/1.0 404 Not Found\nX-Long:  \t" +
+                           std::string(100, 'a') + " \t\nX-Empty:\n\n";
+  HTTPMessageView message;
+
+  ASSERT_EQ(message.parse(bytes(message_lf), message_lf.size()),
+            message_lf.size());
+  EXPECT_EQ(message.startLine(2).str(), "Not Found");
+  EXPECT_EQ(message.find("x-long")->str(), std::string(100, 'a'));
+  EXPECT_TRUE(message.find("x-empty")->empty());
+}
+
+TEST_P(HTTPParserTest, HeaderMaps) {
+  HTTPHeaders headers;
+  std::string http_version, method, url;
+
+  ASSERT_EQ(HTTPRequest::parseHeaders(bytes(request), request.size(), headers,
+                                      http_version, method, url),
+            request.size());
+  EXPECT_EQ(method, "GET");
+  EXPECT_EQ(url, "/dash/bbb/bbb_30fps.mpd");
+  EXPECT_EQ(http_version, "1.1");
+  EXPECT_EQ(headers["origin"], "http://dashif.org");
+
+  std::string status_code, status_string;
+  headers.clear();
+  ASSERT_EQ(HTTPResponse::parseHeaders(bytes(response), response.size(),
+                                       headers, http_version, status_code,
+                                       status_string),
+            response.size());
+  EXPECT_EQ(status_code, "200");
+  EXPECT_EQ(headers["content-type"], "video/iso.segment");
+  EXPECT_EQ(headers.size(), 9u);
+}
+
+TEST_P(HTTPParserTest, Benchmark) {
+  const std::size_t rounds = 200000;
+  std::size_t found = 0;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (std::size_t r = 0; r < rounds; r++) {
+    HTTPMessageView message;
+    std::size_t content_length;
+    message.parse(bytes(response), response.size());
+    auto value = message.find("content-length");
+    found += value && value->toNumber(content_length);
+  }
+
+  auto t1 = std::chrono::steady_clock::now();
+  for (std::size_t r = 0; r < rounds; r++) {
+    HTTPHeaders headers;
+    std::string http_version, status_code, status_string;
+    HTTPResponse::parseHeaders(bytes(response), response.size(), headers,
+                               http_version, status_code, status_string);
+    found += headers.count("content-length");
+  }
+
+  auto t2 = std::chrono::steady_clock::now();
+
+  EXPECT_EQ(found, 2 * rounds);
+
+  // Responses per second, in the XML report
+  double view = std::chrono::duration<double>(t1 - t0).count();
+  double map = std::chrono::duration<double>(t2 - t1).count();
+  RecordProperty("tokenizer", static_cast<int>(rounds / view));
+  RecordProperty("header_map", static_cast<int>(rounds / map));
+}
+
+INSTANTIATE_TEST_SUITE_P(Kernels, HTTPParserTest,
+                         ::testing::Values(HTTPScanKernel::GENERIC,
+                                           HTTPScanKernel::SSE42,
+                                           HTTPScanKernel::AVX2));
+
+}  // namespace http
+}  // namespace transport
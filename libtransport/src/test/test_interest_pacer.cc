@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <protocols/interest_pacer.h>
+
+namespace transport {
+
+namespace protocol {
+
+namespace {
+
+// 100 interests per 10 ms, updated every 100 us
+static constexpr double kWindow = 100;
+static constexpr double kMinRtt = 10000;
+static constexpr int kStep = 100;
+static constexpr int kStepsPerRtt = int(kMinRtt) / kStep;
+
+static constexpr double kGainCycle[] = {1.25, 0.75, 1, 1, 1, 1, 1, 1};
+
+}  // namespace
+
+TEST(InterestPacerTest, GainCycle) {
+  utils::TimePoint now = utils::SteadyClock::now();
+  InterestPacer pacer;
+  pacer.reset(now);
+
+  // One phase per min RTT, wrapping around after the whole cycle
+  for (std::size_t rtt = 0; rtt < 2 * InterestPacer::gain_cycle_length;
+       rtt++) {
+    for (int i = 0; i < kStepsPerRtt; i++) {
+      double rate = pacer.update(now, kWindow, kMinRtt);
+      std::size_t phase = rtt % InterestPacer::gain_cycle_length;
+      ASSERT_EQ(pacer.getGainPhase(), phase);
+      ASSERT_DOUBLE_EQ(pacer.getGain(), kGainCycle[phase]);
+      ASSERT_DOUBLE_EQ(rate, kGainCycle[phase] * kWindow / kMinRtt);
+      now += utils::Microseconds(kStep);
+    }
+  }
+}
+
+TEST(InterestPacerTest, TokenBucketRate) {
+  utils::TimePoint now = utils::SteadyClock::now();
+  InterestPacer pacer;
+  pacer.reset(now);
+
+  // Interests released in each phase follow gain * window
+  for (std::size_t phase = 0; phase < InterestPacer::gain_cycle_length;
+       phase++) {
+    int sent = 0;
+    for (int i = 0; i < kStepsPerRtt; i++) {
+      pacer.update(now, kWindow, kMinRtt);
+      while (pacer.consume()) {
+        sent++;
+      }
+      ASSERT_LT(pacer.getTokens(), 1);
+      now += utils::Microseconds(kStep);
+    }
+
+    // Tokens left over at a phase change move to the next phase
+    EXPECT_NEAR(sent, kGainCycle[phase] * kWindow, 2) << "phase " << phase;
+  }
+}
+
+TEST(InterestPacerTest, NoBurstAfterIdle) {
+  utils::TimePoint now = utils::SteadyClock::now();
+  InterestPacer pacer;
+  pacer.reset(now);
+
+  // After one second of silence, at most two batches worth of tokens
+  pacer.update(now, kWindow, kMinRtt);
+  now += utils::Milliseconds(1000);
+  double rate = pacer.update(now, kWindow, kMinRtt);
+
+  int sent = 0;
+  while (pacer.consume()) {
+    sent++;
+  }
+  EXPECT_LE(sent, 2 * InterestPacer::min_interval * rate);
+
+  // The next interest is at least one batch interval away
+  EXPECT_GE(pacer.getWaitTime(), double(InterestPacer::min_interval));
+}
+
+}  // namespace protocol
+
+}  // namespace transport
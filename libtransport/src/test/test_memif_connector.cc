@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <hicn/transport/core/interest.h>
+#include <io_modules/memif/memif_connector.h>
+#include <unistd.h>
+
+#include <condition_variable>
+#include <set>
+#include <sstream>
+
+namespace transport {
+
+namespace core {
+
+namespace {
+
+// Two memif endpoints in the same process: no VPP needed.
+class MemifConnectorTest : public ::testing::Test {
+ protected:
+  static constexpr long slave = 0;
+  static constexpr long master = 1;
+  static constexpr uint32_t memif_id = 0;
+  static constexpr std::chrono::seconds timeout = std::chrono::seconds(10);
+
+  MemifConnectorTest()
+      : socket_filename_("/tmp/libtransport_memif_test_" +
+                         std::to_string(getpid()) + ".sock"),
+        master_(
+            [this](Connector *c, utils::MemBuf &packet,
+                   const std::error_code &ec) { onPacket(packet); },
+            [](Connector *c, const std::error_code &ec) {},
+            [](Connector *c) {}, [](Connector *c) {}, master_io_service_),
+        slave_([](Connector *c, utils::MemBuf &packet,
+                  const std::error_code &ec) {},
+               [](Connector *c, const std::error_code &ec) {},
+               [](Connector *c) {}, [](Connector *c) {}, slave_io_service_),
+        received_(0) {}
+
+  virtual ~MemifConnectorTest() { ::unlink(socket_filename_.c_str()); }
+
+  void connect(std::uint16_t num_queues) {
+    // connect() returns once the peer is there
+    std::thread master_thread([this, num_queues]() {
+      master_.connect(memif_id, master, socket_filename_, num_queues);
+    });
+    slave_.connect(memif_id, slave, socket_filename_, num_queues);
+    master_thread.join();
+
+    master_thread_ = std::thread([this]() { master_io_service_.run(); });
+    slave_thread_ = std::thread([this]() { slave_io_service_.run(); });
+  }
+
+  virtual void TearDown() {
+    slave_.close();
+    master_.close();
+
+    if (master_thread_.joinable()) {
+      master_thread_.join();
+    }
+
+    if (slave_thread_.joinable()) {
+      slave_thread_.join();
+    }
+  }
+
+  void onPacket(utils::MemBuf &packet) {
+    auto &interest = static_cast<Interest &>(packet);
+
+    std::unique_lock<std::mutex> lock(mtx_);
+    suffixes_.insert(interest.getName().getSuffix());
+    received_++;
+    cv_.notify_all();
+  }
+
+  // Interest i goes to prefix b001::(i % num_prefixes)
+  static Name getName(uint32_t i, uint32_t num_prefixes) {
+    std::stringstream prefix;
+    prefix << "b001::" << std::hex << i % num_prefixes;
+    return Name(prefix.str(), i);
+  }
+
+  void sendInterests(uint32_t first, uint32_t n, uint32_t num_prefixes = 1) {
+    for (uint32_t i = first; i < first + n; i++) {
+      auto interest = std::make_shared<Interest>(getName(i, num_prefixes));
+      slave_.send(*interest);
+    }
+  }
+
+  bool waitFor(std::size_t n) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    return cv_.wait_for(lock, timeout, [this, n]() { return received_ >= n; });
+  }
+
+  std::string socket_filename_;
+  asio::io_service master_io_service_;
+  asio::io_service slave_io_service_;
+  MemifConnector master_;
+  MemifConnector slave_;
+  std::thread master_thread_;
+  std::thread slave_thread_;
+
+  std::mutex mtx_;
+  std::condition_variable cv_;
+  std::size_t received_;
+  std::set<uint32_t> suffixes_;
+};
+
+constexpr std::chrono::seconds MemifConnectorTest::timeout;
+
+}  // namespace
+
+TEST_F(MemifConnectorTest, Loopback) {
+  const uint32_t n = 1000;
+  connect(1);
+  EXPECT_TRUE(master_.isConnected());
+  EXPECT_TRUE(slave_.isConnected());
+
+  sendInterests(0, n);
+
+  EXPECT_TRUE(waitFor(n));
+  EXPECT_EQ(suffixes_.size(), n);
+  EXPECT_EQ(*suffixes_.begin(), 0u);
+  EXPECT_EQ(*suffixes_.rbegin(), n - 1);
+}
+
+TEST_F(MemifConnectorTest, MultiQueueLoopback) {
+  const uint32_t n = 1000;
+  const uint32_t num_prefixes = 64;
+  const uint16_t num_queues = 4;
+  connect(num_queues);
+  EXPECT_EQ(master_.getQueueNumber(), num_queues);
+  EXPECT_EQ(slave_.getQueueNumber(), num_queues);
+
+  // Queues are chosen by prefix: make sure they are all used
+  std::set<uint32_t> queues;
+  for (uint32_t i = 0; i < num_prefixes; i++) {
+    queues.insert(getName(i, num_prefixes).getHash32(false) % num_queues);
+  }
+  EXPECT_EQ(queues.size(), num_queues);
+
+  sendInterests(0, n, num_prefixes);
+
+  EXPECT_TRUE(waitFor(n));
+  EXPECT_EQ(suffixes_.size(), n);
+}
+
+}  // namespace core
+
+}  // namespace transport
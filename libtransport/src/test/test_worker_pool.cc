@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <utils/worker_pool.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+namespace utils {
+
+namespace {
+
+static constexpr std::size_t kThreads[] = {1, 2, 4, 8};
+
+// Runs f on its own thread, so that a deadlock fails the test instead of
+// hanging it.
+template <typename Func>
+bool completesWithin(std::chrono::seconds timeout, Func &&f) {
+  auto done = std::make_shared<std::promise<void>>();
+  auto future = done->get_future();
+  std::thread([done, f]() mutable {
+    f();
+    done->set_value();
+  }).detach();
+
+  return future.wait_for(timeout) == std::future_status::ready;
+}
+
+}  // namespace
+
+TEST(WorkerPoolTest, DestroyIdlePool) {
+  for (auto n : kThreads) {
+    EXPECT_TRUE(completesWithin(std::chrono::seconds(10), [n]() {
+      WorkerPool pool(n);
+      ASSERT_EQ(pool.size(), n);
+    })) << n << " threads";
+  }
+}
+
+TEST(WorkerPoolTest, DestroyAfterWork) {
+  for (auto n : kThreads) {
+    EXPECT_TRUE(completesWithin(std::chrono::seconds(10), [n]() {
+      std::atomic<std::size_t> count(0);
+      {
+        WorkerPool pool(n);
+        pool.parallelFor(1000, [&count](std::size_t begin, std::size_t end) {
+          count += end - begin;
+        });
+        pool.post([&count]() { count++; });
+        pool.parallelFor(1, [](std::size_t, std::size_t) {});
+      }
+      EXPECT_GE(count.load(), 1000u);
+    })) << n << " threads";
+  }
+}
+
+TEST(WorkerPoolTest, ParallelForRethrows) {
+  WorkerPool pool(4);
+  std::atomic<std::size_t> count(0);
+
+  EXPECT_THROW(pool.parallelFor(100,
+                                [&count](std::size_t begin, std::size_t end) {
+                                  count += end - begin;
+                                  if (begin == 0) {
+                                    throw std::runtime_error("chunk failed");
+                                  }
+                                }),
+               std::runtime_error);
+
+  // Every chunk ran, even after the failure
+  EXPECT_EQ(count.load(), 100u);
+}
+
+}  // namespace utils
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <hicn/transport/utils/event_thread.h>
+#include <hicn/transport/utils/noncopyable.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Pool of event threads sharing the same io_service. Work can be posted
+ * asynchronously or split across the threads with parallelFor, which blocks
+ * the caller until every chunk has been processed.
+ */
+class WorkerPool : public NonCopyable {
+ public:
+  WorkerPool(std::size_t n_threads) {
+    n_threads = std::max<std::size_t>(n_threads, 1);
+
+    // EventThread captures its own address in the running thread, so the
+    // vector must never reallocate.
+    threads_.reserve(n_threads);
+    for (std::size_t i = 0; i < n_threads; i++) {
+      threads_.emplace_back(io_service_, /* detached */ false);
+    }
+  }
+
+  ~WorkerPool() {
+    // Each thread holds a work object on the shared io_service, which keeps
+    // run() alive in the others while the first one is joined. Work still
+    // queued is dropped.
+    io_service_.stop();
+    threads_.clear();
+  }
+
+  std::size_t size() const { return threads_.size(); }
+
+  asio::io_service &getIoService() { return io_service_; }
+
+  template <typename Func>
+  void post(Func &&f) {
+    io_service_.post(std::forward<Func>(f));
+  }
+
+  /**
+   * Split [0, n) in contiguous ranges, one per worker, and call
+   * f(begin, end) on each of them. Returns when all the ranges have been
+   * processed. The first exception thrown by a worker is rethrown here.
+   */
+  template <typename Func>
+  void parallelFor(std::size_t n, Func &&f) {
+    if (n == 0) {
+      return;
+    }
+
+    std::size_t n_chunks = std::min(n, threads_.size());
+    std::size_t chunk_size = (n + n_chunks - 1) / n_chunks;
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::size_t pending = (n + chunk_size - 1) / chunk_size;
+    std::exception_ptr error;
+
+    for (std::size_t begin = 0; begin < n; begin += chunk_size) {
+      std::size_t end = std::min(begin + chunk_size, n);
+      io_service_.post([&, begin, end]() {
+        std::exception_ptr e;
+        try {
+          f(begin, end);
+        } catch (...) {
+          e = std::current_exception();
+        }
+
+        std::unique_lock<std::mutex> lck(mtx);
+        if (e && !error) {
+          error = e;
+        }
+
+        if (--pending == 0) {
+          cv.notify_all();
+        }
+      });
+    }
+
+    std::unique_lock<std::mutex> lck(mtx);
+    cv.wait(lck, [&pending]() { return pending == 0; });
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  asio::io_service io_service_;
+  std::vector<EventThread> threads_;
+};
+
+}  // namespace utils
@@ -0,0 +1,557 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Keep order as it is */
+#include <config.h>
+#include <collectd.h>
+#include <plugin.h>
+
+#include <hicn/stats/statsSegmentReader.h>
+
+#define STATIC_ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define IS_TRUE(s)                                                             \
+  ((strcasecmp("true", (s)) == 0) || (strcasecmp("yes", (s)) == 0) ||          \
+   (strcasecmp("on", (s)) == 0))
+#define IS_FALSE(s)                                                            \
+  ((strcasecmp("false", (s)) == 0) || (strcasecmp("no", (s)) == 0) ||          \
+   (strcasecmp("off", (s)) == 0))
+
+/* Reopen the segment if the forwarder did not refresh it for this long */
+#define STALE_TIMEOUT_MS 5000
+
+/************** OPTIONS ***********************************/
+static const char *config_keys[3] = {
+    "Verbose",
+    "Tag",
+    "Segment",
+};
+static int config_keys_num = STATIC_ARRAY_SIZE(config_keys);
+static bool verbose = false;
+static char *tag = NULL;
+static char *segment = NULL;
+
+static StatsSegmentReader *reader = NULL;
+static StatsSegmentSnapshot snapshot;
+
+/************** DATA SOURCES ******************************/
+static data_source_t packets_dsrc[1] = {
+    {"packets", DS_TYPE_DERIVE, 0, NAN},
+};
+
+static data_source_t entries_dsrc[1] = {
+    {"entries", DS_TYPE_GAUGE, 0, NAN},
+};
+
+static data_source_t face_dsrc[3] = {
+    {"interests", DS_TYPE_DERIVE, 0, NAN},
+    {"data", DS_TYPE_DERIVE, 0, NAN},
+    {"bytes", DS_TYPE_DERIVE, 0, NAN},
+};
+
+static data_source_t face_drops_dsrc[3] = {
+    {"no_route", DS_TYPE_DERIVE, 0, NAN},
+    {"no_reverse_path", DS_TYPE_DERIVE, 0, NAN},
+    {"send_failures", DS_TYPE_DERIVE, 0, NAN},
+};
+
+/* The mean latency is the ratio of the two rates */
+static data_source_t latency_dsrc[2] = {
+    {"satisfied", DS_TYPE_DERIVE, 0, NAN},
+    {"latency", DS_TYPE_DERIVE, 0, NAN},
+};
+
+static data_source_t prefix_dsrc[4] = {
+    {"interests", DS_TYPE_DERIVE, 0, NAN},
+    {"interest_bytes", DS_TYPE_DERIVE, 0, NAN},
+    {"data", DS_TYPE_DERIVE, 0, NAN},
+    {"data_bytes", DS_TYPE_DERIVE, 0, NAN},
+};
+
+static data_source_t prefix_drops_dsrc[2] = {
+    {"no_nexthop", DS_TYPE_DERIVE, 0, NAN},
+    {"timeouts", DS_TYPE_DERIVE, 0, NAN},
+};
+
+/************** DATA SETS FORWARDER ***********************/
+static data_set_t interests_received_ds = {
+    "hicn_light_interests_received",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t data_received_ds = {
+    "hicn_light_data_received",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t interests_forwarded_ds = {
+    "hicn_light_interests_forwarded",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t data_forwarded_ds = {
+    "hicn_light_data_forwarded",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t interests_aggregated_ds = {
+    "hicn_light_interests_aggregated",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t interests_from_cache_ds = {
+    "hicn_light_interests_from_cache",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t drops_ds = {
+    "hicn_light_drops",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t drops_no_route_ds = {
+    "hicn_light_drops_no_route",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t drops_no_reverse_path_ds = {
+    "hicn_light_drops_no_reverse_path",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t send_failures_ds = {
+    "hicn_light_send_failures",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+/************** DATA SETS CONTENT STORE *******************/
+static data_set_t cs_hits_ds = {
+    "hicn_light_cs_hits",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t cs_misses_ds = {
+    "hicn_light_cs_misses",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t cs_adds_ds = {
+    "hicn_light_cs_adds",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+static data_set_t cs_evictions_ds = {
+    "hicn_light_cs_evictions",
+    STATIC_ARRAY_SIZE(packets_dsrc),
+    packets_dsrc,
+};
+
+/************** DATA SETS TABLES **************************/
+static data_set_t pit_entries_ds = {
+    "hicn_light_pit_entries",
+    STATIC_ARRAY_SIZE(entries_dsrc),
+    entries_dsrc,
+};
+
+static data_set_t cs_entries_ds = {
+    "hicn_light_cs_entries",
+    STATIC_ARRAY_SIZE(entries_dsrc),
+    entries_dsrc,
+};
+
+static data_set_t fib_entries_ds = {
+    "hicn_light_fib_entries",
+    STATIC_ARRAY_SIZE(entries_dsrc),
+    entries_dsrc,
+};
+
+static data_set_t faces_ds = {
+    "hicn_light_faces",
+    STATIC_ARRAY_SIZE(entries_dsrc),
+    entries_dsrc,
+};
+
+static data_set_t nexthops_ds = {
+    "hicn_light_nexthops",
+    STATIC_ARRAY_SIZE(entries_dsrc),
+    entries_dsrc,
+};
+
+/************** DATA SETS FACE ****************************/
+static data_set_t face_rx_ds = {
+    "hicn_light_face_rx",
+    STATIC_ARRAY_SIZE(face_dsrc),
+    face_dsrc,
+};
+
+static data_set_t face_tx_ds = {
+    "hicn_light_face_tx",
+    STATIC_ARRAY_SIZE(face_dsrc),
+    face_dsrc,
+};
+
+static data_set_t face_drops_ds = {
+    "hicn_light_face_drops",
+    STATIC_ARRAY_SIZE(face_drops_dsrc),
+    face_drops_dsrc,
+};
+
+static data_set_t face_latency_ds = {
+    "hicn_light_face_latency",
+    STATIC_ARRAY_SIZE(latency_dsrc),
+    latency_dsrc,
+};
+
+/************** DATA SETS PREFIX **************************/
+static data_set_t prefix_traffic_ds = {
+    "hicn_light_prefix_traffic",
+    STATIC_ARRAY_SIZE(prefix_dsrc),
+    prefix_dsrc,
+};
+
+static data_set_t prefix_drops_ds = {
+    "hicn_light_prefix_drops",
+    STATIC_ARRAY_SIZE(prefix_drops_dsrc),
+    prefix_drops_dsrc,
+};
+
+static data_set_t prefix_latency_ds = {
+    "hicn_light_prefix_latency",
+    STATIC_ARRAY_SIZE(latency_dsrc),
+    latency_dsrc,
+};
+
+/**********************************************************/
+/********** UTILITY FUNCTIONS *****************************/
+/**********************************************************/
+char *sstrncpy(char *dest, const char *src, size_t n) {
+  strncpy(dest, src, n);
+  dest[n - 1] = '\0';
+  return dest;
+}
+
+/*
+ * Utility function used by the read callback to populate a
+ * value_list_t and pass it to plugin_dispatch_values.
+ */
+static int submit(const char *plugin_instance, const char *type,
+                  value_t *values, size_t values_len, cdtime_t *timestamp) {
+  value_list_t vl = VALUE_LIST_INIT;
+  vl.values = values;
+  vl.values_len = values_len;
+
+  if (timestamp != NULL) {
+    vl.time = *timestamp;
+  }
+
+  sstrncpy(vl.plugin, "hicn_light", sizeof(vl.plugin));
+  sstrncpy(vl.plugin_instance, plugin_instance, sizeof(vl.plugin_instance));
+  sstrncpy(vl.type, type, sizeof(vl.type));
+
+  if (tag != NULL)
+    sstrncpy(vl.type_instance, tag, sizeof(vl.type_instance));
+
+  return plugin_dispatch_values(&vl);
+}
+
+static int submit_derive(const char *plugin_instance, const char *type,
+                         uint64_t value, cdtime_t *timestamp) {
+  value_t values[1] = {{.derive = value}};
+  return submit(plugin_instance, type, values, 1, timestamp);
+}
+
+static int submit_gauge(const char *plugin_instance, const char *type,
+                        uint64_t value, cdtime_t *timestamp) {
+  value_t values[1] = {{.gauge = value}};
+  return submit(plugin_instance, type, values, 1, timestamp);
+}
+
+/*
+ * Prefixes are used as plugin instances, '/' would be interpreted as a path
+ * separator by the write plugins.
+ */
+static void prefix_to_instance(const char *prefix, char *instance,
+                               size_t size) {
+  sstrncpy(instance, prefix, size);
+  for (char *c = instance; *c; c++) {
+    if (*c == '/')
+      *c = '_';
+  }
+}
+
+/*
+ * (Re)open the segment if needed. A restarted forwarder creates a new
+ * segment, the one we mapped is then stale.
+ */
+static int open_segment(void) {
+  if (reader && statsSegmentReader_IsStale(reader, STALE_TIMEOUT_MS)) {
+    plugin_log(LOG_INFO, "hicn_light plugin: segment %s is stale, reopening",
+               segment);
+    statsSegmentReader_Close(&reader);
+  }
+
+  if (!reader) {
+    reader = statsSegmentReader_Open(segment);
+  }
+
+  return reader ? 0 : -1;
+}
+
+/**********************************************************/
+/********** CALLBACK FUNCTIONS ****************************/
+/**********************************************************/
+
+/*
+ * This function is called for each configuration item.
+ */
+static int hicn_light_config(const char *key, const char *value) {
+  if (strcasecmp(key, "Verbose") == 0) {
+    verbose = IS_TRUE(value);
+  } else if (strcasecmp(key, "Tag") == 0) {
+    if (tag != NULL) {
+      free(tag);
+      tag = NULL;
+    }
+
+    if (strcasecmp(value, "None")) {
+      tag = strdup(value);
+    }
+  } else if (strcasecmp(key, "Segment") == 0) {
+    free(segment);
+    segment = strdup(value);
+  } else {
+    return 1;
+  }
+
+  return 0;
+}
+
+/*
+ * This function is called once upon startup to initialize the plugin.
+ */
+static int hicn_light_init(void) {
+  if (segment == NULL) {
+    segment = strdup(HICN_LIGHT_STATS_SEGMENT_NAME);
+  }
+
+  statsSegmentSnapshot_Init(&snapshot);
+
+  // The forwarder may be started later, the read callback retries
+  if (open_segment() < 0)
+    plugin_log(LOG_WARNING, "hicn_light plugin: could not open segment %s",
+               segment);
+
+  return 0;
+}
+
+/*
+ * This function is called in regular intervalls to collect the data.
+ */
+static int hicn_light_read(void) {
+  if (open_segment() < 0)
+    return -1;
+
+  if (statsSegmentReader_Snapshot(reader, &snapshot) < 0) {
+    plugin_log(LOG_ERR, "hicn_light plugin: could not read segment %s",
+               segment);
+    return -1;
+  }
+
+  cdtime_t timestamp = cdtime();
+  char *node_name = "node";
+  const hicn_light_stats_processor_t *processor = &snapshot.processor;
+  const hicn_light_stats_cs_t *cs = &snapshot.cs;
+  const hicn_light_stats_tables_t *tables = &snapshot.tables;
+
+  // FORWARDER
+  submit_derive(node_name, interests_received_ds.type,
+                processor->countInterestsReceived, &timestamp);
+  submit_derive(node_name, data_received_ds.type,
+                processor->countObjectsReceived, &timestamp);
+  submit_derive(node_name, interests_forwarded_ds.type,
+                processor->countInterestForwarded, &timestamp);
+  submit_derive(node_name, data_forwarded_ds.type,
+                processor->countObjectsForwarded, &timestamp);
+  submit_derive(node_name, drops_ds.type, processor->countDropped,
+                &timestamp);
+  submit_derive(node_name, cs_hits_ds.type, cs->countHits, &timestamp);
+
+  submit_gauge(node_name, pit_entries_ds.type, tables->pitEntries,
+               &timestamp);
+  submit_gauge(node_name, cs_entries_ds.type, tables->csEntries, &timestamp);
+  submit_gauge(node_name, fib_entries_ds.type, tables->fibEntries,
+               &timestamp);
+  submit_gauge(node_name, faces_ds.type, tables->faces, &timestamp);
+
+  if (verbose) {
+    submit_derive(node_name, interests_aggregated_ds.type,
+                  processor->countInterestsAggregated, &timestamp);
+    submit_derive(node_name, interests_from_cache_ds.type,
+                  processor->countInterestsSatisfiedFromStore, &timestamp);
+    submit_derive(node_name, drops_no_route_ds.type,
+                  processor->countDroppedNoRoute, &timestamp);
+    submit_derive(node_name, drops_no_reverse_path_ds.type,
+                  processor->countDroppedNoReversePath, &timestamp);
+    submit_derive(node_name, send_failures_ds.type,
+                  processor->countSendFailures, &timestamp);
+    submit_derive(node_name, cs_misses_ds.type, cs->countMisses, &timestamp);
+    submit_derive(node_name, cs_adds_ds.type, cs->countAdds, &timestamp);
+    submit_derive(node_name, cs_evictions_ds.type,
+                  cs->countLruEvictions + cs->countExpiryEvictions +
+                      cs->countRCTEvictions,
+                  &timestamp);
+  }
+
+  // FACES
+  for (size_t i = 0; i < snapshot.faceCount; i++) {
+    const hicn_light_stats_face_t *face = &snapshot.faces[i];
+    const hicn_light_stats_face_counters_t *counters = &face->counters;
+    char face_name[16];
+    value_t values[3];
+
+    snprintf(face_name, sizeof(face_name), "face%u", face->id);
+
+    values[0] = (value_t){.derive = counters->interestsReceived};
+    values[1] = (value_t){.derive = counters->objectsReceived};
+    values[2] = (value_t){.derive = counters->bytesReceived};
+    submit(face_name, face_rx_ds.type, values, 3, &timestamp);
+    values[0] = (value_t){.derive = counters->interestsSent};
+    values[1] = (value_t){.derive = counters->objectsSent};
+    values[2] = (value_t){.derive = counters->bytesSent};
+    submit(face_name, face_tx_ds.type, values, 3, &timestamp);
+    values[0] = (value_t){.derive = counters->droppedNoRoute};
+    values[1] = (value_t){.derive = counters->droppedNoReversePath};
+    values[2] = (value_t){.derive = counters->sendFailures};
+    submit(face_name, face_drops_ds.type, values, 3, &timestamp);
+    values[0] = (value_t){.derive = counters->interestsSatisfied};
+    values[1] = (value_t){.derive = counters->satisfactionLatency};
+    submit(face_name, face_latency_ds.type, values, 2, &timestamp);
+  }
+
+  // PREFIXES
+  if (verbose) {
+    for (size_t i = 0; i < snapshot.prefixCount; i++) {
+      const hicn_light_stats_prefix_t *prefix = &snapshot.prefixes[i];
+      const hicn_light_stats_prefix_counters_t *counters = &prefix->counters;
+      char prefix_name[HICN_LIGHT_STATS_PREFIX_NAME_SIZE];
+      value_t values[4];
+
+      prefix_to_instance(prefix->name, prefix_name, sizeof(prefix_name));
+      submit_gauge(prefix_name, nexthops_ds.type, prefix->nexthops,
+                   &timestamp);
+
+      values[0] = (value_t){.derive = counters->interestsForwarded};
+      values[1] = (value_t){.derive = counters->bytesForwarded};
+      values[2] = (value_t){.derive = counters->objectsReceived};
+      values[3] = (value_t){.derive = counters->bytesReceived};
+      submit(prefix_name, prefix_traffic_ds.type, values, 4, &timestamp);
+      values[0] = (value_t){.derive = counters->droppedNoNexthop};
+      values[1] = (value_t){.derive = counters->timeouts};
+      submit(prefix_name, prefix_drops_ds.type, values, 2, &timestamp);
+      values[0] = (value_t){.derive = counters->interestsSatisfied};
+      values[1] = (value_t){.derive = counters->satisfactionLatency};
+      submit(prefix_name, prefix_latency_ds.type, values, 2, &timestamp);
+    }
+  }
+
+  return 0;
+}
+
+/*
+ * This function is called when plugin_log () has been used.
+ */
+static void hicn_light_log(int severity, const char *msg, user_data_t *ud) {
+  printf("[LOG %i] %s\n", severity, msg);
+  return;
+}
+
+/*
+ * This function is called before shutting down collectd.
+ */
+static int hicn_light_shutdown(void) {
+  plugin_log(LOG_INFO, "hicn_light plugin: shutting down");
+
+  statsSegmentReader_Close(&reader);
+  statsSegmentSnapshot_Free(&snapshot);
+
+  free(segment);
+  segment = NULL;
+
+  if (tag != NULL) {
+    free(tag);
+    tag = NULL;
+  }
+
+  return 0;
+}
+
+/*
+ * This function is called after loading the plugin to register it with
+ * collectd.
+ */
+void module_register(void) {
+  // data sets forwarder
+  plugin_register_data_set(&interests_received_ds);
+  plugin_register_data_set(&data_received_ds);
+  plugin_register_data_set(&interests_forwarded_ds);
+  plugin_register_data_set(&data_forwarded_ds);
+  plugin_register_data_set(&interests_aggregated_ds);
+  plugin_register_data_set(&interests_from_cache_ds);
+  plugin_register_data_set(&drops_ds);
+  plugin_register_data_set(&drops_no_route_ds);
+  plugin_register_data_set(&drops_no_reverse_path_ds);
+  plugin_register_data_set(&send_failures_ds);
+  // data sets content store
+  plugin_register_data_set(&cs_hits_ds);
+  plugin_register_data_set(&cs_misses_ds);
+  plugin_register_data_set(&cs_adds_ds);
+  plugin_register_data_set(&cs_evictions_ds);
+  // data sets tables
+  plugin_register_data_set(&pit_entries_ds);
+  plugin_register_data_set(&cs_entries_ds);
+  plugin_register_data_set(&fib_entries_ds);
+  plugin_register_data_set(&faces_ds);
+  plugin_register_data_set(&nexthops_ds);
+  // data sets face
+  plugin_register_data_set(&face_rx_ds);
+  plugin_register_data_set(&face_tx_ds);
+  plugin_register_data_set(&face_drops_ds);
+  plugin_register_data_set(&face_latency_ds);
+  // data sets prefix
+  plugin_register_data_set(&prefix_traffic_ds);
+  plugin_register_data_set(&prefix_drops_ds);
+  plugin_register_data_set(&prefix_latency_ds);
+  // callbacks
+  plugin_register_log("hicn_light", hicn_light_log, /* user data */ NULL);
+  plugin_register_config("hicn_light", hicn_light_config, config_keys,
+                         config_keys_num);
+  plugin_register_init("hicn_light", hicn_light_init);
+  plugin_register_read("hicn_light", hicn_light_read);
+  plugin_register_shutdown("hicn_light", hicn_light_shutdown);
+  return;
+}
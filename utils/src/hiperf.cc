@@ -19,15 +19,20 @@
 #include <hicn/transport/interfaces/global_conf_interface.h>
 #include <hicn/transport/interfaces/p2psecure_socket_consumer.h>
 #include <hicn/transport/interfaces/p2psecure_socket_producer.h>
+#include <hicn/transport/interfaces/portal.h>
 #include <hicn/transport/interfaces/socket_consumer.h>
 #include <hicn/transport/interfaces/socket_producer.h>
 #include <hicn/transport/auth/identity.h>
 #include <hicn/transport/auth/signer.h>
 #include <hicn/transport/utils/chrono_typedefs.h>
+#include <hicn/transport/utils/hdr_histogram.h>
 #include <hicn/transport/utils/literals.h>
 
 #ifndef _WIN32
+#include <fcntl.h>
 #include <hicn/transport/utils/daemonizator.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #endif
 
 #include <asio.hpp>
@@ -35,6 +40,7 @@
 #include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 #include <unordered_set>
 
 #ifdef __linux__
@@ -55,12 +61,38 @@ namespace interface {
 #endif
 #define ERROR_SETUP -5
 #define MIN_PROBE_SEQ 0xefffffff
+#define MAX_FLOWS 65536
 
 struct packet_t {
   uint64_t timestamp;
   uint32_t size;
 };
 
+/**
+ * Binary request trace replayed by the client (-T). The file is a header
+ * followed by n_records fixed-size records, all in host byte order, so that
+ * it can be memory-mapped and read in place.
+ */
+#define REPLAY_TRACE_MAGIC "HRTR"
+#define REPLAY_TRACE_VERSION 1
+
+struct replay_trace_header_t {
+  char magic[4];
+  uint16_t version;
+  // 4 or 6. IPv4 names use the first 4 bytes of the address.
+  uint16_t ip_version;
+  uint64_t n_records;
+};
+
+struct replay_trace_record_t {
+  // Microseconds since the beginning of the trace, non decreasing
+  uint64_t timestamp;
+  uint8_t address[16];
+  uint32_t suffix;
+  // Size of the requested object, in bytes
+  uint32_t size;
+};
+
 inline uint64_t _ntohll(const uint64_t *input) {
   uint64_t return_val;
   uint8_t *tmp = (uint8_t *)&return_val;
@@ -114,7 +146,12 @@ struct ClientConfiguration {
         test_mode_(false),
         secure_(false),
         producer_prefix_(),
-        interest_lifetime_(500) {}
+        interest_lifetime_(500),
+        n_flows_(1),
+        n_threads_(1),
+        duration_seconds_(0),
+        json_file_(),
+        replay_file_() {}
 
   Name name;
   double beta;
@@ -132,6 +169,11 @@ struct ClientConfiguration {
   bool secure_;
   Prefix producer_prefix_;
   uint32_t interest_lifetime_;
+  std::size_t n_flows_;
+  std::size_t n_threads_;
+  uint32_t duration_seconds_;
+  std::string json_file_;
+  std::string replay_file_;
 };
 
 /**
@@ -231,6 +273,11 @@ class KeyCallback;
 /**
  * Hiperf client class: configure and setup an hicn consumer following the
  * ClientConfiguration.
+ *
+ * A client runs one flow. By default its consumer socket runs on its own
+ * thread and run() blocks until the download is over. When flow_io_service
+ * is given, the socket runs on that io_service instead, so that several
+ * flows can share a thread (see HIperfMultiClient).
  */
 class HIperfClient {
   typedef std::chrono::time_point<std::chrono::steady_clock> Time;
@@ -240,8 +287,13 @@ class HIperfClient {
   friend class KeyCallback;
   friend class RTCCallback;
 
+  // Send times of the last interests, indexed by suffix
+  static constexpr std::size_t log2_sent_interests_size = 14;
+
  public:
-  HIperfClient(const ClientConfiguration &conf)
+  HIperfClient(const ClientConfiguration &conf,
+               asio::io_service *flow_io_service = nullptr,
+               std::size_t flow_id = 0)
       : configuration_(conf),
         total_duration_milliseconds_(0),
         old_bytes_value_(0),
@@ -262,10 +314,38 @@ class HIperfClient {
         lost_packets_(std::unordered_set<uint32_t>()),
         rtc_callback_(*this),
         callback_(*this),
-        key_callback_(*this) {}
+        key_callback_(*this),
+        flow_io_service_(flow_io_service),
+        flow_id_(flow_id),
+        sent_interests_(1 << log2_sent_interests_size),
+        bytes_received_(0),
+        duration_timer_(io_service_) {}
 
   ~HIperfClient() {}
 
+  std::size_t getFlowId() const { return flow_id_; }
+
+  const Name &getName() const { return configuration_.name; }
+
+  uint64_t getBytesReceived() const { return bytes_received_; }
+
+  // Duration of the flow until it completed, or until now
+  utils::Milliseconds getDuration() const {
+    Time end = t_end_ > t_download_ ? t_end_ : utils::SteadyClock::now();
+    return std::chrono::duration_cast<utils::Milliseconds>(end - t_download_);
+  }
+
+  const utils::HdrHistogram &getSegmentLatency() const {
+    return segment_latency_;
+  }
+
+  const utils::HdrHistogram &getFrameDelay() const { return frame_delay_; }
+
+  // Called on the flow thread when the download is over
+  void setOnFlowDone(std::function<void()> &&on_flow_done) {
+    on_flow_done_ = std::move(on_flow_done);
+  }
+
   void checkReceivedRtcContent(ConsumerSocket &c,
                                const ContentObject &contentObject) {
     if (!configuration_.test_mode_) return;
@@ -340,7 +420,61 @@ class HIperfClient {
     expected_seg_ = receivedSeg + 1;
   }
 
-  void processLeavingInterest(ConsumerSocket &c, const Interest &interest) {}
+  void processLeavingInterest(ConsumerSocket &c, const Interest &interest) {
+    uint32_t suffix = interest.getName().getSuffix();
+    auto &entry = sent_interests_[suffix & (sent_interests_.size() - 1)];
+    entry.first = suffix;
+    entry.second = utils::SteadyClock::now();
+  }
+
+  void processContentObject(ConsumerSocket &c,
+                            const ContentObject &content_object) {
+    uint32_t suffix = content_object.getName().getSuffix();
+    auto &entry = sent_interests_[suffix & (sent_interests_.size() - 1)];
+
+    // Latency since the last (re)transmission of the interest
+    if (entry.first == suffix && entry.second != Time()) {
+      segment_latency_.record(
+          std::chrono::duration_cast<utils::Microseconds>(
+              utils::SteadyClock::now() - entry.second)
+              .count());
+      entry.second = Time();
+    }
+
+    auto payload = content_object.getPayload();
+    bytes_received_ += payload->length();
+
+    if (!configuration_.rtc_) {
+      return;
+    }
+
+    // RTC data packets carry the production time (in ms) after the 12 bytes
+    // of RTC header. As for DataDelay, producer and consumer clocks must be
+    // synchronized.
+    if (payload->length() >= 12 + sizeof(uint64_t) &&
+        payload->length() != 16 /* NACK */) {
+      uint64_t production_time;
+      std::memcpy(&production_time, payload->data() + 12,
+                  sizeof(production_time));
+      int64_t now = std::chrono::duration_cast<utils::Microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+      int64_t delay = now - (int64_t)production_time * 1000;
+      frame_delay_.record(delay > 0 ? delay : 0);
+    }
+
+    checkReceivedRtcContent(c, content_object);
+  }
+
+  void done() {
+    t_end_ = utils::SteadyClock::now();
+
+    if (on_flow_done_) {
+      on_flow_done_();
+    } else {
+      io_service_.stop();
+    }
+  }
 
   void handleTimerExpiration(ConsumerSocket &c,
                              const TransportStatistics &stats) {
@@ -513,6 +647,9 @@ class HIperfClient {
             *(static_cast<P2PSecureConsumerSocket *>(consumer_socket_.get()));
         secure_consumer_socket.registerPrefix(configuration_.producer_prefix_);
       }
+    } else if (flow_io_service_) {
+      consumer_socket_ = std::make_shared<ConsumerSocket>(
+          configuration_.transport_protocol_, *flow_io_service_);
     } else {
       consumer_socket_ =
           std::make_shared<ConsumerSocket>(configuration_.transport_protocol_);
@@ -598,15 +735,13 @@ class HIperfClient {
       return ERROR_SETUP;
     }
 
-    if (configuration_.rtc_) {
-      ret = consumer_socket_->setSocketOption(
-          ConsumerCallbacksOptions::CONTENT_OBJECT_INPUT,
-          (ConsumerContentObjectCallback)std::bind(
-              &HIperfClient::checkReceivedRtcContent, this,
-              std::placeholders::_1, std::placeholders::_2));
-      if (ret == SOCKET_OPTION_NOT_SET) {
-        return ERROR_SETUP;
-      }
+    ret = consumer_socket_->setSocketOption(
+        ConsumerCallbacksOptions::CONTENT_OBJECT_INPUT,
+        (ConsumerContentObjectCallback)std::bind(
+            &HIperfClient::processContentObject, this, std::placeholders::_1,
+            std::placeholders::_2));
+    if (ret == SOCKET_OPTION_NOT_SET) {
+      return ERROR_SETUP;
     }
 
     if (configuration_.rtc_) {
@@ -616,21 +751,25 @@ class HIperfClient {
       transport_stats->setAlpha(0.0);
     }
 
-    ret = consumer_socket_->setSocketOption(
-        ConsumerCallbacksOptions::STATS_SUMMARY,
-        (ConsumerTimerCallback)std::bind(&HIperfClient::handleTimerExpiration,
-                                         this, std::placeholders::_1,
-                                         std::placeholders::_2));
+    // With several flows the periodic reports would be interleaved: only
+    // the final summary is printed.
+    if (!flow_io_service_) {
+      ret = consumer_socket_->setSocketOption(
+          ConsumerCallbacksOptions::STATS_SUMMARY,
+          (ConsumerTimerCallback)std::bind(
+              &HIperfClient::handleTimerExpiration, this,
+              std::placeholders::_1, std::placeholders::_2));
 
-    if (ret == SOCKET_OPTION_NOT_SET) {
-      return ERROR_SETUP;
-    }
+      if (ret == SOCKET_OPTION_NOT_SET) {
+        return ERROR_SETUP;
+      }
 
-    if (consumer_socket_->setSocketOption(
-            GeneralTransportOptions::STATS_INTERVAL,
-            configuration_.report_interval_milliseconds_) ==
-        SOCKET_OPTION_NOT_SET) {
-      return ERROR_SETUP;
+      if (consumer_socket_->setSocketOption(
+              GeneralTransportOptions::STATS_INTERVAL,
+              configuration_.report_interval_milliseconds_) ==
+          SOCKET_OPTION_NOT_SET) {
+        return ERROR_SETUP;
+      }
     }
 
     consumer_socket_->connect();
@@ -645,6 +784,14 @@ class HIperfClient {
     signals_.async_wait(
         [this](const std::error_code &, const int &) { io_service_.stop(); });
 
+    if (configuration_.duration_seconds_) {
+      duration_timer_.expires_from_now(
+          std::chrono::seconds(configuration_.duration_seconds_));
+      duration_timer_.async_wait([this](const std::error_code &ec) {
+        if (!ec) io_service_.stop();
+      });
+    }
+
     t_download_ = t_stats_ = std::chrono::steady_clock::now();
     consumer_socket_->asyncConsume(configuration_.name);
     io_service_.run();
@@ -654,6 +801,26 @@ class HIperfClient {
     return ERROR_SUCCESS;
   }
 
+  /**
+   * Start the download on the flow io_service, which is run by the caller.
+   */
+  void start() {
+    flow_io_service_->post([this]() {
+      t_download_ = t_stats_ = std::chrono::steady_clock::now();
+      consumer_socket_->consume(configuration_.name);
+    });
+  }
+
+  /**
+   * Stop the download. To be called on the flow io_service.
+   */
+  void stop() {
+    if (t_end_ <= t_download_) {
+      t_end_ = utils::SteadyClock::now();
+    }
+    consumer_socket_->stop();
+  }
+
  private:
   class RTCCallback : public ConsumerSocket::ReadCallback {
     static constexpr std::size_t mtu = 1500;
@@ -678,7 +845,7 @@ class HIperfClient {
 
     void readError(const std::error_code ec) noexcept override {
       std::cerr << "Error while reading from RTC socket" << std::endl;
-      client_.io_service_.stop();
+      client_.done();
     }
 
     void readSuccess(std::size_t total_size) noexcept override {
@@ -717,7 +884,7 @@ class HIperfClient {
     void readError(const std::error_code ec) noexcept override {
       std::cerr << "Error " << ec.message() << " while reading from socket"
                 << std::endl;
-      client_.io_service_.stop();
+      client_.done();
     }
 
     void readSuccess(std::size_t total_size) noexcept override {
@@ -726,14 +893,16 @@ class HIperfClient {
           std::chrono::duration_cast<TimeDuration>(t2 - client_.t_download_);
       long usec = (long)dt.count();
 
-      std::cout << "Content retrieved. Size: " << total_size << " [Bytes]"
-                << std::endl;
+      if (!client_.flow_io_service_) {
+        std::cout << "Content retrieved. Size: " << total_size << " [Bytes]"
+                  << std::endl;
 
-      std::cerr << "Elapsed Time: " << usec / 1000000.0 << " seconds -- "
-                << (total_size * 8) * 1.0 / usec * 1.0 << " [Mbps]"
-                << std::endl;
+        std::cerr << "Elapsed Time: " << usec / 1000000.0 << " seconds -- "
+                  << (total_size * 8) * 1.0 / usec * 1.0 << " [Mbps]"
+                  << std::endl;
+      }
 
-      client_.io_service_.stop();
+      client_.done();
     }
 
    private:
@@ -766,7 +935,7 @@ class HIperfClient {
     void readError(const std::error_code ec) noexcept override {
       std::cerr << "Error " << ec.message() << " while reading from socket"
                 << std::endl;
-      client_.io_service_.stop();
+      client_.done();
     }
 
     bool validateKey() { return !key_->empty(); }
@@ -815,8 +984,614 @@ class HIperfClient {
   Callback callback_;
   KeyCallback key_callback_;
   std::shared_ptr<ConsumerSocket> consumer_socket_;
+
+  asio::io_service *flow_io_service_;
+  std::size_t flow_id_;
+  std::function<void()> on_flow_done_;
+  Time t_end_;
+  std::vector<std::pair<uint32_t, Time>> sent_interests_;
+  uint64_t bytes_received_;
+  // Microseconds
+  utils::HdrHistogram segment_latency_;
+  utils::HdrHistogram frame_delay_;
+  asio::steady_timer duration_timer_;
 };  // namespace interface
 
+/**
+ * Name of the flow number flow_id: the last 16 bits of the address of name
+ * are incremented by flow_id, so that every flow has its own suffix space.
+ */
+static Name getFlowName(const Name &name, std::size_t flow_id) {
+  ip_prefix_t prefix = name.toIpAddress();
+  uint8_t *address = prefix.address.v6.as_u8;
+  uint16_t last = (uint16_t)((address[14] << 8) | address[15]);
+
+  last = (uint16_t)(last + flow_id);
+  address[14] = (uint8_t)(last >> 8);
+  address[15] = (uint8_t)(last & 0xff);
+
+  return Name(prefix.family,
+              prefix.family == AF_INET ? prefix.address.v4.as_u8
+                                       : prefix.address.v6.as_u8,
+              0);
+}
+
+static void printHistogramJson(std::ostream &os,
+                               const utils::HdrHistogram &histogram) {
+  os << "{\"count\": " << histogram.totalCount()
+     << ", \"min\": " << histogram.min() << ", \"mean\": " << std::fixed
+     << std::setprecision(1) << histogram.mean()
+     << ", \"p50\": " << histogram.valueAtPercentile(50)
+     << ", \"p99\": " << histogram.valueAtPercentile(99)
+     << ", \"p99.9\": " << histogram.valueAtPercentile(99.9)
+     << ", \"max\": " << histogram.max() << "}";
+}
+
+static std::string formatPercentiles(const utils::HdrHistogram &histogram) {
+  std::stringstream ss;
+  ss << histogram.valueAtPercentile(50) << "/"
+     << histogram.valueAtPercentile(99) << "/"
+     << histogram.valueAtPercentile(99.9);
+  return ss.str();
+}
+
+/**
+ * Call write on json_file, or on the standard output if json_file is "-".
+ * Nothing is written if json_file is empty.
+ */
+static void writeJson(const std::string &json_file,
+                      const std::function<void(std::ostream &)> &write) {
+  if (json_file.empty()) {
+    return;
+  }
+
+  if (json_file == "-") {
+    write(std::cout);
+    return;
+  }
+
+  std::ofstream file(json_file);
+  if (!file) {
+    std::cerr << "ERROR -- Impossible to open " << json_file << std::endl;
+    return;
+  }
+  write(file);
+}
+
+/**
+ * Print the per-flow and aggregated results of a run, as a table on the
+ * standard output and optionally as JSON in json_file ("-" for stdout).
+ */
+static void printClientReport(const std::vector<const HIperfClient *> &flows,
+                              const std::string &json_file, bool rtc) {
+  const int width = 18;
+  utils::HdrHistogram total_latency, total_delay;
+  uint64_t total_bytes = 0;
+  int64_t total_ms = 0;
+
+  auto goodput = [](uint64_t bytes, int64_t ms) {
+    return ms > 0 ? bytes * 8.0 / ms / 1000.0 : 0.0;
+  };
+
+  std::cout << std::endl;
+  std::cout << std::left << std::setw(8) << "Flow";
+  std::cout << std::left << std::setw(width) << "Goodput[Mbps]";
+  std::cout << std::left << std::setw(width) << "Segments";
+  std::cout << std::left << std::setw(28) << "Latency p50/p99/p99.9[us]";
+  if (rtc) {
+    std::cout << std::left << std::setw(28) << "FrameDelay p50/p99/p99.9[us]";
+  }
+  std::cout << std::endl;
+
+  for (auto flow : flows) {
+    int64_t ms = flow->getDuration().count();
+
+    total_latency.add(flow->getSegmentLatency());
+    total_delay.add(flow->getFrameDelay());
+    total_bytes += flow->getBytesReceived();
+    total_ms = std::max(total_ms, ms);
+
+    std::cout << std::left << std::setw(8) << flow->getFlowId();
+    std::cout << std::left << std::setw(width) << std::fixed
+              << std::setprecision(3)
+              << goodput(flow->getBytesReceived(), ms);
+    std::cout << std::left << std::setw(width)
+              << flow->getSegmentLatency().totalCount();
+    std::cout << std::left << std::setw(28)
+              << formatPercentiles(flow->getSegmentLatency());
+    if (rtc) {
+      std::cout << std::left << std::setw(28)
+                << formatPercentiles(flow->getFrameDelay());
+    }
+    std::cout << std::endl;
+  }
+
+  if (flows.size() > 1) {
+    std::cout << std::left << std::setw(8) << "Total";
+    std::cout << std::left << std::setw(width) << std::fixed
+              << std::setprecision(3) << goodput(total_bytes, total_ms);
+    std::cout << std::left << std::setw(width) << total_latency.totalCount();
+    std::cout << std::left << std::setw(28) << formatPercentiles(total_latency);
+    if (rtc) {
+      std::cout << std::left << std::setw(28) << formatPercentiles(total_delay);
+    }
+    std::cout << std::endl;
+  }
+
+  writeJson(json_file, [&](std::ostream &os) {
+    os << "{\n  \"flows\": [";
+    for (std::size_t i = 0; i < flows.size(); i++) {
+      auto flow = flows[i];
+      int64_t ms = flow->getDuration().count();
+
+      os << (i ? ",\n" : "\n") << "    {\"id\": " << flow->getFlowId()
+         << ", \"name\": \"" << flow->getName() << "\""
+         << ", \"bytes\": " << flow->getBytesReceived()
+         << ", \"duration_ms\": " << ms << ", \"goodput_mbps\": " << std::fixed
+         << std::setprecision(3) << goodput(flow->getBytesReceived(), ms)
+         << ",\n     \"segment_latency_us\": ";
+      printHistogramJson(os, flow->getSegmentLatency());
+      os << ",\n     \"frame_delay_us\": ";
+      printHistogramJson(os, flow->getFrameDelay());
+      os << "}";
+    }
+    os << "\n  ],\n  \"total\": {\"bytes\": " << total_bytes
+       << ", \"duration_ms\": " << total_ms << ", \"goodput_mbps\": "
+       << std::fixed << std::setprecision(3) << goodput(total_bytes, total_ms)
+       << ",\n    \"segment_latency_us\": ";
+    printHistogramJson(os, total_latency);
+    os << ",\n    \"frame_delay_us\": ";
+    printHistogramJson(os, total_delay);
+    os << "}\n}" << std::endl;
+  });
+}
+
+/**
+ * Run n_flows_ HIperfClient flows over n_threads_ threads. Flow i downloads
+ * getFlowName(name, i) on thread i % n_threads_, with its own consumer
+ * socket.
+ */
+class HIperfMultiClient {
+ public:
+  HIperfMultiClient(const ClientConfiguration &conf)
+      : configuration_(conf),
+        signals_(io_service_),
+        duration_timer_(io_service_),
+        flows_done_(0) {}
+
+  int setup() {
+    std::size_t n_threads =
+        std::min(configuration_.n_threads_, configuration_.n_flows_);
+
+    for (std::size_t i = 0; i < n_threads; i++) {
+      io_services_.emplace_back(std::make_unique<asio::io_service>());
+      works_.emplace_back(
+          std::make_unique<asio::io_service::work>(*io_services_.back()));
+    }
+
+    for (std::size_t i = 0; i < configuration_.n_flows_; i++) {
+      ClientConfiguration flow_configuration = configuration_;
+      flow_configuration.name = getFlowName(configuration_.name, i);
+
+      clients_.emplace_back(std::make_unique<HIperfClient>(
+          flow_configuration, io_services_[i % n_threads].get(), i));
+      clients_.back()->setOnFlowDone([this]() {
+        io_service_.post([this]() {
+          if (++flows_done_ == clients_.size()) {
+            io_service_.stop();
+          }
+        });
+      });
+
+      if (clients_.back()->setup() != ERROR_SUCCESS) {
+        return ERROR_SETUP;
+      }
+    }
+
+    return ERROR_SUCCESS;
+  }
+
+  int run() {
+    std::cout << "Starting " << clients_.size() << " flows on "
+              << io_services_.size() << " threads, from "
+              << configuration_.name << std::endl;
+
+    signals_.add(SIGINT);
+    signals_.async_wait(
+        [this](const std::error_code &, const int &) { io_service_.stop(); });
+
+    if (configuration_.duration_seconds_) {
+      duration_timer_.expires_from_now(
+          std::chrono::seconds(configuration_.duration_seconds_));
+      duration_timer_.async_wait([this](const std::error_code &ec) {
+        if (!ec) io_service_.stop();
+      });
+    }
+
+    for (auto &client : clients_) {
+      client->start();
+    }
+
+    for (auto &io_service : io_services_) {
+      asio::io_service *service = io_service.get();
+      threads_.emplace_back([service]() { service->run(); });
+    }
+
+    io_service_.run();
+
+    // Stop the flows on their own threads, then let the threads exit
+    for (std::size_t i = 0; i < clients_.size(); i++) {
+      HIperfClient *client = clients_[i].get();
+      io_services_[i % io_services_.size()]->post(
+          [client]() { client->stop(); });
+    }
+
+    works_.clear();
+    for (auto &io_service : io_services_) {
+      asio::io_service *service = io_service.get();
+      service->post([service]() { service->stop(); });
+    }
+
+    for (auto &thread : threads_) {
+      thread.join();
+    }
+
+    std::vector<const HIperfClient *> flows;
+    for (auto &client : clients_) {
+      flows.push_back(client.get());
+    }
+    printClientReport(flows, configuration_.json_file_, configuration_.rtc_);
+
+    return ERROR_SUCCESS;
+  }
+
+ private:
+  ClientConfiguration configuration_;
+  asio::io_service io_service_;
+  asio::signal_set signals_;
+  asio::steady_timer duration_timer_;
+  std::size_t flows_done_;
+  std::vector<std::unique_ptr<asio::io_service>> io_services_;
+  std::vector<std::unique_ptr<asio::io_service::work>> works_;
+  std::vector<std::thread> threads_;
+  // Declared last: the sockets are destroyed before their io_services
+  std::vector<std::unique_ptr<HIperfClient>> clients_;
+};
+
+#ifndef _WIN32
+/**
+ * Replay a binary request trace (see replay_trace_header_t) against the
+ * forwarder. Every record is sent as one interest at its timestamp, relative
+ * to the start of the replay, and the latency of every request is recorded.
+ *
+ * The virtual hiperf producer writes the time it sends every data packet in
+ * the first bytes of the payload: a data packet sent by the producer before
+ * its interest was sent was served by a cache in the network. As for the RTC
+ * frame delay, producer and consumer clocks must be synchronized if they do
+ * not run on the same host.
+ */
+class HIperfReplayClient {
+  // Records are read ahead from the file by chunks of this size
+  static constexpr std::size_t prefetch_size = 64 * 1024 * 1024;
+
+ public:
+  HIperfReplayClient(const ClientConfiguration &conf)
+      : configuration_(conf),
+        portal_(),
+        signals_(portal_.getIoService()),
+        timer_(portal_.getIoService()),
+        duration_timer_(portal_.getIoService()),
+        fd_(-1),
+        map_(nullptr),
+        map_size_(0),
+        records_(nullptr),
+        n_records_(0),
+        family_(AF_INET6),
+        index_(0),
+        prefetched_(0),
+        outstanding_(0),
+        sent_(0),
+        coalesced_(0),
+        timeouts_(0),
+        hits_(0),
+        bytes_answered_(0),
+        bytes_hit_(0) {}
+
+  ~HIperfReplayClient() {
+    if (map_) {
+      munmap(map_, map_size_);
+    }
+
+    if (fd_ >= 0) {
+      close(fd_);
+    }
+  }
+
+  int setup() {
+    const std::string &file = configuration_.replay_file_;
+    struct stat st;
+
+    fd_ = open(file.c_str(), O_RDONLY);
+    if (fd_ < 0 || fstat(fd_, &st) < 0) {
+      std::cerr << "ERROR -- Impossible to open " << file << std::endl;
+      return ERROR_SETUP;
+    }
+
+    map_size_ = (std::size_t)st.st_size;
+    if (map_size_ < sizeof(replay_trace_header_t)) {
+      std::cerr << "ERROR -- " << file << " is not a replay trace" << std::endl;
+      return ERROR_SETUP;
+    }
+
+    map_ = mmap(nullptr, map_size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (map_ == MAP_FAILED) {
+      map_ = nullptr;
+      std::cerr << "ERROR -- Impossible to map " << file << std::endl;
+      return ERROR_SETUP;
+    }
+
+    auto header = static_cast<const replay_trace_header_t *>(map_);
+    std::size_t max_records = (map_size_ - sizeof(replay_trace_header_t)) /
+                              sizeof(replay_trace_record_t);
+    if (std::memcmp(header->magic, REPLAY_TRACE_MAGIC, sizeof(header->magic)) ||
+        header->version != REPLAY_TRACE_VERSION ||
+        (header->ip_version != 4 && header->ip_version != 6) ||
+        header->n_records > max_records) {
+      std::cerr << "ERROR -- " << file << " is not a valid replay trace"
+                << std::endl;
+      return ERROR_SETUP;
+    }
+
+    records_ = reinterpret_cast<const replay_trace_record_t *>(header + 1);
+    n_records_ = (std::size_t)header->n_records;
+    family_ = header->ip_version == 4 ? AF_INET : AF_INET6;
+
+    madvise(map_, map_size_, MADV_SEQUENTIAL);
+    prefetch();
+
+    portal_.connect();
+
+    return ERROR_SUCCESS;
+  }
+
+  int run() {
+    std::cout << "Replaying " << n_records_ << " requests from "
+              << configuration_.replay_file_ << std::endl;
+
+    signals_.add(SIGINT);
+    signals_.async_wait(
+        [this](const std::error_code &, const int &) { stop(); });
+
+    if (configuration_.duration_seconds_) {
+      duration_timer_.expires_from_now(
+          std::chrono::seconds(configuration_.duration_seconds_));
+      duration_timer_.async_wait([this](const std::error_code &ec) {
+        if (!ec) stop();
+      });
+    }
+
+    t_start_ = utils::SteadyClock::now();
+    scheduleNext();
+    portal_.runEventsLoop();
+    t_end_ = utils::SteadyClock::now();
+
+    printReport();
+
+    return ERROR_SUCCESS;
+  }
+
+ private:
+  /**
+   * Ask the kernel to read ahead the next chunk of records when the replay
+   * gets close to it, so that sending does not stall on page faults.
+   */
+  void prefetch() {
+    std::size_t offset = (std::size_t)(
+        reinterpret_cast<const uint8_t *>(records_ + index_) -
+        static_cast<const uint8_t *>(map_));
+
+    if (prefetched_ >= map_size_ || offset + prefetch_size / 2 < prefetched_) {
+      return;
+    }
+
+    std::size_t length = std::min(prefetch_size, map_size_ - prefetched_);
+    madvise(static_cast<uint8_t *>(map_) + prefetched_, length,
+            MADV_WILLNEED);
+    prefetched_ += length;
+  }
+
+  utils::TimePoint scheduledTime(std::size_t index) const {
+    // Out of order records are sent as soon as possible
+    int64_t offset =
+        (int64_t)(records_[index].timestamp - records_[0].timestamp);
+    return t_start_ + utils::Microseconds(offset > 0 ? offset : 0);
+  }
+
+  void scheduleNext() {
+    if (index_ == n_records_) {
+      if (outstanding_ == 0) {
+        stop();
+      }
+      return;
+    }
+
+    // Absolute deadlines: the timer does not drift over long traces
+    timer_.expires_at(scheduledTime(index_));
+    timer_.async_wait([this](const std::error_code &ec) {
+      if (!ec) sendRequests();
+    });
+  }
+
+  void sendRequests() {
+    utils::TimePoint now = utils::SteadyClock::now();
+
+    while (index_ < n_records_) {
+      utils::TimePoint t = scheduledTime(index_);
+      if (t > now) {
+        break;
+      }
+
+      send_lag_.record(
+          std::chrono::duration_cast<utils::Microseconds>(now - t).count());
+      sendRequest(records_[index_++]);
+    }
+
+    prefetch();
+    scheduleNext();
+  }
+
+  void sendRequest(const replay_trace_record_t &record) {
+    Name name(family_, record.address, record.suffix);
+
+    // The portal keeps one pending interest per name: a request for a name
+    // already pending is aggregated with it, as the forwarder PIT would do.
+    if (portal_.interestIsPending(name)) {
+      coalesced_++;
+      return;
+    }
+
+    auto interest = std::make_shared<Interest>(
+        name, family_ == AF_INET ? HF_INET_TCP : HF_INET6_TCP);
+    interest->setLifetime(configuration_.interest_lifetime_);
+
+    uint32_t size = record.size;
+    utils::TimePoint t_sent = utils::SteadyClock::now();
+    uint64_t t_sent_us =
+        std::chrono::duration_cast<utils::Microseconds>(
+            std::chrono::system_clock::now().time_since_epoch())
+            .count();
+
+    outstanding_++;
+    sent_++;
+    portal_.sendInterest(
+        std::move(interest),
+        [this, size, t_sent, t_sent_us](Interest &, ContentObject &object) {
+          onContentObject(object, size, t_sent, t_sent_us);
+        },
+        [this](Interest::Ptr &&) {
+          timeouts_++;
+          requestDone();
+        });
+  }
+
+  void onContentObject(ContentObject &object, uint32_t size,
+                       utils::TimePoint t_sent, uint64_t t_sent_us) {
+    uint64_t latency = std::chrono::duration_cast<utils::Microseconds>(
+                           utils::SteadyClock::now() - t_sent)
+                           .count();
+    uint64_t send_time = 0;
+
+    if (object.length() >= object.headerSize() + sizeof(send_time)) {
+      std::memcpy(&send_time, object.data() + object.headerSize(),
+                  sizeof(send_time));
+    }
+
+    latency_.record(latency);
+    bytes_answered_ += size;
+
+    if (send_time && send_time < t_sent_us) {
+      hit_latency_.record(latency);
+      hits_++;
+      bytes_hit_ += size;
+    } else {
+      miss_latency_.record(latency);
+    }
+
+    requestDone();
+  }
+
+  void requestDone() {
+    outstanding_--;
+    if (index_ == n_records_ && outstanding_ == 0) {
+      stop();
+    }
+  }
+
+  void stop() {
+    timer_.cancel();
+    duration_timer_.cancel();
+    portal_.stopEventsLoop();
+  }
+
+  void printReport() {
+    auto ratio = [](uint64_t n, uint64_t total) -> double {
+      return total ? 100.0 * n / total : 0.0;
+    };
+    uint64_t answered = latency_.totalCount();
+    double seconds =
+        std::chrono::duration_cast<utils::Milliseconds>(t_end_ - t_start_)
+            .count() /
+        1000.0;
+
+    std::cout << std::endl;
+    std::cout << "Replayed " << index_ << " of " << n_records_
+              << " requests in " << std::fixed << std::setprecision(3)
+              << seconds << " seconds" << std::endl;
+    std::cout << "Sent: " << sent_ << " Coalesced: " << coalesced_
+              << " Answered: " << answered << " Timeouts: " << timeouts_
+              << std::endl;
+    std::cout << "Hit ratio: " << std::setprecision(2)
+              << ratio(hits_, answered) << "% Byte hit ratio: "
+              << ratio(bytes_hit_, bytes_answered_) << "%" << std::endl;
+    std::cout << "Latency p50/p99/p99.9[us]: " << formatPercentiles(latency_)
+              << " (hit " << formatPercentiles(hit_latency_) << ", miss "
+              << formatPercentiles(miss_latency_) << ")" << std::endl;
+    std::cout << "Send lag p50/p99/p99.9[us]: " << formatPercentiles(send_lag_)
+              << std::endl;
+
+    writeJson(configuration_.json_file_, [&](std::ostream &os) {
+      os << "{\n  \"trace\": \"" << configuration_.replay_file_ << "\""
+         << ", \"records\": " << n_records_ << ", \"replayed\": " << index_
+         << ", \"duration_ms\": " << (int64_t)(seconds * 1000)
+         << ",\n  \"sent\": " << sent_ << ", \"coalesced\": " << coalesced_
+         << ", \"answered\": " << answered << ", \"timeouts\": " << timeouts_
+         << ",\n  \"hits\": " << hits_ << ", \"hit_ratio\": " << std::fixed
+         << std::setprecision(4) << ratio(hits_, answered) / 100
+         << ", \"byte_hit_ratio\": " << ratio(bytes_hit_, bytes_answered_) / 100
+         << ",\n  \"latency_us\": ";
+      printHistogramJson(os, latency_);
+      os << ",\n  \"hit_latency_us\": ";
+      printHistogramJson(os, hit_latency_);
+      os << ",\n  \"miss_latency_us\": ";
+      printHistogramJson(os, miss_latency_);
+      os << ",\n  \"send_lag_us\": ";
+      printHistogramJson(os, send_lag_);
+      os << "\n}" << std::endl;
+    });
+  }
+
+  ClientConfiguration configuration_;
+  Portal portal_;
+  asio::signal_set signals_;
+  asio::steady_timer timer_;
+  asio::steady_timer duration_timer_;
+
+  int fd_;
+  void *map_;
+  std::size_t map_size_;
+  const replay_trace_record_t *records_;
+  std::size_t n_records_;
+  int family_;
+  std::size_t index_;
+  std::size_t prefetched_;
+
+  utils::TimePoint t_start_;
+  utils::TimePoint t_end_;
+  std::size_t outstanding_;
+  uint64_t sent_;
+  uint64_t coalesced_;
+  uint64_t timeouts_;
+  uint64_t hits_;
+  uint64_t bytes_answered_;
+  uint64_t bytes_hit_;
+  // Microseconds
+  utils::HdrHistogram latency_;
+  utils::HdrHistogram hit_latency_;
+  utils::HdrHistogram miss_latency_;
+  utils::HdrHistogram send_lag_;
+};
+#endif
+
 /**
  * Hiperf server class: configure and setup an hicn producer following the
  * ServerConfiguration.
@@ -862,10 +1637,25 @@ class HIperfServer {
 
   void virtualProcessInterest(ProducerSocket &p, const Interest &interest) {
     // std::cout << "Received interest " << interest.getName() << std::endl;
-    content_objects_[content_objects_index_ & mask_]->setName(
-        interest.getName());
-    producer_socket_->produce(
-        *content_objects_[content_objects_index_++ & mask_]);
+    auto &content_object =
+        *content_objects_[content_objects_index_++ & mask_];
+    content_object.setName(interest.getName());
+    producer_socket_->produce(content_object);
+  }
+
+  void stampContentObject(ProducerSocket &p, ContentObject &content_object) {
+    // Time in us at which the producer sends the packet, used by the client
+    // in replay mode to detect the data packets served by a cache. Stamping
+    // on output rather than on production makes anything served by the
+    // producer itself, output buffer included, count as a miss.
+    // It requires clock synchronization between producer and consumer
+    if (configuration_.payload_size_ >= sizeof(uint64_t)) {
+      uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+      std::memcpy(content_object.getPayload()->writableData(), &now,
+                  sizeof(uint64_t));
+    }
   }
 
   void processInterest(ProducerSocket &p, const Interest &interest) {
@@ -1074,6 +1864,16 @@ class HIperfServer {
       if (ret == SOCKET_OPTION_NOT_SET) {
         return ERROR_SETUP;
       }
+
+      ret = producer_socket_->setSocketOption(
+          ProducerCallbacksOptions::CONTENT_OBJECT_OUTPUT,
+          (ProducerContentObjectCallback)bind(
+              &HIperfServer::stampContentObject, this, std::placeholders::_1,
+              std::placeholders::_2));
+
+      if (ret == SOCKET_OPTION_NOT_SET) {
+        return ERROR_SETUP;
+      }
     }
 
     ret = producer_socket_->setSocketOption(
@@ -1383,6 +2183,28 @@ void usage() {
             << std::endl;
   std::cerr << "-P\t\t\t\t\t"
             << "Prefix of the producer where to do the handshake" << std::endl;
+#ifndef _WIN32
+  std::cerr << "-T\t<filename>\t\t\t"
+            << "Replay the requests of a binary trace at their timestamps "
+               "and report the\n\t\t\t\t\tcache hit ratio and the "
+               "latency. The name argument is ignored."
+            << std::endl;
+#endif
+  std::cerr << "-N\t<n_flows>\t\t\t"
+            << "Number of parallel flows. Flow i retrieves the name with the "
+               "last 16 bits of the\n\t\t\t\t\taddress incremented by i "
+               "(default 1)."
+            << std::endl;
+  std::cerr << "-j\t<n_threads>\t\t\t"
+            << "Number of threads running the flows (default 1)." << std::endl;
+  std::cerr << "-e\t<seconds>\t\t\t"
+            << "Stop after <seconds>, even if the download is not over."
+            << std::endl;
+  std::cerr << "-J\t<filename>\t\t\t"
+            << "Write the results, including the segment latency and RTC "
+               "frame delay\n\t\t\t\t\tpercentiles, as JSON to <filename> "
+               "(- for stdout)."
+            << std::endl;
 }
 
 int main(int argc, char *argv[]) {
@@ -1411,9 +2233,9 @@ int main(int argc, char *argv[]) {
 
   int opt;
 #ifndef _WIN32
-  while ((opt = getopt(
-              argc, argv,
-              "DSCf:b:d:W:RM:c:vA:s:rmlK:k:y:p:hi:xE:P:B:ItL:z:T:F:")) != -1) {
+  while ((opt = getopt(argc, argv,
+                       "DSCf:b:d:W:RM:c:vA:s:rmlK:k:y:p:hi:xE:P:B:ItL:z:T:F:"
+                       "N:j:e:J:")) != -1) {
     switch (opt) {
       // Common
       case 'D': {
@@ -1429,12 +2251,13 @@ int main(int argc, char *argv[]) {
         server_configuration.interactive_ = false;
         server_configuration.trace_based_ = true;
         server_configuration.trace_file_ = optarg;
+        client_configuration.replay_file_ = optarg;
         break;
       }
 #else
   while ((opt = getopt(argc, argv,
-                       "SCf:b:d:W:RM:c:vA:s:rmlK:k:y:p:hi:xB:E:P:tL:z:F:")) !=
-         -1) {
+                       "SCf:b:d:W:RM:c:vA:s:rmlK:k:y:p:hi:xB:E:P:tL:z:F:N:j:e:"
+                       "J:")) != -1) {
     switch (opt) {
 #endif
       case 'f': {
@@ -1517,6 +2340,26 @@ int main(int argc, char *argv[]) {
         options = 1;
         break;
       }
+      case 'N': {
+        client_configuration.n_flows_ = std::stoul(optarg);
+        options = 1;
+        break;
+      }
+      case 'j': {
+        client_configuration.n_threads_ = std::stoul(optarg);
+        options = 1;
+        break;
+      }
+      case 'e': {
+        client_configuration.duration_seconds_ = std::stoul(optarg);
+        options = 1;
+        break;
+      }
+      case 'J': {
+        client_configuration.json_file_ = std::string(optarg);
+        options = 1;
+        break;
+      }
       // Server specific
       case 'A': {
         server_configuration.download_size = std::stoul(optarg);
@@ -1612,6 +2455,30 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  if (client_configuration.n_flows_ < 1 ||
+      client_configuration.n_flows_ > MAX_FLOWS ||
+      client_configuration.n_threads_ < 1) {
+    std::cerr << "The number of flows must be in [1, " << MAX_FLOWS
+              << "] and the number of threads at least 1" << std::endl;
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  if (client_configuration.n_flows_ > 1 && client_configuration.secure_) {
+    std::cerr << "Multiple flows cannot be used with the secure consumer (-P)"
+              << std::endl;
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  if (!client_configuration.replay_file_.empty() &&
+      client_configuration.n_flows_ > 1) {
+    std::cerr << "Multiple flows cannot be used in replay mode (-T)"
+              << std::endl;
+    usage();
+    return EXIT_FAILURE;
+  }
+
   if (argv[optind] == 0) {
     std::cerr << "Please specify the name/prefix to use." << std::endl;
     usage();
@@ -1653,10 +2520,24 @@ int main(int argc, char *argv[]) {
   // Parse config file
   transport::interface::global_config::parseConfigurationFile(conf_file);
 
-  if (role > 0) {
+  if (role > 0 && !client_configuration.replay_file_.empty()) {
+#ifndef _WIN32
+    HIperfReplayClient c(client_configuration);
+    if (c.setup() != ERROR_SETUP) {
+      c.run();
+    }
+#endif
+  } else if (role > 0 && client_configuration.n_flows_ > 1) {
+    HIperfMultiClient c(client_configuration);
+    if (c.setup() != ERROR_SETUP) {
+      c.run();
+    }
+  } else if (role > 0) {
     HIperfClient c(client_configuration);
     if (c.setup() != ERROR_SETUP) {
       c.run();
+      printClientReport({&c}, client_configuration.json_file_,
+                        client_configuration.rtc_);
     }
   } else if (role < 0) {
     HIperfServer s(server_configuration);